@@ -0,0 +1,70 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_format_bench.cpp
+ * purpose: buffer formatting against the old per bit toString
+ */
+
+
+#include "bit_format.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/* toString as it was: one std::to_string and append per bit */
+static std::string legacy(const bittle::Bits64U& b)
+{
+  std::string temp;
+  for(int i = 63; i >= 0; --i)
+    temp.append(std::to_string((b.value() >> i) & 1));
+  return temp;
+}
+
+template <typename F>
+static void run(const char* name, const std::vector<bittle::Bits64U>& in, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    for(const auto& b : in)
+      sink += f(b);
+  auto t1 = std::chrono::steady_clock::now();
+
+  std::cout << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(in.size()) * reps)
+            << "ns/value (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 14);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  std::vector<Bits64U> in;
+  uint64_t s = 88172645463325252ULL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    in.push_back(Bits64U(s));
+  }
+
+  char buf[160];
+  BitFormat bin;
+  BitFormat grouped;
+  grouped.group = 8;
+  BitFormat hex;
+  hex.base = 16;
+
+  run("legacy toString  ", in, reps, [](const Bits64U& b) { return legacy(b)[7]; });
+  run("toString         ", in, reps, [](const Bits64U& b) { return b.toString()[7]; });
+  run("format_bits bin  ", in, reps, [&](const Bits64U& b) { return format_bits(b, buf, sizeof(buf), bin) + buf[7]; });
+  run("format_bits bin/8", in, reps, [&](const Bits64U& b) { return format_bits(b, buf, sizeof(buf), grouped) + buf[7]; });
+  run("format_bits hex  ", in, reps, [&](const Bits64U& b) { return format_bits(b, buf, sizeof(buf), hex) + buf[7]; });
+  run("to_text bin      ", in, reps, [](const Bits64U& b) { return to_text(b).c_str()[7]; });
+
+  return EXIT_SUCCESS;
+}
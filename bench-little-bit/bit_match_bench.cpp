@@ -0,0 +1,92 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_match_bench.cpp
+ * purpose: matcher throughput in MB/s over log-like text
+ */
+
+
+#include "bit_match.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const char* name, std::size_t bytes, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << double(bytes) * reps / std::chrono::duration<double, std::micro>(t1 - t0).count()
+            << " MB/s (" << sink / reps << " hits)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  /* words of 2 - 9 lowercase letters between spaces and newlines */
+  std::string text;
+  uint64_t s = 88172645463325252ULL;
+  while(text.size() < n)
+  {
+    next(s);
+    const int len = 2 + static_cast<int>(s % 8);
+    for(int i = 0; i < len; ++i)
+      text += static_cast<char>('a' + (s >> (8 + 5 * i)) % 26);
+    text += (s >> 60) == 0 ? '\n' : ' ';
+  }
+  const std::string pats[] = {"error", "connection refused", std::string(40, 'a') + " timeout " + std::string(50, 'b')};
+
+  for(const std::string& p : pats)
+  {
+    std::cout << "pattern of " << p.size() << " bytes" << std::endl;
+    run("std::string::find    ", text.size(), reps, [&]() {
+      uint64_t c = 0;
+      for(std::size_t i = text.find(p); i != std::string::npos; i = text.find(p, i + 1)) ++c;
+      return c;
+    });
+    const ShiftOr so(p.data(), p.size());
+    run("ShiftOr              ", text.size(), reps, [&]() { return so.count(text.data(), text.size()); });
+    const WuManber h1(p.data(), p.size(), 1, MatchMetric::hamming);
+    run("WuManber hamming k=1 ", text.size(), reps, [&]() { return h1.count(text.data(), text.size()); });
+    const WuManber e2(p.data(), p.size(), 2);
+    run("WuManber edit k=2    ", text.size(), reps, [&]() { return e2.count(text.data(), text.size()); });
+    const Myers my(p.data(), p.size());
+    run("Myers k=2            ", text.size(), reps, [&]() {
+      return my.findAll(text.data(), text.size(), 2, [](std::size_t, std::size_t) {});
+    });
+  }
+
+  /* 16 short patterns: one batch pass against 16 ShiftOr passes */
+  std::vector<std::string> many;
+  std::vector<const char*> ptrs;
+  std::vector<std::size_t> lens;
+  const char* words[] = {"error", "warn", "fatal", "denied", "timeout", "refused", "panic", "abort",
+                         "retry", "closed", "reset", "failed", "invalid", "missing", "overflow", "killed"};
+  for(const char* w : words)
+    many.push_back(w);
+  for(const std::string& w : many)
+  {
+    ptrs.push_back(w.data());
+    lens.push_back(w.size());
+  }
+  std::cout << many.size() << " patterns, " << implementation(Kernel::logic) << " cpu" << std::endl;
+  run("16 x ShiftOr         ", text.size(), reps, [&]() {
+    uint64_t c = 0;
+    for(const std::string& w : many)
+      c += ShiftOr(w.data(), w.size()).count(text.data(), text.size());
+    return c;
+  });
+  const ShiftOrBatch batch(ptrs.data(), lens.data(), many.size());
+  run("ShiftOrBatch         ", text.size(), reps, [&]() { return batch.count(text.data(), text.size()); });
+  return EXIT_SUCCESS;
+}
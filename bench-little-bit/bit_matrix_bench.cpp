@@ -0,0 +1,74 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_matrix_bench.cpp
+ * purpose: BitMatrix kernel timings, sizes given on the command line
+ */
+
+
+#include "bit_matrix.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+
+template <typename F>
+static double time_ms(F&& f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  std::mt19937_64 rng(1);
+
+  std::vector<std::size_t> sizes;
+  for(int i = 1; i < argc; ++i)
+    sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+  if(sizes.empty())
+    sizes = {1024, 2048, 4096, 8192, 16384};
+
+  for(const std::size_t n : sizes)
+  {
+    BitMatrix a(n, n), b(n, n);
+    for(std::size_t i = 0; i < n; ++i)
+      for(std::size_t w = 0; w < a.rowWords() && w * 64 < n; ++w)
+      {
+        a.row(i)[w] = rng();
+        b.row(i)[w] = rng();
+      }
+    if(n % 64)
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        a.row(i)[n / 64] &= (uint64_t(1) << (n % 64)) - 1;
+        b.row(i)[n / 64] &= (uint64_t(1) << (n % 64)) - 1;
+      }
+
+    std::size_t sink = 0;
+    const double tt = time_ms([&] { sink += a.transpose().ones(); });
+    const double tm = time_ms([&] { sink += BitMatrix::multiply(a, b).ones(); });
+    const double tb = time_ms([&] { sink += BitMatrix::booleanMultiply(a, b).ones(); });
+    const double tr = time_ms([&] { sink += a.rank(); });
+
+    /* sparse graph, about two edges per node */
+    BitMatrix g(n, n);
+    for(std::size_t e = 0; e < 2 * n; ++e)
+      g.set(rng() % n, rng() % n);
+    const double tc = time_ms([&] { sink += g.transitiveClosure().ones(); });
+
+    std::cout << "n=" << n
+              << " transpose=" << tt << "ms"
+              << " gf2_mul=" << tm << "ms"
+              << " bool_mul=" << tb << "ms"
+              << " rank=" << tr << "ms"
+              << " closure=" << tc << "ms"
+              << " (" << sink % 2 << ")" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
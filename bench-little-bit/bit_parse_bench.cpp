@@ -0,0 +1,96 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_parse_bench.cpp
+ * purpose: parser throughput in GB/s against one insertRight per char
+ */
+
+
+#include "bit_parse.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const char* name, const std::string& text, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+
+  const double bytes = double(text.size()) * reps;
+  std::cout << name << " " << bytes / std::chrono::duration<double, std::nano>(t1 - t0).count()
+            << "GB/s (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  /* n binary digits, the same as 64 digit lines, and n / 4 hex digits */
+  std::string bin, lines, hex;
+  uint64_t s = 88172645463325252ULL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    bin += static_cast<char>('0' + (s & 1));
+    lines += bin.back();
+    if(i % 64 == 63)
+      lines += '\n';
+    if(i % 4 == 0)
+      hex += "0123456789abcdef"[s >> 60];
+  }
+  std::vector<uint64_t> words(n / 64 + 1);
+
+  run("insertRight per char ", bin, reps, [&]() {
+    /* what users did before: build each word a bit at a time */
+    std::size_t w = 0;
+    for(std::size_t i = 0; i + 64 <= bin.size(); i += 64)
+    {
+      Bits64U b(0);
+      for(int k = 0; k < 64; ++k)
+        b.insertRight(bin[i + k] - '0');
+      words[w++] = b.value();
+    }
+    return words[w / 2];
+  });
+
+  run("Bits::parse x64      ", bin, reps, [&]() {
+    std::size_t w = 0;
+    for(std::size_t i = 0; i + 64 <= bin.size(); i += 64)
+    {
+      Bits64U b(0);
+      Bits64U::parse(bin.data() + i, 64, b);
+      words[w++] = b.value();
+    }
+    return words[w / 2];
+  });
+
+  run("stream binary        ", bin, reps, [&]() {
+    std::size_t w = 0;
+    parse_words<2>(bin.data(), bin.size(), words.data(), words.size(), w);
+    return words[w / 2];
+  });
+
+  run("stream binary lines  ", lines, reps, [&]() {
+    std::size_t w = 0;
+    parse_words<2>(lines.data(), lines.size(), words.data(), words.size(), w);
+    return words[w / 2];
+  });
+
+  run("stream hex           ", hex, reps, [&]() {
+    std::size_t w = 0;
+    parse_words<16>(hex.data(), hex.size(), words.data(), words.size(), w);
+    return words[w / 2];
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_permute_bench.cpp
+ * purpose: compiled permutations against the per bit loop
+ */
+
+
+#include "bit_permute.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+struct DesFp
+{
+  static constexpr uint8_t map[64] = {
+    24, 56, 16, 48,  8, 40,  0, 32, 25, 57, 17, 49,  9, 41,  1, 33,
+    26, 58, 18, 50, 10, 42,  2, 34, 27, 59, 19, 51, 11, 43,  3, 35,
+    28, 60, 20, 52, 12, 44,  4, 36, 29, 61, 21, 53, 13, 45,  5, 37,
+    30, 62, 22, 54, 14, 46,  6, 38, 31, 63, 23, 55, 15, 47,  7, 39 };
+};
+constexpr uint8_t DesFp::map[64];
+
+/* move four 16 bit fields around */
+struct FieldSwap
+{
+  static constexpr uint8_t map[64] = {
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47 };
+};
+constexpr uint8_t FieldSwap::map[64];
+
+template <typename P>
+static void run(const char* name, const std::vector<uint64_t>& in, int reps)
+{
+  std::vector<uint64_t> out(in.size());
+  uint64_t sink = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+  {
+    for(std::size_t i = 0; i < in.size(); ++i)
+      out[i] = P::applyNaive(in[i]);
+    sink += out[r % out.size()];
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+  {
+    P::apply(in.data(), out.data(), in.size());
+    sink += out[r % out.size()];
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  const double words = double(in.size()) * reps;
+  std::cout << name << " (" << (P::plan.benes ? "benes " : "groups ")
+            << (P::plan.benes ? P::plan.stages : P::plan.groups) << ")"
+            << " naive=" << std::chrono::duration<double, std::nano>(t1 - t0).count() / words << "ns/word"
+            << " compiled=" << std::chrono::duration<double, std::nano>(t2 - t1).count() / words << "ns/word"
+            << " (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 16);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  std::vector<uint64_t> in(n);
+  uint64_t s = 88172645463325252ULL;
+  for(auto& v : in)
+  {
+    next(s);
+    v = s;
+  }
+
+  run<BitPermutation<uint64_t, DesFp>>("des-fp", in, reps);
+  run<BitPermutation<uint64_t, FieldSwap>>("field-swap", in, reps);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_reversal_bench.cpp
+ * purpose: tiled bit_reverse_permute against per index reversal loops
+ */
+
+
+#include "bit_reversal.hpp"
+#include <chrono>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t n, int reps, F f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(n) * reps)
+            << " ns/element" << std::endl;
+}
+
+template <typename T>
+static void bench(const char* type, int log2n, int reps, unsigned threads)
+{
+  using namespace bittle;
+  const std::size_t n = std::size_t(1) << log2n;
+  std::vector<T> in(n), out(n);
+  for(std::size_t i = 0; i < n; ++i)
+    in[i] = T(float(i), float(n - i));
+
+  std::cout << type << ", 2^" << log2n << " elements" << std::endl;
+  run("reverse_bits per index", n, reps, [&]() {
+    for(std::size_t i = 0; i < n; ++i)
+      out[bittle::reverse_bits<uint64_t>(i) >> (64 - log2n)] = in[i];
+  });
+  run("reversed counter       ", n, reps, [&]() { detail::reversal_simple(in.data(), out.data(), log2n); });
+  run("in place counter       ", n, reps, [&]() { detail::reversal_simple(out.data(), log2n); });
+  run("tiled                  ", n, reps, [&]() { bit_reverse_permute(in.data(), out.data(), log2n); });
+  run("tiled in place         ", n, reps, [&]() { bit_reverse_permute(out.data(), log2n); });
+  if(threads != 1)
+  {
+    run("tiled, threads         ", n, reps, [&]() { bit_reverse_permute(in.data(), out.data(), log2n, threads); });
+    run("tiled in place, threads", n, reps, [&]() { bit_reverse_permute(out.data(), log2n, threads); });
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const int log2n = argc > 1 ? std::atoi(argv[1]) : 22;
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+  const unsigned threads = argc > 3 ? unsigned(std::atoi(argv[3])) : 0;
+
+  bench<std::complex<float>>("complex<float>", log2n, reps, threads);
+  bench<std::complex<double>>("complex<double>", log2n, reps, threads);
+  return EXIT_SUCCESS;
+}
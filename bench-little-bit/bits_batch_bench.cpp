@@ -0,0 +1,85 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bits_batch_bench.cpp
+ * purpose: BitsBatch over arrays against a Bits per element loop
+ */
+
+
+#include "bits_batch.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t ops, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(ops) * reps)
+            << " ns/op (" << (sink & 1) << ")" << std::endl;
+}
+
+template <typename T>
+static void bench(const char* type, std::size_t n, int reps, uint64_t& s)
+{
+  using namespace bittle;
+  constexpr std::size_t N = 2048 / sizeof(T);
+  std::vector<T> in(n), out(n);
+  for(T& v : in)
+    v = T(next(s));
+
+  /* per element loop, then the same through BitsBatch<T, N> */
+  auto each = [&](const std::string& name, auto f) {
+    run(name + " Bits     ", n, reps, [&]() {
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        Bits<T> b(in[i]);
+        out[i] = f(b);
+      }
+      return uint64_t(out[n / 2]);
+    });
+  };
+  auto batch = [&](const std::string& name, auto f) {
+    run(name + " BitsBatch", n, reps, [&]() {
+      transform_batches<N>(in.data(), out.data(), n, f);
+      return uint64_t(out[n / 2]);
+    });
+  };
+
+  std::cout << type << ", " << n << " values, " << N << " lanes, "
+            << BitsBatch<T, N>::implementation() << std::endl;
+
+  each("reverseBits   ", [](Bits<T>& b) { return b.reverseBits().value(); });
+  batch("reverseBits   ", [](BitsBatch<T, N>& b) { b.reverseBits(); });
+  each("ones          ", [](Bits<T>& b) { return T(b.ones()); });
+  batch("ones          ", [](BitsBatch<T, N>& b) { b = b.ones(); });
+  each("leadingZeroes ", [](Bits<T>& b) { return T(b.leadingZeroes()); });
+  batch("leadingZeroes ", [](BitsBatch<T, N>& b) { b = b.leadingZeroes(); });
+  each("trailingZeroes", [](Bits<T>& b) { return T(b.trailingZeroes()); });
+  batch("trailingZeroes", [](BitsBatch<T, N>& b) { b = b.trailingZeroes(); });
+  each("rotateLeft    ", [](Bits<T>& b) { return b.rotateLeft(5).value(); });
+  batch("rotateLeft    ", [](BitsBatch<T, N>& b) { b.rotateLeft(5); });
+  each("mixed         ", [](Bits<T>& b) { return b.setBit(3).rotateRight(7).multiply(T(0x9E3779B97F4A7C15ULL)).value(); });
+  batch("mixed         ", [](BitsBatch<T, N>& b) { b.setBit(3).rotateRight(7).multiply(T(0x9E3779B97F4A7C15ULL)); });
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  uint64_t s = 88172645463325252ULL;
+  bench<uint8_t>("uint8_t", n, reps, s);
+  bench<uint16_t>("uint16_t", n, reps, s);
+  bench<uint32_t>("uint32_t", n, reps, s);
+  bench<uint64_t>("uint64_t", n, reps, s);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: compile_time_bench.cpp
+ * purpose: build time of a generated translation unit full of variadic
+ * insertRight/insertLeft/assign calls, compiled with -ftime-report
+ */
+
+
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+/* one argument list of n bits, literals are a mix of int and bool so the
+ * calls do not all share one signature */
+static std::string bit_args(int n, uint64_t& s)
+{
+  std::string out;
+  for(int i = 0; i < n; ++i)
+  {
+    const uint64_t r = next(s);
+    if(i)
+      out += ", ";
+    if(r & 2)
+      out += (r & 1) ? "true" : "false";
+    else
+      out += (r & 1) ? "1" : "0";
+  }
+  return out;
+}
+
+/* writes 'uses' functions, each running all three methods over one of the
+ * unsigned widths with a 1 - tsize argument list */
+static void generate(const std::string& path, int uses)
+{
+  static const char* types[] = {"uint8_t", "uint16_t", "uint32_t", "uint64_t"};
+  static const int widths[] = {8, 16, 32, 64};
+  uint64_t s = 88172645463325252ULL;
+
+  std::ofstream out(path);
+  out << "#include \"bittle.hpp\"\n\n";
+  for(int i = 0; i < uses; ++i)
+  {
+    const int t = i % 4;
+    const int n = 1 + int(next(s) % widths[t]);
+    out << "uint64_t use_" << i << "(uint64_t x)\n{\n"
+        << "  bittle::Bits<" << types[t] << "> b(static_cast<" << types[t] << ">(x));\n"
+        << "  b.insertRight(" << bit_args(n, s) << ");\n"
+        << "  b.insertLeft(" << bit_args(n, s) << ");\n"
+        << "  uint64_t r = b.value();\n"
+        << "  b.assign(" << bit_args(n, s) << ");\n"
+        << "  return r ^ b.value();\n}\n\n";
+  }
+}
+
+/* compiles the file once per rep, prints mean wall time and the last
+ * -ftime-report TOTAL line */
+static void run(const std::string& name, const std::string& cmd, int reps)
+{
+  double ms = 0;
+  for(int r = 0; r < reps; ++r)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    if(std::system(cmd.c_str()) != 0)
+    {
+      std::cout << "  " << name << " compile failed" << std::endl;
+      return;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+
+  std::string total;
+  std::ifstream report("/tmp/bittle_compile_bench.txt");
+  for(std::string line; std::getline(report, line); )
+    if(line.find("TOTAL") != std::string::npos)
+      total = line;
+  std::cout << "  " << name << " " << ms / reps << " ms wall" << std::endl
+            << "   " << total << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  const int uses = argc > 1 ? std::atoi(argv[1]) : 4000;
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+  const std::string include = argc > 3 ? argv[3] : "little-bit";
+  const char* env = std::getenv("CXX");
+  const std::string cxx = env ? env : "g++";
+
+  const std::string src = "/tmp/bittle_compile_bench.cpp";
+  generate(src, uses);
+
+  const std::string base = cxx + " -std=c++14 -ftime-report -I " + include + " -c " + src + " -o /dev/null";
+  const std::string report = " 2> /tmp/bittle_compile_bench.txt";
+  std::cout << uses << " generated uses, " << cxx << std::endl;
+  run("-O0", base + " -O0" + report, reps);
+  run("-O2", base + " -O2" + report, reps);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: crc_bench.cpp
+ * purpose: Crc throughput per path
+ */
+
+
+#include "crc.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename C>
+static void run(const char* name, const std::vector<uint8_t>& buf, int reps)
+{
+  using namespace bittle;
+  const char* names[] = {"best", "bytewise", "slice8", "slice16", "clmul", "crc32c"};
+  const CrcPath paths[] = {CrcPath::best, CrcPath::bytewise, CrcPath::slice8,
+                           CrcPath::slice16, CrcPath::clmul, CrcPath::crc32c};
+  for(int i = 0; i < 6; ++i)
+  {
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < reps; ++r)
+      sink += C::compute(buf.data(), buf.size(), paths[i]);
+    auto stop = std::chrono::steady_clock::now();
+    const double s = std::chrono::duration<double>(stop - start).count();
+    std::cout << name << " " << names[i] << ": "
+              << (double(buf.size()) * reps / s / 1e9) << " GB/s (" << (sink & 1) << ")" << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  std::vector<uint8_t> buf(size);
+  for(std::size_t i = 0; i < size; ++i)
+    buf[i] = static_cast<uint8_t>(i * 131 + (i >> 7));
+
+  run<Crc32>("crc32", buf, reps);
+  run<Crc32C>("crc32c", buf, reps);
+  run<Crc64Xz>("crc64/xz", buf, reps);
+
+  return EXIT_SUCCESS;
+}
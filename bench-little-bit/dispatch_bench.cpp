@@ -0,0 +1,62 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: dispatch_bench.cpp
+ * purpose: dispatched kernels against their scalar fallbacks
+ */
+
+
+#include "dispatch.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename F>
+static double gbs(std::size_t bytes, int reps, F f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    f();
+  auto t1 = std::chrono::steady_clock::now();
+  return double(bytes) * reps / std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 14);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+  std::vector<uint64_t> a(n), b(n), out(n);
+  uint64_t s = 88172645463325252ULL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    a[i] = s;
+    b[i] = ~s * 3;
+  }
+
+  const detail::DispatchTable tables[2] = {detail::make_table(CpuFeatures()), dispatch_table()};
+  const std::size_t bytes = n * sizeof(uint64_t);
+  uint64_t sink = 0;
+
+  for(const auto& t : tables)
+  {
+    std::cout << "popcount  " << t.names[0] << ": "
+              << gbs(bytes, reps, [&]() { sink += t.popcount(a.data(), n); }) << " GB/s" << std::endl;
+    std::cout << "pext      " << t.names[1] << ": "
+              << gbs(bytes, reps / 10, [&]() { t.pext_bulk(a.data(), 0x5555AAAA00FF1234ULL, out.data(), n); }) << " GB/s" << std::endl;
+    std::cout << "byteswap  " << t.names[2] << ": "
+              << gbs(bytes, reps, [&]() { t.byteswap(reinterpret_cast<const uint8_t*>(a.data()),
+                                                     reinterpret_cast<uint8_t*>(out.data()), n, 8); }) << " GB/s" << std::endl;
+    std::cout << "xor       " << t.names[3] << ": "
+              << gbs(bytes, reps, [&]() { t.logic[2](a.data(), b.data(), out.data(), n); }) << " GB/s" << std::endl;
+    sink += out[n / 2];
+  }
+
+  std::cout << "(" << (sink & 1) << ")" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: elias_fano_bench.cpp
+ * purpose: EliasFano space and ns per operation against a raw uint64_t array
+ */
+
+
+#include "elias_fano.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename F>
+static void run(const char* name, std::size_t ops, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(ops) * reps)
+            << " ns/op (" << (sink & 1) << ")" << std::endl;
+}
+
+static std::vector<uint64_t> sequence(uint64_t& s, std::size_t n, uint64_t gap)
+{
+  std::vector<uint64_t> v(n);
+  uint64_t x = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    x += 1 + s % gap;
+    v[i] = x;
+  }
+  return v;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 23);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  uint64_t s = 88172645463325252ULL;
+  const std::vector<uint64_t> v = sequence(s, n, 64);
+  const EliasFano ef(v);
+  std::cout << n << " values, mean gap 32, L = " << ef.lowBits() << ", "
+            << double(ef.sizeInBits()) / double(n) << " bits per value (raw 64)" << std::endl;
+
+  std::vector<std::size_t> idx(1 << 20);
+  std::vector<uint64_t> keys(1 << 20);
+  for(std::size_t i = 0; i < idx.size(); ++i)
+  {
+    next(s);
+    idx[i] = s % n;
+    keys[i] = s % v.back();
+  }
+
+  run("raw random access    ", idx.size(), reps, [&]() {
+    uint64_t t = 0;
+    for(std::size_t i : idx) t += v[i];
+    return t;
+  });
+  run("at()                 ", idx.size(), reps, [&]() {
+    uint64_t t = 0;
+    for(std::size_t i : idx) t += ef.at(i);
+    return t;
+  });
+  run("std::lower_bound     ", keys.size(), reps, [&]() {
+    uint64_t t = 0;
+    for(uint64_t x : keys) t += static_cast<uint64_t>(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+    return t;
+  });
+  run("nextGeq()            ", keys.size(), reps, [&]() {
+    uint64_t t = 0;
+    for(uint64_t x : keys) t += ef.nextGeq(x);
+    return t;
+  });
+  run("raw iteration        ", n, reps, [&]() {
+    uint64_t t = 0;
+    for(uint64_t x : v) t += x;
+    return t;
+  });
+  run("cursor iteration     ", n, reps, [&]() {
+    uint64_t t = 0;
+    for(uint64_t x : ef) t += x;
+    return t;
+  });
+  std::vector<uint64_t> out(n);
+  run("decode()             ", n, reps, [&]() {
+    return ef.decode(out.data()) + out[n / 2];
+  });
+
+  /* posting list style: a long list against one 1/64 (and 1/1024) its size */
+  const std::vector<uint64_t> shorts[] = {sequence(s, n / 64, 64 * 64), sequence(s, n / 1024, 64 * 1024)};
+  for(const std::vector<uint64_t>& b : shorts)
+  {
+    const EliasFano eb(b);
+    std::cout << "intersect " << n << " x " << b.size() << std::endl;
+    std::vector<uint64_t> res(b.size());
+    run("std::set_intersection", b.size(), reps, [&]() {
+      return static_cast<uint64_t>(std::set_intersection(v.begin(), v.end(), b.begin(), b.end(), res.begin()) - res.begin());
+    });
+    run("raw lower_bound skip ", b.size(), reps, [&]() {
+      std::size_t k = 0;
+      auto it = v.begin();
+      for(uint64_t x : b)
+      {
+        it = std::lower_bound(it, v.end(), x);
+        if(it == v.end()) break;
+        if(*it == x) res[k++] = x;
+      }
+      return static_cast<uint64_t>(k);
+    });
+    run("intersect()          ", b.size(), reps, [&]() {
+      return static_cast<uint64_t>(intersect(ef, eb, res.data()));
+    });
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: galois_bench.cpp
+ * purpose: clmul per call and GF mulXor throughput per path, one core
+ */
+
+
+#include "galois.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename F>
+static double seconds(int reps, F f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    f();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t1 - t0).count();
+}
+
+static void bench_clmul(uint64_t& s)
+{
+  using namespace bittle;
+  std::vector<uint64_t> a(4096), b(4096);
+  for(std::size_t i = 0; i < a.size(); ++i)
+  {
+    a[i] = next(s);
+    b[i] = next(s);
+  }
+
+  uint64_t sink = 0;
+  const int reps = 2000;
+  const double hw = seconds(reps, [&]() {
+    for(std::size_t i = 0; i < a.size(); ++i)
+      sink += clmul(a[i], b[i]).hi;
+  });
+  const double soft = seconds(reps, [&]() {
+    for(std::size_t i = 0; i < a.size(); ++i)
+      sink += detail::clmul_soft(a[i], b[i]).hi;
+  });
+  const double ops = double(a.size()) * reps;
+  std::cout << "clmul " << (cpu_features().pclmul ? "pclmul" : "soft") << ": " << hw / ops * 1e9 << " ns/op, soft: "
+            << soft / ops * 1e9 << " ns/op (" << (sink & 1) << ")" << std::endl;
+}
+
+/* dst ^= c * src over size elements, a plain mul() loop first */
+template <typename F>
+static void bench_field(const char* name, std::size_t size, int reps, uint64_t& s)
+{
+  using namespace bittle;
+  using V = typename F::value_type;
+  const std::size_t n = size / sizeof(V);
+  std::vector<V> src(n), dst(n);
+  for(std::size_t i = 0; i < n; ++i)
+    src[i] = V(next(s) % (F::ORDER + 1));
+  const V c = V(F::ORDER / 3);
+
+  auto report = [&](const char* impl, double sec) {
+    std::cout << name << " " << impl << ": " << double(size) * reps / sec / 1e9 << " GB/s (" << (dst[n / 2] & 1) << ")"
+              << std::endl;
+  };
+
+  report("mul loop", seconds(reps, [&]() {
+    for(std::size_t i = 0; i < n; ++i)
+      dst[i] ^= F::mul(c, src[i]);
+  }));
+
+  const GfPath paths[] = {GfPath::scalar, GfPath::ssse3, GfPath::avx2, GfPath::avx512bw, GfPath::gfni};
+  for(const GfPath p : paths)
+  {
+    if(p != GfPath::scalar && detail::gf_path(p) != p)
+      continue;
+    report(F::implementation(p), seconds(reps, [&]() { F::mulXor(src.data(), c, dst.data(), n, p); }));
+    if(F::bits > 8)
+      break;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  uint64_t s = 88172645463325252ULL;
+  bench_clmul(s);
+  bench_field<GF256>("gf256", size, reps, s);
+  bench_field<GF65536>("gf65536", size, reps, s);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: gorilla_bench.cpp
+ * purpose: Gorilla bytes per sample and encode/decode ns per sample
+ */
+
+
+#include "gorilla.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename T>
+static void series(const char* name, const std::vector<int64_t>& ts, const std::vector<T>& vs, int reps)
+{
+  using namespace bittle;
+  const std::size_t n = ts.size();
+  std::vector<uint8_t> stream;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+  {
+    GorillaEncoder<T> enc;
+    for(std::size_t i = 0; i < n; ++i)
+      enc.append(ts[i], vs[i]);
+    stream = enc.finish();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  std::vector<int64_t> t(n);
+  std::vector<T> v(n);
+  uint64_t sink = 0;
+  auto t2 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+  {
+    GorillaDecoder<T> dec(stream, n);
+    sink += dec.decode(t.data(), v.data(), n);
+  }
+  auto t3 = std::chrono::steady_clock::now();
+
+  const double per = double(n) * reps;
+  std::cout << name << " " << double(stream.size()) / double(n) << " bytes/sample (raw " << 8 + sizeof(T)
+            << "), encode " << std::chrono::duration<double, std::nano>(t1 - t0).count() / per
+            << " ns, decode " << std::chrono::duration<double, std::nano>(t3 - t2).count() / per
+            << " ns/sample (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 20);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  uint64_t s = 88172645463325252ULL;
+  auto rnd = [&]() { return next(s); };
+
+  /* a 10 s scrape interval with the odd late scrape */
+  std::vector<int64_t> ts(n);
+  int64_t t = 1700000000000LL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    t += 10000 + ((rnd() % 50 == 0) ? static_cast<int64_t>(rnd() % 200) - 100 : 0);
+    ts[i] = t;
+  }
+
+  std::vector<double> cpu(n), temp(n), noise(n);
+  std::vector<float> tempf(n);
+  std::vector<int64_t> counter(n);
+  double c = 35.0, k = 21.0;
+  int64_t bytes = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    c = std::fmin(100.0, std::fmax(0.0, c + (double(rnd() % 200) - 100.0) / 50.0));
+    cpu[i] = std::round(c * 10.0) / 10.0;           /* percent, one decimal */
+    k += (double(rnd() % 100) - 50.0) / 1000.0;
+    temp[i] = k;                                     /* full precision drift */
+    tempf[i] = static_cast<float>(k);
+    noise[i] = double(rnd()) / double(~uint64_t(0)); /* worst case */
+    bytes += static_cast<int64_t>(rnd() % 4096);
+    counter[i] = (i % 7 == 0) ? bytes : counter[i ? i - 1 : 0];
+  }
+
+  std::cout << n << " samples" << std::endl;
+  series("cpu % (1 decimal)    ", ts, cpu, reps);
+  series("temperature double   ", ts, temp, reps);
+  series("temperature float    ", ts, tempf, reps);
+  series("byte counter int64   ", ts, counter, reps);
+  series("uniform noise        ", ts, noise, reps);
+  return EXIT_SUCCESS;
+}
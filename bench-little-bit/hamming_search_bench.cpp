@@ -0,0 +1,147 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hamming_search_bench.cpp
+ * purpose: Hamming top-k and radius search queries per second and recall
+ */
+
+
+#include "hamming_search.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t queries, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << double(queries) * reps / std::chrono::duration<double>(t1 - t0).count()
+            << " queries/s (" << (sink & 1) << ")" << std::endl;
+}
+
+template <std::size_t WORDS>
+static void suite(std::size_t n, int reps)
+{
+  using namespace bittle;
+  uint64_t s = 88172645463325252ULL;
+  const std::size_t k = 10, q = 16;
+
+  /* random codes with 20 near duplicates of every query planted, each
+   * up to 'near' bits away */
+  const std::size_t near = WORDS * 4;
+  std::vector<uint64_t> codes(n * WORDS), queries(q * WORDS);
+  for(uint64_t& w : codes)
+    w = next(s);
+  for(std::size_t j = 0; j < q; ++j)
+  {
+    for(std::size_t w = 0; w < WORDS; ++w)
+      queries[j * WORDS + w] = next(s);
+    for(int c = 0; c < 20; ++c)
+    {
+      uint64_t* code = codes.data() + (next(s) % n) * WORDS;
+      std::copy(queries.begin() + j * WORDS, queries.begin() + (j + 1) * WORDS, code);
+      for(std::size_t f = next(s) % (near + 1); f > 0; --f)
+      {
+        const uint64_t bit = next(s) % (WORDS * 64);
+        code[bit / 64] ^= uint64_t(1) << (bit % 64);
+      }
+    }
+  }
+
+  HammingIndex<WORDS> index(codes.data(), n);
+  std::cout << WORDS * 64 << " bit codes, " << n << " codes, k = " << k << ", "
+            << HammingIndex<WORDS>::implementation() << std::endl;
+
+  /* the loop this replaces: hamming_distance per code into a priority queue */
+  run("distance loop + heap    ", q, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t j = 0; j < q; ++j)
+    {
+      std::priority_queue<std::pair<int, std::size_t>> heap;
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        int d = 0;
+        for(std::size_t w = 0; w < WORDS; ++w)
+          d += hamming_distance<uint64_t>(codes[i * WORDS + w], queries[j * WORDS + w]);
+        if(heap.size() < k)
+          heap.emplace(d, i);
+        else if(d < heap.top().first)
+        {
+          heap.pop();
+          heap.emplace(d, i);
+        }
+      }
+      sum += heap.top().first;
+    }
+    return sum;
+  });
+
+  std::vector<HammingHit> hits(q * k);
+  run("search                  ", q, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t j = 0; j < q; ++j)
+    {
+      index.search(queries.data() + j * WORDS, k, hits.data());
+      sum += hits[0].distance;
+    }
+    return sum;
+  });
+  run("searchBatch x16         ", q, reps, [&]() {
+    index.searchBatch(queries.data(), q, k, hits.data());
+    return uint64_t(hits[0].distance);
+  });
+  run("searchBatch x16, threads", q, reps, [&]() {
+    index.searchBatch(queries.data(), q, k, hits.data(), 0);
+    return uint64_t(hits[0].distance);
+  });
+
+  /* radius search: scan against multi-index hashing, recall of the latter */
+  HammingMultiIndex<WORDS> mih(index);
+  const uint32_t r = static_cast<uint32_t>(near);
+  std::vector<HammingHit> want, got;
+  std::size_t found = 0, total = 0;
+  for(std::size_t j = 0; j < q; ++j)
+  {
+    total += index.radius(queries.data() + j * WORDS, r, want);
+    mih.radius(queries.data() + j * WORDS, r, got);
+    for(const HammingHit& h : got)
+      found += h.distance <= r;
+  }
+  std::cout << "  radius " << r << ", " << mih.substrings() << " x " << mih.substringBits() << " bit substrings, "
+            << mih.sizeInBytes() / (1 << 20) << " MB, recall " << (total ? double(found) / double(total) : 1.0)
+            << " (" << total << " hits)" << std::endl;
+  run("radius scan             ", q, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t j = 0; j < q; ++j)
+      sum += index.radius(queries.data() + j * WORDS, r, want);
+    return sum;
+  });
+  run("radius multi-index      ", q, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t j = 0; j < q; ++j)
+      sum += mih.radius(queries.data() + j * WORDS, r, got);
+    return sum;
+  });
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  suite<1>(n, reps);
+  suite<2>(n, reps);
+  suite<4>(n, reps);
+  suite<8>(n, reps);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: huffman_bench.cpp
+ * purpose: Huffman decode throughput, one stream against interleaved
+ */
+
+
+#include "huffman.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t bytes, int reps, F f)
+{
+  f();
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    f();
+  auto t1 = std::chrono::steady_clock::now();
+  const double s = std::chrono::duration<double>(t1 - t0).count();
+  std::cout << name << " " << double(bytes) * reps / s / 1e6 << " MB/s" << std::endl;
+}
+
+/* the old way: walk the canonical code a bit at a time */
+static void bitwise(const bittle::HuffmanCode& code, const std::vector<uint8_t>& packed, std::size_t n, std::vector<uint8_t>& out)
+{
+  using namespace bittle;
+  int first[HUFFMAN_MAX_LENGTH + 2] = {}, count[HUFFMAN_MAX_LENGTH + 2] = {}, index[HUFFMAN_MAX_LENGTH + 2] = {};
+  std::vector<uint8_t> sorted;
+  for(int len = 1; len <= HUFFMAN_MAX_LENGTH; ++len)
+  {
+    index[len] = static_cast<int>(sorted.size());
+    for(int s = 0; s < 256; ++s)
+      if(code.length(uint8_t(s)) == len)
+      {
+        if(count[len]++ == 0)
+          first[len] = static_cast<int>(code.code(uint8_t(s)));
+        sorted.push_back(uint8_t(s));
+      }
+  }
+  BitReader in(packed);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    int c = 0;
+    for(int len = 1;; ++len)
+    {
+      c = (c << 1) | int(in.readBit());
+      if(c - first[len] < count[len])
+      {
+        out[i] = sorted[index[len] + c - first[len]];
+        break;
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  /* log lines */
+  uint64_t s = 88172645463325252ULL;
+  auto rnd = [&]() { return next(s); };
+  const std::string words[] = {"INFO ", "WARN ", "ERROR ", "GET /api/v1/items ", "POST /login ", "status=200 ",
+                               "status=404 ", "latency_ms=", "user_id=", "\n", "request_id=", "cache=hit "};
+  std::vector<uint8_t> text;
+  text.reserve(n + 32);
+  while(text.size() < n)
+  {
+    const std::string& w = words[rnd() % 12];
+    text.insert(text.end(), w.begin(), w.end());
+    for(uint64_t d = rnd() % 4; d > 0; --d)
+      text.push_back(uint8_t('0' + rnd() % 10));
+  }
+  text.resize(n);
+
+  const HuffmanCode code = HuffmanCode::fromData(text.data(), n);
+  std::cout << n << " bytes of log text, " << double(code.encodedBits(text.data(), n)) / double(n)
+            << " bits/byte, longest code " << code.maxLength() << std::endl;
+
+  std::vector<uint8_t> out(n);
+  std::vector<uint8_t> packed;
+  run("encode 4 streams          ", n, reps, [&]() { packed = huffman_compress(text, 4); });
+
+  BitWriter w;
+  code.encode(text.data(), n, w);
+  const std::vector<uint8_t> one = w.finish();
+  const HuffmanDecoder<11> dec(code);
+  run("decode bit at a time      ", n, 1, [&]() { bitwise(code, one, n, out); });
+  run("decode table, 1 stream    ", n, reps, [&]() { BitReader r(one); dec.decode(r, out.data(), n); });
+  for(std::size_t streams : {1, 2, 4, 8})
+  {
+    const std::vector<uint8_t> p = huffman_compress(text, streams);
+    run("decompress " + std::to_string(streams) + " stream(s)     ", n, reps, [&]() { huffman_decompress(p, out); });
+  }
+  std::cout << (out == text ? "ok" : "MISMATCH") << std::endl;
+  return EXIT_SUCCESS;
+}
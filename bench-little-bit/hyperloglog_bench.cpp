@@ -0,0 +1,107 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hyperloglog_bench.cpp
+ * purpose: HyperLogLog insert, merge and estimate throughput
+ */
+
+
+#include "hyperloglog.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t ops, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(ops) * reps)
+            << " ns/op (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  uint64_t s = 88172645463325252ULL;
+  std::vector<uint64_t> keys(n);
+  for(uint64_t& k : keys)
+    k = next(s);
+
+  for(int p : {12, 14, 16})
+  {
+    std::cout << "p = " << p << ", " << n << " keys" << std::endl;
+    run("add               ", n, reps, [&]() {
+      HyperLogLog h(p);
+      for(uint64_t k : keys)
+        h.add(Bits<uint64_t>(k));
+      return uint64_t(h.estimate());
+    });
+    run("addBulk           ", n, reps, [&]() {
+      HyperLogLog h(p);
+      h.addBulk(keys.data(), keys.size());
+      return uint64_t(h.estimate());
+    });
+    run("add, dense start  ", n, reps, [&]() {
+      HyperLogLog h(p, false);
+      h.addBulk(keys.data(), keys.size());
+      return uint64_t(h.estimate());
+    });
+
+    /* estimate straight off the histogram, and after a merge forces a recount */
+    HyperLogLog full(p, false);
+    full.addBulk(keys.data(), keys.size());
+    run("estimate          ", 1, reps * 1000, [&]() {
+      return uint64_t(full.estimate());
+    });
+    HyperLogLog merged(p, false);
+    merged.merge(full);
+    run("estimate, merged  ", 1, reps * 100, [&]() {
+      return uint64_t(merged.estimate());
+    });
+
+    /* folding many dense sketches, ns per sketch */
+    const std::size_t sketches = 2000;
+    std::vector<HyperLogLog> parts(sketches, HyperLogLog(p, false));
+    for(std::size_t i = 0; i < sketches; ++i)
+      for(int j = 0; j < 64; ++j)
+        parts[i].addHash(next(s));
+    run("merge             ", sketches, reps, [&]() {
+      HyperLogLog total(p, false);
+      for(const HyperLogLog& h : parts)
+        total.merge(h);
+      return uint64_t(total.estimate());
+    });
+
+    std::vector<uint64_t> a((std::size_t(1) << p) / 10 + 1), b(a.size());
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+      a[i] = next(s) & 0x0FFFFFFFFFFFFFFFULL;
+      b[i] = next(s) & 0x0FFFFFFFFFFFFFFFULL;
+    }
+    run("merge kernel SWAR ", sketches, reps, [&]() {
+      for(std::size_t i = 0; i < sketches; ++i)
+        detail::hll_merge_scalar(a.data(), b.data(), a.size());
+      return a[0];
+    });
+#if defined(BITTLE_X86)
+    if(cpu_features().avx2)
+      run("merge kernel AVX2 ", sketches, reps, [&]() {
+        for(std::size_t i = 0; i < sketches; ++i)
+          detail::hll_merge_avx2(a.data(), b.data(), a.size());
+        return a[0];
+      });
+#endif
+  }
+  return EXIT_SUCCESS;
+}
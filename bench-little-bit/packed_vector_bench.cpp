@@ -0,0 +1,122 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: packed_vector_bench.cpp
+ * purpose: PackedVector random and sequential access against a uint32_t array
+ */
+
+
+#include "packed_vector.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template <typename F>
+static void run(const std::string& name, std::size_t ops, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+    sink += f();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "  " << name << " " << std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(ops) * reps)
+            << " ns/op (" << (sink & 1) << ")" << std::endl;
+}
+
+template <typename V>
+static void suite(const std::string& label, V& v, const std::vector<uint32_t>& raw,
+                  const std::vector<std::size_t>& idx, int reps)
+{
+  const std::size_t n = raw.size();
+  std::cout << label << ", " << double(v.sizeInBits()) / double(n) << " bits/value" << std::endl;
+  run("random get        ", idx.size(), reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t i : idx)
+      sum += v.get(i);
+    return sum;
+  });
+  run("random set        ", idx.size(), reps, [&]() {
+    for(std::size_t i : idx)
+      v.set(i, i);
+    return v.get(idx[0]);
+  });
+  run("sequential get    ", n, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t i = 0; i < n; ++i)
+      sum += v.get(i);
+    return sum;
+  });
+  std::vector<uint32_t> out(n);
+  run("decode            ", n, reps, [&]() {
+    v.decode(0, n, out.begin());
+    return uint64_t(out[n / 2]);
+  });
+  run("encode            ", n, reps, [&]() {
+    v.encode(0, raw.begin(), raw.end());
+    return v.get(n / 2);
+  });
+}
+
+template <int W>
+static void width(const std::vector<std::size_t>& idx, std::size_t n, int reps, uint64_t& s)
+{
+  using namespace bittle;
+  std::vector<uint32_t> raw(n);
+  for(uint32_t& x : raw)
+  {
+    next(s);
+    x = static_cast<uint32_t>(s & ((uint64_t(1) << W) - 1));
+  }
+
+  PackedVector<W> fixed(n);
+  fixed.encode(0, raw.begin(), raw.end());
+  suite("PackedVector<" + std::to_string(W) + ">", fixed, raw, idx, reps);
+  DynamicPackedVector dynamic(n, W);
+  dynamic.encode(0, raw.begin(), raw.end());
+  suite("DynamicPackedVector(" + std::to_string(W) + ")", dynamic, raw, idx, reps);
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  uint64_t s = 88172645463325252ULL;
+  std::vector<std::size_t> idx(1 << 22);
+  for(std::size_t& i : idx)
+  {
+    next(s);
+    i = s % n;
+  }
+
+  std::vector<uint32_t> raw(n);
+  for(std::size_t i = 0; i < n; ++i)
+    raw[i] = static_cast<uint32_t>(i * 2654435761u) & 0xFFFFF;
+  std::cout << n << " values" << std::endl << "uint32_t array, 32 bits/value" << std::endl;
+  run("random get        ", idx.size(), reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t i : idx)
+      sum += raw[i];
+    return sum;
+  });
+  run("random set        ", idx.size(), reps, [&]() {
+    for(std::size_t i : idx)
+      raw[i] = static_cast<uint32_t>(i);
+    return uint64_t(raw[idx[0]]);
+  });
+  run("sequential get    ", n, reps, [&]() {
+    uint64_t sum = 0;
+    for(std::size_t i = 0; i < n; ++i)
+      sum += raw[i];
+    return sum;
+  });
+
+  width<3>(idx, n, reps, s);
+  width<13>(idx, n, reps, s);
+  width<20>(idx, n, reps, s);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: radix_sort_bench.cpp
+ * purpose: radix sorts in Mkeys/s against std::sort, uniform and skewed keys
+ */
+
+
+#include "radix_sort.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename F>
+static void run(const char* name, std::size_t n, int reps, F f)
+{
+  double ns = 0;
+  uint64_t sink = 0;
+  for(int r = 0; r < reps; ++r)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    sink += f();
+    auto t1 = std::chrono::steady_clock::now();
+    ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+  }
+  std::cout << "  " << name << " " << double(n) * reps / ns * 1000.0 << " Mkeys/s (" << (sink & 1) << ")" << std::endl;
+}
+
+template <typename T>
+static void suite(const char* label, const std::vector<T>& data, int reps, unsigned threads)
+{
+  using namespace bittle;
+  const std::size_t n = data.size();
+  std::vector<T> keys, scratch(n);
+  std::vector<uint32_t> values(n), vscratch(n);
+  std::vector<std::pair<T, uint32_t>> pairs(n);
+
+  std::cout << label << std::endl;
+  run("std::sort            ", n, reps, [&]() {
+    keys = data;
+    std::sort(keys.begin(), keys.end());
+    return static_cast<uint64_t>(keys[n / 2]);
+  });
+  run("radix_sort           ", n, reps, [&]() {
+    keys = data;
+    radix_sort(keys.data(), n, scratch.data());
+    return static_cast<uint64_t>(keys[n / 2]);
+  });
+  run("radix_sort_parallel  ", n, reps, [&]() {
+    keys = data;
+    radix_sort_parallel(keys.data(), n, scratch.data(), threads);
+    return static_cast<uint64_t>(keys[n / 2]);
+  });
+  run("std::sort pairs      ", n, reps, [&]() {
+    for(std::size_t i = 0; i < n; ++i)
+      pairs[i] = std::make_pair(data[i], static_cast<uint32_t>(i));
+    std::sort(pairs.begin(), pairs.end());
+    return static_cast<uint64_t>(pairs[n / 2].second);
+  });
+  run("radix_sort pairs     ", n, reps, [&]() {
+    keys = data;
+    for(std::size_t i = 0; i < n; ++i)
+      values[i] = static_cast<uint32_t>(i);
+    radix_sort(keys.data(), values.data(), n, scratch.data(), vscratch.data());
+    return static_cast<uint64_t>(values[n / 2]);
+  });
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+  const unsigned threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 0;
+
+  std::vector<uint32_t> u32(n), zipf32(n);
+  std::vector<uint64_t> u64(n), small64(n);
+  uint64_t s = 88172645463325252ULL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    u32[i] = static_cast<uint32_t>(s);
+    u64[i] = s;
+    /* skewed: roughly power law ranks, and 64 bit keys below 2^20 */
+    zipf32[i] = static_cast<uint32_t>(std::pow(double(s >> 11) / double(1ULL << 53), 8.0) * 1e6);
+    small64[i] = s >> 44;
+  }
+
+  std::cout << n << " keys" << std::endl;
+  suite("uint32 uniform", u32, reps, threads);
+  suite("uint32 skewed", zipf32, reps, threads);
+  suite("uint64 uniform", u64, reps, threads);
+  suite("uint64 below 2^20", small64, reps, threads);
+  return EXIT_SUCCESS;
+}
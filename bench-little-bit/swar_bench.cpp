@@ -0,0 +1,77 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: swar_bench.cpp
+ * purpose: SWAR scanners in GB/s against libc memchr and strlen
+ */
+
+
+#include "swar.hpp"
+#include "../test-little-bit/xorshift.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+template <typename F>
+static void run(const char* name, std::size_t len, int reps, F f)
+{
+  uint64_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for(int r = 0; r < reps; ++r)
+  {
+    sink += f();
+    /* keep the calls from being hoisted out of the loop */
+    asm volatile("" : "+r"(sink) : : "memory");
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  const double bytes = double(len) * reps;
+  std::cout << name << " " << bytes / std::chrono::duration<double, std::nano>(t1 - t0).count()
+            << "GB/s (" << (sink & 1) << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 20);
+  const int reps = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  /* nonzero bytes without 0xFF, the needle sits at the very end */
+  std::vector<char> text(n + 1);
+  uint64_t s = 88172645463325252ULL;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    next(s);
+    text[i] = static_cast<char>(1 + s % 254);
+  }
+  text[n - 1] = static_cast<char>(0xFF);
+  text[n] = '\0';
+  const char* p = text.data();
+  asm volatile("" : "+r"(p));
+
+  std::cout << n << " bytes" << std::endl;
+  run("libc memchr   ", n, reps, [&]() {
+    return static_cast<std::size_t>(static_cast<const char*>(std::memchr(p, 0xFF, n)) - p);
+  });
+  run("find_byte     ", n, reps, [&]() {
+    return find_byte(p, 0xFF, n);
+  });
+  run("libc strlen   ", n, reps, [&]() {
+    return std::strlen(p);
+  });
+  run("string_length ", n, reps, [&]() {
+    return string_length(p);
+  });
+  run("std::count    ", n, reps, [&]() {
+    return static_cast<std::size_t>(std::count(p, p + n, '\n'));
+  });
+  run("count_byte    ", n, reps, [&]() {
+    return count_byte(p, '\n', n);
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,335 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_format.hpp
+ * purpose: allocation free binary, octal and hex formatting of Bits
+ */
+
+
+#ifndef BITTLE_BIT_FORMAT_HPP
+#define BITTLE_BIT_FORMAT_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSSE3__)
+	#include <tmmintrin.h>
+#endif
+
+#if __cplusplus >= 201703L
+	#include <string_view>
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * Everything here writes into memory the caller owns:
+ *
+ *     char buf[80];
+ *     std::size_t n = format_bits(b, buf, sizeof(buf), {16, 4, '\''});
+ *
+ * format_bits follows snprintf: it returns the full length, writes the
+ * digits only when they fit and adds a terminator when there is room for
+ * one. BitsText<T> is a stack buffer sized for the worst case of T.
+ *
+ * Binary is spread 16 bits per pshufb with SSSE3 and 8 bits per multiply
+ * otherwise, hex 8 nibbles per SWAR step, octal is a plain loop.
+ */
+
+struct BitFormat
+{
+	int base = 2;           /* 2, 8 or 16 */
+	int group = 0;          /* digits per group, 0 for no separators */
+	char separator = '_';
+	bool lsb_first = false; /* least significant digit first */
+	bool uppercase = false; /* hex letters */
+};
+
+namespace detail {
+
+/* name: format_digits
+ * desc: digit count of a T in base 2, 8 or 16
+ * returns: digit count
+ */
+template <typename T>
+constexpr int format_digits(int base) noexcept
+{
+	return base == 16 ? static_cast<int>(sizeof(T)) * 2 :
+	       base == 8 ? (static_cast<int>(sizeof(T) * BIT_SIZE) + 2) / 3 :
+	       static_cast<int>(sizeof(T) * BIT_SIZE);
+}
+
+/* name: binary_msb
+ * desc: binary digits of n, most significant first
+ * returns: nothing
+ */
+template <typename T>
+inline void binary_msb(const T& n, char* out) noexcept
+{
+#if defined(__SSSE3__)
+	using U = typename std::make_unsigned<T>::type;
+	if(sizeof(T) >= 2)
+	{
+		/* Each half of the register broadcasts one byte, keeps one bit
+		 * per lane and turns the lanes into '0' or '1' */
+		const __m128i spread = _mm_set_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+		const __m128i bit = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+		const __m128i zero = _mm_set1_epi8('0');
+		const uint64_t v = static_cast<uint64_t>(static_cast<U>(n));
+		for(int i = 0; i < static_cast<int>(sizeof(T)); i += 2)
+		{
+			const uint16_t pair = static_cast<uint16_t>(v >> (BIT_SIZE * (static_cast<int>(sizeof(T)) - 2 - i)));
+			__m128i x = _mm_shuffle_epi8(_mm_cvtsi32_si128(pair), spread);
+			x = _mm_cmpeq_epi8(_mm_and_si128(x, bit), bit);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + BIT_SIZE * i), _mm_sub_epi8(zero, x));
+		}
+		return;
+	}
+#endif
+	bittle::binary_chars<T>(n, out);
+}
+
+/* name: hex_chars8
+ * desc: 8 hex digits of a 32 bit value, most significant first
+ * returns: nothing
+ */
+inline void hex_chars8(uint32_t v, char* out, bool upper) noexcept
+{
+	/* byte k of x gets nibble k */
+	uint64_t x = v;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	const uint64_t letter = ((x + 0x0606060606060606ULL) >> 4) & 0x0101010101010101ULL;
+	x += 0x3030303030303030ULL + letter * (upper ? 'A' - '0' - 10 : 'a' - '0' - 10);
+	x = __builtin_bswap64(x);
+	std::memcpy(out, &x, sizeof(x));
+}
+
+/* name: hex_msb
+ * desc: hex digits of n, most significant first
+ * returns: nothing
+ */
+template <typename T>
+inline void hex_msb(const T& n, char* out, bool upper) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	const uint64_t v = static_cast<uint64_t>(static_cast<U>(n));
+	if(sizeof(T) == 8)
+	{
+		hex_chars8(static_cast<uint32_t>(v >> 32), out, upper);
+		hex_chars8(static_cast<uint32_t>(v), out + 8, upper);
+	}
+	else if(sizeof(T) == 4)
+	{
+		hex_chars8(static_cast<uint32_t>(v), out, upper);
+	}
+	else
+	{
+		char temp[8];
+		hex_chars8(static_cast<uint32_t>(v), temp, upper);
+		std::memcpy(out, temp + 8 - 2 * sizeof(T), 2 * sizeof(T));
+	}
+}
+
+/* name: octal_msb
+ * desc: octal digits of n, most significant first
+ * returns: nothing
+ */
+template <typename T>
+inline void octal_msb(const T& n, char* out) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	uint64_t v = static_cast<uint64_t>(static_cast<U>(n));
+	for(int i = format_digits<T>(8) - 1; i >= 0; --i, v >>= 3)
+		out[i] = static_cast<char>('0' + (v & 7));
+}
+
+/* name: reverse_chars
+ * desc: reverses len chars in place
+ * returns: nothing
+ */
+inline void reverse_chars(char* p, int len) noexcept
+{
+	for(int l = 0, r = len - 1; l < r; ++l, --r)
+	{
+		const char c = p[l];
+		p[l] = p[r];
+		p[r] = c;
+	}
+}
+
+}
+
+/* name: format_length
+ * desc: chars format_bits produces for a T, terminator excluded
+ * returns: length
+ */
+template <typename T>
+constexpr std::size_t format_length(const BitFormat& f = BitFormat()) noexcept
+{
+	return static_cast<std::size_t>(detail::format_digits<T>(f.base) +
+		(f.group > 0 ? (detail::format_digits<T>(f.base) - 1) / f.group : 0));
+}
+
+/* name: format_bits
+ * desc: formats n into out[0, cap), digits are only written when the
+ * whole result fits and a terminator is added when there is room
+ * returns: full length of the result, terminator excluded
+ */
+template <typename T>
+std::size_t format_bits(const T& n, char* out, std::size_t cap, const BitFormat& f = BitFormat()) noexcept
+{
+	static_assert(std::is_integral<T>::value, "Template type T must be an integral type in format_bits");
+	BITTLE_PROFILE_KERNEL(format_bits);
+
+	const std::size_t len = format_length<T>(f);
+	if(len > cap)
+		return len;
+
+	const int digits = detail::format_digits<T>(f.base);
+	const bool grouped = f.group > 0 && f.group < digits;
+
+	/* Ungrouped output goes straight to the caller, grouped output is
+	 * spaced out from a local copy */
+	char local[sizeof(T) * BIT_SIZE];
+	char* d = grouped ? local : out;
+
+	if(f.base == 16)
+		detail::hex_msb<T>(n, d, f.uppercase);
+	else if(f.base == 8)
+		detail::octal_msb<T>(n, d);
+	else if(f.lsb_first)
+		bittle::binary_chars<T>(n, d, true);
+	else
+		detail::binary_msb<T>(n, d);
+
+	if(f.lsb_first && f.base != 2)
+		detail::reverse_chars(d, digits);
+
+	if(grouped)
+	{
+		/* Groups are counted from the least significant digit, so in msb
+		 * order only the first group can be short */
+		char* o = out;
+		int chunk = f.lsb_first || digits % f.group == 0 ? f.group : digits % f.group;
+		for(int i = 0; ; )
+		{
+			std::memcpy(o, d + i, static_cast<std::size_t>(chunk));
+			o += chunk;
+			i += chunk;
+			if(i >= digits)
+				break;
+			*o++ = f.separator;
+			chunk = digits - i < f.group ? digits - i : f.group;
+		}
+	}
+
+	if(len < cap)
+		out[len] = '\0';
+	return len;
+}
+
+/* name: format_bits
+ * desc: same as above for a Bits object
+ * returns: full length of the result, terminator excluded
+ */
+template <typename T>
+std::size_t format_bits(const Bits<T>& b, char* out, std::size_t cap, const BitFormat& f = BitFormat()) noexcept
+{
+	return format_bits<T>(b.value(), out, cap, f);
+}
+
+template <typename T>
+class BitsText
+{
+	public:
+
+		/* Binary with a separator between every digit is the worst case */
+		static constexpr std::size_t CAPACITY = 2 * sizeof(T) * BIT_SIZE;
+
+		BitsText(const T& n, const BitFormat& f = BitFormat()) noexcept
+			: len(format_bits<T>(n, buffer, CAPACITY, f))
+		{
+
+		}
+
+		BitsText(const Bits<T>& b, const BitFormat& f = BitFormat()) noexcept
+			: BitsText(b.value(), f)
+		{
+
+		}
+
+		/* name: c_str
+		 * desc: null terminated text
+		 * returns: pointer into this object
+		 */
+		const char* c_str() const noexcept
+		{
+			return this->buffer;
+		}
+
+		/* name: size
+		 * desc: length of the text
+		 * returns: length
+		 */
+		std::size_t size() const noexcept
+		{
+			return this->len;
+		}
+
+	#if __cplusplus >= 201703L
+
+		/* name: view
+		 * desc: the text as a view, valid while this object lives
+		 * returns: string_view
+		 */
+		std::string_view view() const noexcept
+		{
+			return std::string_view(this->buffer, this->len);
+		}
+
+		operator std::string_view() const noexcept
+		{
+			return this->view();
+		}
+
+	#endif
+
+	private:
+
+		char buffer[CAPACITY];
+		std::size_t len;
+};
+
+/* name: to_text
+ * desc: formats a Bits object into a stack buffer
+ * returns: BitsText
+ */
+template <typename T>
+BitsText<T> to_text(const Bits<T>& b, const BitFormat& f = BitFormat()) noexcept
+{
+	return BitsText<T>(b, f);
+}
+
+#if __cplusplus >= 201703L
+
+/* name: format_view
+ * desc: formats into out and views the result, empty when it does not fit
+ * returns: string_view into out
+ */
+template <typename T>
+std::string_view format_view(const Bits<T>& b, char* out, std::size_t cap, const BitFormat& f = BitFormat()) noexcept
+{
+	const std::size_t len = format_bits<T>(b.value(), out, cap, f);
+	return len <= cap ? std::string_view(out, len) : std::string_view();
+}
+
+#endif
+
+}
+
+
+#endif
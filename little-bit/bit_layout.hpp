@@ -0,0 +1,521 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_layout.hpp
+ * purpose: declarative compile time bit-field layouts for binary headers
+ */
+
+
+#ifndef BITTLE_BIT_LAYOUT_HPP
+#define BITTLE_BIT_LAYOUT_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace bittle {
+
+/* namespace: bittle
+ * A layout is a list of fields in wire order, each named by an empty
+ * tag type:
+ *
+ *     struct Version {}; struct Ihl {}; struct Tos {}; struct Length {};
+ *     using Ipv4Head = NetworkLayout<Field<Version, 4>, Field<Ihl, 4>,
+ *                                    Field<Tos, 8>, Field<Length, 16>>;
+ *
+ *     auto len = Ipv4Head::get<Length>(packet);
+ *
+ * msb_first layouts number bits like a network header (first field in
+ * the top bits of the first byte, multi byte fields big endian). The
+ * lsb_first ones match C bit-fields on little endian targets. A field
+ * can still ask for the other byte order (Field<Tag, 16, false,
+ * FieldOrder::little> inside a network header).
+ *
+ * Every offset, mask and load size is a compile time constant so the
+ * accessors are branch free. get/set touch only the bytes the field
+ * spans, and load() reads the whole header once into registers so that
+ * decoding several fields shares the same loads. Multi byte loads assume
+ * a little endian host, like the rest of bittle.
+ */
+
+enum class BitOrder
+{
+	msb_first,	// network order
+	lsb_first	// little endian bit-field order
+};
+
+enum class FieldOrder
+{
+	natural,	// whatever the layout uses
+	big,
+	little
+};
+
+namespace detail {
+
+template <int Width, bool Signed>
+struct field_value
+{
+	using unsigned_type = typename std::conditional<(Width <= 8), uint8_t,
+	                      typename std::conditional<(Width <= 16), uint16_t,
+	                      typename std::conditional<(Width <= 32), uint32_t, uint64_t>::type>::type>::type;
+
+	using type = typename std::conditional<Signed, typename std::make_signed<unsigned_type>::type,
+	                                       unsigned_type>::type;
+};
+
+constexpr uint64_t field_mask(int w) noexcept
+{
+	return w >= 64 ? ~uint64_t(0) : ((uint64_t(1) << w) - 1);
+}
+
+/* name: swap_field_bytes
+ * desc: reverses the w / 8 low bytes of v
+ * returns: swapped value
+ */
+constexpr uint64_t swap_field_bytes(uint64_t v, int w) noexcept
+{
+	return __builtin_bswap64(v) >> (64 - w);
+}
+
+template <int... W>
+struct bit_sum;
+
+template <>
+struct bit_sum<>
+{
+	static constexpr int value = 0;
+};
+
+template <int W, int... Ws>
+struct bit_sum<W, Ws...>
+{
+	static constexpr int value = W + bit_sum<Ws...>::value;
+};
+
+template <typename F>
+struct field_identity
+{
+	using type = F;
+};
+
+/* name: find_field
+ * desc: the Field of a layout whose tag is Tag
+ */
+template <typename Tag, typename... Fs>
+struct find_field
+{
+	static_assert(!std::is_same<Tag, Tag>::value, "Tag is not a field of this layout");
+};
+
+template <typename Tag, typename F, typename... Fs>
+struct find_field<Tag, F, Fs...>
+	: std::conditional<std::is_same<Tag, typename F::tag>::value,
+	                   field_identity<F>, find_field<Tag, Fs...>>::type
+{
+};
+
+/* name: field_offset
+ * desc: sum of the widths in front of Tag
+ * returns: bit offset
+ */
+template <typename Tag, typename... Fs>
+constexpr int field_offset() noexcept
+{
+	const int w[] = {Fs::width...};
+	const bool m[] = {std::is_same<Tag, typename Fs::tag>::value...};
+	int off = 0;
+	for(std::size_t i = 0; i < sizeof...(Fs); ++i)
+	{
+		if(m[i])
+			return off;
+		off += w[i];
+	}
+	return -1;
+}
+
+/* name: load_window
+ * desc: L (1 - 8) bytes at p as a word, first byte on top for msb_first
+ * returns: word
+ */
+template <BitOrder O, int L>
+inline uint64_t load_window(const uint8_t* p) noexcept
+{
+	uint64_t v = 0;
+	std::memcpy(&v, p, L);
+	return O == BitOrder::msb_first ? __builtin_bswap64(v) : v;
+}
+
+template <BitOrder O, int L>
+inline void store_window(uint8_t* p, uint64_t v) noexcept
+{
+	if(O == BitOrder::msb_first)
+		v = __builtin_bswap64(v);
+	std::memcpy(p, &v, L);
+}
+
+}
+
+template <typename Tag, int Width, bool Signed = false, FieldOrder Order = FieldOrder::natural>
+struct Field
+{
+	static_assert(Width >= 1 && Width <= 64, "Field width must be between 1 and 64");
+	static_assert(Order == FieldOrder::natural || Width % 8 == 0,
+	              "Only whole byte fields can pick their own byte order");
+
+	using tag = Tag;
+	using value_type = typename detail::field_value<Width, Signed>::type;
+
+	static constexpr int width = Width;
+	static constexpr bool is_signed = Signed;
+	static constexpr FieldOrder order = Order;
+};
+
+template <BitOrder Order, typename... Fields>
+class BitLayout
+{
+	static_assert(sizeof...(Fields) > 0, "A layout needs at least one field");
+
+	public:
+
+		static constexpr BitOrder order = Order;
+
+		static constexpr int fields = sizeof...(Fields);
+
+		static constexpr int bits = detail::bit_sum<Fields::width...>::value;
+
+		static constexpr int bytes = (bits + BIT_SIZE - 1) / BIT_SIZE;
+
+		static constexpr int words = (bits + 63) / 64;
+
+		/* name: field_type
+		 * desc: the Field declaration for Tag
+		 */
+		template <typename Tag>
+		using field_type = typename detail::find_field<Tag, Fields...>::type;
+
+		template <typename Tag>
+		using value_type = typename field_type<Tag>::value_type;
+
+		/* name: offset
+		 * desc: bit offset of Tag from the start of the layout
+		 * returns: offset
+		 */
+		template <typename Tag>
+		static constexpr int offset() noexcept
+		{
+			return detail::field_offset<Tag, Fields...>();
+		}
+
+		template <typename Tag>
+		static constexpr int width() noexcept
+		{
+			return field_type<Tag>::width;
+		}
+
+		/*
+		 *
+		 *
+		 * Byte buffers
+		 *
+		 *
+		 */
+
+		/* name: get
+		 * desc: reads field Tag from a header at 'p'
+		 * returns: field value
+		 */
+		template <typename Tag>
+		static value_type<Tag> get(const uint8_t* p) noexcept
+		{
+			constexpr int off = offset<Tag>();
+			constexpr int w = width<Tag>();
+			constexpr int first = off / BIT_SIZE;
+			constexpr int s = off % BIT_SIZE;
+			constexpr int span = (s + w + BIT_SIZE - 1) / BIT_SIZE;
+			/* read a full word when the header is long enough */
+			constexpr int L = span > 8 ? 8 : (first + 8 <= bytes ? 8 : span);
+
+			const uint64_t v = detail::load_window<Order, L>(p + first);
+			uint64_t x;
+			if(Order == BitOrder::msb_first)
+				x = span > 8 ? (((v << s) | (uint64_t(p[first + 8]) >> ((BIT_SIZE - s) % BIT_SIZE))) >> (64 - w)) :
+				               ((v << s) >> (64 - w));
+			else
+				x = span > 8 ? (((v >> s) | (uint64_t(p[first + 8]) << ((64 - s) % 64))) & detail::field_mask(w)) :
+				               ((v >> s) & detail::field_mask(w));
+
+			return finish<field_type<Tag>>(x);
+		}
+
+		/* name: set
+		 * desc: writes field Tag into a header at 'p', other bits untouched
+		 * returns: nothing
+		 */
+		template <typename Tag>
+		static void set(uint8_t* p, uint64_t value) noexcept
+		{
+			constexpr int off = offset<Tag>();
+			constexpr int w = width<Tag>();
+			constexpr int first = off / BIT_SIZE;
+			constexpr int s = off % BIT_SIZE;
+			constexpr int span = (s + w + BIT_SIZE - 1) / BIT_SIZE;
+			constexpr int L = span > 8 ? 8 : (first + 8 <= bytes ? 8 : span);
+			constexpr uint64_t m = detail::field_mask(w);
+
+			const uint64_t x = raw<field_type<Tag>>(value) & m;
+			uint64_t v = detail::load_window<Order, L>(p + first);
+			if(Order == BitOrder::msb_first)
+			{
+				const int up = 64 - w - s;
+				v = up >= 0 ? ((v & ~(m << (up & 63))) | (x << (up & 63))) :
+				              ((v & ~(m >> ((-up) & 63))) | (x >> ((-up) & 63)));
+				if(span > 8)
+				{
+					const int r = (s + w - 64) & 7;		// bits in the extra byte
+					const uint8_t hm = static_cast<uint8_t>(0xFF00u >> r);
+					p[first + 8] = static_cast<uint8_t>((p[first + 8] & ~hm) | ((x << (BIT_SIZE - r)) & hm));
+				}
+			}
+			else
+			{
+				v = (v & ~(m << s)) | (x << s);
+				if(span > 8)
+				{
+					const uint8_t hm = static_cast<uint8_t>(m >> ((64 - s) & 63));
+					p[first + 8] = static_cast<uint8_t>((p[first + 8] & ~hm) | (x >> ((64 - s) & 63)));
+				}
+			}
+			detail::store_window<Order, L>(p + first, v);
+		}
+
+		/* Header loaded into registers once */
+		class Record
+		{
+			public:
+
+				/* name: get
+				 * desc: reads field Tag from the loaded words
+				 * returns: field value
+				 */
+				template <typename Tag>
+				value_type<Tag> get() const noexcept
+				{
+					return finish<field_type<Tag>>(extract(this->w, offset<Tag>(), width<Tag>()));
+				}
+
+				/* name: set
+				 * desc: writes field Tag into the loaded words
+				 * returns: *this
+				 */
+				template <typename Tag>
+				Record& set(uint64_t value) noexcept
+				{
+					insert(this->w, offset<Tag>(), width<Tag>(), raw<field_type<Tag>>(value));
+					return *this;
+				}
+
+				uint64_t w[words] = {};
+		};
+
+		/* name: load
+		 * desc: loads the whole header with 'words' wide loads
+		 * returns: Record
+		 */
+		static Record load(const uint8_t* p) noexcept
+		{
+			Record r;
+			loadWords(r.w, p, std::make_index_sequence<words>());
+			return r;
+		}
+
+		/* name: store
+		 * desc: writes a Record back as 'bytes' bytes
+		 * returns: nothing
+		 */
+		static void store(const Record& r, uint8_t* p) noexcept
+		{
+			storeWords(r.w, p, std::make_index_sequence<words>());
+		}
+
+		/* name: decode
+		 * desc: structure of arrays decode of 'count' headers 'stride' bytes
+		 * apart, one output column per field in declaration order
+		 * returns: nothing
+		 */
+		template <typename... Out>
+		static void decode(const uint8_t* p, std::size_t count, std::size_t stride, Out*... columns) noexcept
+		{
+			static_assert(sizeof...(Out) == sizeof...(Fields), "decode needs one column per field");
+			for(std::size_t i = 0; i < count; ++i, p += stride)
+			{
+				const Record r = load(p);
+				const int unused[] = {0, (columns[i] = static_cast<Out>(r.template get<typename Fields::tag>()), 0)...};
+				(void)unused;
+			}
+		}
+
+		/*
+		 *
+		 *
+		 * Bits objects
+		 *
+		 *
+		 */
+
+		/* name: get
+		 * desc: reads field Tag from a Bits holding the layout, msb_first
+		 * layouts start at the top bit of T
+		 * returns: field value
+		 */
+		template <typename Tag, typename T>
+		static constexpr value_type<Tag> get(const Bits<T>& b) noexcept
+		{
+			using U = typename std::make_unsigned<T>::type;
+			return finish<field_type<Tag>>(
+				(static_cast<uint64_t>(static_cast<U>(b.value())) >> bitsShift<Tag, T>()) &
+				detail::field_mask(width<Tag>()));
+		}
+
+		/* name: set
+		 * desc: writes field Tag into a Bits holding the layout
+		 * returns: the Bits object
+		 */
+		template <typename Tag, typename T>
+		static constexpr Bits<T>& set(Bits<T>& b, uint64_t value) noexcept
+		{
+			using U = typename std::make_unsigned<T>::type;
+			constexpr uint64_t m = detail::field_mask(width<Tag>()) << bitsShift<Tag, T>();
+			const uint64_t v = static_cast<uint64_t>(static_cast<U>(b.value()));
+			return b.value(static_cast<T>((v & ~m) | ((raw<field_type<Tag>>(value) << bitsShift<Tag, T>()) & m)));
+		}
+
+		/* name: pack
+		 * desc: builds a Bits from one value per field in declaration order
+		 * returns: new Bits
+		 */
+		template <typename T = uint64_t, typename... V>
+		static constexpr Bits<T> pack(V... values) noexcept
+		{
+			static_assert(sizeof...(V) == sizeof...(Fields), "pack needs one value per field");
+			Bits<T> b(0);
+			const int unused[] = {0, (set<typename Fields::tag>(b, static_cast<uint64_t>(values)), 0)...};
+			(void)unused;
+			return b;
+		}
+
+
+	private:
+
+		template <typename Tag, typename T>
+		static constexpr int bitsShift() noexcept
+		{
+			static_assert(bits <= static_cast<int>(sizeof(T) * BIT_SIZE), "The layout does not fit in T");
+			return Order == BitOrder::msb_first ?
+				static_cast<int>(sizeof(T) * BIT_SIZE) - offset<Tag>() - width<Tag>() : offset<Tag>();
+		}
+
+		/* name: finish
+		 * desc: applies the field byte order and sign extension
+		 * returns: field value
+		 */
+		template <typename F>
+		static constexpr typename F::value_type finish(uint64_t x) noexcept
+		{
+			return static_cast<typename F::value_type>(
+				F::is_signed && F::width < 64 ?
+					static_cast<uint64_t>(static_cast<int64_t>(swapped<F>(x) << (64 - F::width)) >> (64 - F::width)) :
+					swapped<F>(x));
+		}
+
+		/* name: raw
+		 * desc: inverse of finish for writing
+		 * returns: wire bits
+		 */
+		template <typename F>
+		static constexpr uint64_t raw(uint64_t v) noexcept
+		{
+			return swapped<F>(v & detail::field_mask(F::width));
+		}
+
+		template <typename F>
+		static constexpr uint64_t swapped(uint64_t x) noexcept
+		{
+			return ((F::order == FieldOrder::big && Order == BitOrder::lsb_first) ||
+			        (F::order == FieldOrder::little && Order == BitOrder::msb_first)) ?
+				detail::swap_field_bytes(x, F::width) : x;
+		}
+
+		static constexpr uint64_t extract(const uint64_t* w, int off, int width) noexcept
+		{
+			const int q = off / 64;
+			const int s = off % 64;
+			if(Order == BitOrder::msb_first)
+			{
+				const uint64_t hi = w[q] << s;
+				const uint64_t lo = (s + width > 64) ? (w[q + 1] >> (64 - s)) : 0;
+				return (hi | lo) >> (64 - width);
+			}
+			const uint64_t lo = w[q] >> s;
+			const uint64_t hi = (s + width > 64) ? (w[q + 1] << (64 - s)) : 0;
+			return (lo | hi) & detail::field_mask(width);
+		}
+
+		static void insert(uint64_t* w, int off, int width, uint64_t x) noexcept
+		{
+			const int q = off / 64;
+			const int s = off % 64;
+			const uint64_t m = detail::field_mask(width);
+			x &= m;
+			if(Order == BitOrder::msb_first)
+			{
+				const int up = 64 - s - width;
+				if(up >= 0)
+				{
+					w[q] = (w[q] & ~(m << up)) | (x << up);
+				}
+				else
+				{
+					w[q] = (w[q] & ~(m >> -up)) | (x >> -up);
+					w[q + 1] = (w[q + 1] & ~(m << (64 + up))) | (x << (64 + up));
+				}
+				return;
+			}
+			w[q] = (w[q] & ~(m << s)) | (x << s);
+			if(s + width > 64)
+				w[q + 1] = (w[q + 1] & ~(m >> (64 - s))) | (x >> (64 - s));
+		}
+
+		template <std::size_t... Is>
+		static void loadWords(uint64_t* w, const uint8_t* p, std::index_sequence<Is...>) noexcept
+		{
+			const int unused[] = {0, (w[Is] = detail::load_window<Order, wordBytes(Is)>(p + 8 * Is), 0)...};
+			(void)unused;
+		}
+
+		template <std::size_t... Is>
+		static void storeWords(const uint64_t* w, uint8_t* p, std::index_sequence<Is...>) noexcept
+		{
+			const int unused[] = {0, (detail::store_window<Order, wordBytes(Is)>(p + 8 * Is, w[Is]), 0)...};
+			(void)unused;
+		}
+
+		static constexpr int wordBytes(std::size_t i) noexcept
+		{
+			return bytes - 8 * static_cast<int>(i) >= 8 ? 8 : bytes - 8 * static_cast<int>(i);
+		}
+
+};
+
+/* Declarations for ease of use */
+template <typename... Fields>
+using NetworkLayout = BitLayout<BitOrder::msb_first, Fields...>;
+
+template <typename... Fields>
+using LsbLayout = BitLayout<BitOrder::lsb_first, Fields...>;
+
+}
+
+
+#endif
@@ -0,0 +1,633 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_match.hpp
+ * purpose: bit-parallel exact and approximate string matching
+ */
+
+
+#ifndef BITTLE_BIT_MATCH_HPP
+#define BITTLE_BIT_MATCH_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Automaton state lives in bit vectors, bit i standing for pattern
+ * prefix p[0 .. i], one text byte per step:
+ *
+ *     ShiftOr       exact match, the classic shift-or recurrence
+ *     WuManber      up to k mismatches (hamming) or k edits, one state
+ *                   vector per error count
+ *     Myers         edit distance with Myers' bit-vector algorithm in
+ *                   Hyyro's block form, as a distance or as a search
+ *     ShiftOrBatch  many short patterns at once, one 64 bit lane each,
+ *                   four lanes per AVX2 register when the cpu has it
+ *
+ * Patterns longer than 64 bytes use (m + 63) / 64 words of state, the
+ * shift carrying bit 63 of one word into bit 0 of the next (and Myers
+ * passing the horizontal delta from block to block). Matches are handed
+ * to a callback as they are found; the count is returned.
+ */
+
+namespace detail {
+
+/* name: pattern_masks
+ * desc: per byte masks over w words, bit i set where p[i] == c
+ * returns: 256 * w words
+ */
+inline std::vector<uint64_t> pattern_masks(const char* p, std::size_t m, std::size_t w)
+{
+	std::vector<uint64_t> masks(256 * w, 0);
+	for(std::size_t i = 0; i < m; ++i)
+		masks[static_cast<uint8_t>(p[i]) * w + i / 64] |= uint64_t(1) << (i % 64);
+	return masks;
+}
+
+}
+
+class ShiftOr
+{
+	public:
+
+		static constexpr std::size_t npos = ~std::size_t(0);
+
+		/* ctor for a pattern of m > 0 bytes */
+		ShiftOr(const char* pattern, std::size_t m)
+			: m(m), w((m + 63) / 64), masks(detail::pattern_masks(pattern, m, (m + 63) / 64))
+		{
+			/* shift-or wants a zero where the byte matches */
+			for(uint64_t& x : this->masks)
+				x = ~x;
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		std::size_t length() const noexcept
+		{
+			return this->m;
+		}
+
+		/* name: find
+		 * desc: first occurrence of the pattern
+		 * returns: start position or npos
+		 */
+		std::size_t find(const char* text, std::size_t n) const
+		{
+			std::size_t at = npos;
+			this->scan(text, n, [&](std::size_t start) { at = start; return false; });
+			return at;
+		}
+
+		/* name: findAll
+		 * desc: calls f(start) for every occurrence, overlapping ones too
+		 * returns: occurrence count
+		 */
+		template <typename F>
+		std::size_t findAll(const char* text, std::size_t n, F f) const
+		{
+			return this->scan(text, n, [&](std::size_t start) { f(start); return true; });
+		}
+
+		/* name: count
+		 * desc: occurrences of the pattern
+		 * returns: count
+		 */
+		std::size_t count(const char* text, std::size_t n) const
+		{
+			return this->scan(text, n, [](std::size_t) { return true; });
+		}
+
+
+	private:
+
+		/* f returns false to stop */
+		template <typename F>
+		std::size_t scan(const char* text, std::size_t n, F f) const
+		{
+			if(this->m == 0 || this->m > n)
+				return 0;
+			const uint8_t* t = reinterpret_cast<const uint8_t*>(text);
+			const uint64_t* b = this->masks.data();
+			std::size_t hits = 0;
+
+			if(this->w == 1)
+			{
+				const uint64_t top = uint64_t(1) << (this->m - 1);
+				uint64_t d = ~uint64_t(0);
+				for(std::size_t j = 0; j < n; ++j)
+				{
+					d = (d << 1) | b[t[j]];
+					if(!(d & top))
+					{
+						++hits;
+						if(!f(j + 1 - this->m))
+							return hits;
+					}
+				}
+				return hits;
+			}
+
+			const uint64_t top = uint64_t(1) << ((this->m - 1) % 64);
+			std::vector<uint64_t> d(this->w, ~uint64_t(0));
+			for(std::size_t j = 0; j < n; ++j)
+			{
+				const uint64_t* bc = b + t[j] * this->w;
+				uint64_t in = 0;
+				for(std::size_t i = 0; i < this->w; ++i)
+				{
+					const uint64_t out = d[i] >> 63;
+					d[i] = (d[i] << 1) | in | bc[i];
+					in = out;
+				}
+				if(!(d[this->w - 1] & top))
+				{
+					++hits;
+					if(!f(j + 1 - this->m))
+						return hits;
+				}
+			}
+			return hits;
+		}
+
+		std::size_t m;
+		std::size_t w;
+		std::vector<uint64_t> masks;
+};
+
+enum class MatchMetric
+{
+	hamming,  /* substitutions only */
+	edit      /* substitutions, insertions and deletions */
+};
+
+class WuManber
+{
+	public:
+
+		/* ctor for a pattern of m > 0 bytes and up to k errors, k above m
+		 * is the same as m (every position matches), a negative k is
+		 * rejected (see ok) and matches nothing */
+		WuManber(const char* pattern, std::size_t m, int k, MatchMetric metric = MatchMetric::edit)
+			: m(m), w((m + 63) / 64), k(k < 0 ? 0 : (static_cast<std::size_t>(k) > m ? m : static_cast<std::size_t>(k))),
+			  rejected(k < 0), metric(metric), masks(detail::pattern_masks(pattern, m, (m + 63) / 64))
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: ok
+		 * desc: whether k was not negative
+		 * returns: bool
+		 */
+		bool ok() const noexcept
+		{
+			return !this->rejected;
+		}
+
+		/* name: errors
+		 * desc: the error bound in use, k clamped to the pattern length
+		 * returns: error count
+		 */
+		std::size_t errors() const noexcept
+		{
+			return this->k;
+		}
+
+		/* name: findAll
+		 * desc: calls f(end, errors) for every text position where a
+		 * match with at most k errors ends, errors being the fewest
+		 * returns: match count
+		 */
+		template <typename F>
+		std::size_t findAll(const char* text, std::size_t n, F f) const
+		{
+			if(this->m == 0 || this->rejected)
+				return 0;
+			const uint8_t* t = reinterpret_cast<const uint8_t*>(text);
+			const std::size_t W = this->w;
+			const std::size_t K = this->k;
+			const uint64_t top = uint64_t(1) << ((this->m - 1) % 64);
+			const bool edits = this->metric == MatchMetric::edit;
+
+			/* r[j] is the state with j errors, bit i set when p[0 .. i]
+			 * ends here with at most j errors. Edits start with j deleted
+			 * pattern bytes already matched */
+			std::vector<uint64_t> r((K + 1) * W, 0), prev(W), sh(W);
+			if(edits)
+				for(std::size_t j = 1; j <= K; ++j)
+					for(std::size_t i = 0; i < j && i < this->m; ++i)
+						r[j * W + i / 64] |= uint64_t(1) << (i % 64);
+
+			std::size_t hits = 0;
+			if(W == 1)
+			{
+				uint64_t* rs = r.data();
+				for(std::size_t pos = 0; pos < n; ++pos)
+				{
+					const uint64_t bc = this->masks[t[pos]];
+					uint64_t old = rs[0];
+					rs[0] = ((old << 1) | 1) & bc;
+					for(std::size_t j = 1; j <= K; ++j)
+					{
+						const uint64_t o = rs[j];
+						uint64_t x = (((o << 1) | 1) & bc) | (old << 1) | 1;
+						if(edits)
+							x |= old | (rs[j - 1] << 1);
+						rs[j] = x;
+						old = o;
+					}
+					for(std::size_t j = 0; j <= K; ++j)
+					{
+						if(rs[j] & top)
+						{
+							++hits;
+							f(pos, static_cast<int>(j));
+							break;
+						}
+					}
+				}
+				return hits;
+			}
+
+			for(std::size_t pos = 0; pos < n; ++pos)
+			{
+				const uint64_t* bc = this->masks.data() + t[pos] * W;
+				for(std::size_t j = 0; j <= K; ++j)
+				{
+					uint64_t* rj = r.data() + j * W;
+					const uint64_t* up = j ? r.data() + (j - 1) * W : rj;  /* new r[j - 1] */
+
+					/* matched byte: ((r[j] << 1) | 1) & B[c], old r[j - 1]
+					 * kept in prev for the next row */
+					uint64_t in = 1, pin = 1, uin = 1;
+					for(std::size_t i = 0; i < W; ++i)
+					{
+						const uint64_t old = rj[i];
+						uint64_t x = ((old << 1) | in) & bc[i];
+						in = old >> 63;
+						if(j > 0)
+						{
+							/* substitution: old r[j - 1] << 1 */
+							x |= (prev[i] << 1) | pin;
+							pin = prev[i] >> 63;
+							if(edits)
+							{
+								/* insertion: old r[j - 1], deletion: new r[j - 1] << 1 */
+								x |= prev[i] | (up[i] << 1) | uin;
+								uin = up[i] >> 63;
+							}
+						}
+						sh[i] = old;
+						rj[i] = x;
+					}
+					prev.swap(sh);
+				}
+				for(std::size_t j = 0; j <= K; ++j)
+				{
+					if(r[j * W + W - 1] & top)
+					{
+						++hits;
+						f(pos, static_cast<int>(j));
+						break;
+					}
+				}
+			}
+			return hits;
+		}
+
+		/* name: count
+		 * desc: text positions where a match ends
+		 * returns: count
+		 */
+		std::size_t count(const char* text, std::size_t n) const
+		{
+			return this->findAll(text, n, [](std::size_t, int) {});
+		}
+
+
+	private:
+
+		std::size_t m;
+		std::size_t w;
+		std::size_t k;
+		bool rejected;
+		MatchMetric metric;
+		std::vector<uint64_t> masks;
+};
+
+class Myers
+{
+	public:
+
+		/* ctor for a pattern of m > 0 bytes */
+		Myers(const char* pattern, std::size_t m)
+			: m(m), w((m + 63) / 64), masks(detail::pattern_masks(pattern, m, (m + 63) / 64))
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: distance
+		 * desc: edit distance between the pattern and the whole text
+		 * returns: distance
+		 */
+		std::size_t distance(const char* text, std::size_t n) const
+		{
+			std::size_t score = this->m;
+			this->run<true>(text, n, [&](std::size_t, std::size_t s) { score = s; return true; });
+			return n ? score : this->m;
+		}
+
+		/* name: findAll
+		 * desc: calls f(end, distance) for every text position where some
+		 * substring ending there is within k edits of the pattern
+		 * returns: match count
+		 */
+		template <typename F>
+		std::size_t findAll(const char* text, std::size_t n, std::size_t k, F f) const
+		{
+			std::size_t hits = 0;
+			this->run<false>(text, n, [&](std::size_t end, std::size_t s) {
+				if(s <= k)
+				{
+					++hits;
+					f(end, s);
+				}
+				return true;
+			});
+			return hits;
+		}
+
+		/* name: best
+		 * desc: the lowest distance any substring of the text has to the
+		 * pattern, and where the first such substring ends
+		 * returns: distance, 'end' receives the position
+		 */
+		std::size_t best(const char* text, std::size_t n, std::size_t& end) const
+		{
+			std::size_t low = this->m;
+			end = 0;
+			this->run<false>(text, n, [&](std::size_t j, std::size_t s) {
+				if(s < low)
+				{
+					low = s;
+					end = j;
+				}
+				return true;
+			});
+			return low;
+		}
+
+
+	private:
+
+		/* name: block
+		 * desc: one column step of a 64 row block, hin the horizontal
+		 * delta entering at the top (-1, 0 or +1), 'high' the row whose
+		 * delta leaves
+		 * returns: horizontal delta leaving at 'high'
+		 */
+		static int block(uint64_t& pv, uint64_t& mv, uint64_t eq, int hin, uint64_t high) noexcept
+		{
+			const uint64_t neg = hin < 0 ? 1 : 0;
+			const uint64_t xv = eq | mv;
+			eq |= neg;
+			const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+			uint64_t ph = mv | ~(xh | pv);
+			uint64_t mh = pv & xh;
+			const int hout = (ph & high ? 1 : 0) - (mh & high ? 1 : 0);
+			ph = (ph << 1) | (hin > 0 ? 1 : 0);
+			mh = (mh << 1) | neg;
+			pv = mh | ~(xv | ph);
+			mv = ph & xv;
+			return hout;
+		}
+
+		/* Global: every column starts one edit further (hin = +1).
+		 * Search: a match may start anywhere (hin = 0) */
+		template <bool Global, typename F>
+		void run(const char* text, std::size_t n, F f) const
+		{
+			if(this->m == 0)
+				return;
+			const uint8_t* t = reinterpret_cast<const uint8_t*>(text);
+			const std::size_t W = this->w;
+			const uint64_t last = uint64_t(1) << ((this->m - 1) % 64);
+			std::size_t score = this->m;
+
+			if(W == 1)
+			{
+				uint64_t pv = ~uint64_t(0), mv = 0;
+				for(std::size_t j = 0; j < n; ++j)
+				{
+					score += static_cast<std::size_t>(block(pv, mv, this->masks[t[j]], Global ? 1 : 0, last));
+					if(!f(j, score))
+						return;
+				}
+				return;
+			}
+
+			std::vector<uint64_t> pv(W, ~uint64_t(0)), mv(W, 0);
+			for(std::size_t j = 0; j < n; ++j)
+			{
+				const uint64_t* eq = this->masks.data() + t[j] * W;
+				int h = Global ? 1 : 0;
+				for(std::size_t b = 0; b < W; ++b)
+					h = block(pv[b], mv[b], eq[b], h, b + 1 == W ? last : uint64_t(1) << 63);
+				score += static_cast<std::size_t>(h);
+				if(!f(j, score))
+					return;
+			}
+		}
+
+		std::size_t m;
+		std::size_t w;
+		std::vector<uint64_t> masks;
+};
+
+class ShiftOrBatch
+{
+	public:
+
+		/* Longest pattern a lane holds */
+		static constexpr std::size_t MAX_LENGTH = 64;
+
+		/* ctor over 'count' patterns of 1 - 64 bytes each, any other
+		 * length is rejected (see accepted) and never matches */
+		ShiftOrBatch(const char* const* patterns, const std::size_t* lengths, std::size_t count)
+			: lanes(count), stride((count + 3) & ~std::size_t(3)), masks(256 * ((count + 3) & ~std::size_t(3)), ~uint64_t(0)),
+			  tops(((count + 3) & ~std::size_t(3)), 0)
+		{
+			for(std::size_t l = 0; l < count; ++l)
+			{
+				const std::size_t m = lengths[l];
+				if(m == 0 || m > MAX_LENGTH)
+				{
+					this->rejected = true;
+					continue;
+				}
+				for(std::size_t i = 0; i < m; ++i)
+					this->masks[static_cast<uint8_t>(patterns[l][i]) * this->stride + l] &= ~(uint64_t(1) << i);
+				this->tops[l] = uint64_t(1) << (m - 1);
+			}
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		std::size_t size() const noexcept
+		{
+			return this->lanes;
+		}
+
+		/* name: ok
+		 * desc: whether every pattern was 1 - MAX_LENGTH bytes
+		 * returns: bool
+		 */
+		bool ok() const noexcept
+		{
+			return !this->rejected;
+		}
+
+		/* name: accepted
+		 * desc: whether 'pattern' is searched for, a rejected one never
+		 * reports a match
+		 * returns: bool
+		 */
+		bool accepted(std::size_t pattern) const noexcept
+		{
+			return this->tops[pattern] != 0;
+		}
+
+		/* name: findAll
+		 * desc: calls f(pattern, end) for every occurrence of every pattern,
+		 * end being the position of its last byte
+		 * returns: occurrence count
+		 */
+		template <typename F>
+		std::size_t findAll(const char* text, std::size_t n, F f) const
+		{
+		#if defined(BITTLE_X86)
+			if(cpu_features().avx2)
+				return this->scanAvx2(reinterpret_cast<const uint8_t*>(text), n, f);
+		#endif
+			return this->scanScalar(reinterpret_cast<const uint8_t*>(text), n, f);
+		}
+
+		/* name: count
+		 * desc: occurrences of all patterns together
+		 * returns: count
+		 */
+		std::size_t count(const char* text, std::size_t n) const
+		{
+			return this->findAll(text, n, [](std::size_t, std::size_t) {});
+		}
+
+
+	private:
+
+		template <typename F>
+		std::size_t scanScalar(const uint8_t* t, std::size_t n, F& f) const
+		{
+			std::vector<uint64_t> d(this->stride, ~uint64_t(0));
+			std::size_t hits = 0;
+			for(std::size_t j = 0; j < n; ++j)
+			{
+				const uint64_t* b = this->masks.data() + t[j] * this->stride;
+				uint64_t any = 0;
+				for(std::size_t l = 0; l < this->stride; ++l)
+				{
+					d[l] = (d[l] << 1) | b[l];
+					any |= ~d[l] & this->tops[l];
+				}
+				if(any)
+					hits += this->report(d.data(), j, f);
+			}
+			return hits;
+		}
+
+	#if defined(BITTLE_X86)
+
+		template <typename F>
+		BITTLE_TARGET("avx2")
+		std::size_t scanAvx2(const uint8_t* t, std::size_t n, F& f) const
+		{
+			const std::size_t groups = this->stride / 4;
+			std::vector<uint64_t> d(this->stride, ~uint64_t(0));
+			__m256i* dv = reinterpret_cast<__m256i*>(d.data());
+			const __m256i* tops = reinterpret_cast<const __m256i*>(this->tops.data());
+			std::size_t hits = 0;
+			for(std::size_t j = 0; j < n; ++j)
+			{
+				const uint64_t* b = this->masks.data() + t[j] * this->stride;
+				__m256i any = _mm256_setzero_si256();
+				for(std::size_t g = 0; g < groups; ++g)
+				{
+					const __m256i x = _mm256_or_si256(_mm256_slli_epi64(_mm256_loadu_si256(dv + g), 1),
+					                                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 4 * g)));
+					_mm256_storeu_si256(dv + g, x);
+					any = _mm256_or_si256(any, _mm256_andnot_si256(x, _mm256_loadu_si256(tops + g)));
+				}
+				if(!_mm256_testz_si256(any, any))
+					hits += this->report(d.data(), j, f);
+			}
+			return hits;
+		}
+
+	#endif
+
+		template <typename F>
+		std::size_t report(const uint64_t* d, std::size_t end, F& f) const
+		{
+			std::size_t hits = 0;
+			for(std::size_t l = 0; l < this->lanes; ++l)
+			{
+				if(~d[l] & this->tops[l])
+				{
+					++hits;
+					f(l, end);
+				}
+			}
+			return hits;
+		}
+
+		std::size_t lanes;
+		std::size_t stride;            /* lanes rounded up to a register */
+		std::vector<uint64_t> masks;   /* 256 x stride, zero where the byte matches */
+		std::vector<uint64_t> tops;    /* bit m - 1 of every lane, 0 for padding and rejected lanes */
+		bool rejected = false;
+};
+
+}
+
+
+#endif
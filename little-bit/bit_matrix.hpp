@@ -0,0 +1,542 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_matrix.hpp
+ * purpose: dense bit matrices over GF(2) and the boolean semiring
+ */
+
+
+#ifndef BITTLE_BIT_MATRIX_HPP
+#define BITTLE_BIT_MATRIX_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace bittle {
+
+/* namespace: bittle
+ * BitMatrix stores each row as a run of 64 bit words. Bit c of row r
+ * lives in word c / 64 at position c % 64 (least significant first).
+ * Rows are padded to a multiple of four words so every row starts on a
+ * 256 bit boundary relative to the buffer and the row kernels below
+ * can be vectorized without a scalar tail.
+ */
+
+namespace detail {
+
+/* name: xor_row
+ * desc: dst ^= src over n words
+ * returns: nothing
+ */
+inline void xor_row(uint64_t* __restrict dst, const uint64_t* __restrict src, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] ^= src[i];
+}
+
+/* name: or_row
+ * desc: dst |= src over n words
+ * returns: nothing
+ */
+inline void or_row(uint64_t* __restrict dst, const uint64_t* __restrict src, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] |= src[i];
+}
+
+/* name: xor_rows
+ * desc: dst = a ^ b over n words
+ * returns: nothing
+ */
+inline void xor_rows(uint64_t* __restrict dst, const uint64_t* __restrict a,
+                     const uint64_t* __restrict b, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] = a[i] ^ b[i];
+}
+
+/* name: or_rows
+ * desc: dst = a | b over n words
+ * returns: nothing
+ */
+inline void or_rows(uint64_t* __restrict dst, const uint64_t* __restrict a,
+                    const uint64_t* __restrict b, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] = a[i] | b[i];
+}
+
+/* name: transpose64
+ * desc: transposes a 64x64 bit block in place (row i, bit j -> row j, bit i)
+ * returns: nothing
+ */
+inline void transpose64(uint64_t* a) noexcept
+{
+	uint64_t m = 0x00000000FFFFFFFFULL;
+	for(int j = 32; j != 0; j >>= 1, m ^= (m << j))
+	{
+		for(int k = 0; k < 64; k = ((k | j) + 1) & ~j)
+		{
+			const uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+			a[k] ^= t << j;
+			a[k | j] ^= t;
+		}
+	}
+}
+
+}
+
+class BitMatrix
+{
+	public:
+
+		using word_type = uint64_t;
+
+		static constexpr std::size_t WORD_BITS = 64;
+
+		/* Rows are padded to this many words */
+		static constexpr std::size_t ROW_ALIGN = 4;
+
+		/* Columns of A folded into one Four Russians table */
+		static constexpr std::size_t M4RM_K = 8;
+
+		/* Words of B/C processed per table so it stays cache resident */
+		static constexpr std::size_t M4RM_COL_BLOCK = 16;
+
+		/* Rows of A processed per table build */
+		static constexpr std::size_t M4RM_ROW_BLOCK = 2048;
+
+		/* Words per column block of the closure, 64 pivot rows of this
+		 * many words is 16 KiB */
+		static constexpr std::size_t CLOSURE_COL_BLOCK = 32;
+
+		/* Zero sized ctor */
+		BitMatrix() noexcept = default;
+
+		/* Zero filled rows x cols ctor */
+		BitMatrix(std::size_t rows, std::size_t cols)
+			: nrows(rows), ncols(cols), stride(paddedWords(cols)),
+			  data(rows * paddedWords(cols), 0)
+		{
+		}
+
+		/* name: identity
+		 * desc: builds the n x n identity matrix
+		 * returns: new BitMatrix
+		 */
+		static BitMatrix identity(std::size_t n)
+		{
+			BitMatrix m(n, n);
+			for(std::size_t i = 0; i < n; ++i)
+				m.set(i, i, true);
+			return m;
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		std::size_t rows() const noexcept
+		{
+			return this->nrows;
+		}
+
+		std::size_t cols() const noexcept
+		{
+			return this->ncols;
+		}
+
+		/* name: rowWords
+		 * desc: number of (padded) words in every row
+		 * returns: word count
+		 */
+		std::size_t rowWords() const noexcept
+		{
+			return this->stride;
+		}
+
+		/* name: get
+		 * desc: reads the bit at (r, c)
+		 * returns: bool
+		 */
+		bool get(std::size_t r, std::size_t c) const noexcept
+		{
+			return (row(r)[c / WORD_BITS] >> (c % WORD_BITS)) & 1;
+		}
+
+		/* name: word
+		 * desc: reads word w of row r as a Bits object
+		 * returns: Bits64U
+		 */
+		Bits<word_type> word(std::size_t r, std::size_t w) const noexcept
+		{
+			return Bits<word_type>(row(r)[w]);
+		}
+
+		const word_type* row(std::size_t r) const noexcept
+		{
+			return this->data.data() + r * this->stride;
+		}
+
+		/* name: ones
+		 * desc: counts the set entries
+		 * returns: set entry count
+		 */
+		std::size_t ones() const noexcept
+		{
+			return static_cast<std::size_t>(bittle::popcount_words(this->data.data(), this->data.size()));
+		}
+
+		/* name: transpose
+		 * desc: transposes 64x64 tiles in registers and scatters them
+		 * returns: new BitMatrix
+		 */
+		BitMatrix transpose() const
+		{
+			BITTLE_PROFILE_KERNEL(matrix_transpose);
+			BitMatrix out(this->ncols, this->nrows);
+			word_type block[WORD_BITS];
+
+			for(std::size_t rb = 0; rb < this->nrows; rb += WORD_BITS)
+			{
+				const std::size_t rn = std::min(WORD_BITS, this->nrows - rb);
+				for(std::size_t cw = 0; cw * WORD_BITS < this->ncols; ++cw)
+				{
+					std::size_t i = 0;
+					for(; i < rn; ++i)
+						block[i] = row(rb + i)[cw];
+					for(; i < WORD_BITS; ++i)
+						block[i] = 0;
+
+					detail::transpose64(block);
+
+					const std::size_t cn = std::min(WORD_BITS, this->ncols - cw * WORD_BITS);
+					for(std::size_t j = 0; j < cn; ++j)
+						out.row(cw * WORD_BITS + j)[rb / WORD_BITS] = block[j];
+				}
+			}
+
+			return out;
+		}
+
+		/* name: rank
+		 * desc: rank over GF(2)
+		 * returns: rank
+		 */
+		std::size_t rank() const
+		{
+			BITTLE_PROFILE_KERNEL(matrix_rank);
+			BitMatrix tmp(*this);
+			return tmp.rowEchelon(false);
+		}
+
+		friend bool operator==(const BitMatrix& left, const BitMatrix& right) noexcept
+		{
+			return left.nrows == right.nrows && left.ncols == right.ncols &&
+			       left.data == right.data;
+		}
+
+		friend bool operator!=(const BitMatrix& left, const BitMatrix& right) noexcept
+		{
+			return !(left == right);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		word_type* row(std::size_t r) noexcept
+		{
+			return this->data.data() + r * this->stride;
+		}
+
+		/* name: set
+		 * desc: writes the bit at (r, c)
+		 * returns: *this
+		 */
+		BitMatrix& set(std::size_t r, std::size_t c, bool v = true) noexcept
+		{
+			word_type& w = row(r)[c / WORD_BITS];
+			const word_type m = word_type(1) << (c % WORD_BITS);
+			w = v ? (w | m) : (w & ~m);
+			return *this;
+		}
+
+		/* name: toggle
+		 * desc: flips the bit at (r, c)
+		 * returns: *this
+		 */
+		BitMatrix& toggle(std::size_t r, std::size_t c) noexcept
+		{
+			row(r)[c / WORD_BITS] ^= word_type(1) << (c % WORD_BITS);
+			return *this;
+		}
+
+		/* name: clear
+		 * desc: zeroes every entry
+		 * returns: *this
+		 */
+		BitMatrix& clear() noexcept
+		{
+			std::fill(this->data.begin(), this->data.end(), 0);
+			return *this;
+		}
+
+		/* name: rowEchelon
+		 * desc: Gaussian elimination over GF(2), reduced form if 'reduced'
+		 * returns: rank
+		 */
+		std::size_t rowEchelon(bool reduced = true) noexcept
+		{
+			std::size_t r = 0;
+			for(std::size_t c = 0; c < this->ncols && r < this->nrows; ++c)
+			{
+				const std::size_t w = c / WORD_BITS;
+				const word_type m = word_type(1) << (c % WORD_BITS);
+
+				std::size_t p = r;
+				while(p < this->nrows && !(row(p)[w] & m))
+					++p;
+				if(p == this->nrows)
+					continue;
+
+				if(p != r)
+					std::swap_ranges(row(p), row(p) + this->stride, row(r));
+
+				/* Columns before c are already zero in the pivot row */
+				const word_type* piv = row(r) + w;
+				const std::size_t n = this->stride - w;
+				for(std::size_t i = reduced ? 0 : r + 1; i < this->nrows; ++i)
+				{
+					if(i != r && (row(i)[w] & m))
+						detail::xor_row(row(i) + w, piv, n);
+				}
+				++r;
+			}
+
+			return r;
+		}
+
+		/* name: transitiveClosure
+		 * desc: bit parallel Warshall blocked by 64 pivots, see closeBlock.
+		 * A non square matrix is left untouched
+		 * returns: *this
+		 */
+		BitMatrix& transitiveClosure()
+		{
+			if(this->nrows != this->ncols)
+				return *this;
+
+			std::vector<word_type> pivots(this->nrows);
+			for(std::size_t k0 = 0; k0 < this->nrows; k0 += WORD_BITS)
+				closeBlock(k0, pivots.data());
+
+			return *this;
+		}
+
+		/*
+		 *
+		 *
+		 * Static Member Methods
+		 *
+		 *
+		 */
+
+		/* name: multiply
+		 * desc: a * b over GF(2) using the Method of Four Russians
+		 * returns: new BitMatrix, empty (0 x 0) if a.cols() != b.rows()
+		 */
+		static BitMatrix multiply(const BitMatrix& a, const BitMatrix& b)
+		{
+			return m4rm<false>(a, b);
+		}
+
+		/* name: booleanMultiply
+		 * desc: a * b over the (OR, AND) semiring
+		 * returns: new BitMatrix, empty (0 x 0) if a.cols() != b.rows()
+		 */
+		static BitMatrix booleanMultiply(const BitMatrix& a, const BitMatrix& b)
+		{
+			return m4rm<true>(a, b);
+		}
+
+		/* name: multiplyNaive
+		 * desc: reference row by row product, mostly for testing
+		 * returns: new BitMatrix, empty (0 x 0) if a.cols() != b.rows()
+		 */
+		static BitMatrix multiplyNaive(const BitMatrix& a, const BitMatrix& b, bool boolean = false)
+		{
+			if(a.ncols != b.nrows)
+				return BitMatrix();
+
+			BitMatrix c(a.nrows, b.ncols);
+			for(std::size_t i = 0; i < a.nrows; ++i)
+			{
+				for(std::size_t k = 0; k < a.ncols; ++k)
+				{
+					if(!a.get(i, k))
+						continue;
+					if(boolean)
+						detail::or_row(c.row(i), b.row(k), c.stride);
+					else
+						detail::xor_row(c.row(i), b.row(k), c.stride);
+				}
+			}
+			return c;
+		}
+
+		friend BitMatrix operator*(const BitMatrix& left, const BitMatrix& right)
+		{
+			return multiply(left, right);
+		}
+
+
+	private:
+
+		static constexpr std::size_t paddedWords(std::size_t cols) noexcept
+		{
+			return ((cols + WORD_BITS - 1) / WORD_BITS + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+		}
+
+		/* name: closeBlock
+		 * desc: Warshall step for the pivots k0 .. k0 + 63, all in word w.
+		 * The pivot rows are closed among themselves first, after which a
+		 * pivot row already holds every pivot row it reaches, so any other
+		 * row only ORs in the pivot rows named by its own word w as it was
+		 * before the step. Those words are saved to 'pivots', then the
+		 * other rows are walked one column block at a time so the pivot
+		 * rows' slice of the block stays in cache across all rows.
+		 * returns: nothing
+		 */
+		void closeBlock(std::size_t k0, word_type* pivots) noexcept
+		{
+			const std::size_t w = k0 / WORD_BITS;
+			const std::size_t k1 = std::min(this->nrows, k0 + WORD_BITS);
+
+			for(std::size_t k = k0; k < k1; ++k)
+			{
+				const word_type m = word_type(1) << (k % WORD_BITS);
+				for(std::size_t i = k0; i < k1; ++i)
+				{
+					if(i != k && (row(i)[w] & m))
+						detail::or_row(row(i), row(k), this->stride);
+				}
+			}
+
+			for(std::size_t i = 0; i < this->nrows; ++i)
+				pivots[i] = (i >= k0 && i < k1) ? 0 : row(i)[w];
+
+			const std::size_t block = CLOSURE_COL_BLOCK;
+			for(std::size_t j0 = 0; j0 < this->stride; j0 += block)
+			{
+				const std::size_t jn = std::min(block, this->stride - j0);
+				for(std::size_t i = 0; i < this->nrows; ++i)
+				{
+					for(word_type x = pivots[i]; x; x &= x - 1)
+					{
+						const std::size_t k = k0 + static_cast<std::size_t>(__builtin_ctzll(x));
+						detail::or_row(row(i) + j0, row(k) + j0, jn);
+					}
+				}
+			}
+		}
+
+		/* name: m4rm
+		 * desc: Four Russians product. For every group of K columns of 'a'
+		 * all 2^K combinations of the matching rows of 'b' are tabulated,
+		 * entry x being entry x minus its lowest bit plus the row of that
+		 * bit (one row op per entry), and each row of 'a' then needs a
+		 * single table lookup per group. OR-ing subsets works
+		 * exactly like XOR-ing them, so one kernel serves both semirings.
+		 * The table is restricted to a column block of 'b' and reused for a
+		 * block of rows of 'a' to stay in cache.
+		 * returns: new BitMatrix
+		 */
+		template <bool Boolean>
+		static BitMatrix m4rm(const BitMatrix& a, const BitMatrix& b)
+		{
+			BITTLE_PROFILE_KERNEL(matrix_multiply);
+			if(a.ncols != b.nrows)
+				return BitMatrix();
+
+			BitMatrix c(a.nrows, b.ncols);
+			const std::size_t K = M4RM_K;
+			const std::size_t TN = std::size_t(1) << K;
+			std::vector<word_type> table(TN * M4RM_COL_BLOCK);
+
+			const std::size_t inner = a.ncols;
+
+			for(std::size_t r0 = 0; r0 < a.nrows; r0 += M4RM_ROW_BLOCK)
+			{
+				const std::size_t r1 = std::min(a.nrows, r0 + M4RM_ROW_BLOCK);
+				for(std::size_t w0 = 0; w0 < b.stride; w0 += M4RM_COL_BLOCK)
+				{
+					const std::size_t wn = std::min(M4RM_COL_BLOCK, b.stride - w0);
+					for(std::size_t k0 = 0; k0 < inner; k0 += K)
+					{
+						const std::size_t kn = std::min(K, inner - k0);
+
+						/* table[0] = 0, table[x] = table[x & (x - 1)] op b[k0 + ctz(x)] */
+						std::fill(table.begin(), table.begin() + wn, 0);
+						for(std::size_t x = 1; x < (std::size_t(1) << kn); ++x)
+						{
+							const std::size_t lo = static_cast<std::size_t>(__builtin_ctzll(x));
+							word_type* dst = table.data() + x * wn;
+							const word_type* prev = table.data() + (x & (x - 1)) * wn;
+							const word_type* src = b.row(k0 + lo) + w0;
+							if(Boolean)
+								detail::or_rows(dst, prev, src, wn);
+							else
+								detail::xor_rows(dst, prev, src, wn);
+						}
+
+						/* k0 is a multiple of 8 so the group sits inside one word */
+						const std::size_t aw = k0 / WORD_BITS;
+						const std::size_t sh = k0 % WORD_BITS;
+						const word_type km = (word_type(1) << kn) - 1;
+						for(std::size_t i = r0; i < r1; ++i)
+						{
+							const std::size_t x = static_cast<std::size_t>((a.row(i)[aw] >> sh) & km);
+							if(!x)
+								continue;
+							if(Boolean)
+								detail::or_row(c.row(i) + w0, table.data() + x * wn, wn);
+							else
+								detail::xor_row(c.row(i) + w0, table.data() + x * wn, wn);
+						}
+					}
+				}
+			}
+
+			return c;
+		}
+
+		std::size_t nrows = 0;
+		std::size_t ncols = 0;
+		std::size_t stride = 0;
+		std::vector<word_type> data;
+};
+
+constexpr std::size_t BitMatrix::WORD_BITS;
+constexpr std::size_t BitMatrix::ROW_ALIGN;
+constexpr std::size_t BitMatrix::M4RM_K;
+constexpr std::size_t BitMatrix::M4RM_COL_BLOCK;
+constexpr std::size_t BitMatrix::M4RM_ROW_BLOCK;
+constexpr std::size_t BitMatrix::CLOSURE_COL_BLOCK;
+
+}
+
+
+#endif
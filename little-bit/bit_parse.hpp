@@ -0,0 +1,252 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_parse.hpp
+ * purpose: streaming parser from binary and hex text into word arrays
+ */
+
+
+#ifndef BITTLE_BIT_PARSE_HPP
+#define BITTLE_BIT_PARSE_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+
+namespace bittle {
+
+/* namespace: bittle
+ * BitStreamParser turns one long run of binary or hex digits into 64 bit
+ * words, first digit most significant, the way a test vector file reads:
+ *
+ *     uint64_t words[1024];
+ *     BitStreamParser<2> p(words, 1024);
+ *     while(more) p.feed(chunk, chunk_len);   // chunks may split anywhere
+ *     ParseResult r = p.finish();
+ *
+ * Whitespace and '_' are skipped. Text is converted a whole block at a
+ * time (64 binary or 16 hex chars) through binary_block/hex_block; a
+ * separator ends the block early and only that one char goes the slow
+ * way. Nothing is allocated, running out of words is an overflow.
+ */
+
+template <int Base = 2>
+class BitStreamParser
+{
+	static_assert(Base == 2 || Base == 16, "BitStreamParser reads base 2 or base 16");
+
+	static constexpr int SHIFT = Base == 16 ? 4 : 1;
+	static constexpr std::size_t BLOCK = 64 / SHIFT;
+
+
+	public:
+
+		BitStreamParser(uint64_t* out, std::size_t cap) noexcept
+			: out(out), cap(cap)
+		{
+
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: words
+		 * desc: complete words written so far
+		 * returns: word count
+		 */
+		std::size_t words() const noexcept
+		{
+			return this->count;
+		}
+
+		/* name: bits
+		 * desc: digits parsed so far, in bits
+		 * returns: bit count
+		 */
+		std::size_t bits() const noexcept
+		{
+			return this->count * 64 + static_cast<std::size_t>(this->pending);
+		}
+
+		/* name: status
+		 * desc: sticky status, a failed parser ignores further input
+		 * returns: ParseResult, position is absolute over all chunks
+		 */
+		ParseResult status() const noexcept
+		{
+			return ParseResult{this->state, this->state == ParseStatus::ok ? this->offset : this->error};
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: feed
+		 * desc: parses the next chunk, a word may span chunks
+		 * returns: status()
+		 */
+		ParseResult feed(const char* s, std::size_t len) noexcept
+		{
+			BITTLE_PROFILE_KERNEL(stream_feed);
+			if(this->state != ParseStatus::ok)
+				return this->status();
+
+			std::size_t i = 0;
+			while(i < len)
+			{
+				if(len - i >= BLOCK)
+				{
+					uint64_t bad = 0;
+					const uint64_t v = Base == 16 ? bittle::hex_block(s + i, bad) : bittle::binary_block(s + i, bad);
+					if(!bad)
+					{
+						if(!this->push(v, 64))
+							return this->fail(ParseStatus::overflow, i);
+						i += BLOCK;
+						continue;
+					}
+
+					/* keep the digits in front of the first bad char */
+					const int good = __builtin_ctzll(bad);
+					if(good > 0 && !this->push(v >> (64 - good * SHIFT), good * SHIFT))
+						return this->fail(ParseStatus::overflow, i);
+					i += static_cast<std::size_t>(good);
+				}
+
+				const char c = s[i];
+				if(c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '_')
+				{
+					++i;
+					continue;
+				}
+
+				const int d = digit(c);
+				if(d < 0)
+					return this->fail(ParseStatus::invalid_digit, i);
+				if(!this->push(static_cast<uint64_t>(d), SHIFT))
+					return this->fail(ParseStatus::overflow, i);
+				++i;
+			}
+
+			this->offset += len;
+			return this->status();
+		}
+
+		/* name: finish
+		 * desc: writes a trailing partial word, padded with zero bits on
+		 * the right as if the digits went on
+		 * returns: status()
+		 */
+		ParseResult finish() noexcept
+		{
+			if(this->state == ParseStatus::ok && this->pending > 0)
+			{
+				if(this->count == this->cap)
+					return this->fail(ParseStatus::overflow, 0);
+				this->out[this->count++] = this->acc << (64 - this->pending);
+				this->acc = 0;
+				this->pending = 0;
+			}
+			return this->status();
+		}
+
+		/* name: reset
+		 * desc: starts over at the beginning of the same array
+		 * returns: nothing
+		 */
+		void reset() noexcept
+		{
+			this->count = 0;
+			this->acc = 0;
+			this->pending = 0;
+			this->offset = 0;
+			this->error = 0;
+			this->state = ParseStatus::ok;
+		}
+
+
+	private:
+
+		static int digit(char c) noexcept
+		{
+			if(c >= '0' && c <= (Base == 16 ? '9' : '1'))
+				return c - '0';
+			const char l = static_cast<char>(c | 0x20);
+			if(Base == 16 && l >= 'a' && l <= 'f')
+				return l - 'a' + 10;
+			return -1;
+		}
+
+		/* name: push
+		 * desc: appends the low n (1 - 64) bits of v
+		 * returns: false when the output is full
+		 */
+		bool push(uint64_t v, int n) noexcept
+		{
+			if(this->pending + n < 64)
+			{
+				this->acc = (this->acc << n) | v;
+				this->pending += n;
+				return true;
+			}
+
+			if(this->count == this->cap)
+				return false;
+
+			const int take = 64 - this->pending;
+			const int rest = n - take;
+			this->out[this->count++] = (this->pending ? this->acc << take : 0) | (v >> rest);
+			this->acc = rest ? v & ((uint64_t(1) << rest) - 1) : 0;
+			this->pending = rest;
+			return true;
+		}
+
+		ParseResult fail(ParseStatus s, std::size_t i) noexcept
+		{
+			this->state = s;
+			this->error = this->offset + i;
+			return this->status();
+		}
+
+		uint64_t* out;
+		std::size_t cap;
+		std::size_t count = 0;
+		uint64_t acc = 0;
+		int pending = 0;         /* bits waiting in acc */
+		std::size_t offset = 0;  /* chars consumed by earlier chunks */
+		std::size_t error = 0;
+		ParseStatus state = ParseStatus::ok;
+};
+
+/* name: parse_words
+ * desc: one shot BitStreamParser over a whole buffer
+ * returns: ParseResult, 'words' receives the word count
+ */
+template <int Base = 2>
+ParseResult parse_words(const char* s, std::size_t len, uint64_t* out, std::size_t cap, std::size_t& words) noexcept
+{
+	BitStreamParser<Base> p(out, cap);
+	p.feed(s, len);
+	const ParseResult r = p.finish();
+	words = p.words();
+	return r;
+}
+
+/* Declarations for ease of use */
+
+using BinaryStreamParser = BitStreamParser<2>;
+using HexStreamParser = BitStreamParser<16>;
+
+}
+
+
+#endif
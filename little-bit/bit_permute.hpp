@@ -0,0 +1,284 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_permute.hpp
+ * purpose: compile time compiled fixed bit permutations
+ */
+
+
+#ifndef BITTLE_BIT_PERMUTE_HPP
+#define BITTLE_BIT_PERMUTE_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace bittle {
+
+/* namespace: bittle
+ * A permutation is described by a type with a constexpr table
+ *
+ *     struct PBox { static constexpr uint8_t map[64] = { ... }; };
+ *
+ * where output bit i is taken from input bit map[i] (bit 0 is the least
+ * significant). BitPermutation<T, PBox> compiles the table once, at
+ * compile time, into whichever of two plans is cheaper:
+ *
+ *   - shift groups: bits that move by the same distance share one
+ *     mask/shift/or, good for field reordering
+ *   - a Benes network: 2 log2(w) - 1 delta swaps, stages whose mask
+ *     routes nothing are dropped, good for scattered P-boxes
+ *
+ * and applies it with every mask and shift as an immediate.
+ */
+
+template <std::size_t W>
+struct PermutePlan
+{
+	static constexpr int LEVELS = W == 8 ? 3 : W == 16 ? 4 : W == 32 ? 5 : 6;
+	static constexpr int MAX_STAGES = 2 * LEVELS - 1;
+
+	bool valid = false;
+	bool benes = false;
+
+	/* Benes delta swaps */
+	int stages = 0;
+	uint64_t mask[MAX_STAGES] = {};
+	int shift[MAX_STAGES] = {};
+
+	/* Shift groups, positive shifts move left */
+	int groups = 0;
+	uint64_t gmask[2 * W] = {};
+	int gshift[2 * W] = {};
+};
+
+/* name: compile_permutation
+ * desc: routes a gather table through both plans
+ * returns: PermutePlan
+ */
+template <std::size_t W>
+constexpr PermutePlan<W> compile_permutation(const uint8_t (&map)[W]) noexcept
+{
+	static_assert(W == 8 || W == 16 || W == 32 || W == 64, "Permutation width must be 8, 16, 32 or 64");
+
+	PermutePlan<W> p{};
+	const int K = PermutePlan<W>::LEVELS;
+	const int n = static_cast<int>(W);
+
+	bool seen[W] = {};
+	for(int i = 0; i < n; ++i)
+	{
+		if(map[i] >= W || seen[map[i]])
+			return p;
+		seen[map[i]] = true;
+	}
+	p.valid = true;
+
+	/* cur[pos] = final position of the bit currently at pos */
+	int cur[W] = {};
+	for(int i = 0; i < n; ++i)
+		cur[map[i]] = i;
+
+	/* Shift groups */
+	for(int s = 0; s < n; ++s)
+	{
+		const int d = cur[s] - s;
+		int g = 0;
+		while(g < p.groups && p.gshift[g] != d)
+			++g;
+		if(g == p.groups)
+			p.gshift[p.groups++] = d;
+		p.gmask[g] |= uint64_t(1) << s;
+	}
+
+	/* Benes network by the looping algorithm. At distance h every aligned
+	 * block of 2h positions is split into two halves: the first stage
+	 * sends each bit of a pair (l, l + h) to a different half so that the
+	 * last stage can deliver both bits of every output pair. */
+	uint64_t first[6] = {};
+	uint64_t last[6] = {};
+	for(int lvl = 0, h = n / 2; h >= 1; ++lvl, h /= 2)
+	{
+		if(h == 1)
+		{
+			for(int b = 0; b < n; b += 2)
+				if(cur[b] != b)
+					first[lvl] |= uint64_t(1) << b;
+			break;
+		}
+
+		int where[W] = {};
+		int sub[W] = {};
+		bool set[W] = {};
+		for(int i = 0; i < n; ++i)
+			where[cur[i]] = i;
+
+		for(int i = 0; i < n; ++i)
+		{
+			int e = i;
+			while(!set[e])
+			{
+				const int q = e ^ h;
+				sub[e] = 0;
+				sub[q] = 1;
+				set[e] = set[q] = true;
+				/* whoever must land next to q's target rides with e */
+				e = where[cur[q] ^ h];
+			}
+		}
+
+		int next[W] = {};
+		for(int e = 0; e < n; ++e)
+		{
+			const int half = sub[e] ? h : 0;
+			if(!(e & h) && sub[e])
+				first[lvl] |= uint64_t(1) << e;
+			if(half != (cur[e] & h))
+				last[lvl] |= uint64_t(1) << (cur[e] & ~h);
+			next[(e & ~h) | half] = (cur[e] & ~h) | half;
+		}
+		for(int e = 0; e < n; ++e)
+			cur[e] = next[e];
+	}
+
+	for(int lvl = 0; lvl < K; ++lvl)
+	{
+		if(first[lvl])
+		{
+			p.mask[p.stages] = first[lvl];
+			p.shift[p.stages++] = n >> (lvl + 1);
+		}
+	}
+	for(int lvl = K - 2; lvl >= 0; --lvl)
+	{
+		if(last[lvl])
+		{
+			p.mask[p.stages] = last[lvl];
+			p.shift[p.stages++] = n >> (lvl + 1);
+		}
+	}
+
+	/* A delta swap is six operations, a shift group three */
+	p.benes = 6 * p.stages < 3 * p.groups;
+	return p;
+}
+
+template <typename T, typename Map>
+class BitPermutation
+{
+	static_assert(std::is_integral<T>::value, "Template type T must be an integral type in BitPermutation");
+
+	using U = typename std::make_unsigned<T>::type;
+
+	static constexpr std::size_t W = sizeof(T) * BIT_SIZE;
+
+	static_assert(sizeof(Map::map) == W, "The permutation table needs one entry per bit");
+
+
+	public:
+
+		using plan_type = PermutePlan<W>;
+
+		static constexpr plan_type plan = compile_permutation<W>(Map::map);
+
+		static_assert(plan.valid, "The permutation table must contain every bit index exactly once");
+
+		/* name: apply
+		 * desc: permutes the bits of n
+		 * returns: permuted value
+		 */
+		static constexpr T apply(const T& n) noexcept
+		{
+			return static_cast<T>(plan.benes ?
+				benes(static_cast<U>(n), std::make_index_sequence<plan.stages>()) :
+				grouped(static_cast<U>(n), std::make_index_sequence<plan.groups>()));
+		}
+
+		/* name: apply
+		 * desc: permutes the bits of a Bits object
+		 * returns: new Bits
+		 */
+		static constexpr Bits<T> apply(const Bits<T>& b) noexcept
+		{
+			return Bits<T>(apply(b.value()));
+		}
+
+		/* name: apply
+		 * desc: out[i] = apply(in[i]), in and out may be the same array
+		 * returns: nothing
+		 */
+		static void apply(const T* in, T* out, std::size_t len) noexcept
+		{
+			BITTLE_PROFILE_KERNEL(permute_bulk);
+			for(std::size_t i = 0; i < len; ++i)
+				out[i] = apply(in[i]);
+		}
+
+		/* name: applyNaive
+		 * desc: reference per bit gather
+		 * returns: permuted value
+		 */
+		static constexpr T applyNaive(const T& n) noexcept
+		{
+			U r = 0;
+			for(std::size_t i = 0; i < W; ++i)
+				r |= static_cast<U>(((static_cast<U>(n) >> Map::map[i]) & 1) << i);
+			return static_cast<T>(r);
+		}
+
+		/* name: operations
+		 * desc: rough op count of the chosen plan
+		 * returns: op count
+		 */
+		static constexpr int operations() noexcept
+		{
+			return plan.benes ? 6 * plan.stages : 3 * plan.groups;
+		}
+
+
+	private:
+
+		template <std::size_t I>
+		static constexpr U deltaSwap(U x) noexcept
+		{
+			constexpr U m = static_cast<U>(plan.mask[I]);
+			constexpr int s = plan.shift[I];
+			const U t = static_cast<U>(((x >> s) ^ x) & m);
+			return static_cast<U>(x ^ t ^ static_cast<U>(t << s));
+		}
+
+		template <std::size_t I>
+		static constexpr U group(U x) noexcept
+		{
+			constexpr U m = static_cast<U>(plan.gmask[I]);
+			constexpr int s = plan.gshift[I];
+			return s >= 0 ? static_cast<U>((x & m) << s) : static_cast<U>((x & m) >> -s);
+		}
+
+		template <std::size_t... Is>
+		static constexpr U benes(U x, std::index_sequence<Is...>) noexcept
+		{
+			const int unused[] = {0, (x = deltaSwap<Is>(x), 0)...};
+			(void)unused;
+			return x;
+		}
+
+		template <std::size_t... Is>
+		static constexpr U grouped(U x, std::index_sequence<Is...>) noexcept
+		{
+			U r = 0;
+			const int unused[] = {0, (r |= group<Is>(x), 0)...};
+			(void)unused;
+			return r;
+		}
+
+};
+
+template <typename T, typename Map>
+constexpr typename BitPermutation<T, Map>::plan_type BitPermutation<T, Map>::plan;
+
+}
+
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_reversal.hpp
+ * purpose: cache blocked bit-reversal permutation of arrays, in place and
+ * out of place, for FFT reordering
+ */
+
+
+#ifndef BITTLE_BIT_REVERSAL_HPP
+#define BITTLE_BIT_REVERSAL_HPP
+
+#include "bittle.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Moves element i of a 2^log2n array to index reverse(i), reverse being
+ * the low log2n bits of i backwards:
+ *
+ *     bit_reverse_permute(in, out, 22);       // out[reverse(i)] = in[i]
+ *     bit_reverse_permute(data, 22, 0);       // in place, one thread per core
+ *
+ * Done one element at a time every write lands 2^(log2n - 1) elements
+ * from the last, a new cache line and soon a new page each time. Large
+ * arrays are cut COBRA style instead: an index is [a | c | d] with a and
+ * d 'b' bits wide, its reverse is [rev d | rev c | rev a]. For each
+ * middle c, 2^b rows of 2^b contiguous elements are read into a tile
+ * (rows by rev a), then written out as 2^b contiguous rows (rows by
+ * rev d), so both sides move whole cache lines. b is picked so a tile
+ * is about 16 KiB of T. In place, the tiles of c and rev c are loaded
+ * together and swapped. Reversed indices come from an incremental
+ * reversed counter, never a per index reverse_bits.
+ *
+ * Middles are split across threads, each with its own tile. Elements
+ * must be trivially copyable, in and out must not overlap.
+ */
+
+namespace detail {
+
+/* Bytes of one tile, B * B elements */
+static constexpr std::size_t REVERSAL_TILE_BYTES = 16384;
+
+/* Below 2^this elements the array fits in cache, no tiling */
+static constexpr int REVERSAL_MIN_LOG = 12;
+
+/* name: reversal_next
+ * desc: reverse(i + 1) from r = reverse(i), log2n bits, adds one at the
+ * top and carries downwards
+ * returns: next reversed index
+ */
+inline std::size_t reversal_next(std::size_t r, int log2n) noexcept
+{
+	std::size_t bit = std::size_t(1) << (log2n - 1);
+	while(r & bit)
+	{
+		r ^= bit;
+		bit >>= 1;
+	}
+	return r | bit;
+}
+
+/* name: reversal_of
+ * desc: reverse of one index, for the start of a thread's range
+ * returns: reversed index
+ */
+inline std::size_t reversal_of(std::size_t i, int log2n) noexcept
+{
+	std::size_t r = 0;
+	for(int k = 0; k < log2n; ++k, i >>= 1)
+		r = (r << 1) | (i & 1);
+	return r;
+}
+
+/* name: reversal_table
+ * desc: reverse of 0 .. 2^bits - 1 by the incremental counter
+ * returns: nothing
+ */
+inline void reversal_table(std::size_t* table, int bits) noexcept
+{
+	const std::size_t count = std::size_t(1) << bits;
+	table[0] = 0;
+	for(std::size_t i = 1; i < count; ++i)
+		table[i] = bits ? reversal_next(table[i - 1], bits) : 0;
+}
+
+/* name: reversal_tile_bits
+ * desc: b for a 2^log2n array of 'size' byte elements, the largest with a
+ * tile within REVERSAL_TILE_BYTES and 2b <= log2n
+ * returns: b
+ */
+inline int reversal_tile_bits(int log2n, std::size_t size) noexcept
+{
+	int b = 1;
+	while(2 * (b + 1) <= log2n && (std::size_t(1) << (2 * (b + 1))) * size <= REVERSAL_TILE_BYTES)
+		++b;
+	return b;
+}
+
+/* name: reversal_simple
+ * desc: element at a time with the reversed counter, small arrays
+ * returns: nothing
+ */
+template <typename T>
+void reversal_simple(const T* in, T* out, int log2n) noexcept
+{
+	const std::size_t n = std::size_t(1) << log2n;
+	std::size_t r = 0;
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		out[r] = in[i];
+		if(i + 1 < n)
+			r = reversal_next(r, log2n);
+	}
+}
+
+template <typename T>
+void reversal_simple(T* data, int log2n) noexcept
+{
+	const std::size_t n = std::size_t(1) << log2n;
+	std::size_t r = 0;
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		if(i < r)
+			std::swap(data[i], data[r]);
+		if(i + 1 < n)
+			r = reversal_next(r, log2n);
+	}
+}
+
+/* Shape of a tiled permutation, [a | c | d] with a and d 'b' bits */
+struct ReversalShape
+{
+	int log2n;
+	int b;
+	int mid;				// bits of c
+	std::size_t B;			// 2^b
+	std::vector<std::size_t> rev;	// reverse of 0 .. B - 1 in b bits
+
+	ReversalShape(int lg, std::size_t size) :
+		log2n(lg), b(reversal_tile_bits(lg, size)), mid(lg - 2 * b), B(std::size_t(1) << b), rev(B)
+	{
+		reversal_table(rev.data(), b);
+	}
+};
+
+/* name: reversal_load
+ * desc: rows a of middle c into the tile, row rev a at rev[a] * B
+ * returns: nothing
+ */
+template <typename T>
+inline void reversal_load(const T* in, T* tile, std::size_t c, const ReversalShape& s) noexcept
+{
+	const int high = s.log2n - s.b;
+	for(std::size_t a = 0; a < s.B; ++a)
+	{
+		const T* row = in + ((a << high) | (c << s.b));
+		std::copy(row, row + s.B, tile + s.rev[a] * s.B);
+	}
+}
+
+/* name: reversal_store
+ * desc: tile column d to row rev d of middle rc, the inverse gather of
+ * reversal_load
+ * returns: nothing
+ */
+template <typename T>
+inline void reversal_store(const T* tile, T* out, std::size_t rc, const ReversalShape& s) noexcept
+{
+	const int high = s.log2n - s.b;
+	for(std::size_t d = 0; d < s.B; ++d)
+	{
+		T* row = out + ((s.rev[d] << high) | (rc << s.b));
+		const T* col = tile + d;
+		for(std::size_t a = 0; a < s.B; ++a)
+			row[a] = col[a * s.B];
+	}
+}
+
+/* name: reversal_middles
+ * desc: splits the 2^mid middles over threads, f(c_begin, c_end, tile)
+ * with a tile of 'tiles' * B * B elements per thread
+ * returns: nothing
+ */
+template <typename T, typename F>
+void reversal_middles(const ReversalShape& s, unsigned threads, int tiles, F f) noexcept
+{
+	const std::size_t middles = std::size_t(1) << s.mid;
+	threads = thread_count(threads, middles);
+
+	const std::size_t per = (middles + threads - 1) / threads;
+	run_threads(threads, [&](unsigned t) {
+		std::vector<T> tile(static_cast<std::size_t>(tiles) * s.B * s.B);
+		const std::size_t begin = std::min(middles, t * per);
+		f(begin, std::min(middles, begin + per), tile.data());
+	});
+}
+
+/* walks the output middles in order, the reads take the jumps: rows
+ * written next to the last tile's rows run about twice as fast, reads
+ * barely care */
+template <typename T>
+void reversal_tiled(const T* in, T* out, int log2n, unsigned threads) noexcept
+{
+	const ReversalShape s(log2n, sizeof(T));
+	reversal_middles<T>(s, threads, 1, [&](std::size_t begin, std::size_t end, T* tile) {
+		if(begin == end)
+			return;
+		std::size_t rc = reversal_of(begin, s.mid);
+		for(std::size_t c = begin; c < end; ++c)
+		{
+			reversal_load(in, tile, rc, s);
+			reversal_store(tile, out, c, s);
+			if(s.mid && c + 1 < end)
+				rc = reversal_next(rc, s.mid);
+		}
+	});
+}
+
+/* the middles c and rev c swap places, each pair is done by the owner
+ * of the smaller one */
+template <typename T>
+void reversal_tiled(T* data, int log2n, unsigned threads) noexcept
+{
+	const ReversalShape s(log2n, sizeof(T));
+	reversal_middles<T>(s, threads, 2, [&](std::size_t begin, std::size_t end, T* tile) {
+		if(begin == end)
+			return;
+		T* other = tile + s.B * s.B;
+		std::size_t rc = reversal_of(begin, s.mid);
+		for(std::size_t c = begin; c < end; ++c)
+		{
+			if(c == rc)
+			{
+				reversal_load(data, tile, c, s);
+				reversal_store(tile, data, c, s);
+			}
+			else if(c < rc)
+			{
+				reversal_load(data, tile, c, s);
+				reversal_load(data, other, rc, s);
+				reversal_store(tile, data, rc, s);
+				reversal_store(other, data, c, s);
+			}
+			if(s.mid && c + 1 < end)
+				rc = reversal_next(rc, s.mid);
+		}
+	});
+}
+
+}
+
+/* name: bit_reverse_index
+ * desc: the low log2n bits of i reversed
+ * returns: index
+ */
+inline std::size_t bit_reverse_index(std::size_t i, int log2n) noexcept
+{
+	return detail::reversal_of(i, log2n);
+}
+
+/* name: bit_reverse_permute
+ * desc: out[reverse(i)] = in[i] for a 2^log2n array, on up to 'threads'
+ * threads (0 for one per core), in and out must not overlap
+ * returns: nothing
+ */
+template <typename T>
+void bit_reverse_permute(const T* in, T* out, int log2n, unsigned threads = 1) noexcept
+{
+	static_assert(std::is_trivially_copyable<T>::value, "bit_reverse_permute moves trivially copyable elements");
+	if(log2n < 0 || log2n >= static_cast<int>(sizeof(std::size_t) * BIT_SIZE))
+		return;
+	if(log2n < detail::REVERSAL_MIN_LOG)
+		detail::reversal_simple(in, out, log2n);
+	else
+		detail::reversal_tiled(in, out, log2n, threads);
+}
+
+/* name: bit_reverse_permute
+ * desc: the same permutation in place, swapping i and reverse(i)
+ * returns: nothing
+ */
+template <typename T>
+void bit_reverse_permute(T* data, int log2n, unsigned threads = 1) noexcept
+{
+	static_assert(std::is_trivially_copyable<T>::value, "bit_reverse_permute moves trivially copyable elements");
+	if(log2n < 0 || log2n >= static_cast<int>(sizeof(std::size_t) * BIT_SIZE))
+		return;
+	if(log2n < detail::REVERSAL_MIN_LOG)
+		detail::reversal_simple(data, log2n);
+	else
+		detail::reversal_tiled(data, log2n, threads);
+}
+
+}
+
+
+#endif
@@ -0,0 +1,417 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_span.hpp
+ * purpose: non-owning bit views over caller memory
+ */
+
+
+#ifndef BITTLE_BIT_SPAN_HPP
+#define BITTLE_BIT_SPAN_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace bittle {
+
+/* namespace: bittle
+ * BasicBitSpan looks at a run of bits inside a byte buffer it does not
+ * own. Bit i of the span is bit (offset + i) % 8 of byte (offset + i) / 8,
+ * so on a little endian machine a span over a T array numbers its bits
+ * the same way Bits<T> does. The 'Msb' accessors use network order
+ * instead (bit 0 is the top bit of the first byte) for packet headers.
+ *
+ * Fields of up to 64 bits are read and written with one unaligned
+ * 8 byte access, plus one extra byte when the field straddles it. Only
+ * near the end of the buffer do the accessors fall back to bytes, so as
+ * long as every field stays inside the span (pos + n <= size()) nothing
+ * outside [data, data + bytes()) is ever touched. Writes are
+ * read-modify-write of whole bytes and are not atomic.
+ */
+
+template <typename Byte>
+class BasicBitSpan
+{
+	static_assert(std::is_same<typename std::remove_const<Byte>::type, uint8_t>::value,
+	              "BasicBitSpan is a view over uint8_t or const uint8_t");
+
+	static constexpr bool is_const = std::is_const<Byte>::value;
+
+	using void_type = typename std::conditional<is_const, const void, void>::type;
+
+	public:
+
+		static constexpr std::size_t npos = ~std::size_t(0);
+
+		/* Empty span */
+		constexpr BasicBitSpan() noexcept = default;
+
+		/* ctor over 'bits' bits of 'data' starting 'offset' bits in */
+		BasicBitSpan(void_type* data, std::size_t bits, std::size_t offset = 0) noexcept
+			: base(static_cast<Byte*>(data) + offset / BIT_SIZE),
+			  shift(static_cast<unsigned>(offset % BIT_SIZE)), nbits(bits)
+		{
+		}
+
+		/* ctor over an array of Bits, e.g. as_bits(words) */
+		template <typename T>
+		BasicBitSpan(Bits<T>* words, std::size_t count) noexcept
+			: BasicBitSpan(static_cast<void_type*>(words), count * sizeof(T) * BIT_SIZE)
+		{
+		}
+
+		template <typename T>
+		BasicBitSpan(const Bits<T>* words, std::size_t count) noexcept
+			: BasicBitSpan(static_cast<void_type*>(words), count * sizeof(T) * BIT_SIZE)
+		{
+		}
+
+		/* Mutable spans convert to const ones */
+		template <typename B = Byte, typename = typename std::enable_if<std::is_const<B>::value>::type>
+		BasicBitSpan(const BasicBitSpan<uint8_t>& other) noexcept
+			: base(other.data()), shift(other.offset()), nbits(other.size())
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		std::size_t size() const noexcept
+		{
+			return this->nbits;
+		}
+
+		bool empty() const noexcept
+		{
+			return this->nbits == 0;
+		}
+
+		/* name: data
+		 * desc: first byte touched by the span
+		 * returns: pointer
+		 */
+		Byte* data() const noexcept
+		{
+			return this->base;
+		}
+
+		/* name: offset
+		 * desc: bit offset of bit 0 inside data()[0]
+		 * returns: 0 - 7
+		 */
+		unsigned offset() const noexcept
+		{
+			return this->shift;
+		}
+
+		/* name: bytes
+		 * desc: number of bytes the span touches
+		 * returns: byte count
+		 */
+		std::size_t bytes() const noexcept
+		{
+			return (this->shift + this->nbits + BIT_SIZE - 1) / BIT_SIZE;
+		}
+
+		/* name: test
+		 * desc: reads bit 'pos'
+		 * returns: bool
+		 */
+		bool test(std::size_t pos) const noexcept
+		{
+			const std::size_t b = this->shift + pos;
+			return (this->base[b / BIT_SIZE] >> (b % BIT_SIZE)) & 1;
+		}
+
+		/* name: get
+		 * desc: reads the n (0 - 64) bit field starting at bit 'pos'
+		 * returns: field, bit 0 of the result is bit 'pos'
+		 */
+		uint64_t get(std::size_t pos, unsigned n) const noexcept
+		{
+			if(n == 0)
+				return 0;
+			const std::size_t b = this->shift + pos;
+			const std::size_t i = b / BIT_SIZE;
+			const unsigned s = static_cast<unsigned>(b % BIT_SIZE);
+
+			uint64_t w = load(i) >> s;
+			if(s + n > 64)
+				w |= static_cast<uint64_t>(this->base[i + 8]) << (64 - s);
+			return n == 64 ? w : (w & ((uint64_t(1) << n) - 1));
+		}
+
+		/* name: getMsb
+		 * desc: reads the n bit field at 'pos' in network bit order
+		 * returns: field, the first bit is the most significant
+		 */
+		uint64_t getMsb(std::size_t pos, unsigned n) const noexcept
+		{
+			if(n == 0)
+				return 0;
+			const std::size_t b = this->shift + pos;
+			const std::size_t i = b / BIT_SIZE;
+			const unsigned s = static_cast<unsigned>(b % BIT_SIZE);
+
+			uint64_t w = __builtin_bswap64(load(i)) << s;
+			if(s + n > 64)
+				w |= static_cast<uint64_t>(this->base[i + 8]) >> (BIT_SIZE - s);
+			return w >> (64 - n);
+		}
+
+		/* name: field
+		 * desc: reads a T wide field at 'pos' as a Bits object
+		 * returns: Bits<T>
+		 */
+		template <typename T>
+		Bits<T> field(std::size_t pos) const noexcept
+		{
+			return Bits<T>(static_cast<T>(get(pos, sizeof(T) * BIT_SIZE)));
+		}
+
+		/* name: subspan
+		 * desc: the 'count' bits starting at 'pos', npos means to the end
+		 * returns: new span over the same memory
+		 */
+		BasicBitSpan subspan(std::size_t pos, std::size_t count = npos) const noexcept
+		{
+			const std::size_t b = this->shift + pos;
+			BasicBitSpan s;
+			s.base = this->base + b / BIT_SIZE;
+			s.shift = static_cast<unsigned>(b % BIT_SIZE);
+			s.nbits = count == npos ? this->nbits - pos : count;
+			return s;
+		}
+
+		/* name: count
+		 * desc: counts the set bits
+		 * returns: set bit count
+		 */
+		std::size_t count() const noexcept
+		{
+			BITTLE_PROFILE_KERNEL(span_count);
+			std::size_t cnt = 0;
+			std::size_t p = 0;
+
+			/* up to the first byte boundary, then whole 8 byte words so the
+			 * bounds are visible to the compiler, then the tail */
+			if(this->shift && this->nbits)
+			{
+				p = this->nbits < BIT_SIZE - this->shift ? this->nbits : BIT_SIZE - this->shift;
+				cnt += bittle::count_ones<uint64_t>(get(0, static_cast<unsigned>(p)));
+			}
+			const Byte* bytes = this->base + (this->shift ? 1 : 0);
+			const std::size_t whole = (this->nbits - p) / BIT_SIZE;
+			std::size_t i = 0;
+			for(; i + 8 <= whole; i += 8)
+			{
+				uint64_t w;
+				std::memcpy(&w, bytes + i, 8);
+				cnt += bittle::count_ones<uint64_t>(w);
+			}
+			for(p += i * BIT_SIZE; p < this->nbits; p += 64)
+			{
+				const unsigned n = this->nbits - p < 64 ? static_cast<unsigned>(this->nbits - p) : 64;
+				cnt += bittle::count_ones<uint64_t>(get(p, n));
+			}
+			return cnt;
+		}
+
+		/* name: findFirst
+		 * desc: position of the first set bit
+		 * returns: position or npos
+		 */
+		std::size_t findFirst() const noexcept
+		{
+			return findNext(0);
+		}
+
+		/* name: findNext
+		 * desc: position of the first set bit at or after 'pos'
+		 * returns: position or npos
+		 */
+		std::size_t findNext(std::size_t pos) const noexcept
+		{
+			return scan<false>(pos);
+		}
+
+		/* name: findFirstZero
+		 * desc: position of the first clear bit
+		 * returns: position or npos
+		 */
+		std::size_t findFirstZero() const noexcept
+		{
+			return scan<true>(0);
+		}
+
+		/* name: findNextZero
+		 * desc: position of the first clear bit at or after 'pos'
+		 * returns: position or npos
+		 */
+		std::size_t findNextZero(std::size_t pos) const noexcept
+		{
+			return scan<true>(pos);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: set
+		 * desc: writes the low n (0 - 64) bits of v at bit 'pos'
+		 * returns: *this
+		 */
+		const BasicBitSpan& set(std::size_t pos, unsigned n, uint64_t v) const noexcept
+		{
+			static_assert(!is_const, "Cannot write through a const bit span");
+			if(n == 0)
+				return *this;
+			const std::size_t b = this->shift + pos;
+			const std::size_t i = b / BIT_SIZE;
+			const unsigned s = static_cast<unsigned>(b % BIT_SIZE);
+			const uint64_t m = n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1);
+			v &= m;
+
+			store(i, (load(i) & ~(m << s)) | (v << s));
+			if(s + n > 64)
+			{
+				const uint8_t hm = static_cast<uint8_t>(m >> (64 - s));
+				this->base[i + 8] = static_cast<uint8_t>((this->base[i + 8] & ~hm) | (v >> (64 - s)));
+			}
+			return *this;
+		}
+
+		/* name: setMsb
+		 * desc: writes the low n bits of v at 'pos' in network bit order
+		 * returns: *this
+		 */
+		const BasicBitSpan& setMsb(std::size_t pos, unsigned n, uint64_t v) const noexcept
+		{
+			static_assert(!is_const, "Cannot write through a const bit span");
+			if(n == 0)
+				return *this;
+			const std::size_t b = this->shift + pos;
+			const std::size_t i = b / BIT_SIZE;
+			const unsigned s = static_cast<unsigned>(b % BIT_SIZE);
+			const uint64_t m = (n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1)) << (64 - n);
+			v = n == 64 ? v : (v << (64 - n));
+
+			const uint64_t w = __builtin_bswap64(load(i));
+			store(i, __builtin_bswap64((w & ~(m >> s)) | ((v & m) >> s)));
+			if(s + n > 64)
+			{
+				/* the low s bits shifted out above belong to the top of the next byte */
+				const uint8_t hm = static_cast<uint8_t>(m << (BIT_SIZE - s));
+				this->base[i + 8] = static_cast<uint8_t>((this->base[i + 8] & ~hm) |
+				                                         (static_cast<uint8_t>(v << (BIT_SIZE - s)) & hm));
+			}
+			return *this;
+		}
+
+		/* name: setBit
+		 * desc: sets or clears bit 'pos'
+		 * returns: *this
+		 */
+		const BasicBitSpan& setBit(std::size_t pos, bool v = true) const noexcept
+		{
+			static_assert(!is_const, "Cannot write through a const bit span");
+			const std::size_t b = this->shift + pos;
+			const uint8_t m = static_cast<uint8_t>(1u << (b % BIT_SIZE));
+			Byte& byte = this->base[b / BIT_SIZE];
+			byte = static_cast<uint8_t>(v ? (byte | m) : (byte & ~m));
+			return *this;
+		}
+
+		/* name: flipBit
+		 * desc: flips bit 'pos'
+		 * returns: *this
+		 */
+		const BasicBitSpan& flipBit(std::size_t pos) const noexcept
+		{
+			static_assert(!is_const, "Cannot write through a const bit span");
+			const std::size_t b = this->shift + pos;
+			this->base[b / BIT_SIZE] ^= static_cast<uint8_t>(1u << (b % BIT_SIZE));
+			return *this;
+		}
+
+		/* name: setField
+		 * desc: writes a Bits object as a T wide field at 'pos'
+		 * returns: *this
+		 */
+		template <typename T>
+		const BasicBitSpan& setField(std::size_t pos, const Bits<T>& b) const noexcept
+		{
+			using U = typename std::make_unsigned<T>::type;
+			return set(pos, sizeof(T) * BIT_SIZE, static_cast<U>(b.value()));
+		}
+
+
+	private:
+
+		/* name: load
+		 * desc: little endian 8 byte load at byte i, clipped to the span
+		 * returns: word
+		 */
+		uint64_t load(std::size_t i) const noexcept
+		{
+			uint64_t w = 0;
+			const std::size_t end = bytes();
+			if(i + 8 <= end)
+				std::memcpy(&w, this->base + i, 8);
+			else if(i < end)
+				std::memcpy(&w, this->base + i, end - i);
+			return w;
+		}
+
+		void store(std::size_t i, uint64_t w) const noexcept
+		{
+			const std::size_t end = bytes();
+			if(i + 8 <= end)
+				std::memcpy(this->base + i, &w, 8);
+			else if(i < end)
+				std::memcpy(this->base + i, &w, end - i);
+		}
+
+		template <bool Zero>
+		std::size_t scan(std::size_t pos) const noexcept
+		{
+			for(std::size_t p = pos; p < this->nbits; p += 64)
+			{
+				const unsigned n = this->nbits - p < 64 ? static_cast<unsigned>(this->nbits - p) : 64;
+				uint64_t w = get(p, n);
+				if(Zero)
+					w = ~w & (n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1));
+				if(w)
+					return p + static_cast<std::size_t>(bittle::count_trailing_zeroes<uint64_t>(w));
+			}
+			return npos;
+		}
+
+		Byte* base = nullptr;
+		unsigned shift = 0;
+		std::size_t nbits = 0;
+
+};
+
+template <typename Byte>
+constexpr std::size_t BasicBitSpan<Byte>::npos;
+
+/* Declarations for ease of use */
+using BitSpan = BasicBitSpan<uint8_t>;
+using ConstBitSpan = BasicBitSpan<const uint8_t>;
+
+}
+
+
+#endif
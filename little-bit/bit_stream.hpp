@@ -0,0 +1,310 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_stream.hpp
+ * purpose: msb first bit writer and reader over byte buffers
+ */
+
+
+#ifndef BITTLE_BIT_STREAM_HPP
+#define BITTLE_BIT_STREAM_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Bits go out most significant first, the first bit written being the
+ * top bit of byte 0, so a stream reads the same in a hex dump as on
+ * paper. BitWriter gathers bits in a 64 bit accumulator and stores whole
+ * words; BitReader keeps a left aligned 64 bit window it refills with one
+ * unaligned 8 byte load, so at least 56 bits can be peeked at any time.
+ *
+ * The reader never touches memory past the end it was given: near the end
+ * it refills a byte at a time and then shifts in zeros, and overrun()
+ * tells whether any of those zeros were consumed.
+ */
+
+namespace detail {
+
+inline uint64_t load_be64(const uint8_t* p) noexcept
+{
+	uint64_t w;
+	std::memcpy(&w, p, sizeof(w));
+	return Bits<uint64_t>::isLittleEndian() ? __builtin_bswap64(w) : w;
+}
+
+}
+
+class BitWriter
+{
+	public:
+
+		BitWriter() = default;
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: bits
+		 * desc: bits written so far
+		 * returns: bit count
+		 */
+		std::size_t bits() const noexcept
+		{
+			return this->out.size() * BIT_SIZE + static_cast<std::size_t>(this->pending);
+		}
+
+		/* name: bytes
+		 * desc: copy of the stream so far, zero padded to a byte
+		 * returns: byte vector
+		 */
+		std::vector<uint8_t> bytes() const
+		{
+			std::vector<uint8_t> copy(this->out);
+			for(int s = 56; s > 56 - this->pending; s -= BIT_SIZE)
+				copy.push_back(static_cast<uint8_t>(this->acc >> s));
+			return copy;
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: write
+		 * desc: appends the low n (0 - 64) bits of v, top one first
+		 * returns: *this
+		 */
+		BitWriter& write(uint64_t v, int n)
+		{
+			if(n == 0)
+				return *this;
+			if(n < 64)
+				v &= (uint64_t(1) << n) - 1;
+
+			const int room = 64 - this->pending;
+			if(n < room)
+			{
+				this->acc |= v << (room - n);
+				this->pending += n;
+				return *this;
+			}
+
+			/* fill the accumulator, store it, keep the rest */
+			const int rest = n - room;
+			this->acc |= v >> rest;
+			this->store(this->acc);
+			this->acc = rest ? v << (64 - rest) : 0;
+			this->pending = rest;
+			return *this;
+		}
+
+		/* name: writeBit
+		 * desc: appends one bit
+		 * returns: *this
+		 */
+		BitWriter& writeBit(bool b)
+		{
+			return this->write(b ? 1 : 0, 1);
+		}
+
+		/* name: finish
+		 * desc: pads the last byte with zeros, no writes may follow
+		 * until reset()
+		 * returns: the stream
+		 */
+		const std::vector<uint8_t>& finish()
+		{
+			for(; this->pending > 0; this->pending -= BIT_SIZE, this->acc <<= BIT_SIZE)
+				this->out.push_back(static_cast<uint8_t>(this->acc >> 56));
+			this->pending = 0;
+			this->acc = 0;
+			return this->out;
+		}
+
+		/* name: reset
+		 * desc: empties the stream, keeping its memory
+		 * returns: nothing
+		 */
+		void reset() noexcept
+		{
+			this->out.clear();
+			this->acc = 0;
+			this->pending = 0;
+		}
+
+
+	private:
+
+		void store(uint64_t w)
+		{
+			const std::size_t at = this->out.size();
+			this->out.resize(at + 8);
+			if(Bits<uint64_t>::isLittleEndian())
+				w = __builtin_bswap64(w);
+			std::memcpy(this->out.data() + at, &w, sizeof(w));
+		}
+
+		std::vector<uint8_t> out;
+		uint64_t acc = 0;   /* pending bits, left aligned */
+		int pending = 0;
+};
+
+class BitReader
+{
+	public:
+
+		BitReader() noexcept = default;
+
+		/* ctor over 'bytes' bytes of 'data' */
+		BitReader(const uint8_t* data, std::size_t bytes) noexcept
+			: data(data), end(bytes)
+		{
+			this->refill();
+		}
+
+		BitReader(const std::vector<uint8_t>& v) noexcept
+			: BitReader(v.data(), v.size())
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: position
+		 * desc: bits consumed so far
+		 * returns: bit count
+		 */
+		std::size_t position() const noexcept
+		{
+			return this->next * BIT_SIZE - static_cast<std::size_t>(this->count);
+		}
+
+		/* name: overrun
+		 * desc: whether reads went past the end of the data
+		 * returns: bool
+		 */
+		bool overrun() const noexcept
+		{
+			return this->position() > this->end * BIT_SIZE;
+		}
+
+		/* name: window
+		 * desc: the next 56 or more bits, left aligned, after refill()
+		 * returns: window
+		 */
+		uint64_t window() const noexcept
+		{
+			return this->buf;
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: refill
+		 * desc: tops the window up to at least 56 bits
+		 * returns: nothing
+		 */
+		void refill() noexcept
+		{
+			if(this->count > 56)
+				return;
+			if(this->next + 8 <= this->end)
+			{
+				this->buf |= detail::load_be64(this->data + this->next) >> this->count;
+				this->next += static_cast<std::size_t>(63 - this->count) >> 3;
+				this->count |= 56;
+				return;
+			}
+			while(this->count <= 56)
+			{
+				if(this->next < this->end)
+					this->buf |= static_cast<uint64_t>(this->data[this->next]) << (56 - this->count);
+				++this->next;
+				this->count += BIT_SIZE;
+			}
+		}
+
+		/* name: peek
+		 * desc: the next n (1 - 56) bits without consuming them
+		 * returns: bits, right aligned
+		 */
+		uint64_t peek(int n) noexcept
+		{
+			this->refill();
+			return this->buf >> (64 - n);
+		}
+
+		/* name: skip
+		 * desc: consumes n bits, no more than were refilled
+		 * returns: nothing
+		 */
+		void skip(int n) noexcept
+		{
+			this->buf = n < 64 ? this->buf << n : 0;
+			this->count -= n;
+		}
+
+		/* name: read
+		 * desc: consumes the next n (0 - 64) bits
+		 * returns: bits, right aligned
+		 */
+		uint64_t read(int n) noexcept
+		{
+			if(n == 0)
+				return 0;
+			if(n > 56)
+			{
+				const uint64_t hi = this->read(n - 32);
+				return (hi << 32) | this->read(32);
+			}
+			const uint64_t v = this->peek(n);
+			this->skip(n);
+			return v;
+		}
+
+		/* name: readBit
+		 * desc: consumes one bit
+		 * returns: bool
+		 */
+		bool readBit() noexcept
+		{
+			return this->read(1) != 0;
+		}
+
+
+	private:
+
+		const uint8_t* data = nullptr;
+		std::size_t end = 0;        /* bytes */
+		std::size_t next = 0;       /* next byte to load, past end once zeros come in */
+		uint64_t buf = 0;           /* window, left aligned */
+		int count = 0;              /* valid bits in buf */
+};
+
+}
+
+
+#endif
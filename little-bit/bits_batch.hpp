@@ -0,0 +1,1550 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bits_batch.hpp
+ * purpose: lane parallel Bits over N values with vector kernels
+ */
+
+
+#ifndef BITTLE_BITS_BATCH_HPP
+#define BITTLE_BITS_BATCH_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/* same as dispatch.hpp, gcc's avx512 headers trip -Wuninitialized */
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * BitsBatch<T, N> is N Bits<T> side by side, stored as one array of
+ * lanes, and every Bits method works on all of them at once:
+ *
+ *     BitsBatch<uint32_t, 512> b(in);     load 512 values
+ *     b.reverseBits().rotateLeft(3);
+ *     b.ones().store(counts);             per lane popcounts
+ *
+ * Each method is one pass of a vector kernel over the lanes, picked once
+ * per process from what the cpu has: AVX-512BW, AVX2 or SSE4.2 (pshufb
+ * nibble tables for popcount and bit reversal, smear and popcount for the
+ * zero counts), plain loops otherwise. Division, modulo, and lane by lane
+ * shifts where the cpu has no such shift (8 bit lanes, 16 bit below
+ * AVX-512, everything on SSE) stay scalar. A method costs one call, so
+ * it pays to make batches a few hundred lanes or a couple of KB; the
+ * lanes are copied in and out as wide as the kernels read them.
+ *
+ * Counting methods return a batch of counts, checkBit a batch of 0 / 1.
+ * Semantics are what Bits means rather than what its helpers do today:
+ * bit numbers run 1 - width and anything else is a no-op (or 0), shifts
+ * of the width or more give 0, rotates are taken mod the width. Lanes are
+ * unsigned; the signed type of the same size has the same bits.
+ *
+ * transform_batches runs a function over an array N values at a time, the
+ * last short batch zero padded, for bulk work over plain arrays.
+ */
+
+namespace detail {
+
+enum class BatchUnary
+{
+	invert,
+	negate,
+	reverse_bits,
+	reverse_bytes,
+	ones,
+	zeroes,
+	leading_zeroes,
+	trailing_zeroes
+};
+
+enum class BatchBinary
+{
+	and_op,
+	or_op,
+	xor_op,
+	add_op,
+	sub_op,
+	mul_op,
+	div_op,
+	mod_op,
+	shl_op,
+	shr_op,
+	rotl_op,
+	rotr_op,
+	hamming_op
+};
+
+enum class BatchIsa
+{
+	scalar,
+	sse,
+	avx2,
+	avx512
+};
+
+/* lanes narrower than unsigned do their arithmetic in unsigned, so
+ * nothing is promoted to a signed int that can overflow */
+template <typename T>
+using batch_wide = typename std::conditional<(sizeof(T) < sizeof(unsigned)), unsigned, T>::type;
+
+/* pshufb tables, bytes 0 - 7 in lo and 8 - 15 in hi */
+constexpr uint64_t BATCH_POPCOUNT_LO = 0x0302020102010100ULL;
+constexpr uint64_t BATCH_POPCOUNT_HI = 0x0403030203020201ULL;
+constexpr uint64_t BATCH_REVERSE_LO = 0x0E060A020C040800ULL;  /* nibble reversed */
+constexpr uint64_t BATCH_REVERSE_HI = 0x0F070B030D050901ULL;
+
+/* name: batch_bswap_lo
+ * desc: pshufb control reversing every sizeof(T) byte group, the high
+ * eight bytes being these plus 8
+ * returns: low eight control bytes
+ */
+template <typename T>
+constexpr uint64_t batch_bswap_lo() noexcept
+{
+	return sizeof(T) == 2 ? 0x0607040502030001ULL :
+	       sizeof(T) == 4 ? 0x0405060700010203ULL : 0x0001020304050607ULL;
+}
+
+/* name: batch_vector
+ * desc: whether the vector kernels of 'isa' do op on 'size' byte lanes,
+ * the rest go to the scalar loop
+ * returns: bool
+ */
+constexpr bool batch_vector(BatchIsa isa, std::size_t size, BatchBinary op, bool broadcast) noexcept
+{
+	return op == BatchBinary::div_op || op == BatchBinary::mod_op ? false :
+	       broadcast || (op != BatchBinary::shl_op && op != BatchBinary::shr_op &&
+	                     op != BatchBinary::rotl_op && op != BatchBinary::rotr_op) ? true :
+	       isa == BatchIsa::avx512 ? size >= 2 :
+	       isa == BatchIsa::avx2 ? size >= 4 : false;
+}
+
+/* Scalar lanes, also the tails of the vector kernels */
+
+template <typename T>
+inline T batch_reverse_bits(T x) noexcept
+{
+	uint64_t v = __builtin_bswap64(static_cast<uint64_t>(x));
+	v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+	v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+	return static_cast<T>(v >> (64 - sizeof(T) * BIT_SIZE));
+}
+
+template <typename T>
+inline T batch_reverse_bytes(T x) noexcept
+{
+	return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(x)) >> (64 - sizeof(T) * BIT_SIZE));
+}
+
+template <typename T, BatchUnary Op>
+inline T batch_lane(T x) noexcept
+{
+	using P = batch_wide<T>;
+	switch(Op)
+	{
+		case BatchUnary::invert: return static_cast<T>(~P(x));
+		case BatchUnary::negate: return static_cast<T>(P(0) - P(x));
+		case BatchUnary::reverse_bits: return batch_reverse_bits<T>(x);
+		case BatchUnary::reverse_bytes: return batch_reverse_bytes<T>(x);
+		case BatchUnary::ones: return static_cast<T>(count_ones<T>(x));
+		case BatchUnary::zeroes: return static_cast<T>(count_zeroes<T>(x));
+		case BatchUnary::leading_zeroes: return static_cast<T>(count_leading_zeroes<T>(x));
+		default: return static_cast<T>(count_trailing_zeroes<T>(x));
+	}
+}
+
+template <typename T, BatchBinary Op>
+inline T batch_lane(T a, T b) noexcept
+{
+	using P = batch_wide<T>;
+	constexpr unsigned w = sizeof(T) * BIT_SIZE;
+	switch(Op)
+	{
+		case BatchBinary::and_op: return static_cast<T>(a & b);
+		case BatchBinary::or_op: return static_cast<T>(a | b);
+		case BatchBinary::xor_op: return static_cast<T>(a ^ b);
+		case BatchBinary::add_op: return static_cast<T>(P(a) + P(b));
+		case BatchBinary::sub_op: return static_cast<T>(P(a) - P(b));
+		case BatchBinary::mul_op: return static_cast<T>(P(a) * P(b));
+		case BatchBinary::div_op: return static_cast<T>(P(a) / P(b));
+		case BatchBinary::mod_op: return static_cast<T>(P(a) % P(b));
+		case BatchBinary::shl_op: return b >= w ? T(0) : static_cast<T>(P(a) << b);
+		case BatchBinary::shr_op: return b >= w ? T(0) : static_cast<T>(P(a) >> b);
+		case BatchBinary::rotl_op: return rotl<T>(a, static_cast<int>(b & (w - 1)));
+		case BatchBinary::rotr_op: return rotr<T>(a, static_cast<int>(b & (w - 1)));
+		default: return static_cast<T>(count_ones<T>(static_cast<T>(a ^ b)));
+	}
+}
+
+template <typename T, BatchUnary Op>
+inline void batch_unary_scalar(const T* in, T* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = batch_lane<T, Op>(in[i]);
+}
+
+/* b is n lanes, or one value when Broadcast; out may equal a or b */
+template <typename T, BatchBinary Op, bool Broadcast>
+inline void batch_binary_scalar(const T* a, const T* b, T* out, std::size_t n) noexcept
+{
+	const T c = Broadcast ? b[0] : T(0);
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = batch_lane<T, Op>(a[i], Broadcast ? c : b[i]);
+}
+
+#if defined(BITTLE_X86)
+
+/* SSE4.2, 16 bytes at a time */
+
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_table_sse(uint64_t lo, uint64_t hi) noexcept
+{
+	return _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+}
+
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_set1_sse(T v) noexcept
+{
+	return sizeof(T) == 1 ? _mm_set1_epi8(static_cast<char>(v)) :
+	       sizeof(T) == 2 ? _mm_set1_epi16(static_cast<short>(v)) :
+	       sizeof(T) == 4 ? _mm_set1_epi32(static_cast<int>(v)) :
+	                        _mm_set1_epi64x(static_cast<long long>(v));
+}
+
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_add_sse(__m128i a, __m128i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm_add_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm_add_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm_add_epi32(a, b) : _mm_add_epi64(a, b);
+}
+
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_sub_sse(__m128i a, __m128i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm_sub_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm_sub_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm_sub_epi32(a, b) : _mm_sub_epi64(a, b);
+}
+
+/* bytes multiply as even and odd halves of 16 bit lanes, 64 bit lanes as
+ * lo * lo plus the two cross products shifted up */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_mul_sse(__m128i a, __m128i b) noexcept
+{
+	if(sizeof(T) == 1)
+	{
+		const __m128i even = _mm_and_si128(_mm_mullo_epi16(a, b), _mm_set1_epi16(0xFF));
+		const __m128i odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+		return _mm_or_si128(even, _mm_slli_epi16(odd, 8));
+	}
+	if(sizeof(T) == 2)
+		return _mm_mullo_epi16(a, b);
+	if(sizeof(T) == 4)
+		return _mm_mullo_epi32(a, b);
+	const __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+	                                    _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+	return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(cross, 32));
+}
+
+/* every lane by the same count, the width or more giving 0 */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_shl_sse(__m128i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm_and_si128(_mm_sll_epi16(x, n),
+	                                      _mm_set1_epi8(static_cast<char>(c < 8 ? 0xFF << c : 0))) :
+	       sizeof(T) == 2 ? _mm_sll_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm_sll_epi32(x, n) : _mm_sll_epi64(x, n);
+}
+
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_shr_sse(__m128i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm_and_si128(_mm_srl_epi16(x, n),
+	                                      _mm_set1_epi8(static_cast<char>(c < 8 ? 0xFF >> c : 0))) :
+	       sizeof(T) == 2 ? _mm_srl_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm_srl_epi32(x, n) : _mm_srl_epi64(x, n);
+}
+
+/* nibble lookups per byte, then summed up to the lane width */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_popcount_sse(__m128i x) noexcept
+{
+	const __m128i lut = batch_table_sse(BATCH_POPCOUNT_LO, BATCH_POPCOUNT_HI);
+	const __m128i low = _mm_set1_epi8(0x0F);
+	const __m128i c = _mm_add_epi8(_mm_shuffle_epi8(lut, _mm_and_si128(x, low)),
+	                               _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), low)));
+	if(sizeof(T) == 1)
+		return c;
+	if(sizeof(T) == 8)
+		return _mm_sad_epu8(c, _mm_setzero_si128());
+	const __m128i c16 = _mm_maddubs_epi16(c, _mm_set1_epi8(1));
+	return sizeof(T) == 2 ? c16 : _mm_madd_epi16(c16, _mm_set1_epi16(1));
+}
+
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_reverse_bytes_sse(__m128i x) noexcept
+{
+	if(sizeof(T) == 1)
+		return x;
+	return _mm_shuffle_epi8(x, batch_table_sse(batch_bswap_lo<T>(), batch_bswap_lo<T>() + 0x0808080808080808ULL));
+}
+
+/* byte order first, then each byte's nibbles looked up reversed and
+ * swapped */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_reverse_bits_sse(__m128i x) noexcept
+{
+	const __m128i rev = batch_table_sse(BATCH_REVERSE_LO, BATCH_REVERSE_HI);
+	const __m128i rev_high = batch_table_sse(BATCH_REVERSE_LO << 4, BATCH_REVERSE_HI << 4);
+	const __m128i low = _mm_set1_epi8(0x0F);
+	x = batch_reverse_bytes_sse<T>(x);
+	return _mm_or_si128(_mm_shuffle_epi8(rev_high, _mm_and_si128(x, low)),
+	                    _mm_shuffle_epi8(rev, _mm_and_si128(_mm_srli_epi16(x, 4), low)));
+}
+
+/* everything below the top set bit smeared to one, the rest counted */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_leading_zeroes_sse(__m128i x) noexcept
+{
+	x = _mm_or_si128(x, batch_shr_sse<T>(x, 1));
+	x = _mm_or_si128(x, batch_shr_sse<T>(x, 2));
+	x = _mm_or_si128(x, batch_shr_sse<T>(x, 4));
+	if(sizeof(T) >= 2)
+		x = _mm_or_si128(x, batch_shr_sse<T>(x, 8));
+	if(sizeof(T) >= 4)
+		x = _mm_or_si128(x, batch_shr_sse<T>(x, 16));
+	if(sizeof(T) == 8)
+		x = _mm_or_si128(x, batch_shr_sse<T>(x, 32));
+	return batch_popcount_sse<T>(_mm_xor_si128(x, _mm_set1_epi32(-1)));
+}
+
+/* the ones below the lowest set bit, (x - 1) & ~x */
+template <typename T>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_trailing_zeroes_sse(__m128i x) noexcept
+{
+	return batch_popcount_sse<T>(_mm_andnot_si128(x, batch_add_sse<T>(x, _mm_set1_epi32(-1))));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_unary_op_sse(__m128i x) noexcept
+{
+	const __m128i all = _mm_set1_epi32(-1);
+	return Op == BatchUnary::invert ? _mm_xor_si128(x, all) :
+	       Op == BatchUnary::negate ? batch_sub_sse<T>(_mm_setzero_si128(), x) :
+	       Op == BatchUnary::reverse_bits ? batch_reverse_bits_sse<T>(x) :
+	       Op == BatchUnary::reverse_bytes ? batch_reverse_bytes_sse<T>(x) :
+	       Op == BatchUnary::ones ? batch_popcount_sse<T>(x) :
+	       Op == BatchUnary::zeroes ? batch_popcount_sse<T>(_mm_xor_si128(x, all)) :
+	       Op == BatchUnary::leading_zeroes ? batch_leading_zeroes_sse<T>(x) :
+	                                          batch_trailing_zeroes_sse<T>(x);
+}
+
+/* shifts and rotates only come here with the one count c */
+template <typename T, BatchBinary Op>
+BITTLE_TARGET("sse4.2")
+inline __m128i batch_binary_op_sse(__m128i x, __m128i y, uint64_t c) noexcept
+{
+	constexpr uint64_t w = sizeof(T) * BIT_SIZE;
+	return Op == BatchBinary::and_op ? _mm_and_si128(x, y) :
+	       Op == BatchBinary::or_op ? _mm_or_si128(x, y) :
+	       Op == BatchBinary::xor_op ? _mm_xor_si128(x, y) :
+	       Op == BatchBinary::add_op ? batch_add_sse<T>(x, y) :
+	       Op == BatchBinary::sub_op ? batch_sub_sse<T>(x, y) :
+	       Op == BatchBinary::mul_op ? batch_mul_sse<T>(x, y) :
+	       Op == BatchBinary::shl_op ? batch_shl_sse<T>(x, c) :
+	       Op == BatchBinary::shr_op ? batch_shr_sse<T>(x, c) :
+	       Op == BatchBinary::rotl_op ? _mm_or_si128(batch_shl_sse<T>(x, c & (w - 1)),
+	                                                 batch_shr_sse<T>(x, w - (c & (w - 1)))) :
+	       Op == BatchBinary::rotr_op ? _mm_or_si128(batch_shr_sse<T>(x, c & (w - 1)),
+	                                                 batch_shl_sse<T>(x, w - (c & (w - 1)))) :
+	                                    batch_popcount_sse<T>(_mm_xor_si128(x, y));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("sse4.2")
+inline void batch_unary_sse(const T* in, T* out, std::size_t n) noexcept
+{
+	constexpr std::size_t L = 16 / sizeof(T);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+		                 batch_unary_op_sse<T, Op>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+	batch_unary_scalar<T, Op>(in + i, out + i, n - i);
+}
+
+template <typename T, BatchBinary Op, bool Broadcast>
+BITTLE_TARGET("sse4.2")
+inline void batch_binary_sse(const T* a, const T* b, T* out, std::size_t n) noexcept
+{
+	if(!batch_vector(BatchIsa::sse, sizeof(T), Op, Broadcast))
+		return batch_binary_scalar<T, Op, Broadcast>(a, b, out, n);
+
+	constexpr std::size_t L = 16 / sizeof(T);
+	const T c = Broadcast ? b[0] : T(0);
+	const __m128i y = batch_set1_sse<T>(c);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+	{
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i r = Broadcast ? batch_binary_op_sse<T, Op>(x, y, c) :
+		                  batch_binary_op_sse<T, Op>(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), c);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+	}
+	batch_binary_scalar<T, Op, Broadcast>(a + i, Broadcast ? b : b + i, out + i, n - i);
+}
+
+/* AVX2, 32 bytes at a time, the tables repeated in both 16 byte halves */
+
+BITTLE_TARGET("avx2")
+inline __m256i batch_table_avx2(uint64_t lo, uint64_t hi) noexcept
+{
+	return _mm256_broadcastsi128_si256(_mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_set1_avx2(T v) noexcept
+{
+	return sizeof(T) == 1 ? _mm256_set1_epi8(static_cast<char>(v)) :
+	       sizeof(T) == 2 ? _mm256_set1_epi16(static_cast<short>(v)) :
+	       sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(v)) :
+	                        _mm256_set1_epi64x(static_cast<long long>(v));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_add_avx2(__m256i a, __m256i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm256_add_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm256_add_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm256_add_epi32(a, b) : _mm256_add_epi64(a, b);
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_sub_avx2(__m256i a, __m256i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm256_sub_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm256_sub_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm256_sub_epi32(a, b) : _mm256_sub_epi64(a, b);
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_mul_avx2(__m256i a, __m256i b) noexcept
+{
+	if(sizeof(T) == 1)
+	{
+		const __m256i even = _mm256_and_si256(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(0xFF));
+		const __m256i odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+		return _mm256_or_si256(even, _mm256_slli_epi16(odd, 8));
+	}
+	if(sizeof(T) == 2)
+		return _mm256_mullo_epi16(a, b);
+	if(sizeof(T) == 4)
+		return _mm256_mullo_epi32(a, b);
+	const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+	                                       _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+	return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_shl_avx2(__m256i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm256_and_si256(_mm256_sll_epi16(x, n),
+	                                         _mm256_set1_epi8(static_cast<char>(c < 8 ? 0xFF << c : 0))) :
+	       sizeof(T) == 2 ? _mm256_sll_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm256_sll_epi32(x, n) : _mm256_sll_epi64(x, n);
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_shr_avx2(__m256i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm256_and_si256(_mm256_srl_epi16(x, n),
+	                                         _mm256_set1_epi8(static_cast<char>(c < 8 ? 0xFF >> c : 0))) :
+	       sizeof(T) == 2 ? _mm256_srl_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm256_srl_epi32(x, n) : _mm256_srl_epi64(x, n);
+}
+
+/* lane by lane counts, 32 and 64 bit lanes only */
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_shlv_avx2(__m256i x, __m256i c) noexcept
+{
+	return sizeof(T) == 4 ? _mm256_sllv_epi32(x, c) : _mm256_sllv_epi64(x, c);
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_shrv_avx2(__m256i x, __m256i c) noexcept
+{
+	return sizeof(T) == 4 ? _mm256_srlv_epi32(x, c) : _mm256_srlv_epi64(x, c);
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_popcount_avx2(__m256i x) noexcept
+{
+	const __m256i lut = batch_table_avx2(BATCH_POPCOUNT_LO, BATCH_POPCOUNT_HI);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	const __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x, low)),
+	                                  _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+	if(sizeof(T) == 1)
+		return c;
+	if(sizeof(T) == 8)
+		return _mm256_sad_epu8(c, _mm256_setzero_si256());
+	const __m256i c16 = _mm256_maddubs_epi16(c, _mm256_set1_epi8(1));
+	return sizeof(T) == 2 ? c16 : _mm256_madd_epi16(c16, _mm256_set1_epi16(1));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_reverse_bytes_avx2(__m256i x) noexcept
+{
+	if(sizeof(T) == 1)
+		return x;
+	return _mm256_shuffle_epi8(x, batch_table_avx2(batch_bswap_lo<T>(), batch_bswap_lo<T>() + 0x0808080808080808ULL));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_reverse_bits_avx2(__m256i x) noexcept
+{
+	const __m256i rev = batch_table_avx2(BATCH_REVERSE_LO, BATCH_REVERSE_HI);
+	const __m256i rev_high = batch_table_avx2(BATCH_REVERSE_LO << 4, BATCH_REVERSE_HI << 4);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	x = batch_reverse_bytes_avx2<T>(x);
+	return _mm256_or_si256(_mm256_shuffle_epi8(rev_high, _mm256_and_si256(x, low)),
+	                       _mm256_shuffle_epi8(rev, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_leading_zeroes_avx2(__m256i x) noexcept
+{
+	x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 1));
+	x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 2));
+	x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 4));
+	if(sizeof(T) >= 2)
+		x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 8));
+	if(sizeof(T) >= 4)
+		x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 16));
+	if(sizeof(T) == 8)
+		x = _mm256_or_si256(x, batch_shr_avx2<T>(x, 32));
+	return batch_popcount_avx2<T>(_mm256_xor_si256(x, _mm256_set1_epi32(-1)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx2")
+inline __m256i batch_trailing_zeroes_avx2(__m256i x) noexcept
+{
+	return batch_popcount_avx2<T>(_mm256_andnot_si256(x, batch_add_avx2<T>(x, _mm256_set1_epi32(-1))));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("avx2")
+inline __m256i batch_unary_op_avx2(__m256i x) noexcept
+{
+	const __m256i all = _mm256_set1_epi32(-1);
+	return Op == BatchUnary::invert ? _mm256_xor_si256(x, all) :
+	       Op == BatchUnary::negate ? batch_sub_avx2<T>(_mm256_setzero_si256(), x) :
+	       Op == BatchUnary::reverse_bits ? batch_reverse_bits_avx2<T>(x) :
+	       Op == BatchUnary::reverse_bytes ? batch_reverse_bytes_avx2<T>(x) :
+	       Op == BatchUnary::ones ? batch_popcount_avx2<T>(x) :
+	       Op == BatchUnary::zeroes ? batch_popcount_avx2<T>(_mm256_xor_si256(x, all)) :
+	       Op == BatchUnary::leading_zeroes ? batch_leading_zeroes_avx2<T>(x) :
+	                                          batch_trailing_zeroes_avx2<T>(x);
+}
+
+/* with Broadcast shifts and rotates take the count c, otherwise the
+ * lanes of y */
+template <typename T, BatchBinary Op, bool Broadcast>
+BITTLE_TARGET("avx2")
+inline __m256i batch_binary_op_avx2(__m256i x, __m256i y, uint64_t c) noexcept
+{
+	constexpr uint64_t w = sizeof(T) * BIT_SIZE;
+	const __m256i s = _mm256_and_si256(y, batch_set1_avx2<T>(static_cast<T>(w - 1)));
+	const __m256i t = batch_sub_avx2<T>(batch_set1_avx2<T>(static_cast<T>(w)), s);
+	return Op == BatchBinary::and_op ? _mm256_and_si256(x, y) :
+	       Op == BatchBinary::or_op ? _mm256_or_si256(x, y) :
+	       Op == BatchBinary::xor_op ? _mm256_xor_si256(x, y) :
+	       Op == BatchBinary::add_op ? batch_add_avx2<T>(x, y) :
+	       Op == BatchBinary::sub_op ? batch_sub_avx2<T>(x, y) :
+	       Op == BatchBinary::mul_op ? batch_mul_avx2<T>(x, y) :
+	       Op == BatchBinary::hamming_op ? batch_popcount_avx2<T>(_mm256_xor_si256(x, y)) :
+	       Broadcast ?
+	       (Op == BatchBinary::shl_op ? batch_shl_avx2<T>(x, c) :
+	        Op == BatchBinary::shr_op ? batch_shr_avx2<T>(x, c) :
+	        Op == BatchBinary::rotl_op ? _mm256_or_si256(batch_shl_avx2<T>(x, c & (w - 1)),
+	                                                     batch_shr_avx2<T>(x, w - (c & (w - 1)))) :
+	                                     _mm256_or_si256(batch_shr_avx2<T>(x, c & (w - 1)),
+	                                                     batch_shl_avx2<T>(x, w - (c & (w - 1))))) :
+	       (Op == BatchBinary::shl_op ? batch_shlv_avx2<T>(x, y) :
+	        Op == BatchBinary::shr_op ? batch_shrv_avx2<T>(x, y) :
+	        Op == BatchBinary::rotl_op ? _mm256_or_si256(batch_shlv_avx2<T>(x, s), batch_shrv_avx2<T>(x, t)) :
+	                                     _mm256_or_si256(batch_shrv_avx2<T>(x, s), batch_shlv_avx2<T>(x, t)));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("avx2")
+inline void batch_unary_avx2(const T* in, T* out, std::size_t n) noexcept
+{
+	constexpr std::size_t L = 32 / sizeof(T);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		                    batch_unary_op_avx2<T, Op>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))));
+	batch_unary_scalar<T, Op>(in + i, out + i, n - i);
+}
+
+template <typename T, BatchBinary Op, bool Broadcast>
+BITTLE_TARGET("avx2")
+inline void batch_binary_avx2(const T* a, const T* b, T* out, std::size_t n) noexcept
+{
+	if(!batch_vector(BatchIsa::avx2, sizeof(T), Op, Broadcast))
+		return batch_binary_scalar<T, Op, Broadcast>(a, b, out, n);
+
+	constexpr std::size_t L = 32 / sizeof(T);
+	const T c = Broadcast ? b[0] : T(0);
+	const __m256i y = batch_set1_avx2<T>(c);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+	{
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i r = Broadcast ? batch_binary_op_avx2<T, Op, Broadcast>(x, y, c) :
+		                  batch_binary_op_avx2<T, Op, Broadcast>(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)), c);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+	}
+	batch_binary_scalar<T, Op, Broadcast>(a + i, Broadcast ? b : b + i, out + i, n - i);
+}
+
+/* AVX-512BW, 64 bytes at a time */
+
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_table_avx512(uint64_t lo, uint64_t hi) noexcept
+{
+	return _mm512_broadcast_i32x4(_mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_set1_avx512(T v) noexcept
+{
+	return sizeof(T) == 1 ? _mm512_set1_epi8(static_cast<char>(v)) :
+	       sizeof(T) == 2 ? _mm512_set1_epi16(static_cast<short>(v)) :
+	       sizeof(T) == 4 ? _mm512_set1_epi32(static_cast<int>(v)) :
+	                        _mm512_set1_epi64(static_cast<long long>(v));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_add_avx512(__m512i a, __m512i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm512_add_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm512_add_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm512_add_epi32(a, b) : _mm512_add_epi64(a, b);
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_sub_avx512(__m512i a, __m512i b) noexcept
+{
+	return sizeof(T) == 1 ? _mm512_sub_epi8(a, b) :
+	       sizeof(T) == 2 ? _mm512_sub_epi16(a, b) :
+	       sizeof(T) == 4 ? _mm512_sub_epi32(a, b) : _mm512_sub_epi64(a, b);
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_mul_avx512(__m512i a, __m512i b) noexcept
+{
+	if(sizeof(T) == 1)
+	{
+		const __m512i even = _mm512_and_si512(_mm512_mullo_epi16(a, b), _mm512_set1_epi16(0xFF));
+		const __m512i odd = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+		return _mm512_or_si512(even, _mm512_slli_epi16(odd, 8));
+	}
+	if(sizeof(T) == 2)
+		return _mm512_mullo_epi16(a, b);
+	if(sizeof(T) == 4)
+		return _mm512_mullo_epi32(a, b);
+	const __m512i cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), b),
+	                                       _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+	return _mm512_add_epi64(_mm512_mul_epu32(a, b), _mm512_slli_epi64(cross, 32));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_shl_avx512(__m512i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm512_and_si512(_mm512_sll_epi16(x, n),
+	                                         _mm512_set1_epi8(static_cast<char>(c < 8 ? 0xFF << c : 0))) :
+	       sizeof(T) == 2 ? _mm512_sll_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm512_sll_epi32(x, n) : _mm512_sll_epi64(x, n);
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_shr_avx512(__m512i x, uint64_t c) noexcept
+{
+	const __m128i n = _mm_set_epi64x(0, static_cast<long long>(c));
+	return sizeof(T) == 1 ? _mm512_and_si512(_mm512_srl_epi16(x, n),
+	                                         _mm512_set1_epi8(static_cast<char>(c < 8 ? 0xFF >> c : 0))) :
+	       sizeof(T) == 2 ? _mm512_srl_epi16(x, n) :
+	       sizeof(T) == 4 ? _mm512_srl_epi32(x, n) : _mm512_srl_epi64(x, n);
+}
+
+/* lane by lane counts, 16, 32 and 64 bit lanes */
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_shlv_avx512(__m512i x, __m512i c) noexcept
+{
+	return sizeof(T) == 2 ? _mm512_sllv_epi16(x, c) :
+	       sizeof(T) == 4 ? _mm512_sllv_epi32(x, c) : _mm512_sllv_epi64(x, c);
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_shrv_avx512(__m512i x, __m512i c) noexcept
+{
+	return sizeof(T) == 2 ? _mm512_srlv_epi16(x, c) :
+	       sizeof(T) == 4 ? _mm512_srlv_epi32(x, c) : _mm512_srlv_epi64(x, c);
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_popcount_avx512(__m512i x) noexcept
+{
+	const __m512i lut = batch_table_avx512(BATCH_POPCOUNT_LO, BATCH_POPCOUNT_HI);
+	const __m512i low = _mm512_set1_epi8(0x0F);
+	const __m512i c = _mm512_add_epi8(_mm512_shuffle_epi8(lut, _mm512_and_si512(x, low)),
+	                                  _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(x, 4), low)));
+	if(sizeof(T) == 1)
+		return c;
+	if(sizeof(T) == 8)
+		return _mm512_sad_epu8(c, _mm512_setzero_si512());
+	const __m512i c16 = _mm512_maddubs_epi16(c, _mm512_set1_epi8(1));
+	return sizeof(T) == 2 ? c16 : _mm512_madd_epi16(c16, _mm512_set1_epi16(1));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_reverse_bytes_avx512(__m512i x) noexcept
+{
+	if(sizeof(T) == 1)
+		return x;
+	return _mm512_shuffle_epi8(x, batch_table_avx512(batch_bswap_lo<T>(), batch_bswap_lo<T>() + 0x0808080808080808ULL));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_reverse_bits_avx512(__m512i x) noexcept
+{
+	const __m512i rev = batch_table_avx512(BATCH_REVERSE_LO, BATCH_REVERSE_HI);
+	const __m512i rev_high = batch_table_avx512(BATCH_REVERSE_LO << 4, BATCH_REVERSE_HI << 4);
+	const __m512i low = _mm512_set1_epi8(0x0F);
+	x = batch_reverse_bytes_avx512<T>(x);
+	return _mm512_or_si512(_mm512_shuffle_epi8(rev_high, _mm512_and_si512(x, low)),
+	                       _mm512_shuffle_epi8(rev, _mm512_and_si512(_mm512_srli_epi16(x, 4), low)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_leading_zeroes_avx512(__m512i x) noexcept
+{
+	x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 1));
+	x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 2));
+	x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 4));
+	if(sizeof(T) >= 2)
+		x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 8));
+	if(sizeof(T) >= 4)
+		x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 16));
+	if(sizeof(T) == 8)
+		x = _mm512_or_si512(x, batch_shr_avx512<T>(x, 32));
+	return batch_popcount_avx512<T>(_mm512_xor_si512(x, _mm512_set1_epi32(-1)));
+}
+
+template <typename T>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_trailing_zeroes_avx512(__m512i x) noexcept
+{
+	return batch_popcount_avx512<T>(_mm512_andnot_si512(x, batch_add_avx512<T>(x, _mm512_set1_epi32(-1))));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_unary_op_avx512(__m512i x) noexcept
+{
+	const __m512i all = _mm512_set1_epi32(-1);
+	return Op == BatchUnary::invert ? _mm512_xor_si512(x, all) :
+	       Op == BatchUnary::negate ? batch_sub_avx512<T>(_mm512_setzero_si512(), x) :
+	       Op == BatchUnary::reverse_bits ? batch_reverse_bits_avx512<T>(x) :
+	       Op == BatchUnary::reverse_bytes ? batch_reverse_bytes_avx512<T>(x) :
+	       Op == BatchUnary::ones ? batch_popcount_avx512<T>(x) :
+	       Op == BatchUnary::zeroes ? batch_popcount_avx512<T>(_mm512_xor_si512(x, all)) :
+	       Op == BatchUnary::leading_zeroes ? batch_leading_zeroes_avx512<T>(x) :
+	                                          batch_trailing_zeroes_avx512<T>(x);
+}
+
+template <typename T, BatchBinary Op, bool Broadcast>
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i batch_binary_op_avx512(__m512i x, __m512i y, uint64_t c) noexcept
+{
+	constexpr uint64_t w = sizeof(T) * BIT_SIZE;
+	const __m512i s = _mm512_and_si512(y, batch_set1_avx512<T>(static_cast<T>(w - 1)));
+	const __m512i t = batch_sub_avx512<T>(batch_set1_avx512<T>(static_cast<T>(w)), s);
+	return Op == BatchBinary::and_op ? _mm512_and_si512(x, y) :
+	       Op == BatchBinary::or_op ? _mm512_or_si512(x, y) :
+	       Op == BatchBinary::xor_op ? _mm512_xor_si512(x, y) :
+	       Op == BatchBinary::add_op ? batch_add_avx512<T>(x, y) :
+	       Op == BatchBinary::sub_op ? batch_sub_avx512<T>(x, y) :
+	       Op == BatchBinary::mul_op ? batch_mul_avx512<T>(x, y) :
+	       Op == BatchBinary::hamming_op ? batch_popcount_avx512<T>(_mm512_xor_si512(x, y)) :
+	       Broadcast ?
+	       (Op == BatchBinary::shl_op ? batch_shl_avx512<T>(x, c) :
+	        Op == BatchBinary::shr_op ? batch_shr_avx512<T>(x, c) :
+	        Op == BatchBinary::rotl_op ? _mm512_or_si512(batch_shl_avx512<T>(x, c & (w - 1)),
+	                                                     batch_shr_avx512<T>(x, w - (c & (w - 1)))) :
+	                                     _mm512_or_si512(batch_shr_avx512<T>(x, c & (w - 1)),
+	                                                     batch_shl_avx512<T>(x, w - (c & (w - 1))))) :
+	       (Op == BatchBinary::shl_op ? batch_shlv_avx512<T>(x, y) :
+	        Op == BatchBinary::shr_op ? batch_shrv_avx512<T>(x, y) :
+	        Op == BatchBinary::rotl_op ? _mm512_or_si512(batch_shlv_avx512<T>(x, s), batch_shrv_avx512<T>(x, t)) :
+	                                     _mm512_or_si512(batch_shrv_avx512<T>(x, s), batch_shlv_avx512<T>(x, t)));
+}
+
+template <typename T, BatchUnary Op>
+BITTLE_TARGET("avx512f,avx512bw")
+inline void batch_unary_avx512(const T* in, T* out, std::size_t n) noexcept
+{
+	constexpr std::size_t L = 64 / sizeof(T);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+		_mm512_storeu_si512(out + i, batch_unary_op_avx512<T, Op>(_mm512_loadu_si512(in + i)));
+	batch_unary_scalar<T, Op>(in + i, out + i, n - i);
+}
+
+template <typename T, BatchBinary Op, bool Broadcast>
+BITTLE_TARGET("avx512f,avx512bw")
+inline void batch_binary_avx512(const T* a, const T* b, T* out, std::size_t n) noexcept
+{
+	if(!batch_vector(BatchIsa::avx512, sizeof(T), Op, Broadcast))
+		return batch_binary_scalar<T, Op, Broadcast>(a, b, out, n);
+
+	constexpr std::size_t L = 64 / sizeof(T);
+	const T c = Broadcast ? b[0] : T(0);
+	const __m512i y = batch_set1_avx512<T>(c);
+	std::size_t i = 0;
+	for(; i + L <= n; i += L)
+	{
+		const __m512i x = _mm512_loadu_si512(a + i);
+		const __m512i r = Broadcast ? batch_binary_op_avx512<T, Op, Broadcast>(x, y, c) :
+		                  batch_binary_op_avx512<T, Op, Broadcast>(x, _mm512_loadu_si512(b + i), c);
+		_mm512_storeu_si512(out + i, r);
+	}
+	batch_binary_scalar<T, Op, Broadcast>(a + i, Broadcast ? b : b + i, out + i, n - i);
+}
+
+#endif
+
+/* Copies in and out of the lanes, as wide as the kernels so their loads
+ * are forwarded from the copy's stores instead of waiting for them */
+
+inline void batch_copy_scalar(const uint8_t* in, uint8_t* out, std::size_t bytes) noexcept
+{
+	std::memcpy(out, in, bytes);
+}
+
+#if defined(BITTLE_X86)
+
+BITTLE_TARGET("avx2")
+inline void batch_copy_avx2(const uint8_t* in, uint8_t* out, std::size_t bytes) noexcept
+{
+	std::size_t i = 0;
+	for(; i + 32 <= bytes; i += 32)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+	std::memcpy(out + i, in + i, bytes - i);
+}
+
+BITTLE_TARGET("avx512f")
+inline void batch_copy_avx512(const uint8_t* in, uint8_t* out, std::size_t bytes) noexcept
+{
+	std::size_t i = 0;
+	for(; i + 64 <= bytes; i += 64)
+		_mm512_storeu_si512(out + i, _mm512_loadu_si512(in + i));
+	std::memcpy(out + i, in + i, bytes - i);
+}
+
+#endif
+
+/* name: batch_isa
+ * desc: the widest kernels this cpu runs, read once
+ * returns: BatchIsa
+ */
+inline BatchIsa batch_isa() noexcept
+{
+#if defined(BITTLE_X86)
+	static const BatchIsa isa = [] {
+		const CpuFeatures& f = cpu_features();
+		return f.avx512f && f.avx512bw ? BatchIsa::avx512 :
+		       f.avx2 ? BatchIsa::avx2 :
+		       f.sse42 && f.ssse3 ? BatchIsa::sse : BatchIsa::scalar;
+	}();
+	return isa;
+#else
+	return BatchIsa::scalar;
+#endif
+}
+
+inline void batch_copy(const void* in, void* out, std::size_t bytes) noexcept
+{
+	const uint8_t* from = static_cast<const uint8_t*>(in);
+	uint8_t* to = static_cast<uint8_t*>(out);
+	switch(batch_isa())
+	{
+#if defined(BITTLE_X86)
+		case BatchIsa::avx512: return batch_copy_avx512(from, to, bytes);
+		case BatchIsa::avx2: return batch_copy_avx2(from, to, bytes);
+#endif
+		default: return batch_copy_scalar(from, to, bytes);
+	}
+}
+
+template <typename T, BatchUnary Op>
+inline void batch_unary(const T* in, T* out, std::size_t n) noexcept
+{
+	switch(batch_isa())
+	{
+#if defined(BITTLE_X86)
+		case BatchIsa::avx512: return batch_unary_avx512<T, Op>(in, out, n);
+		case BatchIsa::avx2: return batch_unary_avx2<T, Op>(in, out, n);
+		case BatchIsa::sse: return batch_unary_sse<T, Op>(in, out, n);
+#endif
+		default: return batch_unary_scalar<T, Op>(in, out, n);
+	}
+}
+
+template <typename T, BatchBinary Op, bool Broadcast>
+inline void batch_binary(const T* a, const T* b, T* out, std::size_t n) noexcept
+{
+	switch(batch_isa())
+	{
+#if defined(BITTLE_X86)
+		case BatchIsa::avx512: return batch_binary_avx512<T, Op, Broadcast>(a, b, out, n);
+		case BatchIsa::avx2: return batch_binary_avx2<T, Op, Broadcast>(a, b, out, n);
+		case BatchIsa::sse: return batch_binary_sse<T, Op, Broadcast>(a, b, out, n);
+#endif
+		default: return batch_binary_scalar<T, Op, Broadcast>(a, b, out, n);
+	}
+}
+
+}
+
+template <typename T, std::size_t N>
+class BitsBatch
+{
+	static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+	              "Template type T must be an unsigned integral type in class BitsBatch");
+	static_assert(N > 0, "A BitsBatch needs at least one lane");
+
+	using Unary = detail::BatchUnary;
+	using Binary = detail::BatchBinary;
+
+	public:
+
+		/* ctor with every lane 0 */
+		BitsBatch() noexcept
+			: lanes()
+		{
+		}
+
+		/* ctor with every lane set to v */
+		explicit BitsBatch(const T& v) noexcept
+		{
+			this->value(v);
+		}
+
+		/* ctor loading N values from p */
+		explicit BitsBatch(const T* p) noexcept
+		{
+			this->load(p);
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: size
+		 * desc: number of lanes
+		 * returns: N
+		 */
+		static constexpr std::size_t size() noexcept
+		{
+			return N;
+		}
+
+		/* name: bits
+		 * desc: bits per lane
+		 * returns: bit count
+		 */
+		static constexpr int bits() noexcept
+		{
+			return static_cast<int>(sizeof(T) * BIT_SIZE);
+		}
+
+		/* name: implementation
+		 * desc: the kernels in use, "avx512bw", "avx2", "sse4.2" or "scalar"
+		 * returns: name
+		 */
+		static const char* implementation() noexcept
+		{
+			switch(detail::batch_isa())
+			{
+				case detail::BatchIsa::avx512: return "avx512bw";
+				case detail::BatchIsa::avx2: return "avx2";
+				case detail::BatchIsa::sse: return "sse4.2";
+				default: return "scalar";
+			}
+		}
+
+		/* name: value
+		 * desc: gets lane i
+		 * returns: value
+		 */
+		T value(std::size_t i) const noexcept
+		{
+			return this->lanes[i];
+		}
+
+		const T& operator[](std::size_t i) const noexcept
+		{
+			return this->lanes[i];
+		}
+
+		const T* data() const noexcept
+		{
+			return this->lanes;
+		}
+
+		/* name: store
+		 * desc: writes the first count lanes to p
+		 * returns: nothing
+		 */
+		void store(T* p, std::size_t count = N) const noexcept
+		{
+			detail::batch_copy(this->lanes, p, (count < N ? count : N) * sizeof(T));
+		}
+
+		/* name: hammingDistance
+		 * desc: number of different bits, lane by lane
+		 * returns: batch of counts
+		 */
+		BitsBatch hammingDistance(const BitsBatch& right) const noexcept
+		{
+			return this->binary<Binary::hamming_op>(right);
+		}
+
+		/* name: hammingDistance
+		 * desc: number of bits each lane differs from right in
+		 * returns: batch of counts
+		 */
+		BitsBatch hammingDistance(const T& right) const noexcept
+		{
+			return this->binary<Binary::hamming_op>(right);
+		}
+
+		/* name: ones
+		 * desc: counts the one bits of every lane
+		 * returns: batch of counts
+		 */
+		BitsBatch ones() const noexcept
+		{
+			return this->unary<Unary::ones>();
+		}
+
+		/* name: zeroes
+		 * desc: counts the zero bits of every lane
+		 * returns: batch of counts
+		 */
+		BitsBatch zeroes() const noexcept
+		{
+			return this->unary<Unary::zeroes>();
+		}
+
+		/* name: leadingZeroes
+		 * desc: zero bits above the highest set bit of every lane, the
+		 * width for 0
+		 * returns: batch of counts
+		 */
+		BitsBatch leadingZeroes() const noexcept
+		{
+			return this->unary<Unary::leading_zeroes>();
+		}
+
+		/* name: trailingZeroes
+		 * desc: zero bits below the lowest set bit of every lane, the
+		 * width for 0
+		 * returns: batch of counts
+		 */
+		BitsBatch trailingZeroes() const noexcept
+		{
+			return this->unary<Unary::trailing_zeroes>();
+		}
+
+		/* name: checkBit
+		 * desc: checks the bit number n (1 - width) of every lane
+		 * returns: batch of 1 or 0
+		 */
+		BitsBatch checkBit(int n) const noexcept
+		{
+			if(n < 1 || n > bits())
+				return BitsBatch();
+			BitsBatch r = this->binary<Binary::shr_op>(static_cast<T>(n - 1));
+			return r.apply<Binary::and_op>(T(1));
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: value
+		 * desc: sets every lane to v
+		 * returns: *this
+		 */
+		BitsBatch& value(const T& v) noexcept
+		{
+			std::fill(this->lanes, this->lanes + N, v);
+			return *this;
+		}
+
+		/* name: value
+		 * desc: sets lane i to v
+		 * returns: *this
+		 */
+		BitsBatch& value(std::size_t i, const T& v) noexcept
+		{
+			this->lanes[i] = v;
+			return *this;
+		}
+
+		T& operator[](std::size_t i) noexcept
+		{
+			return this->lanes[i];
+		}
+
+		T* data() noexcept
+		{
+			return this->lanes;
+		}
+
+		/* name: load
+		 * desc: reads count lanes from p, zeroing the rest
+		 * returns: *this
+		 */
+		BitsBatch& load(const T* p, std::size_t count = N) noexcept
+		{
+			if(count < N)
+				std::fill(this->lanes + count, this->lanes + N, T(0));
+			detail::batch_copy(p, this->lanes, (count < N ? count : N) * sizeof(T));
+			return *this;
+		}
+
+		/* name: reverseBits
+		 * desc: reverse the bits of every lane
+		 * returns: *this
+		 */
+		BitsBatch& reverseBits() noexcept
+		{
+			return this->apply<Unary::reverse_bits>();
+		}
+
+		/* name: reverseBytes
+		 * desc: reverse the bytes of every lane
+		 * returns: *this
+		 */
+		BitsBatch& reverseBytes() noexcept
+		{
+			return this->apply<Unary::reverse_bytes>();
+		}
+
+		/* name: toggleBit
+		 * desc: toggles the bit number n (1 - width) of every lane
+		 * returns: *this
+		 */
+		BitsBatch& toggleBit(int n) noexcept
+		{
+			return n < 1 || n > bits() ? *this : this->apply<Binary::xor_op>(bit(n));
+		}
+
+		/* name: setBit
+		 * desc: sets the bit number n (1 - width) of every lane
+		 * returns: *this
+		 */
+		BitsBatch& setBit(int n) noexcept
+		{
+			return n < 1 || n > bits() ? *this : this->apply<Binary::or_op>(bit(n));
+		}
+
+		/* name: clearBit
+		 * desc: clears the bit number n (1 - width) of every lane
+		 * returns: *this
+		 */
+		BitsBatch& clearBit(int n) noexcept
+		{
+			return n < 1 || n > bits() ? *this : this->apply<Binary::and_op>(static_cast<T>(~bit(n)));
+		}
+
+		/* name: flipBit
+		 * desc: flips the bit at n, 0 -> 1 ,1 -> 0
+		 * returns: *this
+		 */
+		BitsBatch& flipBit(int n) noexcept
+		{
+			return this->toggleBit(n);
+		}
+
+		/* name: rotateLeft
+		 * desc: rotates every lane left by n, taken mod the width
+		 * returns: *this
+		 */
+		BitsBatch& rotateLeft(int n) noexcept
+		{
+			return this->apply<Binary::rotl_op>(static_cast<T>(static_cast<unsigned>(n) & (bits() - 1)));
+		}
+
+		/* name: rotateLeft
+		 * desc: rotates each lane left by the matching lane of n
+		 * returns: *this
+		 */
+		BitsBatch& rotateLeft(const BitsBatch& n) noexcept
+		{
+			return this->apply<Binary::rotl_op>(n);
+		}
+
+		/* name: rotateRight
+		 * desc: rotates every lane right by n, taken mod the width
+		 * returns: *this
+		 */
+		BitsBatch& rotateRight(int n) noexcept
+		{
+			return this->apply<Binary::rotr_op>(static_cast<T>(static_cast<unsigned>(n) & (bits() - 1)));
+		}
+
+		/* name: rotateRight
+		 * desc: rotates each lane right by the matching lane of n
+		 * returns: *this
+		 */
+		BitsBatch& rotateRight(const BitsBatch& n) noexcept
+		{
+			return this->apply<Binary::rotr_op>(n);
+		}
+
+		/* name: negate
+		 * desc: two's complement negate every lane
+		 * returns: *this
+		 */
+		BitsBatch& negate() noexcept
+		{
+			return this->apply<Unary::negate>();
+		}
+
+		/* name: clear
+		 * desc: sets every lane to 0
+		 * returns: *this
+		 */
+		BitsBatch& clear() noexcept
+		{
+			return this->value(T(0));
+		}
+
+		/* name: add
+		 * desc: add num to every lane
+		 * returns: *this
+		 */
+		BitsBatch& add(const T& num) noexcept
+		{
+			return this->apply<Binary::add_op>(num);
+		}
+
+		BitsBatch& add(const BitsBatch& num) noexcept
+		{
+			return this->apply<Binary::add_op>(num);
+		}
+
+		/* name: subtract
+		 * desc: subtract num from every lane
+		 * returns: *this
+		 */
+		BitsBatch& subtract(const T& num) noexcept
+		{
+			return this->apply<Binary::sub_op>(num);
+		}
+
+		BitsBatch& subtract(const BitsBatch& num) noexcept
+		{
+			return this->apply<Binary::sub_op>(num);
+		}
+
+		/* name: multiply
+		 * desc: multiply every lane by num
+		 * returns: *this
+		 */
+		BitsBatch& multiply(const T& num) noexcept
+		{
+			return this->apply<Binary::mul_op>(num);
+		}
+
+		BitsBatch& multiply(const BitsBatch& num) noexcept
+		{
+			return this->apply<Binary::mul_op>(num);
+		}
+
+		/* name: divide
+		 * desc: divide every lane by num, scalar, 0 is undefined as for Bits
+		 * returns: *this
+		 */
+		BitsBatch& divide(const T& num) noexcept
+		{
+			return this->apply<Binary::div_op>(num);
+		}
+
+		BitsBatch& divide(const BitsBatch& num) noexcept
+		{
+			return this->apply<Binary::div_op>(num);
+		}
+
+		/* name: mod
+		 * desc: every lane modulo num, scalar, 0 is undefined as for Bits
+		 * returns: *this
+		 */
+		BitsBatch& mod(const T& num) noexcept
+		{
+			return this->apply<Binary::mod_op>(num);
+		}
+
+		BitsBatch& mod(const BitsBatch& num) noexcept
+		{
+			return this->apply<Binary::mod_op>(num);
+		}
+
+		/* name: invert
+		 * desc: inverts the bits of every lane
+		 * returns: *this
+		 */
+		BitsBatch& invert() noexcept
+		{
+			return this->apply<Unary::invert>();
+		}
+
+		/* name: switchByteOrder
+		 * desc: reverses the bytes of every lane
+		 * returns: *this
+		 */
+		BitsBatch& switchByteOrder() noexcept
+		{
+			return this->reverseBytes();
+		}
+
+		/* Operators, lane by lane with another batch or every lane with
+		 * one value; shifts of the width or more give 0 */
+
+		BitsBatch& operator&=(const BitsBatch& r) noexcept { return this->apply<Binary::and_op>(r); }
+		BitsBatch& operator|=(const BitsBatch& r) noexcept { return this->apply<Binary::or_op>(r); }
+		BitsBatch& operator^=(const BitsBatch& r) noexcept { return this->apply<Binary::xor_op>(r); }
+		BitsBatch& operator+=(const BitsBatch& r) noexcept { return this->apply<Binary::add_op>(r); }
+		BitsBatch& operator-=(const BitsBatch& r) noexcept { return this->apply<Binary::sub_op>(r); }
+		BitsBatch& operator*=(const BitsBatch& r) noexcept { return this->apply<Binary::mul_op>(r); }
+		BitsBatch& operator/=(const BitsBatch& r) noexcept { return this->apply<Binary::div_op>(r); }
+		BitsBatch& operator%=(const BitsBatch& r) noexcept { return this->apply<Binary::mod_op>(r); }
+		BitsBatch& operator<<=(const BitsBatch& r) noexcept { return this->apply<Binary::shl_op>(r); }
+		BitsBatch& operator>>=(const BitsBatch& r) noexcept { return this->apply<Binary::shr_op>(r); }
+
+		BitsBatch& operator&=(const T& r) noexcept { return this->apply<Binary::and_op>(r); }
+		BitsBatch& operator|=(const T& r) noexcept { return this->apply<Binary::or_op>(r); }
+		BitsBatch& operator^=(const T& r) noexcept { return this->apply<Binary::xor_op>(r); }
+		BitsBatch& operator+=(const T& r) noexcept { return this->apply<Binary::add_op>(r); }
+		BitsBatch& operator-=(const T& r) noexcept { return this->apply<Binary::sub_op>(r); }
+		BitsBatch& operator*=(const T& r) noexcept { return this->apply<Binary::mul_op>(r); }
+		BitsBatch& operator/=(const T& r) noexcept { return this->apply<Binary::div_op>(r); }
+		BitsBatch& operator%=(const T& r) noexcept { return this->apply<Binary::mod_op>(r); }
+		BitsBatch& operator<<=(const T& r) noexcept { return this->apply<Binary::shl_op>(r); }
+		BitsBatch& operator>>=(const T& r) noexcept { return this->apply<Binary::shr_op>(r); }
+
+		BitsBatch operator~() const noexcept { return this->unary<Unary::invert>(); }
+		BitsBatch operator-() const noexcept { return this->unary<Unary::negate>(); }
+
+		friend BitsBatch operator&(BitsBatch l, const BitsBatch& r) noexcept { return l &= r; }
+		friend BitsBatch operator|(BitsBatch l, const BitsBatch& r) noexcept { return l |= r; }
+		friend BitsBatch operator^(BitsBatch l, const BitsBatch& r) noexcept { return l ^= r; }
+		friend BitsBatch operator+(BitsBatch l, const BitsBatch& r) noexcept { return l += r; }
+		friend BitsBatch operator-(BitsBatch l, const BitsBatch& r) noexcept { return l -= r; }
+		friend BitsBatch operator*(BitsBatch l, const BitsBatch& r) noexcept { return l *= r; }
+		friend BitsBatch operator/(BitsBatch l, const BitsBatch& r) noexcept { return l /= r; }
+		friend BitsBatch operator%(BitsBatch l, const BitsBatch& r) noexcept { return l %= r; }
+		friend BitsBatch operator<<(BitsBatch l, const BitsBatch& r) noexcept { return l <<= r; }
+		friend BitsBatch operator>>(BitsBatch l, const BitsBatch& r) noexcept { return l >>= r; }
+
+		friend BitsBatch operator&(BitsBatch l, const T& r) noexcept { return l &= r; }
+		friend BitsBatch operator|(BitsBatch l, const T& r) noexcept { return l |= r; }
+		friend BitsBatch operator^(BitsBatch l, const T& r) noexcept { return l ^= r; }
+		friend BitsBatch operator+(BitsBatch l, const T& r) noexcept { return l += r; }
+		friend BitsBatch operator-(BitsBatch l, const T& r) noexcept { return l -= r; }
+		friend BitsBatch operator*(BitsBatch l, const T& r) noexcept { return l *= r; }
+		friend BitsBatch operator/(BitsBatch l, const T& r) noexcept { return l /= r; }
+		friend BitsBatch operator%(BitsBatch l, const T& r) noexcept { return l %= r; }
+		friend BitsBatch operator<<(BitsBatch l, const T& r) noexcept { return l <<= r; }
+		friend BitsBatch operator>>(BitsBatch l, const T& r) noexcept { return l >>= r; }
+
+		friend bool operator==(const BitsBatch& l, const BitsBatch& r) noexcept
+		{
+			return std::equal(l.lanes, l.lanes + N, r.lanes);
+		}
+
+		friend bool operator!=(const BitsBatch& l, const BitsBatch& r) noexcept
+		{
+			return !(l == r);
+		}
+
+
+	private:
+
+		/* results are written whole by a kernel, no need to zero them */
+		struct Uninitialized {};
+
+		explicit BitsBatch(Uninitialized) noexcept
+		{
+		}
+
+		static constexpr T bit(int n) noexcept
+		{
+			return static_cast<T>(T(1) << (n - 1));
+		}
+
+		template <Unary Op>
+		BitsBatch unary() const noexcept
+		{
+			BitsBatch r{Uninitialized()};
+			detail::batch_unary<T, Op>(this->lanes, r.lanes, N);
+			return r;
+		}
+
+		template <Binary Op>
+		BitsBatch binary(const BitsBatch& right) const noexcept
+		{
+			BitsBatch r{Uninitialized()};
+			detail::batch_binary<T, Op, false>(this->lanes, right.lanes, r.lanes, N);
+			return r;
+		}
+
+		template <Binary Op>
+		BitsBatch binary(const T& right) const noexcept
+		{
+			BitsBatch r{Uninitialized()};
+			detail::batch_binary<T, Op, true>(this->lanes, &right, r.lanes, N);
+			return r;
+		}
+
+		template <Unary Op>
+		BitsBatch& apply() noexcept
+		{
+			detail::batch_unary<T, Op>(this->lanes, this->lanes, N);
+			return *this;
+		}
+
+		template <Binary Op>
+		BitsBatch& apply(const BitsBatch& right) noexcept
+		{
+			detail::batch_binary<T, Op, false>(this->lanes, right.lanes, this->lanes, N);
+			return *this;
+		}
+
+		template <Binary Op>
+		BitsBatch& apply(const T& right) noexcept
+		{
+			const T c = right;  /* right may be one of our lanes */
+			detail::batch_binary<T, Op, true>(this->lanes, &c, this->lanes, N);
+			return *this;
+		}
+
+		alignas(64) T lanes[N];
+};
+
+/* name: transform_batches
+ * desc: runs f over BitsBatch<T, N> loads of in, N values at a time,
+ * storing each batch to out (which may be in); the last short batch is
+ * zero padded and only its n % N lanes are stored
+ * returns: nothing
+ */
+template <std::size_t N, typename T, typename F>
+inline void transform_batches(const T* in, T* out, std::size_t n, F f)
+{
+	BitsBatch<T, N> b;
+	std::size_t i = 0;
+	for(; i + N <= n; i += N)
+	{
+		b.load(in + i);
+		f(b);
+		b.store(out + i);
+	}
+	if(i < n)
+	{
+		b.load(in + i, n - i);
+		f(b);
+		b.store(out + i, n - i);
+	}
+}
+
+/* Declarations for ease of use */
+template <std::size_t N> using BitsBatch8 = BitsBatch<uint8_t, N>;
+template <std::size_t N> using BitsBatch16 = BitsBatch<uint16_t, N>;
+template <std::size_t N> using BitsBatch32 = BitsBatch<uint32_t, N>;
+template <std::size_t N> using BitsBatch64 = BitsBatch<uint64_t, N>;
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+
+#endif
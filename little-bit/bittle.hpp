@@ -22,6 +22,16 @@
 #include <cstdint>
 #include <type_traits>
 #include <functional>
+#include <cstring>
+#include <initializer_list>
+
+#include "profile.hpp"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
 
 
 
@@ -69,13 +79,8 @@ constexpr T reverse_bits(const T& n) noexcept
 template<typename T = uint64_t>
 constexpr uint32_t count_ones(const T& n) noexcept
 {
-	uint32_t cnt = 0;
-	for(int i = 0; i < sizeof(T) * BIT_SIZE; ++i)
-	{
-		if(n & (1 << i)) cnt++;
-	}
-
-	return cnt;
+	using U = typename std::make_unsigned<T>::type;
+	return static_cast<uint32_t>(__builtin_popcountll(static_cast<uint64_t>(static_cast<U>(n))));
 }
 
 
@@ -86,13 +91,32 @@ constexpr uint32_t count_ones(const T& n) noexcept
 template<typename T = uint64_t>
 constexpr uint32_t count_zeroes(const T& n) noexcept
 {
-	uint32_t cnt = 0;
-	for(int i = 0; i < sizeof(T) * BIT_SIZE; ++i)
-	{
-		if(!(n & (1 << i))) cnt++;
-	}
+	return static_cast<uint32_t>(sizeof(T) * BIT_SIZE) - count_ones<T>(n);
+}
 
-	return cnt;
+/* name: count_trailing_zeroes
+ * desc: zero bits below the lowest set bit of 'n'
+ * returns: count, the bit width when n is 0
+ */
+template<typename T = uint64_t>
+constexpr int count_trailing_zeroes(const T& n) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	return n == 0 ? static_cast<int>(sizeof(T) * BIT_SIZE) :
+	                __builtin_ctzll(static_cast<uint64_t>(static_cast<U>(n)));
+}
+
+/* name: count_leading_zeroes
+ * desc: zero bits above the highest set bit of 'n'
+ * returns: count, the bit width when n is 0
+ */
+template<typename T = uint64_t>
+constexpr int count_leading_zeroes(const T& n) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	return n == 0 ? static_cast<int>(sizeof(T) * BIT_SIZE) :
+	                __builtin_clzll(static_cast<uint64_t>(static_cast<U>(n))) -
+	                static_cast<int>(64 - sizeof(T) * BIT_SIZE);
 }
 
 /* name: reverse_bytes
@@ -188,11 +212,21 @@ constexpr T clear_bit(const T& n, int8_t targ) noexcept
 template <typename T = uint64_t>
 constexpr int hamming_distance(const T& x, const T& y) noexcept
 {
-	int diff = 0;
-	for(int i = 0; i < sizeof(T) * BIT_SIZE; ++i)
-		if ((x & (1 << i)) != (y & (1 << i))) diff++;
+	return static_cast<int>(count_ones<T>(static_cast<T>(x ^ y)));
+}
 
-	return diff;
+/* name: extract_bits
+ * desc: the 'width' bits of 'num' starting at bit 'offset', moved down
+ * to bit 0. Widths past the top of T are cut short
+ * returns: the field
+ */
+template <typename T = uint64_t>
+constexpr T extract_bits(const T& num, const int offset, const int width) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	return static_cast<T>((static_cast<U>(num) >> offset) &
+	       (width >= static_cast<int>(sizeof(T) * BIT_SIZE) ? static_cast<U>(~U(0)) :
+	        static_cast<U>((U(1) << width) - 1)));
 }
 
 /* name: right_bits
@@ -202,15 +236,7 @@ constexpr int hamming_distance(const T& x, const T& y) noexcept
  template <typename T = uint64_t>
  constexpr T right_bits(const T& num, const int num_bits)
  {
-	 T ret = 0;
-	 T temp = 0;
-	 for(int i = 0; i < num_bits; i++)
-	 {
-		 temp = (num >> i) & 1;
-		 ret |= temp << i;
-	 }
-
-	 return ret;
+	 return extract_bits<T>(num, 0, num_bits);
  }
 
 
@@ -224,6 +250,235 @@ constexpr int hamming_distance(const T& x, const T& y) noexcept
  	 return num >> ((sizeof(T) * BIT_SIZE) - num_bits - 1);
   }
 
+/* name: rotl
+ * desc: rotates 'n' left by 'r' bits, 'r' is taken mod the bit width
+ * so 0, the width and negative counts are all well defined
+ * returns: rotated number
+ */
+template <typename T = uint64_t>
+constexpr T rotl(const T& n, int r) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	constexpr unsigned w = sizeof(T) * BIT_SIZE;
+	const unsigned s = static_cast<unsigned>(r) & (w - 1);
+	const U u = static_cast<U>(n);
+	return static_cast<T>(static_cast<U>((u << s) | (u >> ((w - s) & (w - 1)))));
+}
+
+/* name: rotr
+ * desc: rotates 'n' right by 'r' bits, 'r' is taken mod the bit width
+ * returns: rotated number
+ */
+template <typename T = uint64_t>
+constexpr T rotr(const T& n, int r) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	constexpr unsigned w = sizeof(T) * BIT_SIZE;
+	const unsigned s = static_cast<unsigned>(r) & (w - 1);
+	const U u = static_cast<U>(n);
+	return static_cast<T>(static_cast<U>((u >> s) | (u << ((w - s) & (w - 1)))));
+}
+
+/* name: binary_chars
+ * desc: writes the sizeof(T) * 8 binary digits of 'n' to 'out', most
+ * significant first or least significant first when 'reverse'. Each byte
+ * is spread to eight ascii digits with one multiply, nothing is allocated
+ * and no terminator is written
+ * returns: number of chars written
+ */
+template <typename T = uint64_t>
+inline int binary_chars(const T& n, char* out, bool reverse = false) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	const uint64_t v = static_cast<uint64_t>(static_cast<U>(n));
+	for(int i = 0; i < static_cast<int>(sizeof(T)); ++i)
+	{
+		const int byte = reverse ? i : static_cast<int>(sizeof(T)) - 1 - i;
+		/* byte k of x keeps bit k, then every nonzero byte becomes 0x01 */
+		uint64_t x = (((v >> (BIT_SIZE * byte)) & 0xFF) * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+		x = (((x + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL) | 0x3030303030303030ULL;
+		if(!reverse)
+			x = __builtin_bswap64(x);
+		std::memcpy(out + BIT_SIZE * i, &x, sizeof(x));
+	}
+	return static_cast<int>(sizeof(T) * BIT_SIZE);
+}
+
+enum class ParseStatus
+{
+	ok,
+	empty,
+	invalid_digit,
+	overflow
+};
+
+/* Outcome of a parse, 'position' is the offending char on error and the
+ * number of chars consumed on success */
+struct ParseResult
+{
+	ParseStatus status;
+	std::size_t position;
+
+	constexpr explicit operator bool() const noexcept
+	{
+		return status == ParseStatus::ok;
+	}
+};
+
+/* name: binary_block
+ * desc: reads exactly 64 '0'/'1' chars, char 0 most significant. Bit k of
+ * 'bad' is set when char k is not a binary digit, value bits for such
+ * chars are meaningless. Validation and conversion are one compare and
+ * one movemask per 16 (SSE2) or 32 (AVX2) chars
+ * returns: parsed value
+ */
+inline uint64_t binary_block(const char* p, uint64_t& bad) noexcept
+{
+	uint64_t m = 0;
+	bad = 0;
+#if defined(__AVX2__)
+	const __m256i fe = _mm256_set1_epi8(static_cast<char>(0xFE));
+	const __m256i zero = _mm256_set1_epi8('0');
+	for(int i = 0; i < 64; i += 32)
+	{
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		/* bit 0 of each char lands in its sign bit */
+		m |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi64(c, 7)))) << i;
+		bad |= static_cast<uint64_t>(static_cast<uint32_t>(
+			~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(c, fe), zero)))) << i;
+	}
+#elif defined(__SSE2__)
+	const __m128i fe = _mm_set1_epi8(static_cast<char>(0xFE));
+	const __m128i zero = _mm_set1_epi8('0');
+	for(int i = 0; i < 64; i += 16)
+	{
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		m |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_slli_epi64(c, 7))) << i;
+		bad |= static_cast<uint64_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(c, fe), zero)) & 0xFFFF) << i;
+	}
+#else
+	for(int i = 0; i < 64; ++i)
+	{
+		m |= static_cast<uint64_t>(p[i] & 1) << i;
+		bad |= static_cast<uint64_t>((p[i] & 0xFE) != '0') << i;
+	}
+#endif
+	/* char k sits at bit k, the value wants it at bit 63 - k */
+	m = __builtin_bswap64(m);
+	m = ((m >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((m & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	m = ((m >> 2) & 0x3333333333333333ULL) | ((m & 0x3333333333333333ULL) << 2);
+	m = ((m >> 1) & 0x5555555555555555ULL) | ((m & 0x5555555555555555ULL) << 1);
+	return m;
+}
+
+/* name: hex_block
+ * desc: reads exactly 16 hex chars (either case), char 0 most
+ * significant. Bit k of 'bad' is set when char k is not a hex digit
+ * returns: parsed value
+ */
+inline uint64_t hex_block(const char* p, uint64_t& bad) noexcept
+{
+#if defined(__SSE2__)
+	const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+	const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+	                                    _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+	const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+	                                     _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+	bad = static_cast<uint64_t>(~_mm_movemask_epi8(_mm_or_si128(digit, letter)) & 0xFFFF);
+
+	/* nibble per byte, then each byte pair folds to one byte */
+	__m128i v = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+	                         _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+	v = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(v, 4), _mm_srli_epi16(v, 8)), _mm_set1_epi16(0xFF));
+	const uint64_t r = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_packus_epi16(v, v)));
+	return __builtin_bswap64(r);
+#else
+	uint64_t r = 0;
+	bad = 0;
+	for(int i = 0; i < 16; ++i)
+	{
+		const char c = p[i];
+		const char l = static_cast<char>(c | 0x20);
+		const int d = (c >= '0' && c <= '9') ? c - '0' : (l >= 'a' && l <= 'f') ? l - 'a' + 10 : -1;
+		bad |= static_cast<uint64_t>(d < 0) << i;
+		r = (r << 4) | static_cast<uint64_t>(d & 0xF);
+	}
+	return r;
+#endif
+}
+
+/* name: parse_bits
+ * desc: parses a binary (base 2) or hex (base 16) string, most
+ * significant digit first, into 'out'. An optional 0b/0x prefix is
+ * skipped and short strings are zero extended. 'out' is only written on
+ * success, on overflow 'position' is the first char past the width
+ * returns: ParseResult
+ */
+template <typename T = uint64_t>
+inline ParseResult parse_bits(const char* s, std::size_t len, T& out, int base = 2) noexcept
+{
+	const int shift = base == 16 ? 4 : 1;
+	const std::size_t digits = sizeof(T) * BIT_SIZE / shift;
+	const std::size_t block = 64 / shift;
+
+	std::size_t skip = 0;
+	if(len >= 2 && s[0] == '0' && (s[1] | 0x20) == (base == 16 ? 'x' : 'b'))
+		skip = 2;
+	s += skip;
+	len -= skip;
+
+	if(len == 0)
+		return ParseResult{ParseStatus::empty, skip};
+	if(len > digits)
+		return ParseResult{ParseStatus::overflow, skip + digits};
+
+	/* Short input is left padded with zeroes to a whole block */
+	char pad[64];
+	const char* p = s;
+	if(len < block)
+	{
+		std::memset(pad, '0', block - len);
+		std::memcpy(pad + block - len, s, len);
+		p = pad;
+	}
+
+	uint64_t bad = 0;
+	const uint64_t v = base == 16 ? bittle::hex_block(p, bad) : bittle::binary_block(p, bad);
+	if(bad)
+		return ParseResult{ParseStatus::invalid_digit, skip + __builtin_ctzll(bad) - (block - len)};
+
+	out = static_cast<T>(v);
+	return ParseResult{ParseStatus::ok, skip + len};
+}
+
+namespace detail {
+
+/* name: all_true
+ * desc: folds a pack of conditions in one instantiation, the two packs
+ * only match when every element is true
+ */
+template <bool... B>
+struct bool_pack {};
+
+template <bool... B>
+struct all_true : std::is_same<bool_pack<true, B...>, bool_pack<B..., true>> {};
+
+/* name: pack_bits
+ * desc: packs one bit per element, the first most significant, one
+ * plain function behind every variadic Bits setter signature
+ * returns: the packed bits in the low bits.size() bits
+ */
+inline constexpr uint64_t pack_bits(std::initializer_list<bool> bits) noexcept
+{
+	uint64_t out = 0;
+	for(bool b : bits)
+		out = (out << 1) | uint64_t(b);
+	return out;
+}
+
+}
+
 template <typename T = uint64_t>
 class Bits;
 
@@ -331,6 +586,7 @@ class Bits
 		 */
 		constexpr int hammingDistance(const Bits& right) noexcept
 		{
+			BITTLE_PROFILE_COUNT(hammingDistance);
 			return bittle::hamming_distance<T>(this->number, right.number);
 		}
 
@@ -340,6 +596,7 @@ class Bits
 		 */
 		constexpr int hammingDistance(const T& right) noexcept
 		{
+			BITTLE_PROFILE_COUNT(hammingDistance);
 			return bittle::hamming_distance<T>(this->number, right);
 		}
 
@@ -352,13 +609,9 @@ class Bits
 			 */
 			std::string toString() const noexcept
 			{
-							std::string temp;
-	            for(int i = tsize - 1; i >= 0; --i)
-	            {
-	                temp.append(std::to_string((this->number >> i) & 1));
-	            }
-
-	            return temp;
+				BITTLE_PROFILE_COUNT(toString);
+				char temp[tsize];
+				return std::string(temp, bittle::binary_chars<T>(this->number, temp));
 			}
 
 			/*
@@ -368,13 +621,9 @@ class Bits
 			 */
 			std::string toStringReverse() const noexcept
 			{
-					std::string temp;
-					for(int i = 0; i < tsize; ++i)
-					{
-						temp.append(std::to_string((this->number >> i) & 1));
-					}
-
-					return temp;
+				BITTLE_PROFILE_COUNT(toStringReverse);
+				char temp[tsize];
+				return std::string(temp, bittle::binary_chars<T>(this->number, temp, true));
 			}
 
 		#endif
@@ -386,6 +635,7 @@ class Bits
 		 */
 		constexpr uint32_t ones() const noexcept
 		{
+			BITTLE_PROFILE_COUNT(ones);
 			return bittle::count_ones<T>(this->number);
 		}
 
@@ -395,15 +645,37 @@ class Bits
 		 */
 		constexpr uint32_t zeroes() const noexcept
 		{
+			BITTLE_PROFILE_COUNT(zeroes);
 			return bittle::count_zeroes<T>(this->number);
 		}
 
+		/* name: leadingZeroes
+		 * desc: counts the zero bits above the highest set bit
+		 * returns: count
+		 */
+		constexpr int leadingZeroes() const noexcept
+		{
+			BITTLE_PROFILE_COUNT(leadingZeroes);
+			return bittle::count_leading_zeroes<T>(this->number);
+		}
+
+		/* name: trailingZeroes
+		 * desc: counts the zero bits below the lowest set bit
+		 * returns: count
+		 */
+		constexpr int trailingZeroes() const noexcept
+		{
+			BITTLE_PROFILE_COUNT(trailingZeroes);
+			return bittle::count_trailing_zeroes<T>(this->number);
+		}
+
 		/* name: checkBit
 		 * desc: checks the bit number n (1 - 32)
 		 * returns: bool
 		 */
 		constexpr bool checkBit(const T& n) const noexcept
 		{
+			BITTLE_PROFILE_COUNT(checkBit);
 			return bittle::check_bit<T>(this->number, n) != 0 ? true : false;
 		}
 
@@ -431,6 +703,7 @@ class Bits
 		 */
 		constexpr Bits& reverseBits() noexcept
 		{
+			BITTLE_PROFILE_COUNT(reverseBits);
 			this->number = bittle::reverse_bits<T>(this->number);
 			return *this;
 		}
@@ -441,6 +714,7 @@ class Bits
 		 */
 		constexpr Bits& reverseBytes() noexcept
 		{
+			BITTLE_PROFILE_COUNT(reverseBytes);
 			this->number = bittle::reverse_bytes<T>(this->number);
 			return *this;
 		}
@@ -451,6 +725,7 @@ class Bits
 		 */
 		constexpr Bits& toggleBit(const T& n) noexcept
 		{
+			BITTLE_PROFILE_COUNT(toggleBit);
 			this->number = bittle::toggle_bit<T>(this->number, n);
 			return *this;
 		}
@@ -461,6 +736,7 @@ class Bits
 		 */
 		constexpr Bits& setBit(const T& n) noexcept
 		{
+			BITTLE_PROFILE_COUNT(setBit);
 			this->number = bittle::set_bit<T>(this->number, n);
 			return *this;
 		}
@@ -471,6 +747,7 @@ class Bits
 		 */
 		constexpr Bits& clearBit(const T& n) noexcept
 		{
+			BITTLE_PROFILE_COUNT(clearBit);
 			this->number = bittle::clear_bit<T>(this->number, n);
 			return *this;
 		}
@@ -481,6 +758,7 @@ class Bits
 		 */
 		 constexpr Bits& flipBit(const T& n) noexcept
 		 {
+			 BITTLE_PROFILE_COUNT(flipBit);
 			 this->number = bittle::flip_bit<T>(this->number, n);
 			 return *this;
 		 }
@@ -503,6 +781,28 @@ class Bits
  				return Bits(left_bits<T>(this->number));
  			}
 
+		/* name: rotateLeft
+		 * desc: rotates the bits left by n
+		 * returns: *this
+		 */
+		constexpr Bits& rotateLeft(int n) noexcept
+		{
+			BITTLE_PROFILE_COUNT(rotateLeft);
+			this->number = bittle::rotl<T>(this->number, n);
+			return *this;
+		}
+
+		/* name: rotateRight
+		 * desc: rotates the bits right by n
+		 * returns: *this
+		 */
+		constexpr Bits& rotateRight(int n) noexcept
+		{
+			BITTLE_PROFILE_COUNT(rotateRight);
+			this->number = bittle::rotr<T>(this->number, n);
+			return *this;
+		}
+
 		/* name: negate
 		 * desc: negate the number
 		 * returns: *this
@@ -1029,132 +1329,59 @@ class Bits
 		/* Assignment Methods */
 
 		/* name: insertRight
-         * desc: pushes bits in on the right side of the digit
-         * returns: *this
-        */
-		template <typename F>
-		constexpr Bits& insertRight(F k) noexcept
-		{
-		   static_assert(std::is_integral<F>::value, "The type T must be integral");
-
-			if (k != 0)
-	        {
-				*this <<= 1;
-				*this |= 1;
-	        }
-	        else
-	        {
-				*this <<= 1;
-	        }
-	        return *this;
-		}
-
-
-		/* name: insertRight
-         * desc: pushes bits in on the right side of the digit
-         * returns: *this
-        */
+		 * desc: pushes bits in on the right side of the digit, the first
+		 * argument ends up most significant
+		 * returns: *this
+		 */
 		template <typename F, typename... Fs>
 		constexpr Bits& insertRight(F k, Fs... bits) noexcept
 		{
-		    static_assert(std::is_integral<F>::value, "The type T must be integral");
-		    constexpr int sz = sizeof(T) * 8;
-		    static_assert(sizeof...(Fs) <= sz, "Bits exceed maximum amount");
-
-			if (k != 0)
-	        {
-				*this <<= 1;
-				*this |= 1;
-	        }
-	        else
-	        {
-				*this <<= 1;
-	        }
-
-
-	        return insertRight(bits...);
-		}
-
-
-		/* name: insertLeft
-         * desc: pushes bits in on the left side of the digit
-         * returns: *this
-        */
-		template <typename F>
-		constexpr Bits& insertLeft(F k) noexcept
-		{
-		   static_assert(std::is_integral<F>::value, "The type T must be integral");
+			static_assert(detail::all_true<std::is_integral<F>::value, std::is_integral<Fs>::value...>::value,
+			              "The type T must be integral");
+			static_assert(sizeof...(Fs) < tsize, "Bits exceed maximum amount");
+			BITTLE_PROFILE_COUNT(insertRight);
 
-	        if (k != 0 && tsize > 0)
-				this->setBit(tsize--);
-	        else
-	           this->clearBit(tsize--);
-
-	        tsize = sizeof(T) * 8;
+			constexpr int n = 1 + sizeof...(Fs);
+			const uint64_t kept = n < tsize ? static_cast<uint64_t>(this->number) << n : 0;
+			this->number = static_cast<T>(kept | detail::pack_bits({k != 0, (bits != 0)...}));
 			return *this;
 		}
 
 		/* name: insertLeft
-         * desc: pushes bits in on the left side of the digit
-         * returns: *this
-        */
+		 * desc: writes bits into the top of the digit, the first argument
+		 * at bit tsize, the bits below them are kept
+		 * returns: *this
+		 */
 		template <typename F, typename... Fs>
 		constexpr Bits& insertLeft(F k, Fs... bits) noexcept
 		{
-		    static_assert(std::is_integral<F>::value, "The type T must be integral");
-		    constexpr int sz = sizeof(T) * 8;
-		    static_assert(sizeof...(Fs) <= sz, "Bits exceed maximum amount");
-
-	        if (k != 0 && tsize > 0)
-				this->setBit(tsize--);
-	        else
-	           this->clearBit(tsize--);
-
-	        return insertLeft(bits...);
-		}
-
-		/* name: assign
-         * desc: assigns new bits to current value, overwriting completley
-         * returns: *this
-        */
-		template <typename F>
-		constexpr Bits& assign(F k) noexcept
-		{
-		   static_assert(std::is_integral<F>::value, "The type T must be integral");
-
-
-	     	if (k != 0)
-				this->setBit(1);
-	        else
-				this->clearBit(1);
+			static_assert(detail::all_true<std::is_integral<F>::value, std::is_integral<Fs>::value...>::value,
+			              "The type T must be integral");
+			static_assert(sizeof...(Fs) < tsize, "Bits exceed maximum amount");
+			BITTLE_PROFILE_COUNT(insertLeft);
 
+			constexpr int n = 1 + sizeof...(Fs);
+			const uint64_t field = (n < 64 ? (uint64_t(1) << n) - 1 : ~uint64_t(0)) << (tsize - n);
+			const uint64_t kept = static_cast<uint64_t>(this->number) & ~field;
+			this->number = static_cast<T>(kept | detail::pack_bits({k != 0, (bits != 0)...}) << (tsize - n));
 			return *this;
 		}
 
 		/* name: assign
-         * desc: assigns new bits to current value, overwriting completley
-         * returns: *this
-        */
+		 * desc: assigns new bits to current value, overwriting completely,
+		 * the first argument most significant
+		 * returns: *this
+		 */
 		template <typename F, typename... Fs>
 		constexpr Bits& assign(F k, Fs... bits) noexcept
 		{
-		    static_assert(std::is_integral<F>::value  , "The type T must be integral");
+			static_assert(detail::all_true<std::is_integral<F>::value, std::is_integral<Fs>::value...>::value,
+			              "The type T must be integral");
+			static_assert(sizeof...(Fs) < tsize, "Bits exceed maximum amount");
+			BITTLE_PROFILE_COUNT(assign);
 
-		    constexpr int sz = sizeof(T) * 8;
-		    static_assert(sizeof...(Fs) <= sz, "Bits exceed maximum amount");
-
-			if (k != 0)
-	        {
-				this->setBit(1);
-				*this <<= 1;
-	        }
-	        else
-	        {
-				*this <<= 1;
-				this->clearBit(1);
-	        }
-
-	        return assign(bits...);
+			this->number = static_cast<T>(detail::pack_bits({k != 0, (bits != 0)...}));
+			return *this;
 		}
 
 		/* Functional Methods */
@@ -1166,6 +1393,7 @@ class Bits
 		 */
 		T reduce(ReduceOperator func, T init) const
 		{
+			BITTLE_PROFILE_COUNT(reduce);
 			T val = init;
 			T n = this->number;
 			for(int i = 0; i <  tsize - 1; i+=2)
@@ -1207,13 +1435,75 @@ class Bits
 		    return Bits<F>(n);
 		}
 
+		/* name: parse
+		 * desc: parses a '0'/'1' string, or hex when base is 16, most
+		 * significant digit first, 'out' is only changed on success
+		 * returns: ParseResult with the error position
+		 */
+		static ParseResult parse(const char* s, std::size_t len, Bits& out, int base = 2) noexcept
+		{
+			BITTLE_PROFILE_COUNT(parse);
+			return bittle::parse_bits<T>(s, len, out.number, base);
+		}
+
+		#ifdef BITTLE_STANDARD
+
+			static ParseResult parse(const std::string& s, Bits& out, int base = 2) noexcept
+			{
+				return parse(s.data(), s.size(), out, base);
+			}
+
+		#endif
+
+
+		/* Width in bits, a compile time constant so Bits<T> is laid out
+		 * exactly like T */
+		static constexpr int tsize = BIT_SIZE * sizeof(T);
+
 
 	private:
+
 		T number = T();	// Defaults to integral default
-		int8_t tsize = BIT_SIZE * sizeof(T); // For some special methods
 
 };
 
+template <typename T>
+constexpr int Bits<T>::tsize;
+
+
+/* name: as_bits
+ * desc: views existing T memory as Bits<T>, Bits<T> is standard layout
+ * with T as its only member so no copy is needed
+ * returns: Bits<T> pointer to the same memory
+ */
+template <typename T>
+inline Bits<T>* as_bits(T* ptr) noexcept
+{
+	return reinterpret_cast<Bits<T>*>(ptr);
+}
+
+template <typename T>
+inline const Bits<T>* as_bits(const T* ptr) noexcept
+{
+	return reinterpret_cast<const Bits<T>*>(ptr);
+}
+
+/* name: as_integers
+ * desc: the reverse view, Bits<T> memory as T
+ * returns: T pointer to the same memory
+ */
+template <typename T>
+inline T* as_integers(Bits<T>* ptr) noexcept
+{
+	return reinterpret_cast<T*>(ptr);
+}
+
+template <typename T>
+inline const T* as_integers(const Bits<T>* ptr) noexcept
+{
+	return reinterpret_cast<const T*>(ptr);
+}
+
 
 template <typename G = uint64_t, typename F = uint64_t, typename C = uint64_t>
 constexpr Bits<C> operator+(const Bits<G>& left, const Bits<F>& right)
@@ -1380,6 +1670,12 @@ using BitsShort = Bits<short>;
 using BitsLong = Bits<long>;
 using BitsChar = Bits<char>;
 
+/* Bits must stay a zero overhead wrapper */
+static_assert(sizeof(Bits8U) == sizeof(uint8_t) && sizeof(Bits64U) == sizeof(uint64_t),
+              "Bits<T> must be exactly sizeof(T)");
+static_assert(std::is_trivially_copyable<Bits64U>::value && std::is_standard_layout<Bits64U>::value,
+              "Bits<T> must be trivially copyable and standard layout");
+
 }
 
 /* Build some test code */
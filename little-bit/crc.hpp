@@ -0,0 +1,609 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: crc.hpp
+ * purpose: configurable CRC engine with sliced tables and hardware paths
+ */
+
+
+#ifndef BITTLE_CRC_HPP
+#define BITTLE_CRC_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Crc follows the usual parameter model (width, poly, init, refin,
+ * refout, xorout) so catalogue entries can be used as is. Any width from
+ * 1 to 64 works. Reflected CRCs run a right shifting register built from
+ * the reverse_bits of the polynomial, the others run a left aligned one.
+ * All lookup tables are built at compile time.
+ */
+
+enum class CrcPath
+{
+	best,		// fastest path this cpu supports
+	bytewise,	// one table lookup per byte
+	slice8,		// 8 tables, 8 bytes per step
+	slice16,	// 16 tables, 16 bytes per step
+	clmul,		// PCLMULQDQ folding, any polynomial
+	crc32c		// SSE4.2 crc32 instruction, CRC32C only
+};
+
+namespace detail {
+
+/* name: crc_reflect
+ * desc: reverses the low 'w' bits of n
+ * returns: reflected value
+ */
+constexpr uint64_t crc_reflect(uint64_t n, int w) noexcept
+{
+	return bittle::reverse_bits<uint64_t>(n) >> (64 - w);
+}
+
+/* name: crc_mulmod
+ * desc: a * b mod (x^w + poly), a and b in normal bit order
+ * returns: product
+ */
+constexpr uint64_t crc_mulmod(uint64_t a, uint64_t b, uint64_t poly, int w) noexcept
+{
+	const uint64_t top = uint64_t(1) << (w - 1);
+	const uint64_t mask = top | (top - 1);
+	uint64_t r = 0;
+	for(int i = w - 1; i >= 0; --i)
+	{
+		const bool carry = (r & top) != 0;
+		r = (r << 1) & mask;
+		if(carry)
+			r ^= poly;
+		if((b >> i) & 1)
+			r ^= a;
+	}
+	return r;
+}
+
+/* name: crc_xpow
+ * desc: x^n mod (x^w + poly) by square and multiply
+ * returns: remainder in normal bit order
+ */
+constexpr uint64_t crc_xpow(uint64_t n, uint64_t poly, int w) noexcept
+{
+	const uint64_t top = uint64_t(1) << (w - 1);
+	const uint64_t mask = top | (top - 1);
+	uint64_t r = 1;
+	uint64_t sq = w > 1 ? 2 : (poly & mask);	// x mod P
+	while(n)
+	{
+		if(n & 1)
+			r = crc_mulmod(r, sq, poly, w);
+		sq = crc_mulmod(sq, sq, poly, w);
+		n >>= 1;
+	}
+	return r;
+}
+
+inline uint64_t load_le64(const uint8_t* p) noexcept
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline uint64_t load_be64(const uint8_t* p) noexcept
+{
+	return __builtin_bswap64(load_le64(p));
+}
+
+}
+
+template <int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut>
+class Crc
+{
+	static_assert(Width >= 1 && Width <= 64, "Crc width must be between 1 and 64");
+
+	public:
+
+		using value_type = typename std::conditional<(Width <= 32), uint32_t, uint64_t>::type;
+
+		static constexpr int width = Width;
+
+		/* Register bits, the non-reflected register is left aligned in it */
+		static constexpr int REG_BITS = sizeof(value_type) * BIT_SIZE;
+
+		/* Bytes per stream of the interleaved crc32c loop */
+		static constexpr std::size_t CRC32C_STREAM = 2048;
+
+		/* Buffers shorter than this stay on the table path */
+		static constexpr std::size_t FOLD_MIN = 256;
+
+		struct Tables
+		{
+			value_type t[16][256];
+		};
+
+		/* Default ctor, ready for update() */
+		constexpr Crc() noexcept : reg(initRegister()) {}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: value
+		 * desc: finalized checksum of everything fed so far
+		 * returns: checksum
+		 */
+		constexpr value_type value() const noexcept
+		{
+			return finalize(this->reg);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: reset
+		 * desc: starts a new checksum
+		 * returns: *this
+		 */
+		Crc& reset() noexcept
+		{
+			this->reg = initRegister();
+			return *this;
+		}
+
+		/* name: update
+		 * desc: feeds len bytes through the selected path
+		 * returns: *this
+		 */
+		Crc& update(const void* data, std::size_t len, CrcPath path = CrcPath::best) noexcept
+		{
+			BITTLE_PROFILE_KERNEL(crc_update);
+			const uint8_t* p = static_cast<const uint8_t*>(data);
+			switch(path)
+			{
+				case CrcPath::bytewise:
+					this->reg = bytewise(this->reg, p, len);
+					break;
+				case CrcPath::slice8:
+					this->reg = sliced<8>(this->reg, p, len);
+					break;
+				case CrcPath::slice16:
+					this->reg = sliced<16>(this->reg, p, len);
+					break;
+				case CrcPath::clmul:
+					this->reg = hasClmul() ? folded(this->reg, p, len) : sliced<16>(this->reg, p, len);
+					break;
+				case CrcPath::crc32c:
+					this->reg = hasCrc32c() ? hardware(this->reg, p, len) : sliced<16>(this->reg, p, len);
+					break;
+				default:
+					this->reg = best(this->reg, p, len);
+					break;
+			}
+			return *this;
+		}
+
+		/*
+		 *
+		 *
+		 * Static Member Methods
+		 *
+		 *
+		 */
+
+		/* name: compute
+		 * desc: one shot checksum
+		 * returns: checksum
+		 */
+		static value_type compute(const void* data, std::size_t len, CrcPath path = CrcPath::best) noexcept
+		{
+			return Crc().update(data, len, path).value();
+		}
+
+		/* name: combine
+		 * desc: checksum of A followed by B from the checksums of A and B,
+		 * lenB is the byte length of B. Lets chunks be summed in parallel.
+		 * returns: checksum
+		 */
+		static constexpr value_type combine(value_type crcA, value_type crcB, uint64_t lenB) noexcept
+		{
+			/* f(r, B) = r * x^(8 lenB) ^ f(0, B) and the register of B already
+			 * holds init * x^(8 lenB), so only A ^ init has to be shifted */
+			return fromNormal(
+				detail::crc_mulmod(toNormal(crcA) ^ (Init & MASK), detail::crc_xpow(8 * lenB, Poly, Width), Poly, Width)
+				^ toNormal(crcB));
+		}
+
+		/* name: hasClmul
+		 * desc: whether the cpu runs the PCLMULQDQ folding path
+		 * returns: bool
+		 */
+		static bool hasClmul() noexcept
+		{
+		#if defined(BITTLE_X86)
+			return cpu_features().pclmul && cpu_features().ssse3;
+		#else
+			return false;
+		#endif
+		}
+
+		/* name: hasCrc32c
+		 * desc: whether the crc32 instruction is usable for this engine
+		 * returns: bool
+		 */
+		static bool hasCrc32c() noexcept
+		{
+		#if defined(BITTLE_X86) && defined(__x86_64__)
+			return cpu_features().sse42 && isCrc32c();
+		#else
+			return false;
+		#endif
+		}
+
+		static constexpr bool isCrc32c() noexcept
+		{
+			return Width == 32 && Poly == 0x1EDC6F41 && RefIn && RefOut;
+		}
+
+		static const Tables tables;
+
+
+	private:
+
+		static constexpr uint64_t MASK = Width == 64 ? ~uint64_t(0) : ((uint64_t(1) << Width) - 1);
+
+		/* Polynomial as used by the register */
+		static constexpr value_type REG_POLY = RefIn ?
+			static_cast<value_type>(detail::crc_reflect(Poly & MASK, Width)) :
+			static_cast<value_type>((Poly & MASK) << (REG_BITS - Width));
+
+		static constexpr value_type initRegister() noexcept
+		{
+			return RefIn ? static_cast<value_type>(detail::crc_reflect(Init & MASK, Width)) :
+			               static_cast<value_type>((Init & MASK) << (REG_BITS - Width));
+		}
+
+		/* name: finalize
+		 * desc: register -> published checksum
+		 * returns: checksum
+		 */
+		static constexpr value_type finalize(value_type r) noexcept
+		{
+			return static_cast<value_type>(fromNormal(RefIn ? detail::crc_reflect(r, Width) :
+			                                                  uint64_t(r) >> (REG_BITS - Width)));
+		}
+
+		/* name: toNormal
+		 * desc: published checksum -> register contents in normal bit order
+		 * returns: polynomial
+		 */
+		static constexpr uint64_t toNormal(value_type c) noexcept
+		{
+			return RefOut ? detail::crc_reflect((c ^ XorOut) & MASK, Width) : ((c ^ XorOut) & MASK);
+		}
+
+		/* name: fromNormal
+		 * desc: register contents in normal bit order -> published checksum
+		 * returns: checksum
+		 */
+		static constexpr value_type fromNormal(uint64_t n) noexcept
+		{
+			return static_cast<value_type>(((RefOut ? detail::crc_reflect(n, Width) : n) ^ XorOut) & MASK);
+		}
+
+		/* name: makeTables
+		 * desc: t[0] is the plain byte table, t[k] is t[0] followed by k zero bytes
+		 * returns: Tables
+		 */
+		static constexpr Tables makeTables() noexcept
+		{
+			Tables r{};
+			for(int b = 0; b < 256; ++b)
+			{
+				value_type c = RefIn ? static_cast<value_type>(b) :
+				                       static_cast<value_type>(value_type(b) << (REG_BITS - 8));
+				for(int i = 0; i < 8; ++i)
+				{
+					if(RefIn)
+						c = (c & 1) ? static_cast<value_type>((c >> 1) ^ REG_POLY) : static_cast<value_type>(c >> 1);
+					else
+						c = ((c >> (REG_BITS - 1)) & 1) ? static_cast<value_type>((c << 1) ^ REG_POLY) :
+						                                  static_cast<value_type>(c << 1);
+				}
+				r.t[0][b] = c;
+			}
+			for(int k = 1; k < 16; ++k)
+			{
+				for(int b = 0; b < 256; ++b)
+				{
+					const value_type c = r.t[k - 1][b];
+					r.t[k][b] = RefIn ?
+						static_cast<value_type>((c >> 8) ^ r.t[0][c & 0xFF]) :
+						static_cast<value_type>((c << 8) ^ r.t[0][(c >> (REG_BITS - 8)) & 0xFF]);
+				}
+			}
+			return r;
+		}
+
+		static value_type step(value_type r, uint8_t b) noexcept
+		{
+			if(RefIn)
+				return static_cast<value_type>((r >> 8) ^ tables.t[0][(r ^ b) & 0xFF]);
+			else
+				return static_cast<value_type>((r << 8) ^ tables.t[0][((r >> (REG_BITS - 8)) ^ b) & 0xFF]);
+		}
+
+		static value_type bytewise(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			for(std::size_t i = 0; i < len; ++i)
+				r = step(r, p[i]);
+			return r;
+		}
+
+		/* name: fold8
+		 * desc: register contribution of the 8 byte word 'w' whose bytes are
+		 * followed by 'After' more bytes in the same step
+		 * returns: partial register
+		 */
+		template <int After>
+		static value_type fold8(uint64_t w) noexcept
+		{
+			const value_type (&t)[16][256] = tables.t;
+			if(RefIn)
+				return t[After + 7][w & 0xFF] ^ t[After + 6][(w >> 8) & 0xFF] ^
+				       t[After + 5][(w >> 16) & 0xFF] ^ t[After + 4][(w >> 24) & 0xFF] ^
+				       t[After + 3][(w >> 32) & 0xFF] ^ t[After + 2][(w >> 40) & 0xFF] ^
+				       t[After + 1][(w >> 48) & 0xFF] ^ t[After][w >> 56];
+			return t[After + 7][w >> 56] ^ t[After + 6][(w >> 48) & 0xFF] ^
+			       t[After + 5][(w >> 40) & 0xFF] ^ t[After + 4][(w >> 32) & 0xFF] ^
+			       t[After + 3][(w >> 24) & 0xFF] ^ t[After + 2][(w >> 16) & 0xFF] ^
+			       t[After + 1][(w >> 8) & 0xFF] ^ t[After][w & 0xFF];
+		}
+
+		/* name: sliced
+		 * desc: slice by 8/16, the register is xor'ed over the first bytes
+		 * of every step and each byte then costs one lookup
+		 * returns: register
+		 */
+		template <int S>
+		static value_type sliced(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			while(len >= S)
+			{
+				uint64_t w0 = RefIn ? detail::load_le64(p) : detail::load_be64(p);
+				w0 ^= RefIn ? uint64_t(r) : (uint64_t(r) << (64 - REG_BITS));
+				if(S == 16)
+				{
+					const uint64_t w1 = RefIn ? detail::load_le64(p + 8) : detail::load_be64(p + 8);
+					r = fold8<S - 8>(w0) ^ fold8<0>(w1);
+				}
+				else
+				{
+					r = fold8<0>(w0);
+				}
+				p += S;
+				len -= S;
+			}
+			return bytewise(r, p, len);
+		}
+
+		static value_type best(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			if(hasCrc32c())
+				return hardware(r, p, len);
+			if(hasClmul() && len >= FOLD_MIN)
+				return folded(r, p, len);
+			return sliced<16>(r, p, len);
+		}
+
+	#if defined(BITTLE_X86) && defined(__x86_64__)
+
+		/* name: shiftTables
+		 * desc: lookup form of r -> r * x^(8 CRC32C_STREAM) in the
+		 * reflected register, used to merge the interleaved streams
+		 * returns: Tables (only t[0..3] used)
+		 */
+		static constexpr Tables makeShiftTables() noexcept
+		{
+			Tables r{};
+			const uint64_t k = detail::crc_xpow(8 * CRC32C_STREAM, Poly, Width);
+			for(int j = 0; j < 4; ++j)
+				for(int b = 0; b < 256; ++b)
+				{
+					const uint64_t n = detail::crc_reflect(uint64_t(b) << (8 * j), Width);
+					r.t[j][b] = static_cast<value_type>(
+						detail::crc_reflect(detail::crc_mulmod(n, k, Poly, Width), Width));
+				}
+			return r;
+		}
+
+		static const Tables shift_tables;
+
+		static uint32_t shiftStream(uint32_t r) noexcept
+		{
+			return shift_tables.t[0][r & 0xFF] ^ shift_tables.t[1][(r >> 8) & 0xFF] ^
+			       shift_tables.t[2][(r >> 16) & 0xFF] ^ shift_tables.t[3][r >> 24];
+		}
+
+		/* name: hardware
+		 * desc: crc32 instruction over three independent streams to hide
+		 * its latency, merged with the shift tables
+		 * returns: register
+		 */
+		BITTLE_TARGET("sse4.2")
+		static value_type hardware(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			if(!isCrc32c())
+				return sliced<16>(r, p, len);
+
+			uint64_t c0 = r;
+			while(len >= 3 * CRC32C_STREAM)
+			{
+				uint64_t c1 = 0, c2 = 0;
+				for(std::size_t i = 0; i < CRC32C_STREAM; i += 8)
+				{
+					c0 = _mm_crc32_u64(c0, detail::load_le64(p + i));
+					c1 = _mm_crc32_u64(c1, detail::load_le64(p + CRC32C_STREAM + i));
+					c2 = _mm_crc32_u64(c2, detail::load_le64(p + 2 * CRC32C_STREAM + i));
+				}
+				c0 = shiftStream(shiftStream(static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c1)) ^ c2;
+				p += 3 * CRC32C_STREAM;
+				len -= 3 * CRC32C_STREAM;
+			}
+			for(; len >= 8; p += 8, len -= 8)
+				c0 = _mm_crc32_u64(c0, detail::load_le64(p));
+			uint32_t c = static_cast<uint32_t>(c0);
+			for(; len; ++p, --len)
+				c = _mm_crc32_u8(c, *p);
+			return static_cast<value_type>(c);
+		}
+
+	#else
+
+		static value_type hardware(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			return sliced<16>(r, p, len);
+		}
+
+	#endif
+
+	#if defined(BITTLE_X86)
+
+		/* name: foldConstant
+		 * desc: multipliers that move a 128 bit block 'dist' bits further.
+		 * A reflected product comes out shifted down by one, so the
+		 * reflected constants use one power less.
+		 * returns: qword pair arranged for the register orientation
+		 */
+		template <uint64_t Dist>
+		BITTLE_TARGET("pclmul,ssse3")
+		static __m128i foldConstant() noexcept
+		{
+			constexpr uint64_t adj = RefIn ? 1 : 0;
+			constexpr uint64_t hi = detail::crc_xpow(Dist + 64 - adj, Poly, Width);
+			constexpr uint64_t lo = detail::crc_xpow(Dist - adj, Poly, Width);
+			if(RefIn)
+				return _mm_set_epi64x(static_cast<long long>(bittle::reverse_bits<uint64_t>(lo)),
+				                      static_cast<long long>(bittle::reverse_bits<uint64_t>(hi)));
+			return _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+		}
+
+		BITTLE_TARGET("pclmul,ssse3")
+		static __m128i load128(const uint8_t* p) noexcept
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			if(RefIn)
+				return v;
+			return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+		}
+
+		BITTLE_TARGET("pclmul,ssse3")
+		static void store128(uint8_t* p, __m128i v) noexcept
+		{
+			if(!RefIn)
+				v = _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+		}
+
+		BITTLE_TARGET("pclmul,ssse3")
+		static __m128i fold(__m128i x, __m128i k) noexcept
+		{
+			return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+		}
+
+		/* name: folded
+		 * desc: four 128 bit accumulators are folded forward with carry-less
+		 * multiplies by x^n mod P. The products stay congruent to the
+		 * message, not reduced, so the final 16 bytes are simply run
+		 * through the table path from a zero register.
+		 * returns: register
+		 */
+		BITTLE_TARGET("pclmul,ssse3")
+		static value_type folded(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			if(len < 64)
+				return sliced<16>(r, p, len);
+
+			const __m128i k512 = foldConstant<512>();
+			const __m128i k128 = foldConstant<128>();
+
+			/* The register is the same as xor'ing it over the first bytes */
+			const __m128i rv = RefIn ? _mm_set_epi64x(0, static_cast<long long>(r)) :
+			                           _mm_set_epi64x(static_cast<long long>(uint64_t(r) << (64 - REG_BITS)), 0);
+
+			__m128i x0 = _mm_xor_si128(load128(p), rv);
+			__m128i x1 = load128(p + 16);
+			__m128i x2 = load128(p + 32);
+			__m128i x3 = load128(p + 48);
+			p += 64;
+			len -= 64;
+
+			for(; len >= 64; p += 64, len -= 64)
+			{
+				x0 = _mm_xor_si128(fold(x0, k512), load128(p));
+				x1 = _mm_xor_si128(fold(x1, k512), load128(p + 16));
+				x2 = _mm_xor_si128(fold(x2, k512), load128(p + 32));
+				x3 = _mm_xor_si128(fold(x3, k512), load128(p + 48));
+			}
+
+			x1 = _mm_xor_si128(fold(x0, k128), x1);
+			x2 = _mm_xor_si128(fold(x1, k128), x2);
+			x3 = _mm_xor_si128(fold(x2, k128), x3);
+
+			for(; len >= 16; p += 16, len -= 16)
+				x3 = _mm_xor_si128(fold(x3, k128), load128(p));
+
+			alignas(16) uint8_t tail[16];
+			store128(tail, x3);
+			return sliced<16>(sliced<16>(0, tail, 16), p, len);
+		}
+
+	#else
+
+		static value_type folded(value_type r, const uint8_t* p, std::size_t len) noexcept
+		{
+			return sliced<16>(r, p, len);
+		}
+
+	#endif
+
+		value_type reg;
+
+};
+
+template <int W, uint64_t P, uint64_t I, bool RI, bool RO, uint64_t X>
+const typename Crc<W, P, I, RI, RO, X>::Tables Crc<W, P, I, RI, RO, X>::tables =
+	Crc<W, P, I, RI, RO, X>::makeTables();
+
+#if defined(BITTLE_X86) && defined(__x86_64__)
+template <int W, uint64_t P, uint64_t I, bool RI, bool RO, uint64_t X>
+const typename Crc<W, P, I, RI, RO, X>::Tables Crc<W, P, I, RI, RO, X>::shift_tables =
+	Crc<W, P, I, RI, RO, X>::makeShiftTables();
+#endif
+
+/* Declarations for ease of use */
+using Crc32 = Crc<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+using Crc32C = Crc<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+using Crc32Bzip2 = Crc<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF>;
+using Crc16CcittFalse = Crc<16, 0x1021, 0xFFFF, false, false, 0x0000>;
+using Crc16Arc = Crc<16, 0x8005, 0x0000, true, true, 0x0000>;
+using Crc64Xz = Crc<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF>;
+using Crc64Ecma = Crc<64, 0x42F0E1EBA9EA3693, 0x0000000000000000, false, false, 0x0000000000000000>;
+
+}
+
+
+#endif
@@ -0,0 +1,732 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: dispatch.hpp
+ * purpose: runtime cpu feature detection and dispatched bulk kernels
+ */
+
+
+#ifndef BITTLE_DISPATCH_HPP
+#define BITTLE_DISPATCH_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#define BITTLE_X86 1
+	#include <cpuid.h>
+	#include <immintrin.h>
+	#define BITTLE_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define BITTLE_TARGET(isa)
+#endif
+
+/* gcc's own avx512 headers trip -Wuninitialized once inlined into target
+ * attributed functions (their _undefined_ helpers self initialize) */
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * One binary, any x86-64. Features are read once with cpuid (and xgetbv
+ * for the AVX register state), every kernel family gets the best
+ * implementation the cpu has, compiled with target attributes so no
+ * -m flag is needed. The environment can take features away for testing:
+ *
+ *     BITTLE_CPU=scalar              everything scalar
+ *     BITTLE_CPU=-avx512f,-bmi2      those two off, and what needs them
+ *
+ * Taking a feature away takes away the ones built on it: ssse3, sse4.2,
+ * avx2, avx512f, then avx512bw and avx512vpopcntdq each need the one
+ * before, and the fast pext needs bmi2. Features can only be taken
+ * away, a token without the leading '-' (or any other malformed spec)
+ * rejects the whole override and the detected features are used.
+ * Unknown feature names are ignored.
+ *
+ * implementation(Kernel) reports what was picked. Bulk entry points go
+ * through one pointer per call, so hand them arrays, not single words.
+ */
+
+struct CpuFeatures
+{
+	bool popcnt = false;
+	bool ssse3 = false;
+	bool sse42 = false;
+	bool pclmul = false;
+	bool avx2 = false;
+	bool bmi2 = false;
+	bool fast_pext = false; /* bmi2 without the microcoded pext of Zen 1/2 */
+	bool avx512f = false;
+	bool avx512bw = false;
+	bool avx512vpopcntdq = false;
+	bool gfni = false;
+};
+
+enum class Kernel
+{
+	popcount,
+	pext,
+	byteswap,
+	logic,
+	count
+};
+
+enum class LogicOp
+{
+	and_op,
+	or_op,
+	xor_op,
+	andnot_op   /* a & ~b */
+};
+
+namespace detail {
+
+/* name: detect_cpu
+ * desc: raw cpuid/xgetbv feature bits of this machine
+ * returns: CpuFeatures
+ */
+inline CpuFeatures detect_cpu() noexcept
+{
+	CpuFeatures f;
+#if defined(BITTLE_X86)
+	unsigned a = 0, b = 0, c = 0, d = 0;
+	if(!__get_cpuid(0, &a, &b, &c, &d))
+		return f;
+	const unsigned max_leaf = a;
+	const bool amd = b == 0x68747541; /* "Auth"enticAMD */
+
+	__get_cpuid(1, &a, &b, &c, &d);
+	unsigned family = (a >> 8) & 0xF;
+	if(family == 0xF)
+		family += (a >> 20) & 0xFF;
+	f.popcnt = (c >> 23) & 1;
+	f.ssse3 = (c >> 9) & 1;
+	f.sse42 = (c >> 20) & 1;
+	f.pclmul = (c >> 1) & 1;
+
+	/* AVX state has to be enabled by the OS as well */
+	uint64_t xcr0 = 0;
+	if((c >> 27) & 1)
+	{
+		unsigned lo = 0, hi = 0;
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		xcr0 = (static_cast<uint64_t>(hi) << 32) | lo;
+	}
+	const bool ymm = (xcr0 & 0x6) == 0x6;
+	const bool zmm = ymm && (xcr0 & 0xE0) == 0xE0;
+
+	if(max_leaf >= 7)
+	{
+		__cpuid_count(7, 0, a, b, c, d);
+		f.bmi2 = (b >> 8) & 1;
+		f.avx2 = ymm && ((b >> 5) & 1);
+		f.avx512f = zmm && ((b >> 16) & 1);
+		f.avx512bw = zmm && ((b >> 30) & 1);
+		f.avx512vpopcntdq = zmm && ((c >> 14) & 1);
+		f.gfni = (c >> 8) & 1;
+	}
+	f.fast_pext = f.bmi2 && !(amd && family < 0x19);
+#endif
+	return f;
+}
+
+/* name: mask_cpu
+ * desc: applies a BITTLE_CPU style override to f, '*valid' (if given)
+ * is set to whether the spec was well formed
+ * returns: CpuFeatures, f itself for a rejected spec
+ */
+inline CpuFeatures mask_cpu(CpuFeatures f, const char* spec, bool* valid = nullptr) noexcept
+{
+	if(valid)
+		*valid = true;
+	if(!spec)
+		return f;
+	if(std::strcmp(spec, "scalar") == 0)
+		return CpuFeatures();
+
+	const CpuFeatures detected = f;
+
+	struct Name
+	{
+		const char* name;
+		bool CpuFeatures::* flag;
+	};
+	static const Name names[] = {
+		{"popcnt", &CpuFeatures::popcnt}, {"ssse3", &CpuFeatures::ssse3},
+		{"sse4.2", &CpuFeatures::sse42}, {"pclmul", &CpuFeatures::pclmul},
+		{"avx2", &CpuFeatures::avx2}, {"bmi2", &CpuFeatures::bmi2},
+		{"avx512f", &CpuFeatures::avx512f}, {"avx512bw", &CpuFeatures::avx512bw},
+		{"avx512vpopcntdq", &CpuFeatures::avx512vpopcntdq}, {"gfni", &CpuFeatures::gfni}};
+
+	for(const char* p = spec; *p; )
+	{
+		const char* e = p;
+		while(*e && *e != ',')
+			++e;
+		if(*p != '-')
+		{
+			if(valid)
+				*valid = false;
+			return detected;
+		}
+		for(const Name& n : names)
+			if(std::strlen(n.name) == static_cast<std::size_t>(e - p - 1) &&
+			   std::strncmp(n.name, p + 1, static_cast<std::size_t>(e - p - 1)) == 0)
+				f.*(n.flag) = false;
+		p = *e ? e + 1 : e;
+	}
+
+	/* each needs the one before it */
+	f.sse42 = f.sse42 && f.ssse3;
+	f.avx2 = f.avx2 && f.sse42;
+	f.avx512f = f.avx512f && f.avx2;
+	f.avx512bw = f.avx512bw && f.avx512f;
+	f.avx512vpopcntdq = f.avx512vpopcntdq && f.avx512f;
+	f.fast_pext = f.fast_pext && f.bmi2;
+	return f;
+}
+
+/* Popcount */
+
+inline uint64_t popcount_scalar(const uint64_t* p, std::size_t n) noexcept
+{
+	uint64_t total = 0;
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		uint64_t x = p[i];
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		total += (x * 0x0101010101010101ULL) >> 56;
+	}
+	return total;
+}
+
+#if defined(BITTLE_X86)
+
+BITTLE_TARGET("popcnt")
+inline uint64_t popcount_popcnt(const uint64_t* p, std::size_t n) noexcept
+{
+	uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		c0 += static_cast<uint64_t>(__builtin_popcountll(p[i]));
+		c1 += static_cast<uint64_t>(__builtin_popcountll(p[i + 1]));
+		c2 += static_cast<uint64_t>(__builtin_popcountll(p[i + 2]));
+		c3 += static_cast<uint64_t>(__builtin_popcountll(p[i + 3]));
+	}
+	for(; i < n; ++i)
+		c0 += static_cast<uint64_t>(__builtin_popcountll(p[i]));
+	return c0 + c1 + c2 + c3;
+}
+
+/* nibble lookup with pshufb, byte counts summed with psadbw */
+BITTLE_TARGET("avx2,popcnt")
+inline uint64_t popcount_avx2(const uint64_t* p, std::size_t n) noexcept
+{
+	const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                                     0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)),
+		                                    _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+	}
+	uint64_t total = static_cast<uint64_t>(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+	                                       _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+	for(; i < n; ++i)
+		total += static_cast<uint64_t>(__builtin_popcountll(p[i]));
+	return total;
+}
+
+BITTLE_TARGET("avx512f,avx512vpopcntdq")
+inline uint64_t popcount_avx512(const uint64_t* p, std::size_t n) noexcept
+{
+	__m512i acc = _mm512_setzero_si512();
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8)
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(p + i)));
+	if(i < n)
+	{
+		const __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(m, p + i)));
+	}
+	return static_cast<uint64_t>(_mm512_reduce_add_epi64(acc));
+}
+
+#endif
+
+/* Parallel bit extract / deposit */
+
+inline uint64_t pext_scalar(uint64_t x, uint64_t m) noexcept
+{
+	uint64_t r = 0;
+	for(uint64_t bb = 1; m; bb += bb)
+	{
+		if(x & m & (0 - m))
+			r |= bb;
+		m &= m - 1;
+	}
+	return r;
+}
+
+inline uint64_t pdep_scalar(uint64_t x, uint64_t m) noexcept
+{
+	uint64_t r = 0;
+	for(uint64_t bb = 1; m; bb += bb)
+	{
+		if(x & bb)
+			r |= m & (0 - m);
+		m &= m - 1;
+	}
+	return r;
+}
+
+inline void pext_bulk_scalar(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = pext_scalar(in[i], m);
+}
+
+inline void pdep_bulk_scalar(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = pdep_scalar(in[i], m);
+}
+
+#if defined(BITTLE_X86) && defined(__x86_64__)
+
+BITTLE_TARGET("bmi2")
+inline uint64_t pext_bmi2(uint64_t x, uint64_t m) noexcept
+{
+	return _pext_u64(x, m);
+}
+
+BITTLE_TARGET("bmi2")
+inline uint64_t pdep_bmi2(uint64_t x, uint64_t m) noexcept
+{
+	return _pdep_u64(x, m);
+}
+
+BITTLE_TARGET("bmi2")
+inline void pext_bulk_bmi2(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = _pext_u64(in[i], m);
+}
+
+BITTLE_TARGET("bmi2")
+inline void pdep_bulk_bmi2(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = _pdep_u64(in[i], m);
+}
+
+#endif
+
+/* Byte swap of count elements of size 2, 4 or 8, in may equal out */
+
+inline void byteswap_scalar(const uint8_t* in, uint8_t* out, std::size_t count, int size) noexcept
+{
+	for(std::size_t i = 0; i < count; ++i, in += size, out += size)
+	{
+		if(size == 8)
+		{
+			uint64_t v;
+			std::memcpy(&v, in, 8);
+			v = __builtin_bswap64(v);
+			std::memcpy(out, &v, 8);
+		}
+		else if(size == 4)
+		{
+			uint32_t v;
+			std::memcpy(&v, in, 4);
+			v = __builtin_bswap32(v);
+			std::memcpy(out, &v, 4);
+		}
+		else
+		{
+			uint16_t v;
+			std::memcpy(&v, in, 2);
+			v = __builtin_bswap16(v);
+			std::memcpy(out, &v, 2);
+		}
+	}
+}
+
+/* name: byteswap_mask
+ * desc: pshufb control that reverses every size byte group of 16 bytes
+ * returns: nothing
+ */
+inline void byteswap_mask(uint8_t (&m)[16], int size) noexcept
+{
+	for(int i = 0; i < 16; ++i)
+		m[i] = static_cast<uint8_t>((i / size) * size + (size - 1 - i % size));
+}
+
+#if defined(BITTLE_X86)
+
+BITTLE_TARGET("ssse3")
+inline void byteswap_ssse3(const uint8_t* in, uint8_t* out, std::size_t count, int size) noexcept
+{
+	uint8_t m[16];
+	byteswap_mask(m, size);
+	const __m128i ctl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m));
+	const std::size_t bytes = count * static_cast<std::size_t>(size);
+	std::size_t i = 0;
+	for(; i + 16 <= bytes; i += 16)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+		                 _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), ctl));
+	byteswap_scalar(in + i, out + i, (bytes - i) / static_cast<std::size_t>(size), size);
+}
+
+BITTLE_TARGET("avx2")
+inline void byteswap_avx2(const uint8_t* in, uint8_t* out, std::size_t count, int size) noexcept
+{
+	uint8_t m[16];
+	byteswap_mask(m, size);
+	const __m256i ctl = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m)));
+	const std::size_t bytes = count * static_cast<std::size_t>(size);
+	std::size_t i = 0;
+	for(; i + 32 <= bytes; i += 32)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		                    _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), ctl));
+	byteswap_scalar(in + i, out + i, (bytes - i) / static_cast<std::size_t>(size), size);
+}
+
+BITTLE_TARGET("avx512f,avx512bw")
+inline void byteswap_avx512(const uint8_t* in, uint8_t* out, std::size_t count, int size) noexcept
+{
+	uint8_t m[16];
+	byteswap_mask(m, size);
+	const __m512i ctl = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m)));
+	const std::size_t bytes = count * static_cast<std::size_t>(size);
+	std::size_t i = 0;
+	for(; i + 64 <= bytes; i += 64)
+		_mm512_storeu_si512(out + i, _mm512_shuffle_epi8(_mm512_loadu_si512(in + i), ctl));
+	byteswap_scalar(in + i, out + i, (bytes - i) / static_cast<std::size_t>(size), size);
+}
+
+#endif
+
+/* Bulk logic, out may equal a or b */
+
+template <LogicOp Op>
+constexpr uint64_t logic_word(uint64_t a, uint64_t b) noexcept
+{
+	return Op == LogicOp::and_op ? a & b :
+	       Op == LogicOp::or_op ? a | b :
+	       Op == LogicOp::xor_op ? a ^ b : a & ~b;
+}
+
+template <LogicOp Op>
+inline void logic_scalar(const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = logic_word<Op>(a[i], b[i]);
+}
+
+#if defined(BITTLE_X86)
+
+template <LogicOp Op>
+BITTLE_TARGET("avx2")
+inline void logic_avx2(const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n) noexcept
+{
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		const __m256i r = Op == LogicOp::and_op ? _mm256_and_si256(x, y) :
+		                  Op == LogicOp::or_op ? _mm256_or_si256(x, y) :
+		                  Op == LogicOp::xor_op ? _mm256_xor_si256(x, y) : _mm256_andnot_si256(y, x);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+	}
+	for(; i < n; ++i)
+		out[i] = logic_word<Op>(a[i], b[i]);
+}
+
+template <LogicOp Op>
+BITTLE_TARGET("avx512f")
+inline void logic_avx512(const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n) noexcept
+{
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		const __m512i x = _mm512_loadu_si512(a + i);
+		const __m512i y = _mm512_loadu_si512(b + i);
+		const __m512i r = Op == LogicOp::and_op ? _mm512_and_si512(x, y) :
+		                  Op == LogicOp::or_op ? _mm512_or_si512(x, y) :
+		                  Op == LogicOp::xor_op ? _mm512_xor_si512(x, y) : _mm512_andnot_si512(y, x);
+		_mm512_storeu_si512(out + i, r);
+	}
+	for(; i < n; ++i)
+		out[i] = logic_word<Op>(a[i], b[i]);
+}
+
+#endif
+
+using logic_fn = void (*)(const uint64_t*, const uint64_t*, uint64_t*, std::size_t);
+
+struct DispatchTable
+{
+	uint64_t (*popcount)(const uint64_t*, std::size_t);
+	uint64_t (*pext)(uint64_t, uint64_t);
+	uint64_t (*pdep)(uint64_t, uint64_t);
+	void (*pext_bulk)(const uint64_t*, uint64_t, uint64_t*, std::size_t);
+	void (*pdep_bulk)(const uint64_t*, uint64_t, uint64_t*, std::size_t);
+	void (*byteswap)(const uint8_t*, uint8_t*, std::size_t, int);
+	logic_fn logic[4];
+	const char* names[static_cast<int>(Kernel::count)];
+};
+
+/* name: make_table
+ * desc: binds every kernel family for a feature set
+ * returns: DispatchTable
+ */
+inline DispatchTable make_table(const CpuFeatures& f) noexcept
+{
+	DispatchTable t;
+	const int popcount = static_cast<int>(Kernel::popcount);
+	const int pext = static_cast<int>(Kernel::pext);
+	const int byteswap = static_cast<int>(Kernel::byteswap);
+	const int logic = static_cast<int>(Kernel::logic);
+
+	t.popcount = popcount_scalar;
+	t.names[popcount] = "scalar";
+	t.pext = pext_scalar;
+	t.pdep = pdep_scalar;
+	t.pext_bulk = pext_bulk_scalar;
+	t.pdep_bulk = pdep_bulk_scalar;
+	t.names[pext] = "scalar";
+	t.byteswap = byteswap_scalar;
+	t.names[byteswap] = "scalar";
+	t.logic[0] = logic_scalar<LogicOp::and_op>;
+	t.logic[1] = logic_scalar<LogicOp::or_op>;
+	t.logic[2] = logic_scalar<LogicOp::xor_op>;
+	t.logic[3] = logic_scalar<LogicOp::andnot_op>;
+	t.names[logic] = "scalar";
+
+#if defined(BITTLE_X86)
+	if(f.avx512f && f.avx512vpopcntdq)
+	{
+		t.popcount = popcount_avx512;
+		t.names[popcount] = "avx512vpopcntdq";
+	}
+	else if(f.avx2 && f.popcnt)
+	{
+		t.popcount = popcount_avx2;
+		t.names[popcount] = "avx2";
+	}
+	else if(f.popcnt)
+	{
+		t.popcount = popcount_popcnt;
+		t.names[popcount] = "popcnt";
+	}
+
+#if defined(__x86_64__)
+	if(f.fast_pext)
+	{
+		t.pext = pext_bmi2;
+		t.pdep = pdep_bmi2;
+		t.pext_bulk = pext_bulk_bmi2;
+		t.pdep_bulk = pdep_bulk_bmi2;
+		t.names[pext] = "bmi2";
+	}
+#endif
+
+	if(f.avx512f && f.avx512bw)
+	{
+		t.byteswap = byteswap_avx512;
+		t.names[byteswap] = "avx512bw";
+	}
+	else if(f.avx2)
+	{
+		t.byteswap = byteswap_avx2;
+		t.names[byteswap] = "avx2";
+	}
+	else if(f.ssse3)
+	{
+		t.byteswap = byteswap_ssse3;
+		t.names[byteswap] = "ssse3";
+	}
+
+	if(f.avx512f)
+	{
+		t.logic[0] = logic_avx512<LogicOp::and_op>;
+		t.logic[1] = logic_avx512<LogicOp::or_op>;
+		t.logic[2] = logic_avx512<LogicOp::xor_op>;
+		t.logic[3] = logic_avx512<LogicOp::andnot_op>;
+		t.names[logic] = "avx512f";
+	}
+	else if(f.avx2)
+	{
+		t.logic[0] = logic_avx2<LogicOp::and_op>;
+		t.logic[1] = logic_avx2<LogicOp::or_op>;
+		t.logic[2] = logic_avx2<LogicOp::xor_op>;
+		t.logic[3] = logic_avx2<LogicOp::andnot_op>;
+		t.names[logic] = "avx2";
+	}
+#else
+	(void)f;
+#endif
+	return t;
+}
+
+}
+
+/* name: detected_cpu
+ * desc: what the hardware and OS support, before any override
+ * returns: CpuFeatures
+ */
+inline const CpuFeatures& detected_cpu() noexcept
+{
+	static const CpuFeatures f = detail::detect_cpu();
+	return f;
+}
+
+/* name: cpu_features
+ * desc: detected features with BITTLE_CPU applied, what dispatch uses
+ * returns: CpuFeatures
+ */
+inline const CpuFeatures& cpu_features() noexcept
+{
+	static const CpuFeatures f = detail::mask_cpu(detected_cpu(), std::getenv("BITTLE_CPU"));
+	return f;
+}
+
+/* name: cpu_override_ok
+ * desc: whether BITTLE_CPU, if set, was well formed and applied
+ * returns: bool
+ */
+inline bool cpu_override_ok() noexcept
+{
+	static const bool ok = [] {
+		bool valid = true;
+		detail::mask_cpu(detected_cpu(), std::getenv("BITTLE_CPU"), &valid);
+		return valid;
+	}();
+	return ok;
+}
+
+/* name: dispatch_table
+ * desc: kernels bound once on first use
+ * returns: DispatchTable
+ */
+inline const detail::DispatchTable& dispatch_table() noexcept
+{
+	static const detail::DispatchTable t = detail::make_table(cpu_features());
+	return t;
+}
+
+/* name: implementation
+ * desc: name of the implementation bound to a kernel family
+ * returns: name, "scalar" when nothing faster is available
+ */
+inline const char* implementation(Kernel k) noexcept
+{
+	return dispatch_table().names[static_cast<int>(k)];
+}
+
+/* name: kernel_name
+ * desc: printable name of a kernel family
+ * returns: name
+ */
+inline const char* kernel_name(Kernel k) noexcept
+{
+	static const char* const names[] = {"popcount", "pext/pdep", "byteswap", "logic"};
+	return names[static_cast<int>(k)];
+}
+
+/* name: popcount_words
+ * desc: set bits over n words
+ * returns: count
+ */
+inline uint64_t popcount_words(const uint64_t* p, std::size_t n) noexcept
+{
+	return dispatch_table().popcount(p, n);
+}
+
+/* name: pext
+ * desc: gathers the bits of x selected by m into the low bits
+ * returns: packed bits
+ */
+inline uint64_t pext(uint64_t x, uint64_t m) noexcept
+{
+	return dispatch_table().pext(x, m);
+}
+
+/* name: pdep
+ * desc: scatters the low bits of x to the set positions of m
+ * returns: deposited bits
+ */
+inline uint64_t pdep(uint64_t x, uint64_t m) noexcept
+{
+	return dispatch_table().pdep(x, m);
+}
+
+/* name: pext_words
+ * desc: out[i] = pext(in[i], m)
+ * returns: nothing
+ */
+inline void pext_words(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	dispatch_table().pext_bulk(in, m, out, n);
+}
+
+/* name: pdep_words
+ * desc: out[i] = pdep(in[i], m)
+ * returns: nothing
+ */
+inline void pdep_words(const uint64_t* in, uint64_t m, uint64_t* out, std::size_t n) noexcept
+{
+	dispatch_table().pdep_bulk(in, m, out, n);
+}
+
+/* name: byteswap_array
+ * desc: reverses the bytes of every element, in and out may be the same
+ * returns: nothing
+ */
+template <typename T>
+inline void byteswap_array(const T* in, T* out, std::size_t n) noexcept
+{
+	static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "byteswap_array takes 2, 4 or 8 byte elements");
+	dispatch_table().byteswap(reinterpret_cast<const uint8_t*>(in), reinterpret_cast<uint8_t*>(out), n,
+	                          static_cast<int>(sizeof(T)));
+}
+
+template <typename T>
+inline void byteswap_array(const Bits<T>* in, Bits<T>* out, std::size_t n) noexcept
+{
+	byteswap_array<T>(as_integers(in), as_integers(out), n);
+}
+
+/* name: logic_words
+ * desc: out[i] = a[i] op b[i], out may be a or b
+ * returns: nothing
+ */
+inline void logic_words(LogicOp op, const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n) noexcept
+{
+	dispatch_table().logic[static_cast<int>(op)](a, b, out, n);
+}
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+
+#endif
@@ -0,0 +1,494 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: elias_fano.hpp
+ * purpose: Elias-Fano compressed monotone sequences of 64 bit integers
+ */
+
+
+#ifndef BITTLE_ELIAS_FANO_HPP
+#define BITTLE_ELIAS_FANO_HPP
+
+#include "bittle.hpp"
+#include "swar.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__BMI2__)
+	#include <immintrin.h>
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * EliasFano stores n non-decreasing values no larger than u in about
+ * 2 + log2(u / n) bits each. Every value is split in two:
+ *
+ *     low  = the bottom L = floor(log2(u / n)) bits, packed at width L
+ *     high = the rest, written as one set bit at position high + i in
+ *            a bitmap of n + (u >> L) + 1 bits
+ *
+ * so the i-th set bit of the bitmap, minus i, gives back the high part.
+ * Every 256th one and every 256th zero of the bitmap has its position
+ * sampled. at(i) and nextGeq(x) start from the nearest sample and scan
+ * words with popcount up to the one holding the answer, so they cost one
+ * sample plus a scan over at most 256 ones (or zeroes) and the gaps
+ * between them: short on dense bitmaps, proportional to the gap on long
+ * sparse runs. Iteration, skipping and decode walk the bitmap a word at
+ * a time with ctz.
+ */
+
+namespace detail {
+
+/* name: select_in_word
+ * desc: position of the (k + 1)-th set bit of w, k < popcount(w)
+ * returns: bit position
+ */
+inline int select_in_word(uint64_t w, int k) noexcept
+{
+#if defined(__BMI2__)
+	return __builtin_ctzll(_pdep_u64(uint64_t(1) << k, w));
+#else
+	/* byte i of prefix is the popcount of bytes 0 .. i */
+	const uint64_t prefix = bittle::byte_popcount(w) * 0x0101010101010101ULL;
+	const int byte = bittle::first_lane(bittle::greater_lanes<8>(prefix, bittle::broadcast<8>(static_cast<uint64_t>(k))));
+	const int before = byte ? static_cast<int>((prefix >> (8 * byte - 8)) & 0xFF) : 0;
+	uint64_t b = (w >> (8 * byte)) & 0xFF;
+	for(int r = k - before; r > 0; --r)
+		b &= b - 1;
+	return 8 * byte + __builtin_ctzll(b);
+#endif
+}
+
+}
+
+class EliasFano
+{
+	public:
+
+		/* Ones (and zeros) of the high bitmap between position samples */
+		static constexpr std::size_t SAMPLE = 256;
+
+		/* name: Cursor
+		 * desc: forward only position in the sequence, skipTo moves to the
+		 * first value >= x by jumping through the zero samples when the
+		 * target is far and stepping through the bitmap when it is near
+		 */
+		class Cursor
+		{
+			public:
+
+				Cursor(const EliasFano* ef, std::size_t i) noexcept : ef(ef)
+				{
+					this->seek(i);
+				}
+
+				/* name: index
+				 * desc: position in the sequence, size() at the end
+				 * returns: index
+				 */
+				std::size_t index() const noexcept
+				{
+					return this->i;
+				}
+
+				/* name: atEnd
+				 * desc: whether the cursor ran past the last value
+				 * returns: bool
+				 */
+				bool atEnd() const noexcept
+				{
+					return this->i >= this->ef->n;
+				}
+
+				/* name: value
+				 * desc: the current value, not valid at the end
+				 * returns: value
+				 */
+				uint64_t value() const noexcept
+				{
+					return ((this->pos - this->i) << this->ef->L) | this->ef->low(this->i);
+				}
+
+				uint64_t operator*() const noexcept
+				{
+					return this->value();
+				}
+
+				/* name: next
+				 * desc: steps to the next value
+				 * returns: *this
+				 */
+				Cursor& next() noexcept
+				{
+					if(++this->i >= this->ef->n)
+						return *this;
+					this->bits &= this->bits - 1;
+					while(this->bits == 0)
+						this->bits = this->ef->high[++this->w];
+					this->pos = this->w * 64 + static_cast<std::size_t>(__builtin_ctzll(this->bits));
+					return *this;
+				}
+
+				Cursor& operator++() noexcept
+				{
+					return this->next();
+				}
+
+				bool operator!=(const Cursor& right) const noexcept
+				{
+					return this->i != right.i;
+				}
+
+				/* name: skipTo
+				 * desc: moves to the first value >= x at or after the
+				 * current one
+				 * returns: false when there is none
+				 */
+				bool skipTo(uint64_t x) noexcept
+				{
+					if(this->atEnd())
+						return false;
+					if(x > this->ef->last)
+					{
+						this->seek(this->ef->n);
+						return false;
+					}
+
+					const uint64_t h = x >> this->ef->L;
+					/* a bucket more than a word ahead is reached through
+					 * select0, a near one by stepping on the high part only */
+					if(h > this->pos - this->i + 64)
+						this->seek(this->ef->bucketStart(h));
+					while(this->pos - this->i < h)
+						this->next();
+
+					while(this->value() < x)
+						this->next();
+					return true;
+				}
+
+
+			private:
+
+				void seek(std::size_t k) noexcept
+				{
+					this->i = k;
+					if(k >= this->ef->n)
+						return;
+					this->pos = this->ef->select1(k);
+					this->w = this->pos / 64;
+					this->bits = this->ef->high[this->w] & (~uint64_t(0) << (this->pos % 64));
+				}
+
+				const EliasFano* ef;
+				std::size_t i = 0;
+				std::size_t pos = 0;  /* bitmap position of value i */
+				std::size_t w = 0;
+				uint64_t bits = 0;    /* high[w] from pos upwards */
+		};
+
+		/* Empty sequence */
+		EliasFano() noexcept = default;
+
+		/* ctor over n non-decreasing values, see valid() */
+		EliasFano(const uint64_t* values, std::size_t count)
+		{
+			if(count == 0)
+				return;
+			for(std::size_t i = 1; i < count; ++i)
+			{
+				if(values[i] < values[i - 1])
+				{
+					this->sorted = false;
+					return;
+				}
+			}
+
+			this->n = count;
+			this->last = values[count - 1];
+			const uint64_t ratio = this->last / count;
+			this->L = ratio ? 63 - __builtin_clzll(ratio) : 0;
+
+			/* one extra word so low() can always read two */
+			this->lows.assign((count * static_cast<std::size_t>(this->L) + 63) / 64 + 1, 0);
+			const std::size_t highBits = count + static_cast<std::size_t>(this->last >> this->L) + 1;
+			this->high.assign((highBits + 63) / 64 + 1, 0);
+
+			const uint64_t mask = this->L ? (~uint64_t(0) >> (64 - this->L)) : 0;
+			std::size_t zeros = 0;
+			std::size_t prev = 0;
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				if(this->L)
+				{
+					const std::size_t o = i * static_cast<std::size_t>(this->L);
+					const uint64_t v = values[i] & mask;
+					this->lows[o / 64] |= v << (o % 64);
+					if(o % 64 + static_cast<std::size_t>(this->L) > 64)
+						this->lows[o / 64 + 1] |= v >> (64 - o % 64);
+				}
+
+				const std::size_t p = static_cast<std::size_t>(values[i] >> this->L) + i;
+				this->high[p / 64] |= uint64_t(1) << (p % 64);
+
+				if(i % SAMPLE == 0)
+					this->ones.push_back(p);
+				/* zeros between the previous one and this one */
+				for(std::size_t z = i ? prev + 1 : 0; z < p; ++z, ++zeros)
+					if(zeros % SAMPLE == 0)
+						this->zeroes.push_back(z);
+				prev = p;
+			}
+			/* the terminating zero after the last one */
+			if(zeros % SAMPLE == 0)
+				this->zeroes.push_back(prev + 1);
+		}
+
+		EliasFano(const std::vector<uint64_t>& values)
+			: EliasFano(values.data(), values.size())
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: valid
+		 * desc: whether construction succeeded, unsorted input leaves the
+		 * sequence empty and invalid
+		 * returns: bool
+		 */
+		bool valid() const noexcept
+		{
+			return this->sorted;
+		}
+
+		std::size_t size() const noexcept
+		{
+			return this->n;
+		}
+
+		bool empty() const noexcept
+		{
+			return this->n == 0;
+		}
+
+		/* name: lowBits
+		 * desc: width of the packed low parts
+		 * returns: L
+		 */
+		int lowBits() const noexcept
+		{
+			return this->L;
+		}
+
+		/* name: sizeInBits
+		 * desc: storage of the sequence including the select samples
+		 * returns: bit count
+		 */
+		std::size_t sizeInBits() const noexcept
+		{
+			return 64 * (this->lows.size() + this->high.size() + this->ones.size() + this->zeroes.size());
+		}
+
+		/* name: at
+		 * desc: the i-th value, i < size()
+		 * returns: value
+		 */
+		uint64_t at(std::size_t i) const noexcept
+		{
+			return (static_cast<uint64_t>(this->select1(i) - i) << this->L) | this->low(i);
+		}
+
+		uint64_t operator[](std::size_t i) const noexcept
+		{
+			return this->at(i);
+		}
+
+		/* name: nextGeq
+		 * desc: index of the first value >= x
+		 * returns: index, size() when every value is smaller
+		 */
+		std::size_t nextGeq(uint64_t x) const noexcept
+		{
+			if(this->n == 0 || x > this->last)
+				return this->n;
+			Cursor c(this, this->bucketStart(x >> this->L));
+			while(c.value() < x)
+				c.next();
+			return c.index();
+		}
+
+		/* name: cursor
+		 * desc: a cursor on the i-th value
+		 * returns: Cursor
+		 */
+		Cursor cursor(std::size_t i = 0) const noexcept
+		{
+			return Cursor(this, i);
+		}
+
+		Cursor begin() const noexcept
+		{
+			return Cursor(this, 0);
+		}
+
+		Cursor end() const noexcept
+		{
+			return Cursor(this, this->n);
+		}
+
+		/* name: decode
+		 * desc: writes values [start, start + count) to out
+		 * returns: values written, fewer near the end
+		 */
+		std::size_t decode(uint64_t* out, std::size_t start = 0, std::size_t count = ~std::size_t(0)) const noexcept
+		{
+			if(start >= this->n)
+				return 0;
+			if(count > this->n - start)
+				count = this->n - start;
+			if(count == 0)
+				return 0;
+
+			const std::size_t p = this->select1(start);
+			std::size_t w = p / 64;
+			uint64_t bits = this->high[w] & (~uint64_t(0) << (p % 64));
+			/* h counts the zeros passed, i.e. the high part */
+			uint64_t base = static_cast<uint64_t>(w * 64 - start);
+			std::size_t k = 0;
+			while(true)
+			{
+				while(bits)
+				{
+					const uint64_t h = base + static_cast<uint64_t>(__builtin_ctzll(bits)) - k;
+					out[k] = (h << this->L) | this->low(start + k);
+					if(++k == count)
+						return count;
+					bits &= bits - 1;
+				}
+				bits = this->high[++w];
+				base += 64;
+			}
+		}
+
+
+	private:
+
+		/* name: low
+		 * desc: the packed low part of value i
+		 */
+		uint64_t low(std::size_t i) const noexcept
+		{
+			if(this->L == 0)
+				return 0;
+			const std::size_t o = i * static_cast<std::size_t>(this->L);
+			const unsigned s = static_cast<unsigned>(o % 64);
+			uint64_t v = this->lows[o / 64] >> s;
+			if(s)
+				v |= this->lows[o / 64 + 1] << (64 - s);
+			return v & (~uint64_t(0) >> (64 - this->L));
+		}
+
+		/* name: select1
+		 * desc: bitmap position of the (k + 1)-th one, i.e. of value k, from
+		 * the sample before it and a word scan
+		 */
+		std::size_t select1(std::size_t k) const noexcept
+		{
+			const std::size_t p = this->ones[k / SAMPLE];
+			std::size_t w = p / 64;
+			uint64_t bits = this->high[w] & (~uint64_t(0) << (p % 64));
+			std::size_t r = k % SAMPLE;
+			for(;;)
+			{
+				const std::size_t c = static_cast<std::size_t>(__builtin_popcountll(bits));
+				if(r < c)
+					return w * 64 + static_cast<std::size_t>(detail::select_in_word(bits, static_cast<int>(r)));
+				r -= c;
+				bits = this->high[++w];
+			}
+		}
+
+		/* name: select0
+		 * desc: bitmap position of the (k + 1)-th zero, from the sample before
+		 * it and a word scan
+		 */
+		std::size_t select0(std::size_t k) const noexcept
+		{
+			const std::size_t p = this->zeroes[k / SAMPLE];
+			std::size_t w = p / 64;
+			uint64_t bits = ~this->high[w] & (~uint64_t(0) << (p % 64));
+			std::size_t r = k % SAMPLE;
+			for(;;)
+			{
+				const std::size_t c = static_cast<std::size_t>(__builtin_popcountll(bits));
+				if(r < c)
+					return w * 64 + static_cast<std::size_t>(detail::select_in_word(bits, static_cast<int>(r)));
+				r -= c;
+				bits = ~this->high[++w];
+			}
+		}
+
+		/* name: bucketStart
+		 * desc: index of the first value whose high part is >= h, h no
+		 * larger than the high part of the last value
+		 */
+		std::size_t bucketStart(uint64_t h) const noexcept
+		{
+			/* the h-th zero closes bucket h - 1, every one before it is a
+			 * value in a lower bucket */
+			return h == 0 ? 0 : this->select0(static_cast<std::size_t>(h) - 1) + 1 - static_cast<std::size_t>(h);
+		}
+
+		std::size_t n = 0;
+		uint64_t last = 0;
+		int L = 0;
+		bool sorted = true;
+		std::vector<uint64_t> lows;
+		std::vector<uint64_t> high;
+		std::vector<std::size_t> ones;    /* position of every SAMPLE-th one */
+		std::vector<std::size_t> zeroes;  /* position of every SAMPLE-th zero */
+};
+
+/* name: intersect
+ * desc: values present in both sequences, in order, each common value
+ * once per matching pair. The shorter side drives, the longer one skips
+ * returns: count written to out (room for min(a.size(), b.size()))
+ */
+inline std::size_t intersect(const EliasFano& a, const EliasFano& b, uint64_t* out) noexcept
+{
+	const EliasFano& small = a.size() <= b.size() ? a : b;
+	const EliasFano& large = a.size() <= b.size() ? b : a;
+	if(small.empty())
+		return 0;
+
+	std::size_t k = 0;
+	EliasFano::Cursor s = small.cursor();
+	EliasFano::Cursor l = large.cursor();
+	for(; !s.atEnd(); s.next())
+	{
+		const uint64_t v = s.value();
+		if(!l.skipTo(v))
+			break;
+		if(l.value() == v)
+		{
+			out[k++] = v;
+			l.next();
+			if(l.atEnd())
+				break;
+		}
+	}
+	return k;
+}
+
+}
+
+
+#endif
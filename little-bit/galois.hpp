@@ -0,0 +1,624 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: galois.hpp
+ * purpose: carry-less multiply and GF(2^n) arithmetic with bulk
+ * multiply-accumulate kernels for erasure coding
+ */
+
+
+#ifndef BITTLE_GALOIS_HPP
+#define BITTLE_GALOIS_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/* gcc's own avx512 headers trip -Wuninitialized once inlined into target
+ * attributed functions */
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * clmul is the 64 x 64 -> 128 bit carry-less product, PCLMULQDQ when the
+ * cpu has it and masked integer multiplies otherwise. clmul_soft is the
+ * same thing as a constant expression.
+ *
+ * GaloisField<N, Poly, Generator> is GF(2^N) for N from 2 to 16, Poly
+ * being the full reduction polynomial (x^N term included) and Generator
+ * a primitive element, checked at compile time. The log/exp tables are
+ * built at compile time, elements are uint8_t up to N = 8, then uint16_t.
+ *
+ * mulXor(src, c, dst, n) is dst[i] ^= c * src[i], the inner loop of a
+ * Reed-Solomon encode. Multiplying by a constant is linear over GF(2),
+ * so for byte fields it is two 16 entry tables, one per nibble, looked
+ * up 32 or 64 bytes at a time with pshufb, or a single 8 x 8 bit matrix
+ * applied by GFNI's gf2p8affineqb. Both work for any polynomial, not just
+ * the AES one gf2p8mulb is fixed to. The tables are rebuilt per call,
+ * around 50 operations, so hand it whole stripes. Wider fields take the
+ * log/exp loop.
+ */
+
+struct Clmul128
+{
+	uint64_t lo;
+	uint64_t hi;
+};
+
+enum class GfPath
+{
+	best,		// fastest path this cpu supports
+	scalar,		// two nibble table lookups per byte
+	ssse3,		// pshufb split nibble, 16 bytes per step
+	avx2,		// pshufb split nibble, 32 bytes per step
+	avx512bw,	// pshufb split nibble, 64 bytes per step
+	gfni		// gf2p8affineqb, 64 or 32 bytes per step
+};
+
+namespace detail {
+
+/* name: clmul_low
+ * desc: low 64 bits of the carry-less a * b with integer multiplies,
+ * every 4th bit of each operand so carries land in the bits masked off.
+ * No table lookups, so the time does not depend on the operands.
+ * returns: product mod x^64
+ */
+constexpr uint64_t clmul_low(uint64_t a, uint64_t b) noexcept
+{
+	const uint64_t m0 = 0x1111111111111111ULL, m1 = m0 << 1, m2 = m0 << 2, m3 = m0 << 3;
+	const uint64_t a0 = a & m0, a1 = a & m1, a2 = a & m2, a3 = a & m3;
+	const uint64_t b0 = b & m0, b1 = b & m1, b2 = b & m2, b3 = b & m3;
+	const uint64_t z0 = (a0 * b0) ^ (a1 * b3) ^ (a2 * b2) ^ (a3 * b1);
+	const uint64_t z1 = (a0 * b1) ^ (a1 * b0) ^ (a2 * b3) ^ (a3 * b2);
+	const uint64_t z2 = (a0 * b2) ^ (a1 * b1) ^ (a2 * b0) ^ (a3 * b3);
+	const uint64_t z3 = (a0 * b3) ^ (a1 * b2) ^ (a2 * b1) ^ (a3 * b0);
+	return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+}
+
+/* name: clmul_reverse
+ * desc: bit reversal by swaps, the bittle::reverse_bits loop is 64 steps
+ * returns: reversed word
+ */
+constexpr uint64_t clmul_reverse(uint64_t x) noexcept
+{
+	x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+	x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+	x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	return __builtin_bswap64(x);
+}
+
+/* name: clmul_soft
+ * desc: carry-less a * b, the high half is the low half of the reversed
+ * operands reversed back, shifted by one for the 127 bit product
+ * returns: Clmul128
+ */
+constexpr Clmul128 clmul_soft(uint64_t a, uint64_t b) noexcept
+{
+	return Clmul128{clmul_low(a, b), clmul_reverse(clmul_low(clmul_reverse(a), clmul_reverse(b))) >> 1};
+}
+
+#if defined(BITTLE_X86) && defined(__x86_64__)
+
+BITTLE_TARGET("pclmul")
+inline Clmul128 clmul_pclmul(uint64_t a, uint64_t b) noexcept
+{
+	const __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(a)),
+	                                       _mm_cvtsi64_si128(static_cast<long long>(b)), 0x00);
+	return Clmul128{static_cast<uint64_t>(_mm_cvtsi128_si64(p)),
+	                static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(p, p)))};
+}
+
+#endif
+
+/* name: gf_xtime
+ * desc: v * x mod poly, v already reduced
+ * returns: product
+ */
+constexpr uint32_t gf_xtime(uint32_t v, uint32_t poly, int n) noexcept
+{
+	v <<= 1;
+	return (v >> n) & 1 ? v ^ poly : v;
+}
+
+/* name: gf_mul_slow
+ * desc: shift and add a * b mod poly, a and b reduced, one step per
+ * bit of b
+ * returns: product
+ */
+constexpr uint32_t gf_mul_slow(uint32_t a, uint32_t b, uint32_t poly, int n) noexcept
+{
+	uint32_t r = 0;
+	for(; b; b >>= 1)
+	{
+		if(b & 1)
+			r ^= a;
+		a = gf_xtime(a, poly, n);
+	}
+	return r;
+}
+
+/* name: gf_generates
+ * desc: whether g has order 2^n - 1, false when poly is reducible
+ * returns: bool
+ */
+constexpr bool gf_generates(uint32_t poly, int n, uint32_t g) noexcept
+{
+	const uint32_t order = (uint32_t(1) << n) - 1;
+	uint32_t v = g;
+	for(uint32_t i = 1; i < order; ++i)
+	{
+		if(v == 1)
+			return false;
+		v = gf_mul_slow(v, g, poly, n);
+	}
+	return v == 1;
+}
+
+/* Everything the byte kernels need to multiply by one constant */
+struct GfMulTable
+{
+	uint8_t lo[16];		// c * i
+	uint8_t hi[16];		// c * (i << 4)
+	uint64_t affine;	// row i of the bit matrix in byte 7 - i
+};
+
+/* name: gf_mul_table
+ * desc: nibble tables and gf2p8affineqb matrix of multiplying by c,
+ * all from c * x^j for the 8 input bits
+ * returns: GfMulTable
+ */
+inline GfMulTable gf_mul_table(uint32_t c, uint32_t poly, int n) noexcept
+{
+	uint32_t basis[8];
+	basis[0] = c;
+	for(int j = 1; j < 8; ++j)
+		basis[j] = gf_xtime(basis[j - 1], poly, n);
+
+	GfMulTable t;
+	for(int i = 0; i < 16; ++i)
+	{
+		uint32_t l = 0, h = 0;
+		for(int j = 0; j < 4; ++j)
+			if((i >> j) & 1)
+			{
+				l ^= basis[j];
+				h ^= basis[j + 4];
+			}
+		t.lo[i] = static_cast<uint8_t>(l);
+		t.hi[i] = static_cast<uint8_t>(h);
+	}
+
+	t.affine = 0;
+	for(int i = 0; i < 8; ++i)
+	{
+		uint64_t row = 0;
+		for(int j = 0; j < 8; ++j)
+			row |= uint64_t((basis[j] >> i) & 1) << j;
+		t.affine |= row << (8 * (7 - i));
+	}
+	return t;
+}
+
+inline void gf_mul_xor_scalar(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] ^= static_cast<uint8_t>(t.lo[src[i] & 15] ^ t.hi[src[i] >> 4]);
+}
+
+#if defined(BITTLE_X86)
+
+BITTLE_TARGET("ssse3")
+inline void gf_mul_xor_ssse3(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo));
+	const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi));
+	const __m128i low = _mm_set1_epi8(0x0F);
+	std::size_t i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i p = _mm_xor_si128(_mm_shuffle_epi8(lo, _mm_and_si128(x, low)),
+		                                _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(x, 4), low)));
+		__m128i* d = reinterpret_cast<__m128i*>(dst + i);
+		_mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), p));
+	}
+	gf_mul_xor_scalar(src + i, dst + i, n - i, t);
+}
+
+/* c * x per byte from the two nibble tables */
+BITTLE_TARGET("avx2")
+inline __m256i gf_nibble_avx2(__m256i x, __m256i lo, __m256i hi) noexcept
+{
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	return _mm256_xor_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(x, low)),
+	                        _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+}
+
+BITTLE_TARGET("avx512f,avx512bw")
+inline __m512i gf_nibble_avx512(__m512i x, __m512i lo, __m512i hi) noexcept
+{
+	const __m512i low = _mm512_set1_epi8(0x0F);
+	return _mm512_xor_si512(_mm512_shuffle_epi8(lo, _mm512_and_si512(x, low)),
+	                        _mm512_shuffle_epi8(hi, _mm512_and_si512(_mm512_srli_epi16(x, 4), low)));
+}
+
+/* two vectors a step so the shuffles of one hide the loads of the other */
+BITTLE_TARGET("avx2")
+inline void gf_mul_xor_avx2(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo)));
+	const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi)));
+	std::size_t i = 0;
+	for(; i + 64 <= n; i += 64)
+	{
+		const __m256i p0 = gf_nibble_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), lo, hi);
+		const __m256i p1 = gf_nibble_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), lo, hi);
+		__m256i* d = reinterpret_cast<__m256i*>(dst + i);
+		_mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), p0));
+		_mm256_storeu_si256(d + 1, _mm256_xor_si256(_mm256_loadu_si256(d + 1), p1));
+	}
+	for(; i + 32 <= n; i += 32)
+	{
+		__m256i* d = reinterpret_cast<__m256i*>(dst + i);
+		const __m256i p = gf_nibble_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), lo, hi);
+		_mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), p));
+	}
+	gf_mul_xor_scalar(src + i, dst + i, n - i, t);
+}
+
+BITTLE_TARGET("avx512f,avx512bw")
+inline void gf_mul_xor_avx512(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	const __m512i lo = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo)));
+	const __m512i hi = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi)));
+	std::size_t i = 0;
+	for(; i + 128 <= n; i += 128)
+	{
+		const __m512i p0 = gf_nibble_avx512(_mm512_loadu_si512(src + i), lo, hi);
+		const __m512i p1 = gf_nibble_avx512(_mm512_loadu_si512(src + i + 64), lo, hi);
+		_mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_loadu_si512(dst + i), p0));
+		_mm512_storeu_si512(dst + i + 64, _mm512_xor_si512(_mm512_loadu_si512(dst + i + 64), p1));
+	}
+	/* masked tail, at most two steps */
+	for(; i < n; i += 64)
+	{
+		const __mmask64 m = n - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (n - i)) - 1;
+		const __m512i p = gf_nibble_avx512(_mm512_maskz_loadu_epi8(m, src + i), lo, hi);
+		_mm512_mask_storeu_epi8(dst + i, m, _mm512_xor_si512(_mm512_maskz_loadu_epi8(m, dst + i), p));
+	}
+}
+
+BITTLE_TARGET("gfni,avx2")
+inline void gf_mul_xor_gfni_avx2(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	const __m256i a = _mm256_set1_epi64x(static_cast<long long>(t.affine));
+	std::size_t i = 0;
+	for(; i + 64 <= n; i += 64)
+	{
+		const __m256i p0 = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), a, 0);
+		const __m256i p1 = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), a, 0);
+		__m256i* d = reinterpret_cast<__m256i*>(dst + i);
+		_mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), p0));
+		_mm256_storeu_si256(d + 1, _mm256_xor_si256(_mm256_loadu_si256(d + 1), p1));
+	}
+	for(; i + 32 <= n; i += 32)
+	{
+		__m256i* d = reinterpret_cast<__m256i*>(dst + i);
+		const __m256i p = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), a, 0);
+		_mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), p));
+	}
+	gf_mul_xor_scalar(src + i, dst + i, n - i, t);
+}
+
+BITTLE_TARGET("gfni,avx512f,avx512bw")
+inline void gf_mul_xor_gfni_avx512(const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	const __m512i a = _mm512_set1_epi64(static_cast<long long>(t.affine));
+	std::size_t i = 0;
+	for(; i + 128 <= n; i += 128)
+	{
+		const __m512i p0 = _mm512_gf2p8affine_epi64_epi8(_mm512_loadu_si512(src + i), a, 0);
+		const __m512i p1 = _mm512_gf2p8affine_epi64_epi8(_mm512_loadu_si512(src + i + 64), a, 0);
+		_mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_loadu_si512(dst + i), p0));
+		_mm512_storeu_si512(dst + i + 64, _mm512_xor_si512(_mm512_loadu_si512(dst + i + 64), p1));
+	}
+	for(; i < n; i += 64)
+	{
+		const __mmask64 m = n - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (n - i)) - 1;
+		const __m512i p = _mm512_gf2p8affine_epi64_epi8(_mm512_maskz_loadu_epi8(m, src + i), a, 0);
+		_mm512_mask_storeu_epi8(dst + i, m, _mm512_xor_si512(_mm512_maskz_loadu_epi8(m, dst + i), p));
+	}
+}
+
+#endif
+
+/* name: gf_path_available
+ * desc: whether this cpu runs path p
+ * returns: bool
+ */
+inline bool gf_path_available(GfPath p) noexcept
+{
+#if defined(BITTLE_X86)
+	const CpuFeatures& f = cpu_features();
+	switch(p)
+	{
+		case GfPath::ssse3: return f.ssse3;
+		case GfPath::avx2: return f.avx2;
+		case GfPath::avx512bw: return f.avx512f && f.avx512bw;
+		case GfPath::gfni: return f.gfni && (f.avx2 || (f.avx512f && f.avx512bw));
+		default: return true;
+	}
+#else
+	return p == GfPath::best || p == GfPath::scalar;
+#endif
+}
+
+/* name: gf_path
+ * desc: p itself when the cpu runs it, the fastest path otherwise
+ * returns: GfPath, never best
+ */
+inline GfPath gf_path(GfPath p) noexcept
+{
+	static const GfPath fastest =
+		gf_path_available(GfPath::gfni) ? GfPath::gfni :
+		gf_path_available(GfPath::avx512bw) ? GfPath::avx512bw :
+		gf_path_available(GfPath::avx2) ? GfPath::avx2 :
+		gf_path_available(GfPath::ssse3) ? GfPath::ssse3 : GfPath::scalar;
+	return p != GfPath::best && gf_path_available(p) ? p : fastest;
+}
+
+inline void gf_mul_xor(GfPath p, const uint8_t* src, uint8_t* dst, std::size_t n, const GfMulTable& t) noexcept
+{
+	switch(gf_path(p))
+	{
+#if defined(BITTLE_X86)
+		case GfPath::gfni:
+			return cpu_features().avx512bw && cpu_features().avx512f ? gf_mul_xor_gfni_avx512(src, dst, n, t) :
+			                                                          gf_mul_xor_gfni_avx2(src, dst, n, t);
+		case GfPath::avx512bw: return gf_mul_xor_avx512(src, dst, n, t);
+		case GfPath::avx2: return gf_mul_xor_avx2(src, dst, n, t);
+		case GfPath::ssse3: return gf_mul_xor_ssse3(src, dst, n, t);
+#endif
+		default: return gf_mul_xor_scalar(src, dst, n, t);
+	}
+}
+
+}
+
+/* name: clmul
+ * desc: 128 bit carry-less product of a and b
+ * returns: Clmul128
+ */
+inline Clmul128 clmul(uint64_t a, uint64_t b) noexcept
+{
+#if defined(BITTLE_X86) && defined(__x86_64__)
+	static const bool hardware = cpu_features().pclmul;
+	if(hardware)
+		return detail::clmul_pclmul(a, b);
+#endif
+	return detail::clmul_soft(a, b);
+}
+
+inline Clmul128 clmul(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return clmul(a.value(), b.value());
+}
+
+/* name: clmul_soft
+ * desc: clmul without the instruction, usable in constant expressions
+ * returns: Clmul128
+ */
+constexpr Clmul128 clmul_soft(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return detail::clmul_soft(a.value(), b.value());
+}
+
+template <int N, uint32_t Poly, uint32_t Generator = 2>
+class GaloisField
+{
+	static_assert(N >= 2 && N <= 16, "GaloisField takes 2 to 16 bit elements");
+	static_assert((Poly >> N) == 1, "Poly must be the reduction polynomial with its x^N term");
+	static_assert(Generator > 1 && Generator < (uint32_t(1) << N), "Generator must be a field element");
+	static_assert(detail::gf_generates(Poly, N, Generator),
+	              "Generator is not primitive, or Poly is not irreducible");
+
+	public:
+
+		using value_type = typename std::conditional<(N <= 8), uint8_t, uint16_t>::type;
+
+		static constexpr int bits = N;
+
+		/* Size of the multiplicative group, 2^N - 1 */
+		static constexpr uint32_t ORDER = (uint32_t(1) << N) - 1;
+
+		/* exp runs twice around the group so a log sum needs no modulo,
+		 * log[0] is unused */
+		struct Tables
+		{
+			value_type exp[2 * ORDER];
+			uint16_t log[ORDER + 1];
+		};
+
+		static const Tables tables;
+
+		/*
+		 *
+		 *
+		 * Static Member Methods
+		 *
+		 *
+		 */
+
+		/* name: add
+		 * desc: a + b, which is also a - b
+		 * returns: sum
+		 */
+		static constexpr value_type add(value_type a, value_type b) noexcept
+		{
+			return static_cast<value_type>(a ^ b);
+		}
+
+		static constexpr value_type sub(value_type a, value_type b) noexcept
+		{
+			return static_cast<value_type>(a ^ b);
+		}
+
+		/* name: mul
+		 * desc: a * b through the log/exp tables
+		 * returns: product
+		 */
+		static value_type mul(value_type a, value_type b) noexcept
+		{
+			return a && b ? tables.exp[tables.log[a] + tables.log[b]] : value_type(0);
+		}
+
+		/* name: mulSlow
+		 * desc: a * b by shift and add, for constant expressions
+		 * returns: product
+		 */
+		static constexpr value_type mulSlow(value_type a, value_type b) noexcept
+		{
+			return static_cast<value_type>(detail::gf_mul_slow(a, b, Poly, N));
+		}
+
+		/* name: div
+		 * desc: a / b, 0 when b is 0
+		 * returns: quotient
+		 */
+		static value_type div(value_type a, value_type b) noexcept
+		{
+			return a && b ? tables.exp[tables.log[a] + ORDER - tables.log[b]] : value_type(0);
+		}
+
+		/* name: inv
+		 * desc: multiplicative inverse, 0 for 0
+		 * returns: inverse
+		 */
+		static value_type inv(value_type a) noexcept
+		{
+			return a ? tables.exp[ORDER - tables.log[a]] : value_type(0);
+		}
+
+		/* name: pow
+		 * desc: a^e, with 0^0 = 1
+		 * returns: power
+		 */
+		static value_type pow(value_type a, uint64_t e) noexcept
+		{
+			if(!a)
+				return e ? value_type(0) : value_type(1);
+			return tables.exp[(uint64_t(tables.log[a]) * (e % ORDER)) % ORDER];
+		}
+
+		/* name: exp
+		 * desc: Generator^i
+		 * returns: element
+		 */
+		static value_type exp(uint64_t i) noexcept
+		{
+			return tables.exp[i % ORDER];
+		}
+
+		/* name: log
+		 * desc: discrete log to base Generator, a must not be 0
+		 * returns: i with Generator^i = a
+		 */
+		static uint32_t log(value_type a) noexcept
+		{
+			return tables.log[a];
+		}
+
+		/* name: mulXor
+		 * desc: dst[i] ^= c * src[i] over n elements, src and dst may be
+		 * the same buffer
+		 * returns: nothing
+		 */
+		static void mulXor(const value_type* src, value_type c, value_type* dst, std::size_t n,
+		                   GfPath path = GfPath::best) noexcept
+		{
+			if(!c)
+				return;
+			mulXorImpl(src, c, dst, n, path, std::integral_constant<bool, (N <= 8)>());
+		}
+
+		/* name: implementation
+		 * desc: name of the kernel mulXor runs for path
+		 * returns: name
+		 */
+		static const char* implementation(GfPath path = GfPath::best) noexcept
+		{
+			if(N > 8)
+				return "log/exp";
+			switch(detail::gf_path(path))
+			{
+				case GfPath::gfni: return cpu_features().avx512bw && cpu_features().avx512f ? "gfni/avx512bw" : "gfni/avx2";
+				case GfPath::avx512bw: return "avx512bw";
+				case GfPath::avx2: return "avx2";
+				case GfPath::ssse3: return "ssse3";
+				default: return "scalar";
+			}
+		}
+
+
+	private:
+
+		/* name: makeTables
+		 * desc: powers of Generator and their logs
+		 * returns: Tables
+		 */
+		static constexpr Tables makeTables() noexcept
+		{
+			Tables r{};
+			uint32_t v = 1;
+			for(uint32_t i = 0; i < ORDER; ++i)
+			{
+				r.exp[i] = static_cast<value_type>(v);
+				r.exp[i + ORDER] = static_cast<value_type>(v);
+				r.log[v] = static_cast<uint16_t>(i);
+				v = detail::gf_mul_slow(v, Generator, Poly, N);
+			}
+			return r;
+		}
+
+		static void mulXorImpl(const value_type* src, value_type c, value_type* dst, std::size_t n, GfPath path,
+		                       std::true_type) noexcept
+		{
+			const detail::GfMulTable t = detail::gf_mul_table(c, Poly, N);
+			detail::gf_mul_xor(path, src, dst, n, t);
+		}
+
+		static void mulXorImpl(const value_type* src, value_type c, value_type* dst, std::size_t n, GfPath,
+		                       std::false_type) noexcept
+		{
+			const uint32_t lc = tables.log[c];
+			for(std::size_t i = 0; i < n; ++i)
+				if(src[i])
+					dst[i] ^= tables.exp[tables.log[src[i]] + lc];
+		}
+};
+
+template <int N, uint32_t P, uint32_t G>
+const typename GaloisField<N, P, G>::Tables GaloisField<N, P, G>::tables = GaloisField<N, P, G>::makeTables();
+
+/* Declarations for ease of use */
+using GF16 = GaloisField<4, 0x13>;
+using GF256 = GaloisField<8, 0x11D>;			// Reed-Solomon erasure codes
+using GF256Aes = GaloisField<8, 0x11B, 3>;		// AES, x is not primitive there
+using GF65536 = GaloisField<16, 0x1100B>;
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+
+#endif
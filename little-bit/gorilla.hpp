@@ -0,0 +1,423 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: gorilla.hpp
+ * purpose: Gorilla style delta-of-delta and XOR time-series compression
+ */
+
+
+#ifndef BITTLE_GORILLA_HPP
+#define BITTLE_GORILLA_HPP
+
+#include "bittle.hpp"
+#include "bit_stream.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * (timestamp, value) samples in one bit stream, after Facebook's Gorilla:
+ *
+ *   timestamp  the first raw, then the delta of the delta to the last
+ *              one: '0' when it is 0, '10' + 7 bits, '110' + 9 bits,
+ *              '1110' + 12 bits, or '1111' + the full 64 bits
+ *   value      the first raw, then XOR with the previous value: '0'
+ *              when equal; '10' + the meaningful bits when they fit the
+ *              previous leading/trailing zero window; otherwise '11' +
+ *              5 bits of leading zeros + the meaningful length (6 bits
+ *              for 64 bit values, 5 for 32, the full width written as 0)
+ *              + the meaningful bits
+ *
+ * Regular timestamps cost one bit, slowly moving values a handful. T is
+ * double, float or any integral type; the decoder needs the sample count,
+ * which the stream does not store.
+ */
+
+namespace detail {
+
+template <typename T>
+struct gorilla_bits
+{
+	using type = typename std::conditional<sizeof(T) == 8, uint64_t,
+	             typename std::conditional<sizeof(T) == 4, uint32_t, void>::type>::type;
+
+	static_assert(std::is_arithmetic<T>::value && !std::is_void<type>::value,
+	              "Gorilla values are 32 or 64 bit arithmetic types");
+
+	static constexpr int WIDTH = sizeof(T) * BIT_SIZE;
+	static constexpr int LENGTH_BITS = WIDTH == 64 ? 6 : 5;
+
+	static type raw(const T& v) noexcept
+	{
+		type r;
+		std::memcpy(&r, &v, sizeof(r));
+		return r;
+	}
+
+	static T value(const type& r) noexcept
+	{
+		T v;
+		std::memcpy(&v, &r, sizeof(v));
+		return v;
+	}
+};
+
+/* name: zigzag
+ * desc: maps small negative and positive numbers to small unsigned ones
+ * returns: encoded / decoded number
+ */
+constexpr uint64_t zigzag(int64_t v) noexcept
+{
+	return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+constexpr int64_t unzigzag(uint64_t v) noexcept
+{
+	return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+}
+
+template <typename T = double>
+class GorillaEncoder
+{
+	using traits = detail::gorilla_bits<T>;
+	using raw_type = typename traits::type;
+
+
+	public:
+
+		GorillaEncoder() = default;
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: size
+		 * desc: samples appended
+		 * returns: sample count
+		 */
+		std::size_t size() const noexcept
+		{
+			return this->count;
+		}
+
+		/* name: bits
+		 * desc: size of the stream
+		 * returns: bit count
+		 */
+		std::size_t bits() const noexcept
+		{
+			return this->out.bits();
+		}
+
+		/* name: bytes
+		 * desc: copy of the stream so far, decodable while appending goes on
+		 * returns: byte vector
+		 */
+		std::vector<uint8_t> bytes() const
+		{
+			return this->out.bytes();
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: append
+		 * desc: adds one sample
+		 * returns: *this
+		 */
+		GorillaEncoder& append(int64_t timestamp, const T& value)
+		{
+			const raw_type v = traits::raw(value);
+			if(this->count++ == 0)
+			{
+				this->out.write(static_cast<uint64_t>(timestamp), 64);
+				this->out.write(v, traits::WIDTH);
+				this->lastTime = timestamp;
+				this->lastValue = v;
+				return *this;
+			}
+
+			this->appendTime(timestamp);
+			this->appendValue(v);
+			return *this;
+		}
+
+		/* name: finish
+		 * desc: pads the stream to a byte, no appends may follow
+		 * returns: the stream
+		 */
+		const std::vector<uint8_t>& finish()
+		{
+			return this->out.finish();
+		}
+
+		/* name: reset
+		 * desc: starts a new empty stream
+		 * returns: nothing
+		 */
+		void reset() noexcept
+		{
+			this->out.reset();
+			this->count = 0;
+			this->lastDelta = 0;
+			this->leading = -1;
+			this->trailing = 0;
+		}
+
+
+	private:
+
+		void appendTime(int64_t t)
+		{
+			const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(t) - static_cast<uint64_t>(this->lastTime));
+			const int64_t dod = static_cast<int64_t>(static_cast<uint64_t>(delta) - static_cast<uint64_t>(this->lastDelta));
+			this->lastTime = t;
+			this->lastDelta = delta;
+
+			/* prefix and payload go out in one write where they fit */
+			const uint64_t z = detail::zigzag(dod);
+			if(z == 0)
+				this->out.write(0, 1);
+			else if(z < (uint64_t(1) << 7))
+				this->out.write((uint64_t(0x2) << 7) | z, 9);
+			else if(z < (uint64_t(1) << 9))
+				this->out.write((uint64_t(0x6) << 9) | z, 12);
+			else if(z < (uint64_t(1) << 12))
+				this->out.write((uint64_t(0xE) << 12) | z, 16);
+			else
+				this->out.write(0xF, 4).write(z, 64);
+		}
+
+		void appendValue(raw_type v)
+		{
+			const raw_type x = static_cast<raw_type>(v ^ this->lastValue);
+			this->lastValue = v;
+			if(x == 0)
+			{
+				this->out.write(0, 1);
+				return;
+			}
+
+			int lead = bittle::count_leading_zeroes<raw_type>(x);
+			const int trail = bittle::count_trailing_zeroes<raw_type>(x);
+			if(lead > 31)
+				lead = 31;
+
+			if(this->leading >= 0 && lead >= this->leading && trail >= this->trailing)
+			{
+				const int len = traits::WIDTH - this->leading - this->trailing;
+				this->out.write(0x2, 2).write(static_cast<uint64_t>(x >> this->trailing), len);
+				return;
+			}
+
+			const int len = traits::WIDTH - lead - trail;
+			this->out.write((uint64_t(0x3) << (5 + traits::LENGTH_BITS)) |
+			                (static_cast<uint64_t>(lead) << traits::LENGTH_BITS) |
+			                static_cast<uint64_t>(len == traits::WIDTH ? 0 : len), 2 + 5 + traits::LENGTH_BITS);
+			this->out.write(static_cast<uint64_t>(x >> trail), len);
+			this->leading = lead;
+			this->trailing = trail;
+		}
+
+		BitWriter out;
+		std::size_t count = 0;
+		int64_t lastTime = 0;
+		int64_t lastDelta = 0;
+		raw_type lastValue = 0;
+		int leading = -1;   /* window of the last explicit XOR, -1 before one */
+		int trailing = 0;
+};
+
+template <typename T = double>
+class GorillaDecoder
+{
+	using traits = detail::gorilla_bits<T>;
+	using raw_type = typename traits::type;
+
+
+	public:
+
+		/* ctor over a stream of 'count' samples */
+		GorillaDecoder(const uint8_t* data, std::size_t bytes, std::size_t count) noexcept
+			: in(data, bytes), remaining(count)
+		{
+		}
+
+		GorillaDecoder(const std::vector<uint8_t>& stream, std::size_t count) noexcept
+			: GorillaDecoder(stream.data(), stream.size(), count)
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: left
+		 * desc: samples left to decode
+		 * returns: sample count
+		 */
+		std::size_t left() const noexcept
+		{
+			return this->remaining;
+		}
+
+		/* name: ok
+		 * desc: whether every sample so far lay inside the stream and had
+		 * a valid bit window
+		 * returns: bool
+		 */
+		bool ok() const noexcept
+		{
+			return !this->in.overrun() && !this->corrupt;
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: next
+		 * desc: decodes one sample, a corrupt value window ends the stream
+		 * returns: false when all samples were read or ok() turned false
+		 */
+		bool next(int64_t& timestamp, T& value) noexcept
+		{
+			if(this->remaining == 0)
+				return false;
+			--this->remaining;
+
+			if(this->first)
+			{
+				this->first = false;
+				this->lastTime = static_cast<int64_t>(this->in.read(64));
+				this->lastValue = static_cast<raw_type>(this->in.read(traits::WIDTH));
+			}
+			else
+			{
+				this->nextTime();
+				if(!this->nextValue())
+				{
+					this->corrupt = true;
+					this->remaining = 0;
+					return false;
+				}
+			}
+			timestamp = this->lastTime;
+			value = traits::value(this->lastValue);
+			return true;
+		}
+
+		/* name: decode
+		 * desc: decodes up to 'max' samples into two arrays
+		 * returns: samples decoded
+		 */
+		std::size_t decode(int64_t* timestamps, T* values, std::size_t max) noexcept
+		{
+			std::size_t k = 0;
+			for(; k < max && this->next(timestamps[k], values[k]); ++k)
+			{
+			}
+			return k;
+		}
+
+
+	private:
+
+		void nextTime() noexcept
+		{
+			/* the prefix is at most four bits, one peek decides it */
+			const uint64_t p = this->in.peek(4);
+			uint64_t z;
+			if(p < 0x8)
+			{
+				this->in.skip(1);
+				z = 0;
+			}
+			else if(p < 0xC)
+			{
+				z = this->in.read(9) & 0x7F;
+			}
+			else if(p < 0xE)
+			{
+				z = this->in.read(12) & 0x1FF;
+			}
+			else if(p < 0xF)
+			{
+				z = this->in.read(16) & 0xFFF;
+			}
+			else
+			{
+				this->in.skip(4);
+				z = this->in.read(64);
+			}
+			this->lastDelta = static_cast<int64_t>(static_cast<uint64_t>(this->lastDelta) + static_cast<uint64_t>(detail::unzigzag(z)));
+			this->lastTime = static_cast<int64_t>(static_cast<uint64_t>(this->lastTime) + static_cast<uint64_t>(this->lastDelta));
+		}
+
+		/* false on a window that does not fit in WIDTH bits, which only a
+		 * corrupt or truncated stream can hold */
+		bool nextValue() noexcept
+		{
+			const uint64_t p = this->in.peek(2);
+			if(p < 0x2)
+			{
+				this->in.skip(1);
+				return true;
+			}
+			if(p == 0x3)
+			{
+				const uint64_t h = this->in.read(2 + 5 + traits::LENGTH_BITS);
+				const int lead = static_cast<int>((h >> traits::LENGTH_BITS) & 0x1F);
+				int len = static_cast<int>(h & ((1u << traits::LENGTH_BITS) - 1));
+				if(len == 0)
+					len = traits::WIDTH;
+				if(lead + len > traits::WIDTH)
+					return false;
+				this->leading = lead;
+				this->trailing = traits::WIDTH - lead - len;
+			}
+			else
+			{
+				this->in.skip(2);
+			}
+			const int len = traits::WIDTH - this->leading - this->trailing;
+			this->lastValue ^= static_cast<raw_type>(this->in.read(len) << this->trailing);
+			return true;
+		}
+
+		BitReader in;
+		std::size_t remaining;
+		bool first = true;
+		int64_t lastTime = 0;
+		int64_t lastDelta = 0;
+		raw_type lastValue = 0;
+		int leading = 0;
+		int trailing = 0;
+		bool corrupt = false;
+};
+
+}
+
+
+#endif
@@ -0,0 +1,801 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hamming_search.hpp
+ * purpose: top-k and radius nearest neighbour search over binary codes
+ */
+
+
+#ifndef BITTLE_HAMMING_SEARCH_HPP
+#define BITTLE_HAMMING_SEARCH_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* same as dispatch.hpp, gcc's avx512 headers trip -Wuninitialized */
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace bittle {
+
+/* namespace: bittle
+ * Exact nearest neighbours of binary codes under Hamming distance.
+ * HammingIndex<WORDS> keeps n codes of WORDS 64 bit words back to back
+ * and answers by scanning them:
+ *
+ *     HammingIndex<4> index(codes, n);            256 bit codes
+ *     std::vector<HammingHit> hits(10);
+ *     index.search(query, 10, hits.data());       10 nearest, closest first
+ *
+ * The scan computes the distances of a block of codes at a time with the
+ * best popcount the cpu has (AVX-512 VPOPCNTDQ, AVX2 nibble lookup or
+ * popcnt), then offers them to a bounded max heap whose root is the
+ * k-th best so far; after warm up almost every code fails that one
+ * compare. searchBatch runs several queries over each block while it is
+ * in cache, and both split the codes across threads when asked to.
+ *
+ * Ties go to the lower index, so results are the first k of all codes
+ * sorted by (distance, index) whatever the kernel or thread count.
+ *
+ * HammingMultiIndex adds multi-index hashing for small radius queries:
+ * the codes are cut into m substrings, each indexed by its value, and a
+ * code within r of the query matches it within r / m on at least one
+ * substring, so only those buckets are probed and checked.
+ */
+
+struct HammingHit
+{
+	uint32_t index;
+	uint32_t distance;
+};
+
+namespace detail {
+
+/* Codes scanned per block, the distances of one block fit in L1 */
+static constexpr std::size_t HAMMING_BLOCK = 512;
+
+using hamming_scan_fn = void (*)(const uint64_t*, std::size_t, const uint64_t*, uint32_t*);
+
+/* Scan kernels: out[i] = distance(codes[i], query) for n codes */
+
+template <std::size_t WORDS>
+inline void hamming_scan_scalar(const uint64_t* codes, std::size_t n, const uint64_t* query, uint32_t* out) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i, codes += WORDS)
+	{
+		uint64_t d = 0;
+		for(std::size_t w = 0; w < WORDS; ++w)
+		{
+			uint64_t x = codes[w] ^ query[w];
+			x = x - ((x >> 1) & 0x5555555555555555ULL);
+			x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+			x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			d += (x * 0x0101010101010101ULL) >> 56;
+		}
+		out[i] = static_cast<uint32_t>(d);
+	}
+}
+
+#if defined(BITTLE_X86)
+
+/* one code, the word loop spelled out by the pack */
+template <std::size_t... W>
+BITTLE_TARGET("popcnt")
+inline uint32_t hamming_code_popcnt(const uint64_t* code, const uint64_t* query, std::index_sequence<W...>) noexcept
+{
+	uint32_t d = 0;
+	const int unused[] = {0, (d += bittle::count_ones<uint64_t>(code[W] ^ query[W]), 0)...};
+	(void)unused;
+	return d;
+}
+
+template <std::size_t WORDS>
+BITTLE_TARGET("popcnt")
+inline void hamming_scan_popcnt(const uint64_t* codes, std::size_t n, const uint64_t* query, uint32_t* out) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i, codes += WORDS)
+		out[i] = hamming_code_popcnt(codes, query, std::make_index_sequence<WORDS>());
+}
+
+/* per byte popcounts by nibble lookup */
+BITTLE_TARGET("avx2")
+inline __m256i hamming_bytes_avx2(__m256i v) noexcept
+{
+	const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                                     0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+	return _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)),
+	                       _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+}
+
+/* per word popcounts of a ^ b */
+BITTLE_TARGET("avx2")
+inline __m256i hamming_words_avx2(const uint64_t* a, __m256i b) noexcept
+{
+	const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)), b);
+	return _mm256_sad_epu8(hamming_bytes_avx2(x), _mm256_setzero_si256());
+}
+
+/* distances of two codes of two words, each in both of its lanes */
+BITTLE_TARGET("avx2")
+inline __m256i hamming_pair_avx2(const uint64_t* codes, __m256i q) noexcept
+{
+	const __m256i s = hamming_words_avx2(codes, q);
+	return _mm256_add_epi64(s, _mm256_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+/* word counts of one code of WORDS = 4, 8, .. words */
+template <std::size_t WORDS>
+BITTLE_TARGET("avx2")
+inline __m256i hamming_code_avx2(const uint64_t* code, const __m256i* q) noexcept
+{
+	__m256i bytes = _mm256_setzero_si256();
+	for(std::size_t c = 0; c < WORDS / 4; ++c)
+		bytes = _mm256_add_epi8(bytes, hamming_bytes_avx2(_mm256_xor_si256(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(code + 4 * c)), q[c])));
+	return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+/* four registers of small lane counts as 16 bit fields of one */
+BITTLE_TARGET("avx2")
+inline __m256i hamming_pack_avx2(__m256i a, __m256i b, __m256i c, __m256i d) noexcept
+{
+	return _mm256_or_si256(_mm256_or_si256(a, _mm256_slli_epi64(b, 16)),
+	                       _mm256_or_si256(_mm256_slli_epi64(c, 32), _mm256_slli_epi64(d, 48)));
+}
+
+/* Codes of 1, 2 or a multiple of 4 words. Word counts come out of psadbw
+ * in 64 bit lanes and are packed into 32 bit distances in code order:
+ * for wide codes four codes share a register as 16 bit fields, so one
+ * horizontal add sums all four. */
+template <std::size_t WORDS>
+BITTLE_TARGET("avx2,popcnt")
+inline void hamming_scan_avx2(const uint64_t* codes, std::size_t n, const uint64_t* query, uint32_t* out) noexcept
+{
+	std::size_t i = 0;
+	if(WORDS == 1)
+	{
+		const __m256i q = _mm256_set1_epi64x(static_cast<long long>(query[0]));
+		const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+		for(; i + 8 <= n; i += 8)
+		{
+			const __m256i a = hamming_words_avx2(codes + i, q);
+			const __m256i b = hamming_words_avx2(codes + i + 4, q);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+			                    _mm256_permutevar8x32_epi32(_mm256_or_si256(a, _mm256_slli_epi64(b, 32)), order));
+		}
+	}
+	else if(WORDS == 2)
+	{
+		const __m256i q = _mm256_setr_epi64x(static_cast<long long>(query[0]), static_cast<long long>(query[1 % WORDS]),
+		                                     static_cast<long long>(query[0]), static_cast<long long>(query[1 % WORDS]));
+		const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+		for(; i + 8 <= n; i += 8)
+		{
+			const uint64_t* code = codes + 2 * i;
+			const __m256i x = _mm256_blend_epi32(hamming_pair_avx2(code, q), _mm256_slli_epi64(hamming_pair_avx2(code + 4, q), 32), 0xAA);
+			const __m256i y = _mm256_blend_epi32(hamming_pair_avx2(code + 8, q), _mm256_slli_epi64(hamming_pair_avx2(code + 12, q), 32), 0xAA);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+			                    _mm256_permutevar8x32_epi32(_mm256_blend_epi32(x, y, 0xCC), order));
+		}
+	}
+	else
+	{
+		__m256i q[(WORDS + 3) / 4];   /* only multiples of 4 get here */
+		for(std::size_t c = 0; c < WORDS / 4; ++c)
+			q[c] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(query + 4 * c));
+		for(; i + 4 <= n; i += 4)
+		{
+			const uint64_t* code = codes + i * WORDS;
+			__m256i packed = hamming_pack_avx2(hamming_code_avx2<WORDS>(code, q), hamming_code_avx2<WORDS>(code + WORDS, q),
+			                                   hamming_code_avx2<WORDS>(code + 2 * WORDS, q),
+			                                   hamming_code_avx2<WORDS>(code + 3 * WORDS, q));
+			packed = _mm256_add_epi64(packed, _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(1, 0, 3, 2)));
+			packed = _mm256_add_epi64(packed, _mm256_shuffle_epi32(packed, _MM_SHUFFLE(1, 0, 3, 2)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvtepu16_epi32(_mm256_castsi256_si128(packed)));
+		}
+	}
+	hamming_scan_popcnt<WORDS>(codes + i * WORDS, n - i, query, out + i);
+}
+
+/* lane counts of one code, a masked load per eight words */
+template <std::size_t WORDS>
+BITTLE_TARGET("avx512f,avx512vpopcntdq")
+inline __m512i hamming_code_avx512(const uint64_t* code, const __m512i* q) noexcept
+{
+	constexpr std::size_t CHUNKS = (WORDS + 7) / 8;
+	const __mmask8 tail = static_cast<__mmask8>(WORDS % 8 ? (1u << (WORDS % 8)) - 1 : 0xFF);
+	__m512i count = _mm512_setzero_si512();
+	for(std::size_t c = 0; c < CHUNKS; ++c)
+		count = _mm512_add_epi64(count, _mm512_popcnt_epi64(_mm512_xor_si512(
+			_mm512_maskz_loadu_epi64(c + 1 < CHUNKS ? 0xFF : tail, code + 8 * c), q[c])));
+	return count;
+}
+
+BITTLE_TARGET("avx512f")
+inline __m512i hamming_pack_avx512(__m512i a, __m512i b, __m512i c, __m512i d) noexcept
+{
+	return _mm512_or_si512(_mm512_or_si512(a, _mm512_slli_epi64(b, 16)),
+	                       _mm512_or_si512(_mm512_slli_epi64(c, 32), _mm512_slli_epi64(d, 48)));
+}
+
+/* Any width. Codes of one, two or four words fill a register with
+ * several codes, other widths take a masked load per eight words and
+ * pack four codes as 16 bit fields, two such registers sharing one
+ * reduction. */
+template <std::size_t WORDS>
+BITTLE_TARGET("avx512f,avx512vpopcntdq,popcnt")
+inline void hamming_scan_avx512(const uint64_t* codes, std::size_t n, const uint64_t* query, uint32_t* out) noexcept
+{
+	std::size_t i = 0;
+	if(WORDS == 1)
+	{
+		const __m512i q = _mm512_set1_epi64(static_cast<long long>(query[0]));
+		for(; i + 8 <= n; i += 8)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+			                    _mm512_cvtepi64_epi32(_mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(codes + i), q))));
+	}
+	else if(WORDS == 2)
+	{
+		const __m512i q = _mm512_set4_epi64(static_cast<long long>(query[1 % WORDS]), static_cast<long long>(query[0]),
+		                                    static_cast<long long>(query[1 % WORDS]), static_cast<long long>(query[0]));
+		const __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+		const __m512i odd = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+		for(; i + 8 <= n; i += 8)
+		{
+			const __m512i a = _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(codes + 2 * i), q));
+			const __m512i b = _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(codes + 2 * i + 8), q));
+			const __m512i d = _mm512_add_epi64(_mm512_permutex2var_epi64(a, even, b), _mm512_permutex2var_epi64(a, odd, b));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi64_epi32(d));
+		}
+	}
+	else if(WORDS == 4)
+	{
+		/* two codes per register; the 16 bit fields of eight codes are
+		 * summed within each half and come out interleaved in order */
+		const __m512i q = _mm512_broadcast_i64x4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(query)));
+		for(; i + 8 <= n; i += 8)
+		{
+			const uint64_t* code = codes + i * WORDS;
+			__m512i packed = hamming_pack_avx512(_mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(code), q)),
+			                                     _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(code + 8), q)),
+			                                     _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(code + 16), q)),
+			                                     _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_loadu_si512(code + 24), q)));
+			packed = _mm512_add_epi64(packed, _mm512_shuffle_i64x2(packed, packed, _MM_SHUFFLE(2, 3, 0, 1)));
+			packed = _mm512_add_epi64(packed, _mm512_shuffle_epi32(packed, _MM_PERM_BADC));
+			const __m128i even = _mm512_castsi512_si128(packed);
+			const __m128i odd = _mm512_extracti32x4_epi32(packed, 2);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtepu16_epi32(_mm_unpacklo_epi16(even, odd)));
+		}
+	}
+	else
+	{
+		constexpr std::size_t CHUNKS = (WORDS + 7) / 8;
+		const __mmask8 tail = static_cast<__mmask8>(WORDS % 8 ? (1u << (WORDS % 8)) - 1 : 0xFF);
+		__m512i q[CHUNKS];
+		for(std::size_t c = 0; c < CHUNKS; ++c)
+			q[c] = _mm512_maskz_loadu_epi64(c + 1 < CHUNKS ? 0xFF : tail, query + 8 * c);
+		for(; i + 8 <= n; i += 8)
+		{
+			const uint64_t* code = codes + i * WORDS;
+			const __m512i lo = hamming_pack_avx512(hamming_code_avx512<WORDS>(code, q),
+			                                       hamming_code_avx512<WORDS>(code + WORDS, q),
+			                                       hamming_code_avx512<WORDS>(code + 2 * WORDS, q),
+			                                       hamming_code_avx512<WORDS>(code + 3 * WORDS, q));
+			const __m512i hi = hamming_pack_avx512(hamming_code_avx512<WORDS>(code + 4 * WORDS, q),
+			                                       hamming_code_avx512<WORDS>(code + 5 * WORDS, q),
+			                                       hamming_code_avx512<WORDS>(code + 6 * WORDS, q),
+			                                       hamming_code_avx512<WORDS>(code + 7 * WORDS, q));
+			/* both reductions at once, ending as the low two words */
+			__m512i sum = _mm512_add_epi64(_mm512_unpacklo_epi64(lo, hi), _mm512_unpackhi_epi64(lo, hi));
+			sum = _mm512_add_epi64(sum, _mm512_shuffle_i64x2(sum, sum, _MM_SHUFFLE(2, 3, 0, 1)));
+			sum = _mm512_add_epi64(sum, _mm512_shuffle_i64x2(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtepu16_epi32(_mm512_castsi512_si128(sum)));
+		}
+	}
+	hamming_scan_popcnt<WORDS>(codes + i * WORDS, n - i, query, out + i);
+}
+
+#endif
+
+struct HammingScan
+{
+	hamming_scan_fn scan;
+	const char* name;
+};
+
+/* name: hamming_scan
+ * desc: the scan kernel for WORDS word codes this cpu runs best
+ * returns: kernel and its name
+ */
+template <std::size_t WORDS>
+inline HammingScan hamming_scan() noexcept
+{
+#if defined(BITTLE_X86)
+	const CpuFeatures& f = cpu_features();
+	if(f.avx512f && f.avx512vpopcntdq && f.popcnt)
+		return {hamming_scan_avx512<WORDS>, "avx512vpopcntdq"};
+	if(f.avx2 && f.popcnt && (WORDS <= 2 || WORDS % 4 == 0))
+		return {hamming_scan_avx2<WORDS>, "avx2"};
+	if(f.popcnt)
+		return {hamming_scan_popcnt<WORDS>, "popcnt"};
+#endif
+	return {hamming_scan_scalar<WORDS>, "scalar"};
+}
+
+/* name: HammingTopK
+ * desc: the k smallest (distance << 32 | index) keys seen, kept in a max
+ * heap of at most k entries. Keys at or above bound() cannot get in, so
+ * the scan pays one compare per code and touches the heap only on a hit
+ */
+class HammingTopK
+{
+	public:
+
+		explicit HammingTopK(std::size_t k)
+			: k(k), worst(k ? ~uint64_t(0) : 0)
+		{
+			this->heap.reserve(k);
+		}
+
+		uint64_t bound() const noexcept
+		{
+			return this->worst;
+		}
+
+		const std::vector<uint64_t>& keys() const noexcept
+		{
+			return this->heap;
+		}
+
+		/* offers one key below bound() */
+		void push(uint64_t key) noexcept
+		{
+			if(this->heap.size() < this->k)
+			{
+				this->heap.push_back(key);
+				if(this->heap.size() == this->k)
+				{
+					std::make_heap(this->heap.begin(), this->heap.end());
+					this->worst = this->heap[0];
+				}
+				return;
+			}
+
+			/* replace the root and sift the new key down */
+			const std::size_t n = this->heap.size();
+			std::size_t i = 0;
+			for(;;)
+			{
+				std::size_t c = 2 * i + 1;
+				if(c >= n)
+					break;
+				c += static_cast<std::size_t>(c + 1 < n && this->heap[c + 1] > this->heap[c]);
+				if(this->heap[c] <= key)
+					break;
+				this->heap[i] = this->heap[c];
+				i = c;
+			}
+			this->heap[i] = key;
+			this->worst = this->heap[0];
+		}
+
+		/* offers the distances of codes base .. base + n - 1. Sixteen at a
+		 * time are checked against the k-th best distance first, a flat
+		 * loop the compiler turns into vector compares */
+		void scan(const uint32_t* d, std::size_t n, std::size_t base) noexcept
+		{
+			std::size_t i = 0;
+			for(; i + 16 <= n; i += 16)
+			{
+				const uint32_t bound = static_cast<uint32_t>(this->worst >> 32);
+				uint32_t hit = 0;
+				for(std::size_t j = 0; j < 16; ++j)
+					hit |= static_cast<uint32_t>(d[i + j] <= bound);
+				if(hit)
+					this->offer(d + i, 16, base + i);
+			}
+			this->offer(d + i, n - i, base + i);
+		}
+
+		void offer(const uint32_t* d, std::size_t n, std::size_t base) noexcept
+		{
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				const uint64_t key = (static_cast<uint64_t>(d[i]) << 32) | static_cast<uint64_t>(base + i);
+				if(key < this->worst)
+					this->push(key);
+			}
+		}
+
+		/* writes the hits closest first */
+		std::size_t write(HammingHit* out)
+		{
+			std::sort(this->heap.begin(), this->heap.end());
+			for(std::size_t i = 0; i < this->heap.size(); ++i)
+				out[i] = HammingHit{static_cast<uint32_t>(this->heap[i]), static_cast<uint32_t>(this->heap[i] >> 32)};
+			return this->heap.size();
+		}
+
+
+	private:
+
+		std::size_t k;
+		uint64_t worst;
+		std::vector<uint64_t> heap;
+};
+
+}
+
+template <std::size_t WORDS>
+class HammingIndex
+{
+	static_assert(WORDS >= 1 && WORDS <= 64, "Codes are 1 - 64 words long");
+
+
+	public:
+
+		static constexpr std::size_t BITS = WORDS * 64;
+
+		HammingIndex() = default;
+
+		/* ctor copying n codes of WORDS words each */
+		HammingIndex(const uint64_t* codes, std::size_t n)
+			: codes(codes, codes + n * WORDS)
+		{
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: size
+		 * desc: codes held
+		 * returns: code count
+		 */
+		std::size_t size() const noexcept
+		{
+			return this->codes.size() / WORDS;
+		}
+
+		/* name: code
+		 * desc: the WORDS words of code i
+		 * returns: pointer into the index
+		 */
+		const uint64_t* code(std::size_t i) const noexcept
+		{
+			return this->codes.data() + i * WORDS;
+		}
+
+		/* name: distance
+		 * desc: Hamming distance of code i to a query
+		 * returns: distance
+		 */
+		uint32_t distance(std::size_t i, const uint64_t* query) const noexcept
+		{
+			const uint64_t* c = this->code(i);
+			uint32_t d = 0;
+			for(std::size_t w = 0; w < WORDS; ++w)
+				d += bittle::count_ones<uint64_t>(c[w] ^ query[w]);
+			return d;
+		}
+
+		/* name: implementation
+		 * desc: the scan kernel this cpu uses
+		 * returns: kernel name
+		 */
+		static const char* implementation() noexcept
+		{
+			return detail::hamming_scan<WORDS>().name;
+		}
+
+		/* name: search
+		 * desc: the k codes closest to query, closest first, on up to
+		 * 'threads' threads (0 for one per core)
+		 * returns: hits written, min(k, size())
+		 */
+		std::size_t search(const uint64_t* query, std::size_t k, HammingHit* out, unsigned threads = 1) const
+		{
+			return this->searchBatch(query, 1, k, out, threads);
+		}
+
+		/* name: searchBatch
+		 * desc: search for q queries at once, query j's hits go to
+		 * out[j * k, j * k + k). Every block of codes is scanned by all
+		 * queries while in cache
+		 * returns: hits per query, min(k, size())
+		 */
+		std::size_t searchBatch(const uint64_t* queries, std::size_t q, std::size_t k, HammingHit* out,
+		                        unsigned threads = 1) const
+		{
+			const std::size_t n = this->size();
+			const std::size_t blocks = (n + detail::HAMMING_BLOCK - 1) / detail::HAMMING_BLOCK;
+			threads = detail::thread_count(threads, blocks);
+
+			/* whole blocks per thread, each with its own heaps */
+			const std::size_t per = (blocks + threads - 1) / threads * detail::HAMMING_BLOCK;
+			std::vector<std::vector<detail::HammingTopK>> tops(threads, std::vector<detail::HammingTopK>(q, detail::HammingTopK(k)));
+			detail::run_threads(threads, [&](unsigned t) {
+				this->scan(queries, q, std::min(n, t * per), std::min(n, (t + 1) * per), tops[t].data());
+			});
+
+			for(std::size_t j = 0; j < q; ++j)
+			{
+				detail::HammingTopK& best = tops[0][j];
+				for(unsigned t = 1; t < threads; ++t)
+					for(uint64_t key : tops[t][j].keys())
+						if(key < best.bound())
+							best.push(key);
+				best.write(out + j * k);
+			}
+			return std::min(k, n);
+		}
+
+		/* name: radius
+		 * desc: every code within distance r of query, closest first
+		 * returns: hit count
+		 */
+		std::size_t radius(const uint64_t* query, uint32_t r, std::vector<HammingHit>& out) const
+		{
+			out.clear();
+			const detail::HammingScan kernel = detail::hamming_scan<WORDS>();
+			const std::size_t n = this->size();
+			uint32_t d[detail::HAMMING_BLOCK];
+			for(std::size_t b = 0; b < n; b += detail::HAMMING_BLOCK)
+			{
+				const std::size_t len = std::min(detail::HAMMING_BLOCK, n - b);
+				kernel.scan(this->code(b), len, query, d);
+				for(std::size_t i = 0; i < len; ++i)
+					if(d[i] <= r)
+						out.push_back(HammingHit{static_cast<uint32_t>(b + i), d[i]});
+			}
+			std::stable_sort(out.begin(), out.end(), [](const HammingHit& a, const HammingHit& b) {
+				return a.distance < b.distance;
+			});
+			return out.size();
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: add
+		 * desc: appends n codes, indices go up to 2^32 - 1
+		 * returns: nothing
+		 */
+		void add(const uint64_t* code, std::size_t n = 1)
+		{
+			this->codes.insert(this->codes.end(), code, code + n * WORDS);
+		}
+
+		/* name: reserve
+		 * desc: room for n codes
+		 * returns: nothing
+		 */
+		void reserve(std::size_t n)
+		{
+			this->codes.reserve(n * WORDS);
+		}
+
+		/* name: clear
+		 * desc: drops every code
+		 * returns: nothing
+		 */
+		void clear() noexcept
+		{
+			this->codes.clear();
+		}
+
+
+	private:
+
+		void scan(const uint64_t* queries, std::size_t q, std::size_t begin, std::size_t end,
+		          detail::HammingTopK* tops) const noexcept
+		{
+			const detail::HammingScan kernel = detail::hamming_scan<WORDS>();
+			uint32_t d[detail::HAMMING_BLOCK];
+			for(std::size_t b = begin; b < end; b += detail::HAMMING_BLOCK)
+			{
+				const std::size_t len = std::min(detail::HAMMING_BLOCK, end - b);
+				for(std::size_t j = 0; j < q; ++j)
+				{
+					kernel.scan(this->code(b), len, queries + j * WORDS, d);
+					tops[j].scan(d, len, b);
+				}
+			}
+		}
+
+		std::vector<uint64_t> codes;
+};
+
+template <std::size_t WORDS>
+class HammingMultiIndex
+{
+	public:
+
+		static constexpr int MAX_SUBSTRING_BITS = 24;
+
+		/* ctor over the codes of 'index' at build time, which must outlive
+		 * it; 'substrings' 0 picks about log2(n) bits per substring */
+		explicit HammingMultiIndex(const HammingIndex<WORDS>& index, int substrings = 0)
+			: index(&index)
+		{
+			const int bits = static_cast<int>(HammingIndex<WORDS>::BITS);
+			if(substrings <= 0)
+			{
+				int target = 8;
+				while(target < 16 && (std::size_t(1) << (target + 1)) <= index.size())
+					++target;
+				substrings = (bits + target - 1) / target;
+			}
+			const int fewest = (bits + MAX_SUBSTRING_BITS - 1) / MAX_SUBSTRING_BITS;
+			this->m = std::min(std::max(substrings, fewest), bits);
+			this->width = (bits + this->m - 1) / this->m;
+			this->m = (bits + this->width - 1) / this->width;
+
+			/* one counting sort per substring, ids stay in index order */
+			const std::size_t n = index.size();
+			const std::size_t buckets = std::size_t(1) << this->width;
+			this->offsets.assign(static_cast<std::size_t>(this->m) * (buckets + 1), 0);
+			this->ids.resize(static_cast<std::size_t>(this->m) * n);
+			for(int j = 0; j < this->m; ++j)
+			{
+				uint32_t* off = this->offsets.data() + static_cast<std::size_t>(j) * (buckets + 1);
+				for(std::size_t i = 0; i < n; ++i)
+					++off[this->substring(index.code(i), j) + 1];
+				for(std::size_t b = 0; b < buckets; ++b)
+					off[b + 1] += off[b];
+				std::vector<uint32_t> fill(off, off + buckets);
+				uint32_t* run = this->ids.data() + static_cast<std::size_t>(j) * n;
+				for(std::size_t i = 0; i < n; ++i)
+					run[fill[this->substring(index.code(i), j)]++] = static_cast<uint32_t>(i);
+			}
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: substrings
+		 * desc: number of substring tables m
+		 * returns: m
+		 */
+		int substrings() const noexcept
+		{
+			return this->m;
+		}
+
+		/* name: substringBits
+		 * desc: bits per substring, the last may be shorter
+		 * returns: width
+		 */
+		int substringBits() const noexcept
+		{
+			return this->width;
+		}
+
+		/* name: sizeInBytes
+		 * desc: memory held by the tables
+		 * returns: byte count
+		 */
+		std::size_t sizeInBytes() const noexcept
+		{
+			return (this->offsets.size() + this->ids.size()) * sizeof(uint32_t);
+		}
+
+		/* name: radius
+		 * desc: every code within distance r of query, closest first,
+		 * same as HammingIndex::radius. Probes grow as C(width, r / m),
+		 * meant for r up to a few times m
+		 * returns: hit count
+		 */
+		std::size_t radius(const uint64_t* query, uint32_t r, std::vector<HammingHit>& out) const
+		{
+			out.clear();
+			const std::size_t n = this->index->size();
+			const std::size_t buckets = std::size_t(1) << this->width;
+			const int rho = static_cast<int>(r / static_cast<uint32_t>(this->m));
+			const int extra = static_cast<int>(r % static_cast<uint32_t>(this->m));
+
+			/* substrings 0 .. extra are searched within rho, the rest within
+			 * rho - 1: a code missing all of them is r + 1 or more away */
+			for(int j = 0; j < this->m; ++j)
+			{
+				const int bits = this->bitsOf(j);
+				const int reach = std::min(j <= extra ? rho : rho - 1, bits);
+				const uint32_t* off = this->offsets.data() + static_cast<std::size_t>(j) * (buckets + 1);
+				const uint32_t* run = this->ids.data() + static_cast<std::size_t>(j) * n;
+				const uint64_t key = this->substring(query, j);
+				const uint64_t limit = uint64_t(1) << bits;
+				for(int e = 0; e <= reach; ++e)
+				{
+					/* every e bit flip pattern, Gosper's hack */
+					for(uint64_t flip = (uint64_t(1) << e) - 1; flip < limit; )
+					{
+						const uint64_t b = key ^ flip;
+						for(uint32_t p = off[b]; p < off[b + 1]; ++p)
+						{
+							const uint32_t d = this->index->distance(run[p], query);
+							if(d <= r)
+								out.push_back(HammingHit{run[p], d});
+						}
+						if(flip == 0)
+							break;
+						const uint64_t c = flip & (0 - flip);
+						const uint64_t s = flip + c;
+						flip = (((s ^ flip) >> 2) / c) | s;
+					}
+				}
+			}
+
+			/* a code can turn up in several tables */
+			std::sort(out.begin(), out.end(), [](const HammingHit& a, const HammingHit& b) {
+				return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+			});
+			out.erase(std::unique(out.begin(), out.end(), [](const HammingHit& a, const HammingHit& b) {
+				return a.index == b.index;
+			}), out.end());
+			return out.size();
+		}
+
+
+	private:
+
+		int bitsOf(int j) const noexcept
+		{
+			return std::min(this->width, static_cast<int>(HammingIndex<WORDS>::BITS) - j * this->width);
+		}
+
+		uint64_t substring(const uint64_t* code, int j) const noexcept
+		{
+			const std::size_t start = static_cast<std::size_t>(j) * static_cast<std::size_t>(this->width);
+			const std::size_t word = start / 64;
+			const int shift = static_cast<int>(start % 64);
+			uint64_t v = code[word] >> shift;
+			if(shift && word + 1 < WORDS)
+				v |= code[word + 1] << (64 - shift);
+			return v & ((uint64_t(1) << this->bitsOf(j)) - 1);
+		}
+
+		const HammingIndex<WORDS>* index;
+		int m = 1;
+		int width = 1;
+		std::vector<uint32_t> offsets;   /* m tables of 2^width + 1 bucket starts */
+		std::vector<uint32_t> ids;       /* m runs of n code indices */
+};
+
+/* Declarations for ease of use */
+using HammingIndex64 = HammingIndex<1>;
+using HammingIndex128 = HammingIndex<2>;
+using HammingIndex256 = HammingIndex<4>;
+using HammingIndex512 = HammingIndex<8>;
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+
+#endif
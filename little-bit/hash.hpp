@@ -0,0 +1,219 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hash.hpp
+ * purpose: integer mixers/finalizers and bulk key hashing
+ */
+
+
+#ifndef BITTLE_HASH_HPP
+#define BITTLE_HASH_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Small fast mixers for hash tables. Every mixer is a stateless functor
+ * with a constexpr operator() over uint64_t so it can be handed to the
+ * bulk routines below, which are plain loops the compiler vectorizes
+ * (the 128 bit multiply of WyMix is the one exception).
+ */
+
+/* name: fmix32
+ * desc: murmur3 32 bit finalizer
+ * returns: mixed value
+ */
+constexpr uint32_t fmix32(uint32_t h) noexcept
+{
+	h ^= h >> 16;
+	h *= 0x85EBCA6BU;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35U;
+	h ^= h >> 16;
+	return h;
+}
+
+/* name: fmix64
+ * desc: murmur3 64 bit finalizer
+ * returns: mixed value
+ */
+constexpr uint64_t fmix64(uint64_t k) noexcept
+{
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDULL;
+	k ^= k >> 33;
+	k *= 0xC4CEB9FE1A85EC53ULL;
+	k ^= k >> 33;
+	return k;
+}
+
+/* name: splitmix64
+ * desc: splitmix64 output function (golden gamma step included)
+ * returns: mixed value
+ */
+constexpr uint64_t splitmix64(uint64_t z) noexcept
+{
+	z += 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/* name: wymix
+ * desc: 64x64 -> 128 multiply folded back to 64 bits by xor
+ * returns: mixed value
+ */
+constexpr uint64_t wymix(uint64_t a, uint64_t b) noexcept
+{
+	return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64) ^
+	       static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b);
+}
+
+/* name: fxmix
+ * desc: rotate, xor, multiply step used to fold several words
+ * returns: new state
+ */
+constexpr uint64_t fxmix(uint64_t h, uint64_t v) noexcept
+{
+	return (bittle::rotl<uint64_t>(h, 5) ^ v) * 0x517CC1B727220A95ULL;
+}
+
+static constexpr uint64_t WY_P0 = 0xA0761D6478BD642FULL;
+static constexpr uint64_t WY_P1 = 0xE7037ED1A0B428DBULL;
+static constexpr uint64_t WY_P2 = 0x8EBC6AF09C88C6E3ULL;
+
+/* Mixer functors */
+
+struct Fmix
+{
+	constexpr uint64_t operator()(uint64_t k) const noexcept
+	{
+		return fmix64(k);
+	}
+};
+
+struct SplitMix
+{
+	constexpr uint64_t operator()(uint64_t k) const noexcept
+	{
+		return splitmix64(k);
+	}
+};
+
+struct WyMix
+{
+	constexpr uint64_t operator()(uint64_t k) const noexcept
+	{
+		return wymix(k ^ WY_P0, WY_P1);
+	}
+};
+
+/* name: hash_bits
+ * desc: mixes a Bits value, narrower types are zero extended first
+ * returns: 64 bit hash
+ */
+template <typename Mixer = Fmix, typename T = uint64_t>
+constexpr uint64_t hash_bits(const Bits<T>& b, Mixer mix = Mixer()) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	return mix(static_cast<uint64_t>(static_cast<U>(b.value())));
+}
+
+/* name: hash_words
+ * desc: hashes a wide key given as n 64 bit words
+ * returns: 64 bit hash
+ */
+inline uint64_t hash_words(const uint64_t* k, std::size_t n, uint64_t seed = 0) noexcept
+{
+	uint64_t a = seed ^ WY_P0;
+	std::size_t i = 0;
+	for(; i + 2 <= n; i += 2)
+		a = wymix(k[i] ^ WY_P1, k[i + 1] ^ a);
+	if(i < n)
+		a = wymix(k[i] ^ WY_P1, a ^ WY_P2);
+	return wymix(a ^ static_cast<uint64_t>(n), WY_P2);
+}
+
+/* name: hash_bytes
+ * desc: wyhash style hash of an arbitrary byte string
+ * returns: 64 bit hash
+ */
+inline uint64_t hash_bytes(const void* data, std::size_t len, uint64_t seed = 0) noexcept
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	uint64_t a = seed ^ WY_P0;
+	uint64_t w0 = 0, w1 = 0;
+	std::size_t n = len;
+	for(; n > 16; p += 16, n -= 16)
+	{
+		std::memcpy(&w0, p, 8);
+		std::memcpy(&w1, p + 8, 8);
+		a = wymix(w0 ^ WY_P1, w1 ^ a);
+	}
+	/* Last 1..16 bytes, read as two possibly overlapping words */
+	w0 = w1 = 0;
+	if(n >= 8)
+	{
+		std::memcpy(&w0, p, 8);
+		std::memcpy(&w1, p + n - 8, 8);
+	}
+	else if(n >= 4)
+	{
+		uint32_t x, y;
+		std::memcpy(&x, p, 4);
+		std::memcpy(&y, p + n - 4, 4);
+		w0 = x;
+		w1 = y;
+	}
+	else if(n > 0)
+	{
+		w0 = (uint64_t(p[0]) << 16) | (uint64_t(p[n >> 1]) << 8) | p[n - 1];
+	}
+	a = wymix(w0 ^ WY_P1, w1 ^ a);
+	return wymix(a ^ static_cast<uint64_t>(len), WY_P2);
+}
+
+/* name: hash_bulk
+ * desc: out[i] = mix(in[i]), written as a flat loop so it vectorizes
+ * returns: nothing
+ */
+template <typename Mixer = Fmix, typename T = uint64_t>
+void hash_bulk(const T* __restrict in, uint64_t* __restrict out, std::size_t n, Mixer mix = Mixer()) noexcept
+{
+	BITTLE_PROFILE_KERNEL(hash_bulk);
+	using U = typename std::make_unsigned<T>::type;
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = mix(static_cast<uint64_t>(static_cast<U>(in[i])));
+}
+
+/* name: hash_bulk
+ * desc: same as above over an array of Bits
+ * returns: nothing
+ */
+template <typename Mixer = Fmix, typename T = uint64_t>
+void hash_bulk(const Bits<T>* __restrict in, uint64_t* __restrict out, std::size_t n, Mixer mix = Mixer()) noexcept
+{
+	BITTLE_PROFILE_KERNEL(hash_bulk);
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = hash_bits(in[i], mix);
+}
+
+/* name: hash_bulk32
+ * desc: out[i] = fmix32(in[i]), a plain loop the compiler is free to
+ * vectorize
+ * returns: nothing
+ */
+inline void hash_bulk32(const uint32_t* __restrict in, uint32_t* __restrict out, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		out[i] = fmix32(in[i]);
+}
+
+}
+
+
+#endif
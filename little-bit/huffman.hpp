@@ -0,0 +1,707 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: huffman.hpp
+ * purpose: length limited canonical Huffman coding of bytes with table driven decode
+ */
+
+
+#ifndef BITTLE_HUFFMAN_HPP
+#define BITTLE_HUFFMAN_HPP
+
+#include "bittle.hpp"
+#include "bit_stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Canonical Huffman codes over the 256 byte values, written MSB first with
+ * BitWriter so codes of one length are consecutive numbers and the code
+ * book is nothing but the 256 code lengths.
+ *
+ *   huffman_lengths   code lengths from frequencies, limited to a maximum
+ *                     length by pushing rare symbols down until the Kraft
+ *                     sum fits again
+ *   HuffmanCode       the canonical code of a set of lengths, and encode
+ *   HuffmanDecoder    decode through a 2^ROOT entry table (ROOT a template
+ *                     parameter) indexed by the top bits of the BitReader
+ *                     window; one entry holds up to three whole symbols
+ *                     that fit in ROOT bits, codes longer than ROOT go on
+ *                     to a second level table
+ *   huffman_compress  framed format: size, lengths, then the input cut in
+ *                     up to 8 streams that decode interleaved, so the
+ *                     table lookups of one stream hide the latency of the
+ *                     others
+ */
+
+/* Longest code the nibble packed code book can describe */
+constexpr int HUFFMAN_MAX_LENGTH = 15;
+
+/* Byte alphabet */
+constexpr std::size_t HUFFMAN_SYMBOLS = 256;
+
+/* Most streams huffman_compress cuts its input into */
+constexpr std::size_t HUFFMAN_MAX_STREAMS = 8;
+
+namespace detail {
+
+/* name: huffman_histogram
+ * desc: byte frequencies, counted in four tables so runs of one byte do
+ * not wait on their own increments
+ * returns: nothing
+ */
+inline void huffman_histogram(const uint8_t* data, std::size_t n, uint64_t* freq) noexcept
+{
+	uint32_t t[4][HUFFMAN_SYMBOLS] = {};
+	std::fill(freq, freq + HUFFMAN_SYMBOLS, 0);
+	std::size_t i = 0;
+	while(i < n)
+	{
+		/* flush before a 32 bit counter can wrap */
+		const std::size_t stop = std::min(n, i + (std::size_t(1) << 30));
+		for(; i + 4 <= stop; i += 4)
+		{
+			++t[0][data[i]];
+			++t[1][data[i + 1]];
+			++t[2][data[i + 2]];
+			++t[3][data[i + 3]];
+		}
+		for(; i < stop; ++i)
+			++t[0][data[i]];
+		for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+		{
+			freq[s] += uint64_t(t[0][s]) + t[1][s] + t[2][s] + t[3][s];
+			t[0][s] = t[1][s] = t[2][s] = t[3][s] = 0;
+		}
+	}
+}
+
+}
+
+/* name: huffman_lengths
+ * desc: Huffman code lengths for 'symbols' frequencies, none longer than
+ * maxLength (1 - 15); unused symbols get length 0 and a lone used symbol
+ * gets length 1
+ * returns: false if maxLength cannot hold that many used symbols
+ */
+inline bool huffman_lengths(const uint64_t* freq, std::size_t symbols, uint8_t* lengths, int maxLength)
+{
+	std::fill(lengths, lengths + symbols, 0);
+	if(maxLength < 1 || maxLength > HUFFMAN_MAX_LENGTH)
+		return false;
+
+	std::vector<std::size_t> order;
+	for(std::size_t s = 0; s < symbols; ++s)
+		if(freq[s])
+			order.push_back(s);
+
+	const std::size_t m = order.size();
+	if(m == 0)
+		return true;
+	if(m > (std::size_t(1) << maxLength))
+		return false;
+	if(m == 1)
+	{
+		lengths[order[0]] = 1;
+		return true;
+	}
+
+	/* two queue construction over leaves sorted by weight: leaves are
+	 * nodes 0 .. m - 1, internal nodes m .. 2m - 2 come out in order */
+	std::stable_sort(order.begin(), order.end(), [freq](std::size_t a, std::size_t b) { return freq[a] < freq[b]; });
+	std::vector<uint64_t> weight(2 * m - 1);
+	std::vector<std::size_t> parent(2 * m - 1, 0);
+	for(std::size_t i = 0; i < m; ++i)
+		weight[i] = freq[order[i]];
+
+	std::size_t leaf = 0, node = m;
+	for(std::size_t k = m; k < 2 * m - 1; ++k)
+	{
+		std::size_t pick[2];
+		for(std::size_t& p : pick)
+			p = (leaf < m && (node >= k || weight[leaf] <= weight[node])) ? leaf++ : node++;
+		weight[k] = weight[pick[0]] + weight[pick[1]];
+		parent[pick[0]] = parent[pick[1]] = k;
+	}
+
+	/* parents come after their children, so one backwards pass gives depths */
+	std::vector<int> depth(2 * m - 1, 0);
+	for(std::size_t k = 2 * m - 2; k-- > 0;)
+		depth[k] = depth[parent[k]] + 1;
+
+	/* limit: clamp, then lengthen the rarest codes below the limit until
+	 * the Kraft sum, in units of 2^-maxLength, is back to at most one */
+	const uint64_t full = uint64_t(1) << maxLength;
+	uint64_t kraft = 0;
+	for(std::size_t i = 0; i < m; ++i)
+	{
+		depth[i] = std::min(depth[i], maxLength);
+		kraft += full >> depth[i];
+	}
+	while(kraft > full)
+	{
+		for(std::size_t i = 0; i < m && kraft > full; ++i)
+		{
+			if(depth[i] < maxLength)
+			{
+				++depth[i];
+				kraft -= full >> depth[i];
+			}
+		}
+	}
+
+	/* and give back what overshot to the most frequent symbols */
+	for(std::size_t i = m; i-- > 0;)
+	{
+		while(depth[i] > 1 && kraft + (full >> depth[i]) <= full)
+		{
+			kraft += full >> depth[i];
+			--depth[i];
+		}
+	}
+
+	for(std::size_t i = 0; i < m; ++i)
+		lengths[order[i]] = static_cast<uint8_t>(depth[i]);
+	return true;
+}
+
+class HuffmanCode
+{
+	public:
+
+		/* empty code, no symbol has a length */
+		HuffmanCode() noexcept
+		{
+			this->lengths.fill(0);
+			this->codes.fill(0);
+		}
+
+		/* ctor from 256 code lengths (0 - 15), see valid() */
+		explicit HuffmanCode(const uint8_t* lengths) noexcept
+		{
+			std::copy(lengths, lengths + HUFFMAN_SYMBOLS, this->lengths.begin());
+			this->assign();
+		}
+
+		/* name: fromFrequencies
+		 * desc: length limited code for 256 frequencies, maxLength clamped
+		 * to 8 - 15
+		 * returns: the code
+		 */
+		static HuffmanCode fromFrequencies(const uint64_t* freq, int maxLength = 11)
+		{
+			uint8_t lengths[HUFFMAN_SYMBOLS];
+			huffman_lengths(freq, HUFFMAN_SYMBOLS, lengths, std::min(std::max(maxLength, 8), HUFFMAN_MAX_LENGTH));
+			return HuffmanCode(lengths);
+		}
+
+		/* name: fromData
+		 * desc: length limited code for the byte frequencies of data
+		 * returns: the code
+		 */
+		static HuffmanCode fromData(const uint8_t* data, std::size_t n, int maxLength = 11)
+		{
+			uint64_t freq[HUFFMAN_SYMBOLS];
+			detail::huffman_histogram(data, n, freq);
+			return HuffmanCode::fromFrequencies(freq, maxLength);
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: valid
+		 * desc: whether the lengths are at most 15 and form a prefix code
+		 * returns: bool
+		 */
+		bool valid() const noexcept
+		{
+			return this->ok;
+		}
+
+		/* name: length
+		 * desc: code length of a symbol, 0 if it has no code
+		 * returns: length
+		 */
+		int length(uint8_t symbol) const noexcept
+		{
+			return this->lengths[symbol];
+		}
+
+		/* name: code
+		 * desc: canonical code of a symbol, right aligned
+		 * returns: code
+		 */
+		uint32_t code(uint8_t symbol) const noexcept
+		{
+			return this->codes[symbol];
+		}
+
+		/* name: maxLength
+		 * desc: longest code length
+		 * returns: length
+		 */
+		int maxLength() const noexcept
+		{
+			return this->longest;
+		}
+
+		/* name: encodedBits
+		 * desc: size data would encode to
+		 * returns: bit count
+		 */
+		std::size_t encodedBits(const uint8_t* data, std::size_t n) const noexcept
+		{
+			std::size_t bits = 0;
+			for(std::size_t i = 0; i < n; ++i)
+				bits += this->lengths[data[i]];
+			return bits;
+		}
+
+		/* name: encode
+		 * desc: appends the codes of n bytes, each of which must have a
+		 * code; four codes (at most 60 bits) go out per write
+		 * returns: nothing
+		 */
+		void encode(const uint8_t* data, std::size_t n, BitWriter& out) const
+		{
+			std::size_t i = 0;
+			for(; i + 4 <= n; i += 4)
+			{
+				uint64_t v = 0;
+				int bits = 0;
+				for(std::size_t k = 0; k < 4; ++k)
+				{
+					const uint8_t s = data[i + k];
+					v = (v << this->lengths[s]) | this->codes[s];
+					bits += this->lengths[s];
+				}
+				out.write(v, bits);
+			}
+			for(; i < n; ++i)
+				out.write(this->codes[data[i]], this->lengths[data[i]]);
+		}
+
+		/* name: writeLengths
+		 * desc: appends the code book, 256 lengths of 4 bits
+		 * returns: nothing
+		 */
+		void writeLengths(BitWriter& out) const
+		{
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+				out.write(this->lengths[s], 4);
+		}
+
+		/* name: readLengths
+		 * desc: reads a code book written by writeLengths
+		 * returns: the code, check valid()
+		 */
+		static HuffmanCode readLengths(BitReader& in) noexcept
+		{
+			uint8_t lengths[HUFFMAN_SYMBOLS];
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+				lengths[s] = static_cast<uint8_t>(in.read(4));
+			return HuffmanCode(lengths);
+		}
+
+
+	private:
+
+		void assign() noexcept
+		{
+			/* canonical: by length, then by symbol, counting up */
+			uint32_t count[HUFFMAN_MAX_LENGTH + 2] = {};
+			uint64_t kraft = 0;
+			this->ok = true;
+			this->longest = 0;
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+			{
+				const int len = this->lengths[s];
+				if(len > HUFFMAN_MAX_LENGTH)
+				{
+					this->ok = false;
+					continue;
+				}
+				++count[len];
+				if(len)
+					kraft += uint64_t(1) << (HUFFMAN_MAX_LENGTH - len);
+				this->longest = std::max(this->longest, len);
+			}
+			if(kraft > (uint64_t(1) << HUFFMAN_MAX_LENGTH))
+				this->ok = false;
+
+			uint32_t next[HUFFMAN_MAX_LENGTH + 2] = {};
+			count[0] = 0;
+			for(int len = 1; len <= HUFFMAN_MAX_LENGTH; ++len)
+				next[len] = (next[len - 1] + count[len - 1]) << 1;
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+			{
+				const int len = this->lengths[s];
+				this->codes[s] = (this->ok && len) ? next[len]++ : 0;
+			}
+		}
+
+		std::array<uint8_t, HUFFMAN_SYMBOLS> lengths;
+		std::array<uint32_t, HUFFMAN_SYMBOLS> codes;
+		int longest = 0;
+		bool ok = true;
+};
+
+template <int ROOT = 11>
+class HuffmanDecoder
+{
+	static_assert(ROOT >= 8 && ROOT <= HUFFMAN_MAX_LENGTH, "root table index is 8 to 15 bits");
+
+	/* entry: symbols in bits 0 - 23 (first in the low byte), bits used in
+	 * 24 - 28, symbol count in 29 - 30; a count of 0 links to a second
+	 * level table at offset bits 0 - 23 indexed by bits 24 - 28 more bits,
+	 * and an all zero entry is a code that does not exist */
+	static constexpr int BITS_SHIFT = 24;
+	static constexpr int COUNT_SHIFT = 29;
+
+
+	public:
+
+		/* ctor, the code must be valid() */
+		explicit HuffmanDecoder(const HuffmanCode& code)
+		{
+			this->build(code);
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: decode
+		 * desc: decodes n bytes from one stream
+		 * returns: false on a code that does not exist or a read past the
+		 * end of the stream
+		 */
+		bool decode(BitReader& in, uint8_t* out, std::size_t n) const noexcept
+		{
+			return this->decodeStreams(&in, &out, &n, 1);
+		}
+
+		/* name: decodeStreams
+		 * desc: decodes n[i] bytes from each of 'streams' streams, four,
+		 * two or one at a time interleaved
+		 * returns: false if any stream failed
+		 */
+		bool decodeStreams(BitReader* in, uint8_t* const* out, const std::size_t* n, std::size_t streams) const noexcept
+		{
+			bool ok = true;
+			std::size_t i = 0;
+			for(; i + 4 <= streams; i += 4)
+				ok &= this->interleave<4>(in + i, out + i, n + i);
+			if(i + 2 <= streams)
+			{
+				ok &= this->interleave<2>(in + i, out + i, n + i);
+				i += 2;
+			}
+			if(i < streams)
+				ok &= this->interleave<1>(in + i, out + i, n + i);
+			return ok;
+		}
+
+
+	private:
+
+		static uint32_t entry(uint32_t symbols, int bits, int count) noexcept
+		{
+			return symbols | (static_cast<uint32_t>(bits) << BITS_SHIFT) | (static_cast<uint32_t>(count) << COUNT_SHIFT);
+		}
+
+		void build(const HuffmanCode& code)
+		{
+			this->longest = code.maxLength();
+			this->sub = std::max(this->longest - ROOT, 0);
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+				this->lengths[s] = static_cast<uint8_t>(code.length(static_cast<uint8_t>(s)));
+
+			std::array<uint32_t, (1u << ROOT)> single;
+			single.fill(0);
+			this->second.clear();
+			for(std::size_t s = 0; s < HUFFMAN_SYMBOLS; ++s)
+			{
+				const int len = this->lengths[s];
+				if(len == 0)
+					continue;
+				const uint32_t c = code.code(static_cast<uint8_t>(s));
+				if(len <= ROOT)
+				{
+					const uint32_t first = c << (ROOT - len);
+					std::fill(single.begin() + first, single.begin() + first + (1u << (ROOT - len)), entry(static_cast<uint32_t>(s), len, 1));
+					continue;
+				}
+
+				/* one second level table per root prefix, made on first use */
+				const uint32_t prefix = c >> (len - ROOT);
+				if(single[prefix] == 0)
+				{
+					single[prefix] = static_cast<uint32_t>(this->second.size()) | (static_cast<uint32_t>(this->sub) << BITS_SHIFT);
+					this->second.resize(this->second.size() + (std::size_t(1) << this->sub), 0);
+				}
+				const uint32_t base = single[prefix] & 0xFFFFFF;
+				const int rest = len - ROOT;
+				const uint32_t first = (c & ((1u << rest) - 1)) << (this->sub - rest);
+				std::fill(this->second.begin() + base + first, this->second.begin() + base + first + (1u << (this->sub - rest)), entry(static_cast<uint32_t>(s), len, 1));
+			}
+
+			/* pack up to three whole codes into each root entry */
+			const uint32_t mask = (1u << ROOT) - 1;
+			for(uint32_t i = 0; i <= mask; ++i)
+			{
+				uint32_t e = single[i];
+				if((e >> COUNT_SHIFT) == 0)
+				{
+					this->root[i] = e;
+					continue;
+				}
+				uint32_t symbols = e & 0xFF;
+				int used = static_cast<int>((e >> BITS_SHIFT) & 0x1F);
+				int count = 1;
+				for(; count < 3; ++count)
+				{
+					const uint32_t next = single[(i << used) & mask];
+					const int len = static_cast<int>((next >> BITS_SHIFT) & 0x1F);
+					if((next >> COUNT_SHIFT) == 0 || used + len > ROOT)
+						break;
+					symbols |= (next & 0xFF) << (8 * count);
+					used += len;
+				}
+				this->root[i] = entry(symbols, used, count);
+			}
+		}
+
+		/* second level lookup for a link entry, 0 for a missing code */
+		uint32_t link(uint32_t e, uint64_t window) const noexcept
+		{
+			const int bits = static_cast<int>((e >> BITS_SHIFT) & 0x1F);
+			if(bits == 0)
+				return 0;
+			return this->second[(e & 0xFFFFFF) + ((window << ROOT) >> (64 - bits))];
+		}
+
+		/* one root lookup, writing the entry's symbols (and a spare byte)
+		 * at o and moving the window past them; 'ok' drops on a missing code.
+		 * Without LINKS (longest <= ROOT) a missing code is the only entry
+		 * with a zero count and consumes nothing */
+		template <bool LINKS>
+		void step(uint64_t& w, uint8_t*& o, int& used, bool& ok) const noexcept
+		{
+			uint32_t e = this->root[w >> (64 - ROOT)];
+			if(LINKS && (e >> COUNT_SHIFT) == 0)
+				e = this->link(e, w);
+			if(Bits<uint64_t>::isLittleEndian())
+			{
+				std::memcpy(o, &e, sizeof(e));
+			}
+			else
+			{
+				o[0] = static_cast<uint8_t>(e);
+				o[1] = static_cast<uint8_t>(e >> 8);
+				o[2] = static_cast<uint8_t>(e >> 16);
+			}
+			const int bits = static_cast<int>((e >> BITS_SHIFT) & 0x1F);
+			ok &= e != 0;
+			o += e >> COUNT_SHIFT;
+			w <<= bits;
+			used += bits;
+		}
+
+		/* PER lookups per stream from one refill (PER * longest <= 56),
+		 * the streams stepped in turn so their load chains overlap; every
+		 * stream is its own local, unrolled through K, so the readers,
+		 * windows and outputs stay in registers */
+		template <int PER, bool LINKS, std::size_t... K>
+		bool fast(BitReader* in, uint8_t** out, uint8_t* const* stop, std::index_sequence<K...>) const noexcept
+		{
+			BitReader r[] = {in[K]...};
+			uint8_t* o[] = {out[K]...};
+			bool ok = true;
+			for(;;)
+			{
+				bool room = ok;
+				const int check[] = {0, (room &= o[K] < stop[K], 0)...};
+				(void)check;
+				if(!room)
+					break;
+
+				uint64_t w[] = {(r[K].refill(), r[K].window())...};
+				int used[] = {(static_cast<void>(K), 0)...};
+				for(int j = 0; j < PER; ++j)
+				{
+					const int lookups[] = {0, (this->template step<LINKS>(w[K], o[K], used[K], ok), 0)...};
+					(void)lookups;
+				}
+				const int skips[] = {0, (r[K].skip(used[K]), 0)...};
+				(void)skips;
+			}
+
+			const int done[] = {0, (in[K] = r[K], out[K] = o[K], 0)...};
+			(void)done;
+			return ok;
+		}
+
+		template <std::size_t S>
+		bool interleave(BitReader* in, uint8_t* const* out, const std::size_t* n) const noexcept
+		{
+			/* the fast loop writes 4 bytes for every lookup and may make
+			 * 3 symbols of progress, so it stops that far from the end */
+			const int per = this->longest <= ROOT ? 56 / ROOT : 56 / HUFFMAN_MAX_LENGTH;
+			const std::size_t slack = static_cast<std::size_t>(per) * 3 + 1;
+			uint8_t* o[S];
+			uint8_t* stop[S];
+			for(std::size_t k = 0; k < S; ++k)
+			{
+				o[k] = out[k];
+				stop[k] = out[k] + (n[k] > slack ? n[k] - slack : 0);
+			}
+
+			const bool ok = this->longest <= ROOT ? this->fast<56 / ROOT, false>(in, o, stop, std::make_index_sequence<S>())
+			                                      : this->fast<56 / HUFFMAN_MAX_LENGTH, true>(in, o, stop, std::make_index_sequence<S>());
+			if(!ok)
+				return false;
+
+			/* one symbol per lookup to the exact end */
+			bool good = true;
+			for(std::size_t k = 0; k < S; ++k)
+			{
+				for(uint8_t* end = out[k] + n[k]; o[k] < end;)
+				{
+					in[k].refill();
+					uint32_t e = this->root[in[k].window() >> (64 - ROOT)];
+					if((e >> COUNT_SHIFT) == 0)
+						e = this->link(e, in[k].window());
+					if(e == 0)
+						return false;
+					const uint8_t s = static_cast<uint8_t>(e);
+					*o[k]++ = s;
+					in[k].skip(this->lengths[s]);
+				}
+				good &= !in[k].overrun();
+			}
+			return good;
+		}
+
+		std::array<uint32_t, (1u << ROOT)> root;
+		std::vector<uint32_t> second;
+		std::array<uint8_t, HUFFMAN_SYMBOLS> lengths;
+		int longest = 0;
+		int sub = 0;
+};
+
+/* name: huffman_compress
+ * desc: encodes n bytes as a 64 bit size, a stream count, the code book
+ * and 64 bit stream sizes, followed by 'streams' (1 - 8) equal slices of
+ * the input each coded as its own byte padded stream
+ * returns: compressed bytes
+ */
+inline std::vector<uint8_t> huffman_compress(const uint8_t* data, std::size_t n, std::size_t streams = 4, int maxLength = 11)
+{
+	streams = std::min(std::max(streams, std::size_t(1)), HUFFMAN_MAX_STREAMS);
+	const HuffmanCode code = HuffmanCode::fromData(data, n, maxLength);
+	const std::size_t slice = (n + streams - 1) / streams;
+
+	std::vector<std::vector<uint8_t>> coded(streams);
+	BitWriter w;
+	for(std::size_t k = 0; k < streams; ++k)
+	{
+		const std::size_t from = std::min(n, k * slice);
+		w.reset();
+		code.encode(data + from, std::min(n, from + slice) - from, w);
+		coded[k] = w.finish();
+	}
+
+	BitWriter head;
+	head.write(n, 64).write(streams, 8);
+	code.writeLengths(head);
+	for(const std::vector<uint8_t>& c : coded)
+		head.write(c.size(), 64);
+	std::vector<uint8_t> result = head.finish();
+	for(const std::vector<uint8_t>& c : coded)
+		result.insert(result.end(), c.begin(), c.end());
+	return result;
+}
+
+inline std::vector<uint8_t> huffman_compress(const std::vector<uint8_t>& data, std::size_t streams = 4, int maxLength = 11)
+{
+	return huffman_compress(data.data(), data.size(), streams, maxLength);
+}
+
+/* name: huffman_decompress
+ * desc: decodes the output of huffman_compress into out
+ * returns: false if the input is malformed
+ */
+template <int ROOT = 11>
+bool huffman_decompress(const uint8_t* data, std::size_t bytes, std::vector<uint8_t>& out)
+{
+	BitReader head(data, bytes);
+	const uint64_t n = head.read(64);
+	const std::size_t streams = static_cast<std::size_t>(head.read(8));
+	const HuffmanCode code = HuffmanCode::readLengths(head);
+	if(streams == 0 || streams > HUFFMAN_MAX_STREAMS || !code.valid())
+		return false;
+
+	std::size_t offset = (head.position() + streams * 64 + BIT_SIZE - 1) / BIT_SIZE;
+	std::size_t sizes[HUFFMAN_MAX_STREAMS];
+	for(std::size_t k = 0; k < streams; ++k)
+	{
+		sizes[k] = static_cast<std::size_t>(head.read(64));
+		if(sizes[k] > bytes)
+			return false;
+	}
+	if(head.overrun() || offset > bytes)
+		return false;
+
+	/* every symbol costs at least a bit */
+	if(n > (bytes - offset) * BIT_SIZE)
+		return false;
+	if(n && code.maxLength() == 0)
+		return false;
+
+	out.resize(static_cast<std::size_t>(n));
+	const std::size_t slice = (out.size() + streams - 1) / streams;
+	BitReader in[HUFFMAN_MAX_STREAMS];
+	uint8_t* to[HUFFMAN_MAX_STREAMS];
+	std::size_t count[HUFFMAN_MAX_STREAMS];
+	for(std::size_t k = 0; k < streams; ++k)
+	{
+		if(sizes[k] > bytes - offset)
+			return false;
+		in[k] = BitReader(data + offset, sizes[k]);
+		offset += sizes[k];
+		const std::size_t from = std::min(out.size(), k * slice);
+		to[k] = out.data() + from;
+		count[k] = std::min(out.size(), from + slice) - from;
+	}
+
+	const HuffmanDecoder<ROOT> decoder(code);
+	return decoder.decodeStreams(in, to, count, streams);
+}
+
+template <int ROOT = 11>
+bool huffman_decompress(const std::vector<uint8_t>& data, std::vector<uint8_t>& out)
+{
+	return huffman_decompress<ROOT>(data.data(), data.size(), out);
+}
+
+}
+
+
+#endif
@@ -0,0 +1,497 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hyperloglog.hpp
+ * purpose: HyperLogLog++ style distinct counting with 6 bit packed registers
+ */
+
+
+#ifndef BITTLE_HYPERLOGLOG_HPP
+#define BITTLE_HYPERLOGLOG_HPP
+
+#include "bittle.hpp"
+#include "dispatch.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * HyperLogLog estimates how many distinct keys it has seen from the
+ * leading zeros of their 64 bit hashes. With precision p the top p bits
+ * of a hash pick one of m = 2^p registers, which keeps the largest
+ * 1 + leading zero count of the remaining 64 - p bits (at most 65 - p,
+ * so 6 bits). The standard error is about 1.04 / sqrt(m).
+ *
+ *   dense    ten registers per 64 bit word (bits 6i to 6i + 5, the top
+ *            four bits unused), so merging is a lane wise max done by SWAR
+ *            arithmetic on whole words, four words at a time with AVX2
+ *   sparse   while few registers are set, the sketch instead keeps sorted
+ *            32 bit entries of a 25 bit index and its 6 bit rank, counted
+ *            by linear counting over 2^25 buckets; it turns dense once the
+ *            entries would take more memory than the registers
+ *
+ * Dense estimates use Ertl's improved estimator over the register
+ * histogram, which corrects the small and large range bias of the raw
+ * harmonic mean without empirical tables. The histogram is kept up to
+ * date by add and rebuilt from the registers after a dense merge, so
+ * estimate() is always O(64).
+ */
+
+namespace detail {
+
+/* bit 0 and bit 5 of each of the ten 6 bit lanes */
+constexpr uint64_t HLL_LOW = 0x041041041041041ULL;
+constexpr uint64_t HLL_HIGH = HLL_LOW << 5;
+
+/* sparse entries use a 25 bit index */
+constexpr int HLL_SPARSE_PRECISION = 25;
+
+/* name: hll_max_word
+ * desc: lane wise unsigned max of ten 6 bit lanes: bit 5 of
+ * (a | H) - (b & ~H) is the compare of the low five bits, no lane
+ * borrows from the next, and the top bits decide the rest
+ * returns: word of maxima
+ */
+constexpr uint64_t hll_max_word(uint64_t a, uint64_t b) noexcept
+{
+	const uint64_t low = (a | HLL_HIGH) - (b & ~HLL_HIGH);
+	const uint64_t ge = ((a & ~b) | (~(a ^ b) & low)) & HLL_HIGH;
+	const uint64_t mask = (ge << 1) - (ge >> 5);
+	return (a & mask) | (b & ~mask);
+}
+
+inline void hll_merge_scalar(uint64_t* dst, const uint64_t* src, std::size_t n) noexcept
+{
+	for(std::size_t i = 0; i < n; ++i)
+		dst[i] = hll_max_word(dst[i], src[i]);
+}
+
+#if defined(BITTLE_X86)
+
+BITTLE_TARGET("avx2")
+inline void hll_merge_avx2(uint64_t* dst, const uint64_t* src, std::size_t n) noexcept
+{
+	const __m256i high = _mm256_set1_epi64x(static_cast<long long>(HLL_HIGH));
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		const __m256i low = _mm256_sub_epi64(_mm256_or_si256(a, high), _mm256_andnot_si256(high, b));
+		const __m256i same = _mm256_andnot_si256(_mm256_xor_si256(a, b), low);
+		const __m256i ge = _mm256_and_si256(_mm256_or_si256(_mm256_andnot_si256(b, a), same), high);
+		const __m256i mask = _mm256_sub_epi64(_mm256_slli_epi64(ge, 1), _mm256_srli_epi64(ge, 5));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+		                    _mm256_or_si256(_mm256_and_si256(a, mask), _mm256_andnot_si256(mask, b)));
+	}
+	hll_merge_scalar(dst + i, src + i, n - i);
+}
+
+#endif
+
+/* name: hll_merge
+ * desc: dst[i] = lane wise max(dst[i], src[i]) with the best kernel
+ * returns: nothing
+ */
+inline void hll_merge(uint64_t* dst, const uint64_t* src, std::size_t n) noexcept
+{
+#if defined(BITTLE_X86)
+	if(cpu_features().avx2)
+	{
+		hll_merge_avx2(dst, src, n);
+		return;
+	}
+#endif
+	hll_merge_scalar(dst, src, n);
+}
+
+/* Ertl's sigma and tau series, summed until they stop changing */
+
+inline double hll_sigma(double x) noexcept
+{
+	if(x == 1.0)
+		return std::numeric_limits<double>::infinity();
+	double y = 1.0, z = x, last;
+	do
+	{
+		x *= x;
+		last = z;
+		z += x * y;
+		y += y;
+	} while(z != last);
+	return z;
+}
+
+inline double hll_tau(double x) noexcept
+{
+	if(x == 0.0 || x == 1.0)
+		return 0.0;
+	double y = 1.0, z = 1.0 - x, last;
+	do
+	{
+		x = std::sqrt(x);
+		last = z;
+		y *= 0.5;
+		z -= (1.0 - x) * (1.0 - x) * y;
+	} while(z != last);
+	return z / 3.0;
+}
+
+}
+
+class HyperLogLog
+{
+	public:
+
+		static constexpr int MIN_PRECISION = 4;
+		static constexpr int MAX_PRECISION = 18;
+
+		/* ctor, precision clamped to 4 - 18; 'sparse' false starts dense */
+		explicit HyperLogLog(int precision = 14, bool sparse = true)
+			: p(precision < MIN_PRECISION ? MIN_PRECISION : precision > MAX_PRECISION ? MAX_PRECISION : precision),
+			  dense(!sparse), startDense(!sparse)
+		{
+			if(this->dense)
+				this->makeDense();
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: precision
+		 * desc: index bits p
+		 * returns: p
+		 */
+		int precision() const noexcept
+		{
+			return this->p;
+		}
+
+		/* name: registerCount
+		 * desc: m = 2^p
+		 * returns: register count
+		 */
+		std::size_t registerCount() const noexcept
+		{
+			return std::size_t(1) << this->p;
+		}
+
+		/* name: isSparse
+		 * desc: whether the sketch is still in sparse form
+		 * returns: bool
+		 */
+		bool isSparse() const noexcept
+		{
+			return !this->dense;
+		}
+
+		/* name: sizeInBytes
+		 * desc: memory held by the registers or sparse entries
+		 * returns: byte count
+		 */
+		std::size_t sizeInBytes() const noexcept
+		{
+			return this->dense ? this->words.size() * sizeof(uint64_t)
+			                   : (this->sparse.size() + this->pending.size()) * sizeof(uint32_t);
+		}
+
+		/* name: registers
+		 * desc: writes the m register values the sketch stands for, also
+		 * in sparse form
+		 * returns: nothing
+		 */
+		void registers(uint8_t* out) const
+		{
+			const std::size_t m = this->registerCount();
+			if(this->dense)
+			{
+				for(std::size_t i = 0; i < m; ++i)
+					out[i] = static_cast<uint8_t>((this->words[i / 10] >> (6 * (i % 10))) & 63);
+				return;
+			}
+			std::fill(out, out + m, 0);
+			for(const std::vector<uint32_t>* list : {&this->sparse, &this->pending})
+			{
+				for(uint32_t e : *list)
+				{
+					std::size_t i;
+					const int r = this->denseRank(e, i);
+					out[i] = std::max(out[i], static_cast<uint8_t>(r));
+				}
+			}
+		}
+
+		/* name: estimate
+		 * desc: estimated number of distinct keys added
+		 * returns: cardinality
+		 */
+		double estimate() const
+		{
+			if(!this->dense)
+			{
+				/* linear counting over the 2^25 sparse buckets */
+				std::size_t distinct = this->sparse.size();
+				if(!this->pending.empty())
+				{
+					std::vector<uint32_t> all(this->sparse);
+					HyperLogLog::mergeEntries(all, std::vector<uint32_t>(this->pending));
+					distinct = all.size();
+				}
+				const double mp = static_cast<double>(uint64_t(1) << detail::HLL_SPARSE_PRECISION);
+				return mp * std::log(mp / (mp - static_cast<double>(distinct)));
+			}
+
+			const uint32_t* c = this->histogram;
+			const int q = 64 - this->p;
+			const double m = static_cast<double>(this->registerCount());
+			double z = m * detail::hll_tau(1.0 - c[q + 1] / m);
+			for(int k = q; k >= 1; --k)
+				z = 0.5 * (z + c[k]);
+			z += m * detail::hll_sigma(c[0] / m);
+			return m * m / (2.0 * std::log(2.0) * z);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: add
+		 * desc: adds a key, hashed with fmix64
+		 * returns: nothing
+		 */
+		void add(const Bits<uint64_t>& key)
+		{
+			this->addHash(hash_bits(key));
+		}
+
+		/* name: add
+		 * desc: adds a byte string key, hashed with hash_bytes
+		 * returns: nothing
+		 */
+		void add(const void* data, std::size_t len)
+		{
+			this->addHash(hash_bytes(data, len));
+		}
+
+		/* name: addBulk
+		 * desc: adds n integer keys, hashing a block at a time with
+		 * hash_bulk, which vectorizes where 64 bit multiplies do
+		 * returns: nothing
+		 */
+		void addBulk(const uint64_t* keys, std::size_t n)
+		{
+			uint64_t h[256];
+			for(std::size_t i = 0; i < n; i += 256)
+			{
+				const std::size_t k = std::min<std::size_t>(256, n - i);
+				hash_bulk(keys + i, h, k);
+				for(std::size_t j = 0; j < k; ++j)
+					this->addHash(h[j]);
+			}
+		}
+
+		/* name: addHash
+		 * desc: adds a key by its 64 bit hash, which must be well mixed
+		 * returns: nothing
+		 */
+		void addHash(uint64_t h)
+		{
+			if(this->dense)
+			{
+				const uint64_t rest = h << this->p;
+				const int rank = rest ? bittle::count_leading_zeroes<uint64_t>(rest) + 1 : 65 - this->p;
+				this->raise(static_cast<std::size_t>(h >> (64 - this->p)), rank);
+				return;
+			}
+
+			const uint64_t rest = h << detail::HLL_SPARSE_PRECISION;
+			const uint32_t rank = rest ? static_cast<uint32_t>(bittle::count_leading_zeroes<uint64_t>(rest)) + 1
+			                           : 65 - detail::HLL_SPARSE_PRECISION;
+			this->pending.push_back(static_cast<uint32_t>(h >> (64 - detail::HLL_SPARSE_PRECISION)) << 6 | rank);
+			if(this->pending.size() >= this->sparseLimit())
+				this->flush();
+		}
+
+		/* name: merge
+		 * desc: folds another sketch of the same precision into this one,
+		 * the result is the sketch of the union
+		 * returns: false, changing nothing, if the precisions differ
+		 */
+		bool merge(const HyperLogLog& other)
+		{
+			if(other.p != this->p)
+				return false;
+			if(&other == this)
+				return true;
+
+			if(!other.dense)
+			{
+				if(!this->dense)
+				{
+					this->pending.insert(this->pending.end(), other.sparse.begin(), other.sparse.end());
+					this->pending.insert(this->pending.end(), other.pending.begin(), other.pending.end());
+					this->flush();
+					return true;
+				}
+				for(const std::vector<uint32_t>* list : {&other.sparse, &other.pending})
+				{
+					for(uint32_t e : *list)
+					{
+						std::size_t i;
+						const int r = this->denseRank(e, i);
+						this->raise(i, r);
+					}
+				}
+				return true;
+			}
+
+			if(!this->dense)
+				this->makeDense();
+			detail::hll_merge(this->words.data(), other.words.data(), this->words.size());
+			this->countRegisters(this->histogram);
+			return true;
+		}
+
+		/* name: clear
+		 * desc: forgets every key, back to sparse form unless started dense
+		 * returns: nothing
+		 */
+		void clear()
+		{
+			this->sparse.clear();
+			this->pending.clear();
+			this->words.clear();
+			if(this->startDense)
+				this->makeDense();
+			else
+				this->dense = false;
+		}
+
+
+	private:
+
+		/* entries kept before going dense: as many bytes as the registers */
+		std::size_t sparseLimit() const noexcept
+		{
+			return std::max<std::size_t>(((this->registerCount() + 9) / 10) * 2, 4);
+		}
+
+		/* dense register and rank of a sparse entry */
+		int denseRank(uint32_t e, std::size_t& index) const noexcept
+		{
+			const int extra = detail::HLL_SPARSE_PRECISION - this->p;
+			const uint32_t idx = e >> 6;
+			const uint32_t low = idx & ((uint32_t(1) << extra) - 1);
+			index = idx >> extra;
+			return low ? extra - (32 - bittle::count_leading_zeroes<uint32_t>(low)) + 1
+			           : extra + static_cast<int>(e & 63);
+		}
+
+		void raise(std::size_t i, int rank) noexcept
+		{
+			uint64_t& w = this->words[i / 10];
+			const unsigned s = static_cast<unsigned>(6 * (i % 10));
+			const int old = static_cast<int>((w >> s) & 63);
+			if(rank <= old)
+				return;
+			w += static_cast<uint64_t>(rank - old) << s;
+			--this->histogram[old];
+			++this->histogram[rank];
+		}
+
+		void countRegisters(uint32_t* c) const noexcept
+		{
+			std::fill(c, c + 64, 0);
+			const std::size_t m = this->registerCount();
+			const std::size_t full = m / 10;
+			for(std::size_t k = 0; k < full; ++k)
+			{
+				const uint64_t w = this->words[k];
+				for(unsigned s = 0; s < 60; s += 6)
+					++c[(w >> s) & 63];
+			}
+			for(std::size_t i = full * 10; i < m; ++i)
+				++c[(this->words[full] >> (6 * (i - full * 10))) & 63];
+		}
+
+		/* sort and dedupe 'more' into the sorted unique list, keeping the
+		 * largest rank of each index */
+		static void mergeEntries(std::vector<uint32_t>& list, std::vector<uint32_t> more)
+		{
+			std::sort(more.begin(), more.end());
+			std::vector<uint32_t> out;
+			out.reserve(list.size() + more.size());
+			std::merge(list.begin(), list.end(), more.begin(), more.end(), std::back_inserter(out));
+			std::size_t k = 0;
+			for(std::size_t i = 0; i < out.size(); ++i)
+			{
+				/* sorted by index then rank: the last of a run wins */
+				if(k && (out[k - 1] >> 6) == (out[i] >> 6))
+					out[k - 1] = out[i];
+				else
+					out[k++] = out[i];
+			}
+			out.resize(k);
+			list.swap(out);
+		}
+
+		void flush()
+		{
+			std::vector<uint32_t> more;
+			more.swap(this->pending);
+			HyperLogLog::mergeEntries(this->sparse, std::move(more));
+			if(this->sparse.size() > this->sparseLimit())
+				this->makeDense();
+		}
+
+		void makeDense()
+		{
+			/* padded to whole AVX2 registers, the padding stays zero */
+			this->words.assign(((this->registerCount() + 9) / 10 + 3) / 4 * 4, 0);
+			std::fill(this->histogram, this->histogram + 64, 0);
+			this->histogram[0] = static_cast<uint32_t>(this->registerCount());
+			this->dense = true;
+
+			for(const std::vector<uint32_t>* list : {&this->sparse, &this->pending})
+			{
+				for(uint32_t e : *list)
+				{
+					std::size_t i;
+					const int r = this->denseRank(e, i);
+					this->raise(i, r);
+				}
+			}
+			std::vector<uint32_t>().swap(this->sparse);
+			std::vector<uint32_t>().swap(this->pending);
+		}
+
+		int p;
+		bool dense;
+		bool startDense;
+		std::vector<uint64_t> words;       /* dense registers, ten per word */
+		std::vector<uint32_t> sparse;      /* sorted, one entry per index */
+		std::vector<uint32_t> pending;     /* unsorted sparse entries */
+		uint32_t histogram[64] = {};       /* registers per value */
+};
+
+}
+
+
+#endif
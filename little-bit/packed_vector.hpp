@@ -0,0 +1,562 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: packed_vector.hpp
+ * purpose: random access vector of unsigned integers packed at any bit width
+ */
+
+
+#ifndef BITTLE_PACKED_VECTOR_HPP
+#define BITTLE_PACKED_VECTOR_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * PackedVector<W> stores unsigned values of W (1 - 64) bits back to back
+ * in 64 bit words: value i is bits W * i to W * i + W - 1 of the word
+ * array, low bits first. W = DYNAMIC_WIDTH picks the width at run time;
+ * a fixed W lets the compiler fold the shifts and masks.
+ *
+ * A value covers at most two words, and one zero word is kept past the
+ * last one, so get and set always touch words k and k + 1 with no branch:
+ * the part in word k + 1 is shifted in with (x << 1) << (63 - s), which is
+ * 0 when the value does not reach it. On little endian machines widths up
+ * to 57 instead take one unaligned 8 byte access from the value's first
+ * byte. decode and encode stream through the words for sequential runs.
+ *
+ * set is not thread safe, setAtomic is: it updates each word with a
+ * compare exchange that only changes this value's bits, so threads may
+ * set different values of one word at once. A value that straddles two
+ * words is written one word at a time, so a concurrent getAtomic of that
+ * same value may see half of it.
+ */
+
+/* Width value for a PackedVector sized at run time */
+constexpr int DYNAMIC_WIDTH = 0;
+
+template <int W = DYNAMIC_WIDTH>
+class PackedVector
+{
+	static_assert(W >= 0 && W <= 64, "PackedVector width is 1 to 64 bits, or DYNAMIC_WIDTH");
+
+
+	public:
+
+		/* name: ConstIterator
+		 * desc: random access iterator over the values, by value
+		 */
+		class ConstIterator
+		{
+			public:
+
+				using iterator_category = std::random_access_iterator_tag;
+				using value_type = uint64_t;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = uint64_t;
+
+				ConstIterator() noexcept = default;
+
+				ConstIterator(const PackedVector* v, std::size_t i) noexcept : v(v), i(i) {}
+
+				uint64_t operator*() const noexcept
+				{
+					return this->v->get(this->i);
+				}
+
+				uint64_t operator[](difference_type n) const noexcept
+				{
+					return this->v->get(this->i + static_cast<std::size_t>(n));
+				}
+
+				ConstIterator& operator++() noexcept
+				{
+					++this->i;
+					return *this;
+				}
+
+				ConstIterator operator++(int) noexcept
+				{
+					ConstIterator old = *this;
+					++this->i;
+					return old;
+				}
+
+				ConstIterator& operator--() noexcept
+				{
+					--this->i;
+					return *this;
+				}
+
+				ConstIterator operator--(int) noexcept
+				{
+					ConstIterator old = *this;
+					--this->i;
+					return old;
+				}
+
+				ConstIterator& operator+=(difference_type n) noexcept
+				{
+					this->i += static_cast<std::size_t>(n);
+					return *this;
+				}
+
+				ConstIterator& operator-=(difference_type n) noexcept
+				{
+					this->i -= static_cast<std::size_t>(n);
+					return *this;
+				}
+
+				friend ConstIterator operator+(ConstIterator it, difference_type n) noexcept
+				{
+					return it += n;
+				}
+
+				friend ConstIterator operator+(difference_type n, ConstIterator it) noexcept
+				{
+					return it += n;
+				}
+
+				friend ConstIterator operator-(ConstIterator it, difference_type n) noexcept
+				{
+					return it -= n;
+				}
+
+				friend difference_type operator-(const ConstIterator& a, const ConstIterator& b) noexcept
+				{
+					return static_cast<difference_type>(a.i - b.i);
+				}
+
+				bool operator==(const ConstIterator& right) const noexcept
+				{
+					return this->i == right.i;
+				}
+
+				bool operator!=(const ConstIterator& right) const noexcept
+				{
+					return this->i != right.i;
+				}
+
+				bool operator<(const ConstIterator& right) const noexcept
+				{
+					return this->i < right.i;
+				}
+
+				bool operator>(const ConstIterator& right) const noexcept
+				{
+					return this->i > right.i;
+				}
+
+				bool operator<=(const ConstIterator& right) const noexcept
+				{
+					return this->i <= right.i;
+				}
+
+				bool operator>=(const ConstIterator& right) const noexcept
+				{
+					return this->i >= right.i;
+				}
+
+
+			private:
+
+				const PackedVector* v = nullptr;
+				std::size_t i = 0;
+		};
+
+		/* name: Reference
+		 * desc: proxy for one value, reads and writes through get / set
+		 */
+		class Reference
+		{
+			public:
+
+				Reference(PackedVector* v, std::size_t i) noexcept : v(v), i(i) {}
+
+				operator uint64_t() const noexcept
+				{
+					return this->v->get(this->i);
+				}
+
+				Reference& operator=(uint64_t value) noexcept
+				{
+					this->v->set(this->i, value);
+					return *this;
+				}
+
+				Reference& operator=(const Reference& right) noexcept
+				{
+					return *this = static_cast<uint64_t>(right);
+				}
+
+
+			private:
+
+				PackedVector* v;
+				std::size_t i;
+		};
+
+		/* Empty vector of fixed width W */
+		PackedVector() : PackedVector(0, W) {}
+
+		/* ctor of n copies of 'value', 'width' (1 - 64) only counts when
+		 * W is DYNAMIC_WIDTH */
+		explicit PackedVector(std::size_t n, int width = W, uint64_t value = 0)
+			: bitWidth(W ? W : (width < 1 ? 1 : width > 64 ? 64 : width))
+		{
+			this->resize(n, value);
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: size
+		 * desc: values stored
+		 * returns: value count
+		 */
+		std::size_t size() const noexcept
+		{
+			return this->count;
+		}
+
+		/* name: empty
+		 * desc: whether no values are stored
+		 * returns: bool
+		 */
+		bool empty() const noexcept
+		{
+			return this->count == 0;
+		}
+
+		/* name: width
+		 * desc: bits per value
+		 * returns: width
+		 */
+		int width() const noexcept
+		{
+			return W ? W : this->bitWidth;
+		}
+
+		/* name: maxValue
+		 * desc: largest value a slot holds, larger ones are cut to their
+		 * low width() bits
+		 * returns: 2^width - 1
+		 */
+		uint64_t maxValue() const noexcept
+		{
+			return bittle::extract_bits<uint64_t>(~uint64_t(0), 0, this->width());
+		}
+
+		/* name: words
+		 * desc: the backing words, one zero word past the last value
+		 * returns: pointer to the words
+		 */
+		const uint64_t* words() const noexcept
+		{
+			return this->data.data();
+		}
+
+		/* name: sizeInBits
+		 * desc: memory held by the words
+		 * returns: bit count
+		 */
+		std::size_t sizeInBits() const noexcept
+		{
+			return this->data.size() * 64;
+		}
+
+		/* name: get
+		 * desc: reads value i
+		 * returns: value
+		 */
+		uint64_t get(std::size_t i) const noexcept
+		{
+			const std::size_t bit = i * static_cast<std::size_t>(this->width());
+			if(this->width() <= 57 && Bits<uint64_t>::isLittleEndian())
+			{
+				/* one unaligned load from the value's first byte holds it all */
+				uint64_t w;
+				std::memcpy(&w, reinterpret_cast<const uint8_t*>(this->data.data()) + bit / BIT_SIZE, sizeof(w));
+				return (w >> (bit % BIT_SIZE)) & this->maxValue();
+			}
+			const uint64_t* p = this->data.data() + bit / 64;
+			const unsigned s = static_cast<unsigned>(bit % 64);
+			return ((p[0] >> s) | ((p[1] << 1) << (63 - s))) & this->maxValue();
+		}
+
+		uint64_t operator[](std::size_t i) const noexcept
+		{
+			return this->get(i);
+		}
+
+		/* name: getAtomic
+		 * desc: reads value i with relaxed atomic loads, for use alongside
+		 * setAtomic
+		 * returns: value
+		 */
+		uint64_t getAtomic(std::size_t i) const noexcept
+		{
+			const std::size_t bit = i * static_cast<std::size_t>(this->width());
+			const uint64_t* p = this->data.data() + bit / 64;
+			const unsigned s = static_cast<unsigned>(bit % 64);
+			const uint64_t lo = __atomic_load_n(p, __ATOMIC_RELAXED);
+			const uint64_t hi = __atomic_load_n(p + 1, __ATOMIC_RELAXED);
+			return ((lo >> s) | ((hi << 1) << (63 - s))) & this->maxValue();
+		}
+
+		/* name: decode
+		 * desc: writes values [first, first + n) to out, walking the words
+		 * once
+		 * returns: out past the last value
+		 */
+		template <typename OutputIt>
+		OutputIt decode(std::size_t first, std::size_t n, OutputIt out) const
+		{
+			const int w = this->width();
+			const uint64_t mask = this->maxValue();
+			std::size_t bit = first * static_cast<std::size_t>(w);
+			if(w <= 57 && Bits<uint64_t>::isLittleEndian())
+			{
+				const uint8_t* bytes = reinterpret_cast<const uint8_t*>(this->data.data());
+				for(std::size_t k = 0; k < n; ++k, bit += static_cast<std::size_t>(w))
+				{
+					uint64_t x;
+					std::memcpy(&x, bytes + bit / BIT_SIZE, sizeof(x));
+					*out++ = (x >> (bit % BIT_SIZE)) & mask;
+				}
+				return out;
+			}
+
+			/* wider values: carry the high word over to the next value */
+			const uint64_t* p = this->data.data() + bit / 64;
+			unsigned s = static_cast<unsigned>(bit % 64);
+			uint64_t lo = p[0];
+			for(std::size_t k = 0; k < n; ++k)
+			{
+				const uint64_t hi = p[1];
+				*out++ = ((lo >> s) | ((hi << 1) << (63 - s))) & mask;
+				s += static_cast<unsigned>(w);
+				if(s >= 64)
+				{
+					s -= 64;
+					++p;
+					lo = hi;
+				}
+			}
+			return out;
+		}
+
+		ConstIterator begin() const noexcept
+		{
+			return ConstIterator(this, 0);
+		}
+
+		ConstIterator end() const noexcept
+		{
+			return ConstIterator(this, this->count);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: set
+		 * desc: writes the low width() bits of 'value' to slot i
+		 * returns: nothing
+		 */
+		void set(std::size_t i, uint64_t value) noexcept
+		{
+			const uint64_t mask = this->maxValue();
+			const std::size_t bit = i * static_cast<std::size_t>(this->width());
+			value &= mask;
+			if(this->width() <= 57 && Bits<uint64_t>::isLittleEndian())
+			{
+				uint8_t* at = reinterpret_cast<uint8_t*>(this->data.data()) + bit / BIT_SIZE;
+				const unsigned s = static_cast<unsigned>(bit % BIT_SIZE);
+				uint64_t w;
+				std::memcpy(&w, at, sizeof(w));
+				w = (w & ~(mask << s)) | (value << s);
+				std::memcpy(at, &w, sizeof(w));
+				return;
+			}
+			uint64_t* p = this->data.data() + bit / 64;
+			const unsigned s = static_cast<unsigned>(bit % 64);
+			p[0] = (p[0] & ~(mask << s)) | (value << s);
+			p[1] = (p[1] & ~((mask >> 1) >> (63 - s))) | ((value >> 1) >> (63 - s));
+		}
+
+		Reference operator[](std::size_t i) noexcept
+		{
+			return Reference(this, i);
+		}
+
+		/* name: setAtomic
+		 * desc: set that other threads' setAtomic calls on other slots of
+		 * the same words cannot undo: each word is updated by a compare
+		 * exchange of only this value's bits
+		 * returns: nothing
+		 */
+		void setAtomic(std::size_t i, uint64_t value) noexcept
+		{
+			const uint64_t mask = this->maxValue();
+			const std::size_t bit = i * static_cast<std::size_t>(this->width());
+			uint64_t* p = this->data.data() + bit / 64;
+			const unsigned s = static_cast<unsigned>(bit % 64);
+			value &= mask;
+			PackedVector::exchangeBits(p, mask << s, value << s);
+			const uint64_t high = (mask >> 1) >> (63 - s);
+			if(high)
+				PackedVector::exchangeBits(p + 1, high, (value >> 1) >> (63 - s));
+		}
+
+		/* name: encode
+		 * desc: overwrites slots [first, first + (last - it)) with the values
+		 * of [it, last), which must fit in size(); whole words are built in a
+		 * register and stored once
+		 * returns: nothing
+		 */
+		template <typename InputIt>
+		void encode(std::size_t first, InputIt it, InputIt last) noexcept
+		{
+			const int w = this->width();
+			const uint64_t mask = this->maxValue();
+			std::size_t bit = first * static_cast<std::size_t>(w);
+			uint64_t* p = this->data.data() + bit / 64;
+			unsigned s = static_cast<unsigned>(bit % 64);
+
+			/* keep the bits below the first slot */
+			uint64_t acc = p[0] & ((uint64_t(1) << s) - 1);
+			for(; it != last; ++it)
+			{
+				const uint64_t v = static_cast<uint64_t>(*it) & mask;
+				acc |= v << s;
+				s += static_cast<unsigned>(w);
+				if(s >= 64)
+				{
+					*p++ = acc;
+					s -= 64;
+					acc = (v >> 1) >> (static_cast<unsigned>(w) - s - 1);
+				}
+			}
+
+			/* and the bits above the last */
+			if(s)
+				*p = (*p & ~((uint64_t(1) << s) - 1)) | acc;
+		}
+
+		/* name: push_back
+		 * desc: appends one value
+		 * returns: nothing
+		 */
+		void push_back(uint64_t value)
+		{
+			this->resize(this->count + 1);
+			this->set(this->count - 1, value);
+		}
+
+		/* name: append
+		 * desc: appends the values of [it, last)
+		 * returns: nothing
+		 */
+		template <typename ForwardIt>
+		void append(ForwardIt it, ForwardIt last)
+		{
+			const std::size_t at = this->count;
+			this->resize(at + static_cast<std::size_t>(std::distance(it, last)));
+			this->encode(at, it, last);
+		}
+
+		/* name: pop_back
+		 * desc: drops the last value
+		 * returns: nothing
+		 */
+		void pop_back() noexcept
+		{
+			this->set(this->count - 1, 0);
+			--this->count;
+		}
+
+		/* name: resize
+		 * desc: grows with copies of 'value' or shrinks to n values
+		 * returns: nothing
+		 */
+		void resize(std::size_t n, uint64_t value = 0)
+		{
+			const std::size_t old = this->count;
+			const std::size_t w = static_cast<std::size_t>(this->width());
+			if(n < old)
+			{
+				/* every bit past the last value stays zero */
+				const std::size_t bit = n * w;
+				this->count = n;
+				this->data.resize((bit + 63) / 64 + 1);
+				this->data[bit / 64] &= (uint64_t(1) << (bit % 64)) - 1;
+				this->data.back() = 0;
+				return;
+			}
+
+			this->data.resize((n * w + 63) / 64 + 1, 0);
+			this->count = n;
+			if(value)
+				for(std::size_t i = old; i < n; ++i)
+					this->set(i, value);
+		}
+
+		/* name: reserve
+		 * desc: makes room for n values
+		 * returns: nothing
+		 */
+		void reserve(std::size_t n)
+		{
+			this->data.reserve((n * static_cast<std::size_t>(this->width()) + 63) / 64 + 1);
+		}
+
+		/* name: clear
+		 * desc: drops every value
+		 * returns: nothing
+		 */
+		void clear() noexcept
+		{
+			this->data.assign(1, 0);
+			this->count = 0;
+		}
+
+
+	private:
+
+		static void exchangeBits(uint64_t* p, uint64_t mask, uint64_t bits) noexcept
+		{
+			uint64_t old = __atomic_load_n(p, __ATOMIC_RELAXED);
+			while(!__atomic_compare_exchange_n(p, &old, (old & ~mask) | bits, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			{
+			}
+		}
+
+		std::vector<uint64_t> data;
+		std::size_t count = 0;
+		int bitWidth;
+};
+
+/* Declarations for ease of use */
+using DynamicPackedVector = PackedVector<DYNAMIC_WIDTH>;
+
+}
+
+
+#endif
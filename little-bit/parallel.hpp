@@ -0,0 +1,78 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: parallel.hpp
+ * purpose: the thread fan out shared by the multi threaded bulk kernels
+ */
+
+
+#ifndef BITTLE_PARALLEL_HPP
+#define BITTLE_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * radix_sort_parallel, HammingIndex and bit_reverse_permute split their
+ * work into 'count' independent parts and hand them to run_threads. A
+ * thread that cannot be started is not an error: its part, and every
+ * part after it, runs on the calling thread instead.
+ */
+
+namespace detail {
+
+/* name: thread_count
+ * desc: 'requested' threads (0 for one per core) for 'parts' units of
+ * work, at least one and no more than there are parts
+ * returns: thread count
+ */
+inline unsigned thread_count(unsigned requested, std::size_t parts) noexcept
+{
+	if(requested == 0)
+		requested = std::max(1u, std::thread::hardware_concurrency());
+	return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(requested, parts)));
+}
+
+/* name: run_threads
+ * desc: runs f(0) .. f(count - 1), f(0) and any part whose thread failed
+ * to start on the calling thread
+ * returns: nothing
+ */
+template <typename F>
+void run_threads(unsigned count, F f) noexcept
+{
+	std::vector<std::thread> pool;
+	unsigned started = 1;
+	/* without exceptions a failed start aborts inside std::thread */
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+	try
+	{
+#endif
+		pool.reserve(count > 1 ? count - 1 : 0);
+		for(; started < count; ++started)
+			pool.emplace_back(f, started);
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+	}
+	catch(...)
+	{
+	}
+#endif
+
+	if(count)
+		f(0);
+	for(unsigned t = started; t < count; ++t)
+		f(t);
+	for(std::thread& t : pool)
+		t.join();
+}
+
+}
+
+}
+
+
+#endif
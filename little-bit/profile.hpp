@@ -0,0 +1,453 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: profile.hpp
+ * purpose: opt in call counters and cycle sampling (BITTLE_PROFILE)
+ */
+
+
+#ifndef BITTLE_PROFILE_HPP
+#define BITTLE_PROFILE_HPP
+
+/* namespace: bittle::profile
+ * Build with -DBITTLE_PROFILE to count how often each Bits method and
+ * bulk kernel runs. Counters are thread local, a snapshot merges every
+ * live thread plus the threads that already exited:
+ *
+ *     bittle::profile::set_sample_period(64);    // rdtsc every 64th kernel call
+ *     ...
+ *     std::cout << bittle::profile::snapshot().text();
+ *
+ * Without BITTLE_PROFILE the two hooks below expand to nothing and none
+ * of the API exists, so wrap reporting code in #ifdef BITTLE_PROFILE.
+ *
+ *   BITTLE_PROFILE_COUNT(site)   a call counter, safe inside constexpr
+ *                                functions (skipped at compile time)
+ *   BITTLE_PROFILE_KERNEL(site)  a counter plus sampled cycles for the
+ *                                rest of the enclosing scope
+ */
+
+/* X(site, printed name), a new site is one line here and one hook */
+#define BITTLE_PROFILE_SITES(X) \
+	X(hammingDistance, "Bits::hammingDistance") \
+	X(toString, "Bits::toString") \
+	X(toStringReverse, "Bits::toStringReverse") \
+	X(ones, "Bits::ones") \
+	X(zeroes, "Bits::zeroes") \
+	X(leadingZeroes, "Bits::leadingZeroes") \
+	X(trailingZeroes, "Bits::trailingZeroes") \
+	X(checkBit, "Bits::checkBit") \
+	X(reverseBits, "Bits::reverseBits") \
+	X(reverseBytes, "Bits::reverseBytes") \
+	X(toggleBit, "Bits::toggleBit") \
+	X(setBit, "Bits::setBit") \
+	X(clearBit, "Bits::clearBit") \
+	X(flipBit, "Bits::flipBit") \
+	X(rotateLeft, "Bits::rotateLeft") \
+	X(rotateRight, "Bits::rotateRight") \
+	X(insertRight, "Bits::insertRight") \
+	X(insertLeft, "Bits::insertLeft") \
+	X(assign, "Bits::assign") \
+	X(reduce, "Bits::reduce") \
+	X(parse, "Bits::parse") \
+	X(crc_update, "Crc::update") \
+	X(matrix_multiply, "BitMatrix::multiply") \
+	X(matrix_transpose, "BitMatrix::transpose") \
+	X(matrix_rank, "BitMatrix::rank") \
+	X(hash_bulk, "hash_bulk") \
+	X(permute_bulk, "BitPermutation::apply[]") \
+	X(span_count, "BitSpan::count") \
+	X(stream_feed, "BitStreamParser::feed") \
+	X(format_bits, "format_bits")
+
+
+#ifdef BITTLE_PROFILE
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#else
+	#include <chrono>
+#endif
+
+#ifdef BITTLE_STANDARD
+	#include <string>
+#endif
+
+namespace bittle {
+
+namespace profile {
+
+enum class Site : int
+{
+#define BITTLE_PROFILE_ENUM(site, name) site,
+	BITTLE_PROFILE_SITES(BITTLE_PROFILE_ENUM)
+#undef BITTLE_PROFILE_ENUM
+	count
+};
+
+static constexpr int SITES = static_cast<int>(Site::count);
+
+/* name: site_name
+ * desc: printable name of a site
+ * returns: name
+ */
+inline const char* site_name(Site s) noexcept
+{
+	static const char* const names[] = {
+#define BITTLE_PROFILE_NAME(site, name) name,
+		BITTLE_PROFILE_SITES(BITTLE_PROFILE_NAME)
+#undef BITTLE_PROFILE_NAME
+	};
+	return names[static_cast<int>(s)];
+}
+
+/* name: ticks
+ * desc: time stamp counter, steady_clock nanoseconds off x86
+ * returns: ticks
+ */
+inline uint64_t ticks() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+namespace detail {
+
+/* One writer per block, relaxed atomics only so snapshot() may read
+ * while the owning thread keeps counting */
+struct Counters
+{
+	std::atomic<uint64_t> calls[SITES];
+	std::atomic<uint64_t> cycles[SITES];
+	std::atomic<uint64_t> samples[SITES];
+
+	Counters() noexcept
+	{
+		this->clear();
+	}
+
+	void clear() noexcept
+	{
+		for(int i = 0; i < SITES; ++i)
+		{
+			this->calls[i].store(0, std::memory_order_relaxed);
+			this->cycles[i].store(0, std::memory_order_relaxed);
+			this->samples[i].store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+/* name: bump
+ * desc: single writer add, a plain load and store
+ * returns: the new value
+ */
+inline uint64_t bump(std::atomic<uint64_t>& c, uint64_t v) noexcept
+{
+	const uint64_t n = c.load(std::memory_order_relaxed) + v;
+	c.store(n, std::memory_order_relaxed);
+	return n;
+}
+
+struct ThreadCounters;
+
+struct Registry
+{
+	std::mutex lock;
+	ThreadCounters* head = nullptr;
+	Counters retired;
+	std::atomic<uint64_t> period{0};
+};
+
+inline Registry& registry() noexcept
+{
+	static Registry r;
+	return r;
+}
+
+struct ThreadCounters : Counters
+{
+	ThreadCounters* next = nullptr;
+	ThreadCounters* prev = nullptr;
+
+	ThreadCounters() noexcept
+	{
+		Registry& r = registry();
+		std::lock_guard<std::mutex> guard(r.lock);
+		this->next = r.head;
+		if(r.head)
+			r.head->prev = this;
+		r.head = this;
+	}
+
+	/* Exiting threads fold their counts into the retired totals */
+	~ThreadCounters()
+	{
+		Registry& r = registry();
+		std::lock_guard<std::mutex> guard(r.lock);
+		for(int i = 0; i < SITES; ++i)
+		{
+			bump(r.retired.calls[i], this->calls[i].load(std::memory_order_relaxed));
+			bump(r.retired.cycles[i], this->cycles[i].load(std::memory_order_relaxed));
+			bump(r.retired.samples[i], this->samples[i].load(std::memory_order_relaxed));
+		}
+		if(this->prev)
+			this->prev->next = this->next;
+		else
+			r.head = this->next;
+		if(this->next)
+			this->next->prev = this->prev;
+	}
+};
+
+inline ThreadCounters& local() noexcept
+{
+	thread_local ThreadCounters counters;
+	return counters;
+}
+
+}
+
+/* name: hit
+ * desc: counts one call of a site on this thread
+ * returns: nothing
+ */
+inline void hit(Site s) noexcept
+{
+	detail::bump(detail::local().calls[static_cast<int>(s)], 1);
+}
+
+/* name: set_sample_period
+ * desc: kernels read the cycle counter on every n-th call, 0 turns
+ * sampling off (the default)
+ * returns: nothing
+ */
+inline void set_sample_period(uint64_t n) noexcept
+{
+	detail::registry().period.store(n, std::memory_order_relaxed);
+}
+
+/* Counts a kernel call and, when sampled, the ticks until scope exit */
+class Scope
+{
+	public:
+
+		explicit Scope(Site s) noexcept
+			: counters(detail::local()), site(static_cast<int>(s))
+		{
+			const uint64_t n = detail::bump(this->counters.calls[this->site], 1);
+			const uint64_t p = detail::registry().period.load(std::memory_order_relaxed);
+			if(p != 0 && n % p == 0)
+				this->start = ticks();
+		}
+
+		~Scope()
+		{
+			if(this->start)
+			{
+				detail::bump(this->counters.cycles[this->site], ticks() - this->start);
+				detail::bump(this->counters.samples[this->site], 1);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+
+		detail::Counters& counters;
+		int site;
+		uint64_t start = 0;
+};
+
+struct Snapshot
+{
+	uint64_t period = 0;
+	uint64_t calls[SITES] = {};
+	uint64_t cycles[SITES] = {};
+	uint64_t samples[SITES] = {};
+
+	/* name: callsTo
+	 * desc: merged call count of a site
+	 * returns: call count
+	 */
+	uint64_t callsTo(Site s) const noexcept
+	{
+		return this->calls[static_cast<int>(s)];
+	}
+
+	/* name: cyclesPerCall
+	 * desc: mean ticks over the sampled calls of a site
+	 * returns: ticks per call, 0 when nothing was sampled
+	 */
+	double cyclesPerCall(Site s) const noexcept
+	{
+		const int i = static_cast<int>(s);
+		return this->samples[i] ? double(this->cycles[i]) / double(this->samples[i]) : 0.0;
+	}
+
+	/* name: text
+	 * desc: one line per called site, most called first, snprintf rules
+	 * returns: full length, terminator excluded
+	 */
+	std::size_t text(char* out, std::size_t cap) const noexcept
+	{
+		int order[SITES];
+		const int n = this->sorted(order);
+		Writer w{out, cap};
+		for(int k = 0; k < n; ++k)
+		{
+			const int i = order[k];
+			w.put("%-26s %14llu calls", site_name(static_cast<Site>(i)),
+			      static_cast<unsigned long long>(this->calls[i]));
+			if(this->samples[i])
+				w.put("  %12.1f cycles/call over %llu samples", this->cyclesPerCall(static_cast<Site>(i)),
+				      static_cast<unsigned long long>(this->samples[i]));
+			w.put("\n");
+		}
+		return w.len;
+	}
+
+	/* name: json
+	 * desc: called sites as a JSON object, most called first, snprintf rules
+	 * returns: full length, terminator excluded
+	 */
+	std::size_t json(char* out, std::size_t cap) const noexcept
+	{
+		int order[SITES];
+		const int n = this->sorted(order);
+		Writer w{out, cap};
+		w.put("{\"sample_period\":%llu,\"sites\":[", static_cast<unsigned long long>(this->period));
+		for(int k = 0; k < n; ++k)
+		{
+			const int i = order[k];
+			w.put("%s{\"name\":\"%s\",\"calls\":%llu,\"cycles\":%llu,\"samples\":%llu}", k ? "," : "",
+			      site_name(static_cast<Site>(i)), static_cast<unsigned long long>(this->calls[i]),
+			      static_cast<unsigned long long>(this->cycles[i]), static_cast<unsigned long long>(this->samples[i]));
+		}
+		w.put("]}");
+		return w.len;
+	}
+
+#ifdef BITTLE_STANDARD
+
+	std::string text() const
+	{
+		std::string s(this->text(nullptr, 0), '\0');
+		this->text(&s[0], s.size() + 1);
+		return s;
+	}
+
+	std::string json() const
+	{
+		std::string s(this->json(nullptr, 0), '\0');
+		this->json(&s[0], s.size() + 1);
+		return s;
+	}
+
+#endif
+
+	private:
+
+		struct Writer
+		{
+			char* out;
+			std::size_t cap;
+			std::size_t len = 0;
+
+			template <typename... Args>
+			void put(const char* fmt, Args... args) noexcept
+			{
+				char* p = this->len < this->cap ? this->out + this->len : nullptr;
+				const int n = std::snprintf(p, p ? this->cap - this->len : 0, fmt, args...);
+				if(n > 0)
+					this->len += static_cast<std::size_t>(n);
+			}
+		};
+
+		int sorted(int* order) const noexcept
+		{
+			int n = 0;
+			for(int i = 0; i < SITES; ++i)
+			{
+				if(!this->calls[i])
+					continue;
+				int k = n++;
+				for(; k > 0 && this->calls[order[k - 1]] < this->calls[i]; --k)
+					order[k] = order[k - 1];
+				order[k] = i;
+			}
+			return n;
+		}
+};
+
+/* name: snapshot
+ * desc: merges the counters of every thread, live or exited
+ * returns: Snapshot
+ */
+inline Snapshot snapshot() noexcept
+{
+	detail::Registry& r = detail::registry();
+	Snapshot s;
+	s.period = r.period.load(std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> guard(r.lock);
+	auto merge = [&s](const detail::Counters& c)
+	{
+		for(int i = 0; i < SITES; ++i)
+		{
+			s.calls[i] += c.calls[i].load(std::memory_order_relaxed);
+			s.cycles[i] += c.cycles[i].load(std::memory_order_relaxed);
+			s.samples[i] += c.samples[i].load(std::memory_order_relaxed);
+		}
+	};
+	merge(r.retired);
+	for(const detail::ThreadCounters* t = r.head; t; t = t->next)
+		merge(*t);
+	return s;
+}
+
+/* name: reset
+ * desc: zeroes every counter, counts racing with the reset may survive
+ * returns: nothing
+ */
+inline void reset() noexcept
+{
+	detail::Registry& r = detail::registry();
+	std::lock_guard<std::mutex> guard(r.lock);
+	r.retired.clear();
+	for(detail::ThreadCounters* t = r.head; t; t = t->next)
+		t->clear();
+}
+
+}
+
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define BITTLE_PROFILE_COUNT(site) \
+		do { if(!__builtin_is_constant_evaluated()) ::bittle::profile::hit(::bittle::profile::Site::site); } while(0)
+#else
+	#define BITTLE_PROFILE_COUNT(site) ::bittle::profile::hit(::bittle::profile::Site::site)
+#endif
+
+#define BITTLE_PROFILE_KERNEL(site) \
+	const ::bittle::profile::Scope bittle_profile_scope(::bittle::profile::Site::site)
+
+#else
+
+#define BITTLE_PROFILE_COUNT(site) ((void)0)
+#define BITTLE_PROFILE_KERNEL(site) ((void)0)
+
+#endif
+
+
+#endif
@@ -0,0 +1,381 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: radix_sort.hpp
+ * purpose: LSD and parallel MSD/LSD radix sort of integral and Bits keys
+ */
+
+
+#ifndef BITTLE_RADIX_SORT_HPP
+#define BITTLE_RADIX_SORT_HPP
+
+#include "bittle.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace bittle {
+
+/* namespace: bittle
+ * Byte at a time radix sort of integral or Bits<T> keys, optionally
+ * dragging a payload array along. The caller owns the scratch space:
+ *
+ *     std::vector<uint64_t> keys = ..., scratch(keys.size());
+ *     radix_sort(keys.data(), keys.size(), scratch.data());
+ *
+ * One read pass builds the histogram of every digit, digits every key
+ * shares are skipped, and each remaining pass scatters through a cache
+ * line sized write combining buffer per bucket. Signed keys (plain or
+ * Bits<int32_t> and friends) have their sign bit flipped on the way in.
+ *
+ * radix_sort_parallel splits on the highest digit where the keys differ
+ * (MSD) and then sorts the 256 buckets on separate threads (LSD). The
+ * sort is stable; keys and payloads must be trivially copyable.
+ */
+
+namespace detail {
+
+/* Key to an unsigned value with the same order */
+template <typename T>
+struct radix_traits
+{
+	static_assert(std::is_integral<T>::value, "Radix sort keys must be integral or Bits");
+
+	using U = typename std::make_unsigned<T>::type;
+	static constexpr int DIGITS = sizeof(T);
+
+	static constexpr U key(const T& k) noexcept
+	{
+		return static_cast<U>(static_cast<U>(k) ^
+		       (std::is_signed<T>::value ? static_cast<U>(U(1) << (sizeof(T) * BIT_SIZE - 1)) : U(0)));
+	}
+};
+
+template <typename T>
+struct radix_traits<Bits<T>> : radix_traits<T>
+{
+	static constexpr typename radix_traits<T>::U key(const Bits<T>& k) noexcept
+	{
+		return radix_traits<T>::key(k.value());
+	}
+};
+
+/* Payload stand in for key only sorts, never touched */
+struct radix_none {};
+
+template <typename K>
+inline unsigned radix_digit(const K& k, int d) noexcept
+{
+	using U = typename radix_traits<K>::U;
+	return static_cast<unsigned>(bittle::extract_bits<U>(radix_traits<K>::key(k), d * BIT_SIZE, BIT_SIZE));
+}
+
+/* Below this many keys a bucket is insertion sorted */
+static constexpr std::size_t RADIX_SMALL = 32;
+
+template <typename K, typename V>
+inline void radix_insertion(K* k, V* v, std::size_t n) noexcept
+{
+	constexpr bool payload = !std::is_same<V, radix_none>::value;
+	for(std::size_t i = 1; i < n; ++i)
+	{
+		const K key = k[i];
+		const auto u = radix_traits<K>::key(key);
+		std::size_t j = i;
+		if(payload)
+		{
+			const V value = v[i];
+			for(; j > 0 && radix_traits<K>::key(k[j - 1]) > u; --j)
+			{
+				k[j] = k[j - 1];
+				v[j] = v[j - 1];
+			}
+			v[j] = value;
+		}
+		else
+		{
+			for(; j > 0 && radix_traits<K>::key(k[j - 1]) > u; --j)
+				k[j] = k[j - 1];
+		}
+		k[j] = key;
+	}
+}
+
+/* name: RadixScatter
+ * desc: moves keys (and payloads) into their buckets, staging WC of
+ * them per bucket so every store to the output is a whole cache line.
+ * WC follows the wider of key and payload, and payloads over 64 bytes
+ * are already whole lines and go straight to the output, so the
+ * staging buffers stay within about 80 KiB of stack
+ */
+template <typename K, typename V>
+class RadixScatter
+{
+	static constexpr bool PAYLOAD = !std::is_same<V, radix_none>::value;
+	static constexpr std::size_t VSIZE = PAYLOAD ? sizeof(V) : 1;
+	static constexpr std::size_t WIDEST = sizeof(K) > VSIZE ? sizeof(K) : VSIZE;
+	static constexpr bool DIRECT = WIDEST > 64;
+	static constexpr std::size_t WC = DIRECT ? 1 : (64 / WIDEST > 4 ? 64 / WIDEST : 4);
+
+
+	public:
+
+		/* name: run
+		 * desc: scatters src[0, n) on digit d, offsets[b] is where bucket
+		 * b starts in dst and is advanced past what was written
+		 * returns: nothing
+		 */
+		void run(const K* ks, const V* vs, std::size_t n, K* kd, V* vd, std::size_t* offsets, int d) noexcept
+		{
+			if(DIRECT)
+			{
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					const std::size_t to = offsets[radix_digit<K>(ks[i], d)]++;
+					std::memcpy(kd + to, ks + i, sizeof(K));
+					if(PAYLOAD)
+						std::memcpy(vd + to, vs + i, VSIZE);
+				}
+				return;
+			}
+
+			std::memset(this->fill, 0, sizeof(this->fill));
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				const unsigned b = radix_digit<K>(ks[i], d);
+				const std::size_t slot = b * WC + this->fill[b];
+				std::memcpy(this->keys + slot * sizeof(K), ks + i, sizeof(K));
+				if(PAYLOAD)
+					std::memcpy(this->values + slot * VSIZE, vs + i, VSIZE);
+				if(++this->fill[b] == WC)
+				{
+					this->flush(b, kd, vd, offsets, WC);
+					this->fill[b] = 0;
+				}
+			}
+			for(unsigned b = 0; b < 256; ++b)
+				if(this->fill[b])
+					this->flush(b, kd, vd, offsets, this->fill[b]);
+		}
+
+
+	private:
+
+		void flush(unsigned b, K* kd, V* vd, std::size_t* offsets, std::size_t count) noexcept
+		{
+			std::memcpy(kd + offsets[b], this->keys + b * WC * sizeof(K), count * sizeof(K));
+			if(PAYLOAD)
+				std::memcpy(vd + offsets[b], this->values + b * WC * VSIZE, count * VSIZE);
+			offsets[b] += count;
+		}
+
+		alignas(64) unsigned char keys[DIRECT ? 1 : 256 * WC * sizeof(K)];
+		alignas(64) unsigned char values[PAYLOAD && !DIRECT ? 256 * WC * VSIZE : 1];
+		std::size_t fill[256];
+};
+
+/* name: radix_lsd
+ * desc: sorts a[0, n) on its low 'digits' digits using b as scratch
+ * returns: true when the result ended up in b instead of a
+ */
+template <typename K, typename V>
+bool radix_lsd(K* ka, V* va, K* kb, V* vb, std::size_t n, int digits) noexcept
+{
+	if(n <= RADIX_SMALL)
+	{
+		radix_insertion<K, V>(ka, va, n);
+		return false;
+	}
+
+	std::size_t hist[radix_traits<K>::DIGITS][256] = {};
+	for(std::size_t i = 0; i < n; ++i)
+		for(int d = 0; d < digits; ++d)
+			++hist[d][radix_digit<K>(ka[i], d)];
+
+	RadixScatter<K, V> scatter;
+	bool flipped = false;
+	for(int d = 0; d < digits; ++d)
+	{
+		/* every key has the same digit here, nothing would move */
+		if(hist[d][radix_digit<K>(ka[0], d)] == n)
+			continue;
+
+		std::size_t offsets[256];
+		std::size_t sum = 0;
+		for(int b = 0; b < 256; ++b)
+		{
+			offsets[b] = sum;
+			sum += hist[d][b];
+		}
+
+		scatter.run(ka, va, n, kb, vb, offsets, d);
+		std::swap(ka, kb);
+		std::swap(va, vb);
+		flipped = !flipped;
+	}
+	return flipped;
+}
+
+template <typename K, typename V>
+void radix_sort(K* keys, V* values, std::size_t n, K* key_scratch, V* value_scratch) noexcept
+{
+	static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+	              "Radix sort moves keys and payloads with memcpy");
+	if(radix_lsd<K, V>(keys, values, key_scratch, value_scratch, n, radix_traits<K>::DIGITS))
+	{
+		std::memcpy(keys, key_scratch, n * sizeof(K));
+		if(!std::is_same<V, radix_none>::value)
+			std::memcpy(values, value_scratch, n * sizeof(V));
+	}
+}
+
+/* Below this many keys radix_sort_parallel stays on one thread */
+static constexpr std::size_t RADIX_PARALLEL_MIN = std::size_t(1) << 16;
+
+template <typename K, typename V>
+void radix_sort_parallel(K* keys, V* values, std::size_t n, K* key_scratch, V* value_scratch, unsigned threads) noexcept
+{
+	using U = typename radix_traits<K>::U;
+	constexpr bool payload = !std::is_same<V, radix_none>::value;
+
+	threads = detail::thread_count(threads, n);
+	if(threads == 1 || n < RADIX_PARALLEL_MIN)
+		return detail::radix_sort<K, V>(keys, values, n, key_scratch, value_scratch);
+
+	const std::size_t chunk = (n + threads - 1) / threads;
+	auto begin = [&](unsigned t) { return std::min(n, t * chunk); };
+
+	/* Bits set in some keys and clear in others, the highest of them
+	 * picks the digit to split on */
+	std::vector<U> any(threads, 0), all(threads, static_cast<U>(~U(0)));
+	run_threads(threads, [&](unsigned t) {
+		U a = 0, b = static_cast<U>(~U(0));
+		for(std::size_t i = begin(t); i < begin(t + 1); ++i)
+		{
+			a |= radix_traits<K>::key(keys[i]);
+			b &= radix_traits<K>::key(keys[i]);
+		}
+		any[t] = a;
+		all[t] = b;
+	});
+	U differ = 0, same = static_cast<U>(~U(0));
+	for(unsigned t = 0; t < threads; ++t)
+	{
+		differ |= any[t];
+		same &= all[t];
+	}
+	differ = static_cast<U>(differ ^ same);
+	if(differ == 0)
+		return;
+	const int top = (static_cast<int>(sizeof(U) * BIT_SIZE) - 1 - bittle::count_leading_zeroes<U>(differ)) / BIT_SIZE;
+
+	/* MSD split on 'top', every thread scatters its own chunk */
+	std::vector<std::size_t> hist(static_cast<std::size_t>(threads) * 256, 0);
+	run_threads(threads, [&](unsigned t) {
+		std::size_t* h = hist.data() + t * 256;
+		for(std::size_t i = begin(t); i < begin(t + 1); ++i)
+			++h[radix_digit<K>(keys[i], top)];
+	});
+
+	std::size_t bucket[257];
+	std::size_t sum = 0;
+	for(int b = 0; b < 256; ++b)
+	{
+		bucket[b] = sum;
+		for(unsigned t = 0; t < threads; ++t)
+		{
+			const std::size_t c = hist[t * 256 + b];
+			hist[t * 256 + b] = sum;
+			sum += c;
+		}
+	}
+	bucket[256] = n;
+
+	run_threads(threads, [&](unsigned t) {
+		RadixScatter<K, V> scatter;
+		const std::size_t lo = begin(t);
+		scatter.run(keys + lo, payload ? values + lo : values, begin(t + 1) - lo,
+		            key_scratch, value_scratch, hist.data() + t * 256, top);
+	});
+
+	/* LSD on the digits below 'top', biggest buckets handed out first */
+	unsigned order[256];
+	for(unsigned b = 0; b < 256; ++b)
+		order[b] = b;
+	std::sort(order, order + 256, [&](unsigned x, unsigned y) {
+		return bucket[x + 1] - bucket[x] > bucket[y + 1] - bucket[y];
+	});
+
+	std::atomic<unsigned> next(0);
+	run_threads(threads, [&](unsigned) {
+		for(unsigned i = next.fetch_add(1, std::memory_order_relaxed); i < 256;
+		    i = next.fetch_add(1, std::memory_order_relaxed))
+		{
+			const std::size_t lo = bucket[order[i]];
+			const std::size_t len = bucket[order[i] + 1] - lo;
+			if(len == 0)
+				continue;
+			V* vs = payload ? value_scratch + lo : value_scratch;
+			V* vk = payload ? values + lo : values;
+			if(!radix_lsd<K, V>(key_scratch + lo, vs, keys + lo, vk, len, top))
+			{
+				std::memcpy(keys + lo, key_scratch + lo, len * sizeof(K));
+				if(payload)
+					std::memcpy(vk, vs, len * sizeof(V));
+			}
+		}
+	});
+}
+
+}
+
+/* name: radix_sort
+ * desc: sorts keys[0, n) ascending, scratch holds n keys
+ * returns: nothing
+ */
+template <typename K>
+void radix_sort(K* keys, std::size_t n, K* scratch) noexcept
+{
+	detail::radix_sort<K, detail::radix_none>(keys, nullptr, n, scratch, nullptr);
+}
+
+/* name: radix_sort
+ * desc: sorts keys[0, n) ascending and applies the same permutation to
+ * values[0, n), the scratch arrays hold n of each
+ * returns: nothing
+ */
+template <typename K, typename V>
+void radix_sort(K* keys, V* values, std::size_t n, K* key_scratch, V* value_scratch) noexcept
+{
+	detail::radix_sort<K, V>(keys, values, n, key_scratch, value_scratch);
+}
+
+/* name: radix_sort_parallel
+ * desc: radix_sort on up to 'threads' threads, 0 for one per core
+ * returns: nothing
+ */
+template <typename K>
+void radix_sort_parallel(K* keys, std::size_t n, K* scratch, unsigned threads = 0) noexcept
+{
+	detail::radix_sort_parallel<K, detail::radix_none>(keys, nullptr, n, scratch, nullptr, threads);
+}
+
+/* name: radix_sort_parallel
+ * desc: radix_sort with payloads on up to 'threads' threads
+ * returns: nothing
+ */
+template <typename K, typename V>
+void radix_sort_parallel(K* keys, V* values, std::size_t n, K* key_scratch, V* value_scratch,
+                         unsigned threads = 0) noexcept
+{
+	detail::radix_sort_parallel<K, V>(keys, values, n, key_scratch, value_scratch, threads);
+}
+
+}
+
+
+#endif
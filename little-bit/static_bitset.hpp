@@ -0,0 +1,565 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: static_bitset.hpp
+ * purpose: fixed size constexpr bitset on an inline array of Bits words
+ */
+
+
+#ifndef BITTLE_STATIC_BITSET_HPP
+#define BITTLE_STATIC_BITSET_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace bittle {
+
+/* namespace: bittle
+ * StaticBitset<N> is N bits in (N + 63) / 64 Bits<uint64_t> words held
+ * inline, bit i being bit i % 64 of word i / 64. Everything is
+ * constexpr, so masks can be built and checked at compile time:
+ *
+ *     constexpr StaticBitset<256> admin{0, 3, 200};
+ *     static_assert(admin.test(200) && admin.count() == 3, "");
+ *     for(std::size_t i : admin.setBits()) ...
+ *
+ * Every loop runs over a compile time number of words and is unrolled by
+ * the optimizer for the usual 128 - 1024 bit sizes. Bits at or above N in
+ * the last word are kept clear. subset and intersects tests stop at the
+ * first word that decides them.
+ */
+
+template <std::size_t N>
+class StaticBitset
+{
+	static_assert(N > 0, "StaticBitset needs at least one bit");
+
+	using Word = Bits<uint64_t>;
+
+	static constexpr std::size_t WORDS = (N + 63) / 64;
+
+	/* valid bits of the last word */
+	static constexpr uint64_t TAIL = N % 64 ? (uint64_t(1) << (N % 64)) - 1 : ~uint64_t(0);
+
+
+	public:
+
+		static constexpr std::size_t npos = ~std::size_t(0);
+
+		/* name: SetBitIterator
+		 * desc: walks the set bits in increasing order, one ctz per bit
+		 */
+		class SetBitIterator
+		{
+			public:
+
+				constexpr SetBitIterator(const StaticBitset* set, std::size_t word) noexcept
+					: set(set), word(word), rest(word < WORDS ? set->words[word].value() : 0)
+				{
+					this->skip();
+				}
+
+				constexpr std::size_t operator*() const noexcept
+				{
+					return this->word * 64 + static_cast<std::size_t>(bittle::count_trailing_zeroes<uint64_t>(this->rest));
+				}
+
+				constexpr SetBitIterator& operator++() noexcept
+				{
+					this->rest &= this->rest - 1;
+					this->skip();
+					return *this;
+				}
+
+				constexpr bool operator==(const SetBitIterator& right) const noexcept
+				{
+					return this->word == right.word && this->rest == right.rest;
+				}
+
+				constexpr bool operator!=(const SetBitIterator& right) const noexcept
+				{
+					return !(*this == right);
+				}
+
+
+			private:
+
+				constexpr void skip() noexcept
+				{
+					while(this->rest == 0 && this->word < WORDS)
+						this->rest = ++this->word < WORDS ? this->set->words[this->word].value() : 0;
+				}
+
+				const StaticBitset* set;
+				std::size_t word;
+				uint64_t rest;
+		};
+
+		/* name: SetBitRange
+		 * desc: begin/end pair for range for over the set bits
+		 */
+		class SetBitRange
+		{
+			public:
+
+				constexpr explicit SetBitRange(const StaticBitset* set) noexcept : set(set) {}
+
+				constexpr SetBitIterator begin() const noexcept
+				{
+					return SetBitIterator(this->set, 0);
+				}
+
+				constexpr SetBitIterator end() const noexcept
+				{
+					return SetBitIterator(this->set, WORDS);
+				}
+
+
+			private:
+
+				const StaticBitset* set;
+		};
+
+		/* Empty set */
+		constexpr StaticBitset() noexcept : StaticBitset(std::make_index_sequence<WORDS>()) {}
+
+		/* ctor from the low 64 bits */
+		explicit constexpr StaticBitset(uint64_t low) noexcept : StaticBitset()
+		{
+			this->words[0].value(WORDS == 1 ? low & TAIL : low);
+		}
+
+		/* ctor from a list of set bit positions, positions >= N are ignored */
+		constexpr StaticBitset(std::initializer_list<std::size_t> positions) noexcept : StaticBitset()
+		{
+			for(std::size_t p : positions)
+				if(p < N)
+					this->setBit(p);
+		}
+
+		/*
+		 *
+		 *
+		 * Non-Mutators
+		 *
+		 *
+		 */
+
+		/* name: size
+		 * desc: bits in the set
+		 * returns: N
+		 */
+		static constexpr std::size_t size() noexcept
+		{
+			return N;
+		}
+
+		/* name: word
+		 * desc: word i, bits 64 * i to 64 * i + 63
+		 * returns: Bits<uint64_t>
+		 */
+		constexpr Bits<uint64_t> word(std::size_t i) const noexcept
+		{
+			return this->words[i];
+		}
+
+		/* name: test
+		 * desc: reads bit 'pos'
+		 * returns: bool
+		 */
+		constexpr bool test(std::size_t pos) const noexcept
+		{
+			return (this->words[pos / 64].value() >> (pos % 64)) & 1;
+		}
+
+		/* name: count
+		 * desc: counts the set bits
+		 * returns: set bit count
+		 */
+		constexpr std::size_t count() const noexcept
+		{
+			std::size_t cnt = 0;
+			for(std::size_t i = 0; i < WORDS; ++i)
+				cnt += bittle::count_ones<uint64_t>(this->words[i].value());
+			return cnt;
+		}
+
+		/* name: any
+		 * desc: whether some bit is set
+		 * returns: bool
+		 */
+		constexpr bool any() const noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				if(this->words[i].value())
+					return true;
+			return false;
+		}
+
+		/* name: none
+		 * desc: whether no bit is set
+		 * returns: bool
+		 */
+		constexpr bool none() const noexcept
+		{
+			return !this->any();
+		}
+
+		/* name: all
+		 * desc: whether every bit is set
+		 * returns: bool
+		 */
+		constexpr bool all() const noexcept
+		{
+			for(std::size_t i = 0; i + 1 < WORDS; ++i)
+				if(~this->words[i].value())
+					return false;
+			return this->words[WORDS - 1].value() == TAIL;
+		}
+
+		/* name: rank
+		 * desc: set bits below 'pos', pos may be N
+		 * returns: count
+		 */
+		constexpr std::size_t rank(std::size_t pos) const noexcept
+		{
+			std::size_t cnt = 0;
+			for(std::size_t i = 0; i < pos / 64; ++i)
+				cnt += bittle::count_ones<uint64_t>(this->words[i].value());
+			if(pos % 64)
+				cnt += bittle::count_ones<uint64_t>(this->words[pos / 64].value() & ((uint64_t(1) << (pos % 64)) - 1));
+			return cnt;
+		}
+
+		/* name: findFirst
+		 * desc: position of the first set bit
+		 * returns: position or npos
+		 */
+		constexpr std::size_t findFirst() const noexcept
+		{
+			return this->scan<false>(0);
+		}
+
+		/* name: findNext
+		 * desc: position of the first set bit at or after 'pos'
+		 * returns: position or npos
+		 */
+		constexpr std::size_t findNext(std::size_t pos) const noexcept
+		{
+			return this->scan<false>(pos);
+		}
+
+		/* name: findFirstZero
+		 * desc: position of the first clear bit
+		 * returns: position or npos
+		 */
+		constexpr std::size_t findFirstZero() const noexcept
+		{
+			return this->scan<true>(0);
+		}
+
+		/* name: findNextZero
+		 * desc: position of the first clear bit at or after 'pos'
+		 * returns: position or npos
+		 */
+		constexpr std::size_t findNextZero(std::size_t pos) const noexcept
+		{
+			return this->scan<true>(pos);
+		}
+
+		/* name: findLast
+		 * desc: position of the last set bit
+		 * returns: position or npos
+		 */
+		constexpr std::size_t findLast() const noexcept
+		{
+			for(std::size_t i = WORDS; i-- > 0; )
+				if(this->words[i].value())
+					return i * 64 + 63 - static_cast<std::size_t>(bittle::count_leading_zeroes<uint64_t>(this->words[i].value()));
+			return npos;
+		}
+
+		/* name: isSubsetOf
+		 * desc: whether every bit of this is set in 'right'
+		 * returns: bool
+		 */
+		constexpr bool isSubsetOf(const StaticBitset& right) const noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				if(this->words[i].value() & ~right.words[i].value())
+					return false;
+			return true;
+		}
+
+		/* name: intersects
+		 * desc: whether this and 'right' share a set bit
+		 * returns: bool
+		 */
+		constexpr bool intersects(const StaticBitset& right) const noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				if(this->words[i].value() & right.words[i].value())
+					return true;
+			return false;
+		}
+
+		/* name: setBits
+		 * desc: the positions of the set bits, for range for
+		 * returns: SetBitRange, valid while this object lives
+		 */
+		constexpr SetBitRange setBits() const noexcept
+		{
+			return SetBitRange(this);
+		}
+
+		/* name: forEach
+		 * desc: calls f(position) for every set bit in increasing order
+		 * returns: nothing
+		 */
+		template <typename F>
+		constexpr void forEach(F f) const
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				for(uint64_t w = this->words[i].value(); w; w &= w - 1)
+					f(i * 64 + static_cast<std::size_t>(bittle::count_trailing_zeroes<uint64_t>(w)));
+		}
+
+		constexpr bool operator==(const StaticBitset& right) const noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				if(this->words[i].value() != right.words[i].value())
+					return false;
+			return true;
+		}
+
+		constexpr bool operator!=(const StaticBitset& right) const noexcept
+		{
+			return !(*this == right);
+		}
+
+		/*
+		 *
+		 *
+		 * Mutators
+		 *
+		 *
+		 */
+
+		/* name: setBit
+		 * desc: sets or clears bit 'pos'
+		 * returns: *this
+		 */
+		constexpr StaticBitset& setBit(std::size_t pos, bool v = true) noexcept
+		{
+			const uint64_t m = uint64_t(1) << (pos % 64);
+			Word& w = this->words[pos / 64];
+			w.value(v ? (w.value() | m) : (w.value() & ~m));
+			return *this;
+		}
+
+		/* name: clearBit
+		 * desc: clears bit 'pos'
+		 * returns: *this
+		 */
+		constexpr StaticBitset& clearBit(std::size_t pos) noexcept
+		{
+			return this->setBit(pos, false);
+		}
+
+		/* name: flipBit
+		 * desc: flips bit 'pos'
+		 * returns: *this
+		 */
+		constexpr StaticBitset& flipBit(std::size_t pos) noexcept
+		{
+			Word& w = this->words[pos / 64];
+			w.value(w.value() ^ (uint64_t(1) << (pos % 64)));
+			return *this;
+		}
+
+		/* name: setAll
+		 * desc: sets every bit
+		 * returns: *this
+		 */
+		constexpr StaticBitset& setAll() noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(~uint64_t(0));
+			this->words[WORDS - 1].value(TAIL);
+			return *this;
+		}
+
+		/* name: clear
+		 * desc: clears every bit
+		 * returns: *this
+		 */
+		constexpr StaticBitset& clear() noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(0);
+			return *this;
+		}
+
+		/* name: invert
+		 * desc: flips every bit
+		 * returns: *this
+		 */
+		constexpr StaticBitset& invert() noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(~this->words[i].value());
+			this->words[WORDS - 1].value(this->words[WORDS - 1].value() & TAIL);
+			return *this;
+		}
+
+		constexpr StaticBitset& operator&=(const StaticBitset& right) noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(this->words[i].value() & right.words[i].value());
+			return *this;
+		}
+
+		constexpr StaticBitset& operator|=(const StaticBitset& right) noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(this->words[i].value() | right.words[i].value());
+			return *this;
+		}
+
+		constexpr StaticBitset& operator^=(const StaticBitset& right) noexcept
+		{
+			for(std::size_t i = 0; i < WORDS; ++i)
+				this->words[i].value(this->words[i].value() ^ right.words[i].value());
+			return *this;
+		}
+
+		/* name: operator<<=
+		 * desc: moves every bit up by 'n', bits pushed past N are lost
+		 * returns: *this
+		 */
+		constexpr StaticBitset& operator<<=(std::size_t n) noexcept
+		{
+			const std::size_t ws = n / 64;
+			const unsigned bs = static_cast<unsigned>(n % 64);
+			for(std::size_t i = WORDS; i-- > 0; )
+			{
+				uint64_t w = 0;
+				if(i >= ws)
+				{
+					w = this->words[i - ws].value() << bs;
+					if(bs && i > ws)
+						w |= this->words[i - ws - 1].value() >> (64 - bs);
+				}
+				this->words[i].value(w);
+			}
+			this->words[WORDS - 1].value(this->words[WORDS - 1].value() & TAIL);
+			return *this;
+		}
+
+		/* name: operator>>=
+		 * desc: moves every bit down by 'n'
+		 * returns: *this
+		 */
+		constexpr StaticBitset& operator>>=(std::size_t n) noexcept
+		{
+			const std::size_t ws = n / 64;
+			const unsigned bs = static_cast<unsigned>(n % 64);
+			for(std::size_t i = 0; i < WORDS; ++i)
+			{
+				uint64_t w = 0;
+				if(i + ws < WORDS)
+				{
+					w = this->words[i + ws].value() >> bs;
+					if(bs && i + ws + 1 < WORDS)
+						w |= this->words[i + ws + 1].value() << (64 - bs);
+				}
+				this->words[i].value(w);
+			}
+			return *this;
+		}
+
+
+	private:
+
+		template <std::size_t... I>
+		constexpr explicit StaticBitset(std::index_sequence<I...>) noexcept
+			: words{((void)I, Word(0))...}
+		{
+
+		}
+
+		template <bool Zero>
+		constexpr std::size_t scan(std::size_t pos) const noexcept
+		{
+			if(pos >= N)
+				return npos;
+			std::size_t i = pos / 64;
+			uint64_t w = (Zero ? ~this->words[i].value() : this->words[i].value()) & (~uint64_t(0) << (pos % 64));
+			for(;;)
+			{
+				if(i == WORDS - 1 && Zero)
+					w &= TAIL;
+				if(w)
+					return i * 64 + static_cast<std::size_t>(bittle::count_trailing_zeroes<uint64_t>(w));
+				if(++i == WORDS)
+					return npos;
+				w = Zero ? ~this->words[i].value() : this->words[i].value();
+			}
+		}
+
+		Word words[WORDS];
+};
+
+template <std::size_t N>
+constexpr std::size_t StaticBitset<N>::npos;
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator&(StaticBitset<N> left, const StaticBitset<N>& right) noexcept
+{
+	return left &= right;
+}
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator|(StaticBitset<N> left, const StaticBitset<N>& right) noexcept
+{
+	return left |= right;
+}
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator^(StaticBitset<N> left, const StaticBitset<N>& right) noexcept
+{
+	return left ^= right;
+}
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator~(StaticBitset<N> right) noexcept
+{
+	return right.invert();
+}
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator<<(StaticBitset<N> left, std::size_t n) noexcept
+{
+	return left <<= n;
+}
+
+template <std::size_t N>
+constexpr StaticBitset<N> operator>>(StaticBitset<N> left, std::size_t n) noexcept
+{
+	return left >>= n;
+}
+
+/* Declarations for ease of use */
+
+using Bitset128 = StaticBitset<128>;
+using Bitset256 = StaticBitset<256>;
+using Bitset512 = StaticBitset<512>;
+using Bitset1024 = StaticBitset<1024>;
+
+}
+
+
+#endif
@@ -0,0 +1,433 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: swar.hpp
+ * purpose: SIMD within a register lane operations and byte scanners
+ */
+
+
+#ifndef BITTLE_SWAR_HPP
+#define BITTLE_SWAR_HPP
+
+#include "bittle.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace bittle {
+
+/* namespace: bittle
+ * A uint64_t (or Bits<uint64_t>) seen as 64 / W lanes of W bits, W being
+ * 8 by default, 16 or 32. Lane 0 is the least significant, which is the
+ * first byte in memory on little endian machines.
+ *
+ * Predicates return a lane mask: the top bit of every matching lane set,
+ * everything else clear. Masks are exact (no false positives above a
+ * match) so they can be counted, combined with & | ~, widened with
+ * expand_lanes or scanned with first_lane / last_lane.
+ */
+
+namespace detail {
+
+template <int W>
+constexpr uint64_t lane_ones() noexcept
+{
+	static_assert(W == 8 || W == 16 || W == 32, "Lanes are 8, 16 or 32 bits wide");
+	return ~uint64_t(0) / ((uint64_t(1) << W) - 1);
+}
+
+template <int W>
+constexpr uint64_t lane_high() noexcept
+{
+	return lane_ones<W>() << (W - 1);
+}
+
+}
+
+/* name: broadcast
+ * desc: copies the low W bits of v into every lane
+ * returns: word
+ */
+template <int W = 8>
+constexpr uint64_t broadcast(uint64_t v) noexcept
+{
+	return (v & ((uint64_t(1) << W) - 1)) * detail::lane_ones<W>();
+}
+
+/* name: zero_lanes
+ * desc: lanes of x that are zero
+ * returns: lane mask
+ */
+template <int W = 8>
+constexpr uint64_t zero_lanes(uint64_t x) noexcept
+{
+	return ~(((x & ~detail::lane_high<W>()) + ~detail::lane_high<W>()) | x | ~detail::lane_high<W>());
+}
+
+/* name: has_zero_byte
+ * desc: whether any byte of x is zero, the classic three operation test
+ * returns: bool
+ */
+constexpr bool has_zero_byte(uint64_t x) noexcept
+{
+	return ((x - detail::lane_ones<8>()) & ~x & detail::lane_high<8>()) != 0;
+}
+
+/* name: equal_lanes
+ * desc: lanes where x and y are equal
+ * returns: lane mask
+ */
+template <int W = 8>
+constexpr uint64_t equal_lanes(uint64_t x, uint64_t y) noexcept
+{
+	return zero_lanes<W>(x ^ y);
+}
+
+/* name: byte_equal_mask
+ * desc: bytes of x equal to c
+ * returns: lane mask
+ */
+constexpr uint64_t byte_equal_mask(uint64_t x, uint8_t c) noexcept
+{
+	return zero_lanes<8>(x ^ broadcast<8>(c));
+}
+
+/* name: lane_add
+ * desc: lane wise a + b mod 2^W, no carry crosses a lane
+ * returns: sums
+ */
+template <int W = 8>
+constexpr uint64_t lane_add(uint64_t a, uint64_t b) noexcept
+{
+	return ((a & ~detail::lane_high<W>()) + (b & ~detail::lane_high<W>())) ^ ((a ^ b) & detail::lane_high<W>());
+}
+
+/* name: lane_sub
+ * desc: lane wise a - b mod 2^W, no borrow crosses a lane
+ * returns: differences
+ */
+template <int W = 8>
+constexpr uint64_t lane_sub(uint64_t a, uint64_t b) noexcept
+{
+	return ((a | detail::lane_high<W>()) - (b & ~detail::lane_high<W>())) ^ ((a ^ ~b) & detail::lane_high<W>());
+}
+
+/* name: less_lanes
+ * desc: lanes where a < b, unsigned. The top bit of the lane is the
+ * borrow out of a - b
+ * returns: lane mask
+ */
+template <int W = 8>
+constexpr uint64_t less_lanes(uint64_t a, uint64_t b) noexcept
+{
+	return ((~a & b) | ((~a | b) & lane_sub<W>(a, b))) & detail::lane_high<W>();
+}
+
+/* name: greater_lanes
+ * desc: lanes where a > b, unsigned
+ * returns: lane mask
+ */
+template <int W = 8>
+constexpr uint64_t greater_lanes(uint64_t a, uint64_t b) noexcept
+{
+	return less_lanes<W>(b, a);
+}
+
+/* name: expand_lanes
+ * desc: widens a lane mask to all ones in each marked lane
+ * returns: full lane mask
+ */
+template <int W = 8>
+constexpr uint64_t expand_lanes(uint64_t m) noexcept
+{
+	return ((m >> (W - 1)) << W) - (m >> (W - 1));
+}
+
+/* name: lane_min
+ * desc: lane wise unsigned minimum
+ * returns: minima
+ */
+template <int W = 8>
+constexpr uint64_t lane_min(uint64_t a, uint64_t b) noexcept
+{
+	return b ^ ((a ^ b) & expand_lanes<W>(less_lanes<W>(a, b)));
+}
+
+/* name: lane_max
+ * desc: lane wise unsigned maximum
+ * returns: maxima
+ */
+template <int W = 8>
+constexpr uint64_t lane_max(uint64_t a, uint64_t b) noexcept
+{
+	return a ^ ((a ^ b) & expand_lanes<W>(less_lanes<W>(a, b)));
+}
+
+/* name: byte_popcount
+ * desc: set bits of every byte, left in that byte
+ * returns: per byte counts
+ */
+constexpr uint64_t byte_popcount(uint64_t x) noexcept
+{
+	return (((x - ((x >> 1) & 0x5555555555555555ULL)) & 0x3333333333333333ULL) +
+	        (((x - ((x >> 1) & 0x5555555555555555ULL)) >> 2) & 0x3333333333333333ULL) +
+	        ((((x - ((x >> 1) & 0x5555555555555555ULL)) & 0x3333333333333333ULL) +
+	          (((x - ((x >> 1) & 0x5555555555555555ULL)) >> 2) & 0x3333333333333333ULL)) >> 4)) &
+	       0x0F0F0F0F0F0F0F0FULL;
+}
+
+/* name: nibble_popcount
+ * desc: set bits of every nibble, left in that nibble
+ * returns: per nibble counts
+ */
+constexpr uint64_t nibble_popcount(uint64_t x) noexcept
+{
+	return ((x - ((x >> 1) & 0x5555555555555555ULL)) & 0x3333333333333333ULL) +
+	       (((x - ((x >> 1) & 0x5555555555555555ULL)) >> 2) & 0x3333333333333333ULL);
+}
+
+/* name: sum_bytes
+ * desc: adds the eight bytes of x
+ * returns: sum (0 - 2040)
+ */
+constexpr uint32_t sum_bytes(uint64_t x) noexcept
+{
+	return static_cast<uint32_t>(
+		(((x & 0x00FF00FF00FF00FFULL) + ((x >> 8) & 0x00FF00FF00FF00FFULL)) * 0x0001000100010001ULL) >> 48);
+}
+
+/* name: first_lane
+ * desc: lowest marked lane of a mask
+ * returns: lane index, 64 / W when the mask is empty
+ */
+template <int W = 8>
+constexpr int first_lane(uint64_t m) noexcept
+{
+	return bittle::count_trailing_zeroes<uint64_t>(m) / W;
+}
+
+/* name: last_lane
+ * desc: highest marked lane of a mask
+ * returns: lane index, -1 when the mask is empty
+ */
+template <int W = 8>
+constexpr int last_lane(uint64_t m) noexcept
+{
+	return (63 - bittle::count_leading_zeroes<uint64_t>(m)) / W - (m == 0);
+}
+
+/* name: lane_count
+ * desc: marked lanes of a mask
+ * returns: count
+ */
+constexpr int lane_count(uint64_t m) noexcept
+{
+	return static_cast<int>(bittle::count_ones<uint64_t>(m));
+}
+
+/* Bits<uint64_t> overloads */
+
+template <int W = 8>
+constexpr Bits<uint64_t> zero_lanes(const Bits<uint64_t>& x) noexcept
+{
+	return Bits<uint64_t>(zero_lanes<W>(x.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> equal_lanes(const Bits<uint64_t>& x, const Bits<uint64_t>& y) noexcept
+{
+	return Bits<uint64_t>(equal_lanes<W>(x.value(), y.value()));
+}
+
+constexpr Bits<uint64_t> byte_equal_mask(const Bits<uint64_t>& x, uint8_t c) noexcept
+{
+	return Bits<uint64_t>(byte_equal_mask(x.value(), c));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> lane_add(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(lane_add<W>(a.value(), b.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> lane_sub(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(lane_sub<W>(a.value(), b.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> less_lanes(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(less_lanes<W>(a.value(), b.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> greater_lanes(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(greater_lanes<W>(a.value(), b.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> lane_min(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(lane_min<W>(a.value(), b.value()));
+}
+
+template <int W = 8>
+constexpr Bits<uint64_t> lane_max(const Bits<uint64_t>& a, const Bits<uint64_t>& b) noexcept
+{
+	return Bits<uint64_t>(lane_max<W>(a.value(), b.value()));
+}
+
+constexpr Bits<uint64_t> byte_popcount(const Bits<uint64_t>& x) noexcept
+{
+	return Bits<uint64_t>(byte_popcount(x.value()));
+}
+
+constexpr Bits<uint64_t> nibble_popcount(const Bits<uint64_t>& x) noexcept
+{
+	return Bits<uint64_t>(nibble_popcount(x.value()));
+}
+
+template <int W = 8>
+constexpr int first_lane(const Bits<uint64_t>& m) noexcept
+{
+	return first_lane<W>(m.value());
+}
+
+/* Scanners. Words are loaded little endian so lane i is byte i. */
+
+namespace detail {
+
+inline uint64_t load_word(const uint8_t* p) noexcept
+{
+	uint64_t w;
+	std::memcpy(&w, p, sizeof(w));
+	return bittle::Bits<uint64_t>::isLittleEndian() ? w : __builtin_bswap64(w);
+}
+
+/* name: load_aligned_word
+ * desc: load_word of an 8 byte aligned address, for string_length only:
+ * the word may reach past the end of the object (never past its page),
+ * so address sanitizer is told to look away here and nowhere else
+ * returns: word
+ */
+#if defined(__GNUC__) || defined(__clang__)
+typedef uint64_t swar_aliased_word __attribute__((may_alias));
+
+__attribute__((no_sanitize_address))
+inline uint64_t load_aligned_word(const uint8_t* p) noexcept
+{
+	const uint64_t w = *reinterpret_cast<const swar_aliased_word*>(p);
+	return bittle::Bits<uint64_t>::isLittleEndian() ? w : __builtin_bswap64(w);
+}
+#else
+inline uint64_t load_aligned_word(const uint8_t* p) noexcept
+{
+	return load_word(p);
+}
+#endif
+
+/* name: byte_hits
+ * desc: bytes equal to c, exact in the lowest hit only (a borrow may
+ * mark lanes above a real match), three operations per word
+ * returns: lane mask
+ */
+constexpr uint64_t byte_hits(uint64_t w, uint64_t pattern) noexcept
+{
+	return ((w ^ pattern) - lane_ones<8>()) & ~(w ^ pattern) & lane_high<8>();
+}
+
+}
+
+/* name: find_byte
+ * desc: memchr, two words per step
+ * returns: index of the first c in p[0, n), n when there is none
+ */
+inline std::size_t find_byte(const void* data, uint8_t c, std::size_t n) noexcept
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	const uint64_t pattern = broadcast<8>(c);
+	std::size_t i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		const uint64_t m0 = detail::byte_hits(detail::load_word(p + i), pattern);
+		const uint64_t m1 = detail::byte_hits(detail::load_word(p + i + 8), pattern);
+		if(m0 | m1)
+			return i + (m0 ? first_lane(m0) : 8 + first_lane(m1));
+	}
+	if(i + 8 <= n)
+	{
+		const uint64_t m = detail::byte_hits(detail::load_word(p + i), pattern);
+		if(m)
+			return i + static_cast<std::size_t>(first_lane(m));
+		i += 8;
+	}
+	if(i < n && n >= 8)
+	{
+		/* last word again, overlapping, with the lanes already seen dropped */
+		const std::size_t back = 8 - (n - i);
+		const uint64_t m = byte_equal_mask(detail::load_word(p + n - 8), c) >> (8 * back);
+		return m ? i + static_cast<std::size_t>(first_lane(m)) : n;
+	}
+	for(; i < n; ++i)
+		if(p[i] == c)
+			return i;
+	return n;
+}
+
+/* name: count_byte
+ * desc: occurrences of c in p[0, n), e.g. lines in a buffer
+ * returns: count
+ */
+inline std::size_t count_byte(const void* data, uint8_t c, std::size_t n) noexcept
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	const uint64_t pattern = broadcast<8>(c);
+	std::size_t total = 0;
+	std::size_t i = 0;
+	while(i + 8 <= n)
+	{
+		/* each hit adds one to its own byte of acc, 255 words at most
+		 * before the bytes are summed */
+		uint64_t acc = 0;
+		for(int k = 0; k < 255 && i + 8 <= n; ++k, i += 8)
+			acc += zero_lanes<8>(detail::load_word(p + i) ^ pattern) >> 7;
+		total += sum_bytes(acc);
+	}
+	for(; i < n; ++i)
+		total += p[i] == c;
+	return total;
+}
+
+/* name: string_length
+ * desc: strlen. Every load is an aligned word, which can not cross into
+ * an unmapped page but may read before s and past the terminator, see
+ * load_aligned_word
+ * returns: length
+ */
+inline std::size_t string_length(const char* s) noexcept
+{
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(s);
+	const std::size_t mis = reinterpret_cast<uintptr_t>(p) & 7;
+	const uint8_t* w = p - mis;
+
+	/* the bytes in front of s are forced nonzero */
+	uint64_t word = detail::load_aligned_word(w);
+	word |= (uint64_t(1) << (8 * mis)) - 1;
+
+	for(;;)
+	{
+		const uint64_t m = (word - detail::lane_ones<8>()) & ~word & detail::lane_high<8>();
+		if(m)
+			return static_cast<std::size_t>(w - p) + static_cast<std::size_t>(first_lane(m));
+		w += 8;
+		word = detail::load_aligned_word(w);
+	}
+}
+
+}
+
+
+#endif
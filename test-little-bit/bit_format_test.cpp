@@ -0,0 +1,121 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_format_test.cpp
+ * purpose: formatting against a per digit reference
+ */
+
+
+#include "bit_format.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+
+/* reference: one digit at a time, then spaced out */
+template <typename T>
+static std::string reference(T n, const bittle::BitFormat& f)
+{
+  using U = typename std::make_unsigned<T>::type;
+  const int shift = f.base == 16 ? 4 : f.base == 8 ? 3 : 1;
+  const int digits = bittle::detail::format_digits<T>(f.base);
+  const char* abc = f.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+  std::string msb;
+  for(int i = digits - 1; i >= 0; --i)
+    msb += abc[(static_cast<uint64_t>(static_cast<U>(n)) >> (i * shift)) & (f.base - 1)];
+
+  std::string out;
+  for(int i = 0; i < digits; ++i)
+  {
+    const int d = f.lsb_first ? digits - 1 - i : i;
+    const int from_lsb = f.lsb_first ? i : digits - i;
+    if(i > 0 && f.group > 0 && f.group < digits && from_lsb % f.group == 0)
+      out += f.separator;
+    out += msb[d];
+  }
+  return out;
+}
+
+template <typename T>
+static int check(T n)
+{
+  int failures = 0;
+  const int bases[] = {2, 8, 16};
+  for(int base : bases)
+    for(int group = 0; group <= 5; ++group)
+      for(int lsb = 0; lsb < 2; ++lsb)
+        for(int upper = 0; upper < 2; ++upper)
+        {
+          bittle::BitFormat f;
+          f.base = base;
+          f.group = group;
+          f.lsb_first = lsb != 0;
+          f.uppercase = upper != 0;
+
+          char buf[200];
+          std::memset(buf, '#', sizeof(buf));
+          const std::size_t len = bittle::format_bits(bittle::Bits<T>(n), buf, sizeof(buf), f);
+          const std::string want = reference<T>(n, f);
+          if(len != want.size() || len != bittle::format_length<T>(f) || want != buf)
+          {
+            std::cout << "format " << sizeof(T) << " base " << base << " group " << group
+                      << " got " << buf << " want " << want << std::endl;
+            ++failures;
+          }
+
+          /* too small: nothing written, full length returned */
+          std::memset(buf, '#', sizeof(buf));
+          if(bittle::format_bits<T>(n, buf, len - 1, f) != len || buf[0] != '#')
+            ++failures;
+
+          /* exact fit: no terminator */
+          if(bittle::format_bits<T>(n, buf, len, f) != len || buf[len] != '#')
+            ++failures;
+
+          if(bittle::BitsText<T>(n, f).c_str() != want)
+            ++failures;
+        }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  uint64_t s = 88172645463325252ULL;
+  for(int i = 0; i < 200; ++i)
+  {
+    next(s);
+    failures += check<uint64_t>(s);
+    failures += check<int64_t>(static_cast<int64_t>(s));
+    failures += check<uint32_t>(static_cast<uint32_t>(s));
+    failures += check<int16_t>(static_cast<int16_t>(s));
+    failures += check<uint8_t>(static_cast<uint8_t>(s));
+    failures += check<int8_t>(static_cast<int8_t>(s));
+  }
+
+  /* toString keeps its old output */
+  Bits16U b(0xA5F0);
+  if(b.toString() != "1010010111110000" || b.toStringReverse() != "0000111110100101")
+    ++failures;
+
+  BitFormat hex;
+  hex.base = 16;
+  hex.group = 4;
+  hex.separator = '\'';
+  hex.uppercase = true;
+  if(std::string(to_text(Bits64U(0xDEADBEEF0BADF00DULL), hex).c_str()) != "DEAD'BEEF'0BAD'F00D")
+    ++failures;
+
+#if __cplusplus >= 201703L
+  char buf[32];
+  if(format_view(Bits8U(5), buf, sizeof(buf)) != "00000101" || !format_view(Bits8U(5), buf, 4).empty())
+    ++failures;
+#endif
+
+  std::cout << "bit_format failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
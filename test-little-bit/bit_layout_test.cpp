@@ -0,0 +1,131 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_layout_test.cpp
+ * purpose: BitLayout accessors against BitSpan
+ */
+
+
+#include "bit_layout.hpp"
+#include "bit_span.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+struct Version {}; struct Ihl {}; struct Tos {}; struct Length {};
+struct Id {}; struct Flags {}; struct Frag {}; struct Ttl {};
+
+using Ipv4Head = bittle::NetworkLayout<
+  bittle::Field<Version, 4>, bittle::Field<Ihl, 4>, bittle::Field<Tos, 8>, bittle::Field<Length, 16>,
+  bittle::Field<Id, 16>, bittle::Field<Flags, 3>, bittle::Field<Frag, 13>, bittle::Field<Ttl, 8>>;
+
+struct A {}; struct B {}; struct C {}; struct D {}; struct E {};
+
+/* odd widths so fields straddle bytes and words */
+template <bittle::BitOrder O>
+using Odd = bittle::BitLayout<O,
+  bittle::Field<A, 3>, bittle::Field<B, 61, true>, bittle::Field<C, 64>,
+  bittle::Field<D, 16, false, bittle::FieldOrder::little>, bittle::Field<E, 5, true>>;
+
+static_assert(Ipv4Head::bits == 72 && Ipv4Head::offset<Frag>() == 51, "layout offsets");
+
+using Small = bittle::NetworkLayout<bittle::Field<A, 4>, bittle::Field<B, 4>, bittle::Field<C, 8>>;
+static_assert(Small::pack<uint16_t>(0xA, 0x5, 0x3C).value() == 0xA53C, "constexpr pack");
+static_assert(Small::get<B>(bittle::Bits16U(0xA53C)) == 0x5, "constexpr get");
+
+template <bittle::BitOrder O>
+static int check_odd(std::mt19937_64& rng)
+{
+  using namespace bittle;
+  using L = Odd<O>;
+  int failures = 0;
+  const bool msb = O == BitOrder::msb_first;
+
+  for(int t = 0; t < 2000; ++t)
+  {
+    std::vector<uint8_t> buf(L::bytes);
+    for(auto& b : buf)
+      b = static_cast<uint8_t>(rng());
+    BitSpan span(buf.data(), buf.size() * 8);
+    auto ref = [&](int off, int w) { return msb ? span.getMsb(off, w) : span.get(off, w); };
+
+    if(L::template get<A>(buf.data()) != ref(0, 3))
+      ++failures;
+    const uint64_t b = ref(3, 61);
+    if(static_cast<uint64_t>(L::template get<B>(buf.data())) != (b | ((b >> 60) ? ~((uint64_t(1) << 61) - 1) : 0)))
+      ++failures;
+    if(L::template get<C>(buf.data()) != ref(64, 64))
+      ++failures;
+    const uint64_t d = ref(128, 16);
+    const uint64_t dnat = msb ? ((d >> 8) | ((d & 0xFF) << 8)) : d;
+    if(L::template get<D>(buf.data()) != dnat)
+      ++failures;
+
+    /* record path agrees with the direct path */
+    auto r = L::load(buf.data());
+    if(r.template get<C>() != L::template get<C>(buf.data()) || r.template get<E>() != L::template get<E>(buf.data()))
+      ++failures;
+
+    const uint64_t v = rng();
+    const std::vector<uint8_t> before = buf;
+    L::template set<B>(buf.data(), v);
+    if(static_cast<uint64_t>(L::template get<B>(buf.data())) << 3 != v << 3 ||
+       ref(0, 3) != (msb ? BitSpan(const_cast<uint8_t*>(before.data()), 8).getMsb(0, 3) :
+                           BitSpan(const_cast<uint8_t*>(before.data()), 8).get(0, 3)) ||
+       ref(64, 64) != (msb ? ConstBitSpan(before.data(), before.size() * 8).getMsb(64, 64) :
+                             ConstBitSpan(before.data(), before.size() * 8).get(64, 64)))
+      ++failures;
+    L::template set<D>(buf.data(), 0x1234);
+    L::template set<E>(buf.data(), static_cast<uint64_t>(-3));
+    if(L::template get<D>(buf.data()) != 0x1234 || L::template get<E>(buf.data()) != -3)
+      ++failures;
+
+    r = L::load(buf.data());
+    r.template set<A>(5).template set<C>(v);
+    std::vector<uint8_t> out(L::bytes);
+    L::store(r, out.data());
+    if(L::template get<A>(out.data()) != 5 || L::template get<C>(out.data()) != v ||
+       L::template get<D>(out.data()) != 0x1234)
+      ++failures;
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  std::mt19937_64 rng(11);
+  int failures = 0;
+
+  const uint8_t pkt[9] = {0x45, 0x00, 0x05, 0xDC, 0x1C, 0x46, 0x40, 0x00, 0x40};
+  if(Ipv4Head::get<Version>(pkt) != 4 || Ipv4Head::get<Ihl>(pkt) != 5 || Ipv4Head::get<Length>(pkt) != 1500 ||
+     Ipv4Head::get<Id>(pkt) != 0x1C46 || Ipv4Head::get<Flags>(pkt) != 2 || Ipv4Head::get<Frag>(pkt) != 0 ||
+     Ipv4Head::get<Ttl>(pkt) != 64)
+    ++failures;
+
+  failures += check_odd<BitOrder::msb_first>(rng);
+  failures += check_odd<BitOrder::lsb_first>(rng);
+
+  /* structure of arrays decode */
+  uint8_t many[3 * 9];
+  for(int i = 0; i < 3; ++i)
+  {
+    std::copy(pkt, pkt + 9, many + 9 * i);
+    Ipv4Head::set<Ttl>(many + 9 * i, 10 + i);
+  }
+  uint8_t ver[3], ihl[3], tos[3], ttl[3], flags[3];
+  uint16_t len[3], id[3], frag[3];
+  Ipv4Head::decode(many, 3, 9, ver, ihl, tos, len, id, flags, frag, ttl);
+  if(ttl[0] != 10 || ttl[2] != 12 || len[1] != 1500 || ver[2] != 4)
+    ++failures;
+
+  Bits16U b(0);
+  Small::set<C>(b, 0xFF);
+  if(b.value() != 0x00FF || Small::get<C>(b) != 0xFF)
+    ++failures;
+
+  std::cout << "bit_layout failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
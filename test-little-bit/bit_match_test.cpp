@@ -0,0 +1,223 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_match_test.cpp
+ * purpose: bit-parallel matchers against naive search and dynamic programming
+ */
+
+
+#include "bit_match.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+static std::string random_text(uint64_t& s, std::size_t n, int sigma)
+{
+  std::string t;
+  for(std::size_t i = 0; i < n; ++i)
+    t += static_cast<char>('a' + next(s) % sigma);
+  return t;
+}
+
+/* Sellers: best edit distance of p to a substring of t ending at each j */
+static std::vector<std::size_t> sellers(const std::string& p, const std::string& t)
+{
+  const std::size_t m = p.size();
+  std::vector<std::size_t> col(m + 1), out;
+  for(std::size_t i = 0; i <= m; ++i)
+    col[i] = i;
+  for(char c : t)
+  {
+    std::size_t diag = col[0];
+    col[0] = 0;
+    for(std::size_t i = 1; i <= m; ++i)
+    {
+      const std::size_t up = col[i];
+      col[i] = std::min({up + 1, col[i - 1] + 1, diag + (p[i - 1] == c ? 0 : 1)});
+      diag = up;
+    }
+    out.push_back(col[m]);
+  }
+  return out;
+}
+
+static std::size_t levenshtein(const std::string& a, const std::string& b)
+{
+  std::vector<std::size_t> col(a.size() + 1);
+  for(std::size_t i = 0; i <= a.size(); ++i)
+    col[i] = i;
+  for(std::size_t j = 0; j < b.size(); ++j)
+  {
+    std::size_t diag = col[0];
+    col[0] = j + 1;
+    for(std::size_t i = 1; i <= a.size(); ++i)
+    {
+      const std::size_t up = col[i];
+      col[i] = std::min({up + 1, col[i - 1] + 1, diag + (a[i - 1] == b[j] ? 0 : 1)});
+      diag = up;
+    }
+  }
+  return col[a.size()];
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  const std::size_t lengths[] = {1, 2, 5, 31, 63, 64, 65, 100, 128, 129, 200};
+  for(std::size_t m : lengths)
+  {
+    for(int r = 0; r < 4; ++r)
+    {
+      const int sigma = r < 2 ? 2 : 4;
+      std::string text = random_text(s, 1500, sigma);
+      const std::string p = random_text(s, m, sigma);
+      /* plant a few exact and a few damaged copies */
+      for(int c = 0; c < 3 && m < text.size(); ++c)
+      {
+        std::string q = p;
+        if(c)
+          q[next(s) % m] = 'x';
+        text.replace(next(s) % (text.size() - m), m, q);
+      }
+
+      /* exact */
+      std::vector<std::size_t> expect, got;
+      for(std::size_t i = 0; i + m <= text.size(); ++i)
+        if(text.compare(i, m, p) == 0)
+          expect.push_back(i);
+      const ShiftOr so(p.data(), m);
+      so.findAll(text.data(), text.size(), [&](std::size_t i) { got.push_back(i); });
+      failures += got != expect;
+      failures += so.count(text.data(), text.size()) != expect.size();
+      failures += so.find(text.data(), text.size()) != (expect.empty() ? ShiftOr::npos : expect[0]);
+
+      const int k = static_cast<int>(std::min<std::size_t>(m - 1, 1 + next(s) % 4));
+
+      /* k mismatches */
+      std::vector<std::pair<std::size_t, int>> want, have;
+      for(std::size_t i = 0; i + m <= text.size(); ++i)
+      {
+        int e = 0;
+        for(std::size_t q = 0; q < m; ++q)
+          e += text[i + q] != p[q];
+        if(e <= k)
+          want.emplace_back(i + m - 1, e);
+      }
+      const WuManber hm(p.data(), m, k, MatchMetric::hamming);
+      hm.findAll(text.data(), text.size(), [&](std::size_t end, int e) { have.emplace_back(end, e); });
+      failures += have != want;
+
+      /* k edits, Wu-Manber and Myers against Sellers */
+      const std::vector<std::size_t> best = sellers(p, text);
+      want.clear();
+      have.clear();
+      for(std::size_t j = 0; j < best.size(); ++j)
+        if(best[j] <= static_cast<std::size_t>(k))
+          want.emplace_back(j, static_cast<int>(best[j]));
+      const WuManber ed(p.data(), m, k, MatchMetric::edit);
+      ed.findAll(text.data(), text.size(), [&](std::size_t end, int e) { have.emplace_back(end, e); });
+      failures += have != want;
+
+      have.clear();
+      const Myers my(p.data(), m);
+      my.findAll(text.data(), text.size(), static_cast<std::size_t>(k),
+                 [&](std::size_t end, std::size_t e) { have.emplace_back(end, static_cast<int>(e)); });
+      failures += have != want;
+
+      std::size_t end = 0;
+      const std::size_t low = my.best(text.data(), text.size(), end);
+      const std::size_t lowest = *std::min_element(best.begin(), best.end());
+      failures += low != lowest;
+      failures += best[end] != lowest;
+
+      const std::string other = random_text(s, next(s) % 300, sigma);
+      failures += my.distance(other.data(), other.size()) != levenshtein(p, other);
+    }
+  }
+
+  /* k past the pattern length is clamped to m, a negative k is rejected */
+  for(const std::size_t m : {std::size_t(5), std::size_t(70)})
+  {
+    const std::string p = random_text(s, m, 3);
+    const std::string text = random_text(s, 400, 3);
+    for(const MatchMetric metric : {MatchMetric::hamming, MatchMetric::edit})
+    {
+      const WuManber huge(p.data(), m, static_cast<int>(m) + 5, metric), exact(p.data(), m, static_cast<int>(m), metric);
+      std::vector<std::pair<std::size_t, int>> want, have;
+      exact.findAll(text.data(), text.size(), [&](std::size_t end, int e) { want.emplace_back(end, e); });
+      huge.findAll(text.data(), text.size(), [&](std::size_t end, int e) { have.emplace_back(end, e); });
+      failures += !huge.ok() || huge.errors() != m || have != want;
+
+      /* against the references at k = m */
+      std::vector<std::pair<std::size_t, int>> ref;
+      if(metric == MatchMetric::hamming)
+        for(std::size_t i = 0; i + m <= text.size(); ++i)
+        {
+          int e = 0;
+          for(std::size_t q = 0; q < m; ++q)
+            e += text[i + q] != p[q];
+          ref.emplace_back(i + m - 1, e);
+        }
+      else
+      {
+        const std::vector<std::size_t> best = sellers(p, text);
+        for(std::size_t j = 0; j < best.size(); ++j)
+          ref.emplace_back(j, static_cast<int>(best[j]));
+      }
+      failures += want != ref;
+
+      const WuManber negative(p.data(), m, -1, metric);
+      failures += negative.ok() || negative.count(text.data(), text.size()) != 0;
+    }
+  }
+
+  /* batch against one ShiftOr per pattern */
+  for(int r = 0; r < 10; ++r)
+  {
+    const std::string text = random_text(s, 5000, 2 + r % 3);
+    std::vector<std::string> pats;
+    std::vector<const char*> ptrs;
+    std::vector<std::size_t> lens;
+    const std::size_t count = 1 + next(s) % 13;
+    for(std::size_t i = 0; i < count; ++i)
+      pats.push_back(random_text(s, 1 + next(s) % 64, 2 + r % 3));
+    for(const std::string& q : pats)
+    {
+      ptrs.push_back(q.data());
+      lens.push_back(q.size());
+    }
+    const ShiftOrBatch batch(ptrs.data(), lens.data(), count);
+    std::vector<std::pair<std::size_t, std::size_t>> want, have;
+    for(std::size_t i = 0; i < count; ++i)
+      ShiftOr(pats[i].data(), pats[i].size()).findAll(text.data(), text.size(),
+        [&](std::size_t start) { want.emplace_back(start + pats[i].size() - 1, i); });
+    batch.findAll(text.data(), text.size(), [&](std::size_t l, std::size_t end) { have.emplace_back(end, l); });
+    std::sort(want.begin(), want.end());
+    std::sort(have.begin(), have.end());
+    failures += have != want;
+    failures += !batch.ok();
+  }
+
+  /* 65 bytes is over the lane width, its 64 byte prefix must not match */
+  {
+    const std::string text(200, 'a');
+    const std::string longer(65, 'a'), fits(64, 'a');
+    const char* ptrs[] = {longer.data(), fits.data(), "", "b"};
+    const std::size_t lens[] = {longer.size(), fits.size(), 0, 1};
+    const ShiftOrBatch batch(ptrs, lens, 4);
+    std::size_t hits[4] = {0, 0, 0, 0};
+    batch.findAll(text.data(), text.size(), [&](std::size_t l, std::size_t) { ++hits[l]; });
+    failures += batch.ok() || batch.accepted(0) || !batch.accepted(1) || batch.accepted(2) || !batch.accepted(3);
+    failures += hits[0] != 0 || hits[1] != 200 - 63 || hits[2] != 0 || hits[3] != 0;
+  }
+
+  std::cout << "bit_match failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_matrix_test.cpp
+ * purpose: BitMatrix checks against the naive product and plain bool
+ * references, at sizes around word boundaries
+ */
+
+
+#include "bit_matrix.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+static bittle::BitMatrix random_matrix(std::size_t r, std::size_t c, std::mt19937_64& rng)
+{
+  bittle::BitMatrix m(r, c);
+  for(std::size_t i = 0; i < r; ++i)
+    for(std::size_t j = 0; j < c; ++j)
+      m.set(i, j, rng() & 1);
+  return m;
+}
+
+using Dense = std::vector<std::vector<bool>>;
+
+static Dense dense(const bittle::BitMatrix& m)
+{
+  Dense d(m.rows(), std::vector<bool>(m.cols()));
+  for(std::size_t i = 0; i < m.rows(); ++i)
+    for(std::size_t j = 0; j < m.cols(); ++j)
+      d[i][j] = m.get(i, j);
+  return d;
+}
+
+/* reduced row echelon form by the textbook loop, returns the rank */
+static std::size_t dense_echelon(Dense& d, std::size_t cols)
+{
+  std::size_t r = 0;
+  for(std::size_t c = 0; c < cols && r < d.size(); ++c)
+  {
+    std::size_t p = r;
+    while(p < d.size() && !d[p][c])
+      ++p;
+    if(p == d.size())
+      continue;
+    std::swap(d[p], d[r]);
+    for(std::size_t i = 0; i < d.size(); ++i)
+      if(i != r && d[i][c])
+        for(std::size_t j = 0; j < cols; ++j)
+          d[i][j] = d[i][j] != d[r][j];
+    ++r;
+  }
+  return r;
+}
+
+/* Floyd Warshall on bools */
+static void dense_closure(Dense& d)
+{
+  for(std::size_t k = 0; k < d.size(); ++k)
+    for(std::size_t i = 0; i < d.size(); ++i)
+      if(d[i][k])
+        for(std::size_t j = 0; j < d.size(); ++j)
+          d[i][j] = d[i][j] || d[k][j];
+}
+
+static int check_size(std::size_t n, std::mt19937_64& rng)
+{
+  using namespace bittle;
+  int failures = 0;
+  const std::size_t m = n + 1 + rng() % 70;
+
+  /* transpose of an n x m matrix */
+  BitMatrix a = random_matrix(n, m, rng);
+  const BitMatrix t = a.transpose();
+  bool ok = t.rows() == m && t.cols() == n;
+  for(std::size_t i = 0; ok && i < n; ++i)
+    for(std::size_t j = 0; j < m; ++j)
+      ok = ok && t.get(j, i) == a.get(i, j);
+  if(!ok)
+  {
+    std::cout << "transpose " << n << " x " << m << " mismatch" << std::endl;
+    ++failures;
+  }
+
+  /* elimination, rank deficient by duplicating and summing rows */
+  BitMatrix e = random_matrix(n, n, rng);
+  for(std::size_t i = 0; i + 2 < n; i += 3)
+    for(std::size_t j = 0; j < n; ++j)
+      e.set(i + 2, j, e.get(i, j) != e.get(i + 1, j));
+  Dense de = dense(e);
+  const std::size_t want = dense_echelon(de, n);
+  const std::size_t rank = e.rank();
+  if(e.rowEchelon() != want || rank != want || dense(e) != de)
+  {
+    std::cout << "echelon " << n << " rank " << rank << " want " << want << " mismatch" << std::endl;
+    ++failures;
+  }
+
+  /* closure of a sparse graph, chains cross the word boundaries */
+  BitMatrix g(n, n);
+  for(std::size_t k = 0; k < n + n / 2; ++k)
+    g.set(rng() % n, rng() % n);
+  Dense dg = dense(g);
+  dense_closure(dg);
+  if(dense(g.transitiveClosure()) != dg)
+  {
+    std::cout << "closure " << n << " mismatch" << std::endl;
+    ++failures;
+  }
+
+  /* Four Russians against the naive product, odd inner sizes */
+  const BitMatrix b = random_matrix(m, n + 3, rng);
+  if(BitMatrix::multiply(a, b) != BitMatrix::multiplyNaive(a, b) ||
+     BitMatrix::booleanMultiply(a, b) != BitMatrix::multiplyNaive(a, b, true))
+  {
+    std::cout << "multiply " << n << " x " << m << " mismatch" << std::endl;
+    ++failures;
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  std::mt19937_64 rng(42);
+  int failures = 0;
+
+  BitMatrix a = random_matrix(131, 77, rng);
+  BitMatrix b = random_matrix(77, 200, rng);
+
+  if(BitMatrix::multiply(a, b) != BitMatrix::multiplyNaive(a, b))
+    ++failures;
+  if(BitMatrix::booleanMultiply(a, b) != BitMatrix::multiplyNaive(a, b, true))
+    ++failures;
+  if(a.transpose().transpose() != a || a.transpose().get(5, 100) != a.get(100, 5))
+    ++failures;
+  if(BitMatrix::identity(100).rank() != 100 || a.rank() != a.transpose().rank())
+    ++failures;
+
+  /* chain 0 -> 1 -> ... -> 9 closes to a strict upper triangle */
+  BitMatrix g(10, 10);
+  for(std::size_t i = 0; i + 1 < 10; ++i)
+    g.set(i, i + 1);
+  g.transitiveClosure();
+  if(g.ones() != 45 || !g.get(0, 9) || g.get(9, 0))
+    ++failures;
+
+  for(std::size_t n : {1, 63, 64, 65, 128, 129, 200})
+    failures += check_size(n, rng);
+
+  /* inner sizes disagree, the product is empty */
+  const BitMatrix c = random_matrix(78, 199, rng);
+  if(BitMatrix::multiply(a, c).rows() != 0 || BitMatrix::booleanMultiply(a, c).cols() != 0 ||
+     BitMatrix::multiplyNaive(a, c).rows() != 0 || (a * b).rows() != 131)
+    ++failures;
+
+  /* closure only applies to square matrices */
+  BitMatrix r = random_matrix(10, 20, rng);
+  const BitMatrix r0 = r;
+  if(r.transitiveClosure() != r0)
+    ++failures;
+
+  std::cout << "bit_matrix failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_parse_test.cpp
+ * purpose: Bits::parse and the stream parser against a per char reference
+ */
+
+
+#include "bit_parse.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/* reference: digits only, one bit at a time, last word padded on the right */
+static std::vector<uint64_t> reference(const std::string& text, int base)
+{
+  std::vector<uint64_t> words;
+  uint64_t acc = 0;
+  int n = 0;
+  const int shift = base == 16 ? 4 : 1;
+  for(char c : text)
+  {
+    int d = -1;
+    if(c >= '0' && c <= '9') d = c - '0';
+    else if((c | 0x20) >= 'a' && (c | 0x20) <= 'f') d = (c | 0x20) - 'a' + 10;
+    if(d < 0)
+      continue;
+    for(int b = shift - 1; b >= 0; --b)
+    {
+      acc = (acc << 1) | ((d >> b) & 1);
+      if(++n == 64)
+      {
+        words.push_back(acc);
+        acc = 0;
+        n = 0;
+      }
+    }
+  }
+  if(n)
+    words.push_back(acc << (64 - n));
+  return words;
+}
+
+template <int Base>
+static int check_stream(uint64_t& s)
+{
+  int failures = 0;
+  const char* abc = "0123456789abcdefABCDEF";
+  std::string text;
+  const std::size_t len = next(s) % 3000;
+  for(std::size_t i = 0; i < len; ++i)
+  {
+    const uint64_t r = next(s);
+    if(r % 50 == 0)
+      text += r & 64 ? '\n' : '_';
+    else
+      text += Base == 16 ? abc[r % 22] : abc[r & 1];
+  }
+
+  const std::vector<uint64_t> want = reference(text, Base);
+  std::vector<uint64_t> got(want.size() + 1);
+
+  /* random chunking must not matter */
+  bittle::BitStreamParser<Base> p(got.data(), got.size());
+  for(std::size_t i = 0; i < text.size(); )
+  {
+    const std::size_t n = std::min<std::size_t>(text.size() - i, next(s) % 200);
+    p.feed(text.data() + i, n);
+    i += n;
+  }
+  const bittle::ParseResult r = p.finish();
+  got.resize(p.words());
+  if(!r || r.position != text.size() || got != want)
+  {
+    std::cout << "stream base " << Base << " len " << text.size() << std::endl;
+    ++failures;
+  }
+
+  /* a bad char is reported at its absolute position */
+  if(!text.empty())
+  {
+    const std::size_t at = next(s) % text.size();
+    std::string broken = text;
+    broken[at] = 'z';
+    std::size_t words = 0;
+    got.assign(want.size() + 1, 0);
+    const bittle::ParseResult e = bittle::parse_words<Base>(broken.data(), broken.size(), got.data(), got.size(), words);
+    if(e.status != bittle::ParseStatus::invalid_digit || e.position != at)
+      ++failures;
+  }
+
+  /* not enough room */
+  if(want.size() > 1)
+  {
+    std::size_t words = 0;
+    const bittle::ParseResult e = bittle::parse_words<Base>(text.data(), text.size(), got.data(), want.size() - 1, words);
+    if(e.status != bittle::ParseStatus::overflow || words != want.size() - 1)
+      ++failures;
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int i = 0; i < 300; ++i)
+  {
+    const uint64_t v = next(s);
+
+    /* round trip through toString for every width */
+    Bits64U b64(0);
+    if(!Bits64U::parse(Bits64U(v).toString(), b64) || b64.value() != v)
+      ++failures;
+    Bits16 b16(0);
+    if(!Bits16::parse(Bits16(static_cast<int16_t>(v)).toString(), b16) || b16.value() != static_cast<int16_t>(v))
+      ++failures;
+
+    /* short strings are zero extended */
+    const int len = 1 + static_cast<int>(v % 64);
+    const std::string tail = Bits64U(v).toString().substr(64 - len);
+    const uint64_t mask = len == 64 ? ~uint64_t(0) : (uint64_t(1) << len) - 1;
+    if(!Bits64U::parse(tail, b64) || b64.value() != (v & mask))
+      ++failures;
+
+    /* hex, either case */
+    char hex[16];
+    for(int d = 0; d < 16; ++d)
+    {
+      const char* abc = (v >> d) & 1 ? "0123456789ABCDEF" : "0123456789abcdef";
+      hex[d] = abc[(v >> (60 - 4 * d)) & 15];
+    }
+    uint64_t h = 0;
+    if(!parse_bits<uint64_t>(hex, 16, h, 16) || h != v)
+      ++failures;
+
+    failures += check_stream<2>(s);
+    failures += check_stream<16>(s);
+  }
+
+  Bits32U b(7);
+  ParseResult r = Bits32U::parse("0x1F", b, 16);
+  if(!r || b.value() != 0x1F || r.position != 4)
+    ++failures;
+  r = Bits32U::parse("0b101", b);
+  if(!r || b.value() != 5)
+    ++failures;
+  r = Bits32U::parse("1012", b);
+  if(r.status != ParseStatus::invalid_digit || r.position != 3 || b.value() != 5)
+    ++failures;
+  Bits8U b8(0);
+  r = Bits8U::parse("111111111", b8, 2);
+  if(r.status != ParseStatus::overflow || r.position != 8)
+    ++failures;
+  r = Bits32U::parse("0x", b, 16);
+  if(r.status != ParseStatus::empty)
+    ++failures;
+  Bits64U b64(0);
+  r = Bits64U::parse(std::string(63, '1') + "\x81", b64);
+  if(r.status != ParseStatus::invalid_digit || r.position != 63)
+    ++failures;
+
+  std::cout << "bit_parse failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_permute_test.cpp
+ * purpose: compiled permutations against the per bit gather
+ */
+
+
+#include "bit_permute.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+
+/* DES final permutation (0 based, reflected to lsb first numbering) */
+struct DesFp
+{
+  static constexpr uint8_t map[64] = {
+    24, 56, 16, 48,  8, 40,  0, 32, 25, 57, 17, 49,  9, 41,  1, 33,
+    26, 58, 18, 50, 10, 42,  2, 34, 27, 59, 19, 51, 11, 43,  3, 35,
+    28, 60, 20, 52, 12, 44,  4, 36, 29, 61, 21, 53, 13, 45,  5, 37,
+    30, 62, 22, 54, 14, 46,  6, 38, 31, 63, 23, 55, 15, 47,  7, 39 };
+};
+constexpr uint8_t DesFp::map[64];
+
+struct Reverse32
+{
+  static constexpr uint8_t map[32] = {
+    31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16,
+    15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0 };
+};
+constexpr uint8_t Reverse32::map[32];
+
+/* swap the two nibbles of each byte of a 16 bit word */
+struct NibbleSwap16
+{
+  static constexpr uint8_t map[16] = { 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11 };
+};
+constexpr uint8_t NibbleSwap16::map[16];
+
+struct Scatter8
+{
+  static constexpr uint8_t map[8] = { 3, 7, 0, 5, 1, 6, 2, 4 };
+};
+constexpr uint8_t Scatter8::map[8];
+
+static_assert(bittle::BitPermutation<uint32_t, Reverse32>::apply(1u) == 0x80000000u, "constexpr apply");
+
+template <typename P, typename T>
+static int check(std::mt19937_64& rng)
+{
+  int failures = 0;
+  for(int i = 0; i < 10000; ++i)
+  {
+    const T x = static_cast<T>(rng());
+    if(P::apply(x) != P::applyNaive(x))
+      ++failures;
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  std::mt19937_64 rng(7);
+  int failures = 0;
+
+  failures += check<BitPermutation<uint64_t, DesFp>, uint64_t>(rng);
+  failures += check<BitPermutation<int64_t, DesFp>, int64_t>(rng);
+  failures += check<BitPermutation<uint32_t, Reverse32>, uint32_t>(rng);
+  failures += check<BitPermutation<uint16_t, NibbleSwap16>, uint16_t>(rng);
+  failures += check<BitPermutation<uint8_t, Scatter8>, uint8_t>(rng);
+
+  /* every random permutation must route through the Benes network */
+  for(int t = 0; t < 200; ++t)
+  {
+    uint8_t map[64];
+    for(int i = 0; i < 64; ++i)
+      map[i] = static_cast<uint8_t>(i);
+    std::shuffle(map, map + 64, rng);
+    PermutePlan<64> p = compile_permutation<64>(map);
+    const uint64_t x = rng();
+    uint64_t y = x, want = 0;
+    for(int s = 0; s < p.stages; ++s)
+    {
+      const uint64_t d = ((y >> p.shift[s]) ^ y) & p.mask[s];
+      y ^= d ^ (d << p.shift[s]);
+    }
+    for(int i = 0; i < 64; ++i)
+      want |= ((x >> map[i]) & 1) << i;
+    if(y != want)
+      ++failures;
+  }
+
+  const Bits32U b(0x0000FFFFu);
+  if(BitPermutation<uint32_t, Reverse32>::apply(b).value() != 0xFFFF0000u)
+    ++failures;
+
+  std::cout << "bit_permute failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
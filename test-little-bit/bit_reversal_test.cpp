@@ -0,0 +1,99 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_reversal_test.cpp
+ * purpose: bit_reverse_permute in and out of place against the per index
+ * definition, for several element sizes, lengths and thread counts
+ */
+
+
+#include "bit_reversal.hpp"
+#include "xorshift.hpp"
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/* 24 bytes, not a power of two */
+struct Sample
+{
+  uint64_t a, b, c;
+
+  bool operator==(const Sample& o) const
+  {
+    return a == o.a && b == o.b && c == o.c;
+  }
+};
+
+template <typename T>
+static T make(uint64_t v);
+
+template <> uint8_t make<uint8_t>(uint64_t v) { return uint8_t(v); }
+template <> uint32_t make<uint32_t>(uint64_t v) { return uint32_t(v); }
+template <> std::complex<double> make<std::complex<double>>(uint64_t v) { return {double(v & 0xFFFF), double(v >> 48)}; }
+template <> Sample make<Sample>(uint64_t v) { return Sample{v, ~v, v * 3}; }
+
+template <typename T>
+static int check(const char* name, int log2n, unsigned threads, uint64_t& s)
+{
+  using namespace bittle;
+  const std::size_t n = std::size_t(1) << log2n;
+  std::vector<T> in(n), out(n), want(n);
+  for(std::size_t i = 0; i < n; ++i)
+    in[i] = make<T>(next(s));
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    std::size_t r = 0;
+    for(int k = 0; k < log2n; ++k)
+      r |= ((i >> k) & 1) << (log2n - 1 - k);
+    want[r] = in[i];
+  }
+
+  int failures = 0;
+  bit_reverse_permute(in.data(), out.data(), log2n, threads);
+  if(out != want)
+  {
+    std::cout << name << " out of place 2^" << log2n << " threads " << threads << " mismatch" << std::endl;
+    ++failures;
+  }
+
+  bit_reverse_permute(in.data(), log2n, threads);
+  if(in != want)
+  {
+    std::cout << name << " in place 2^" << log2n << " threads " << threads << " mismatch" << std::endl;
+    ++failures;
+  }
+  return failures;
+}
+
+template <typename T>
+static int check_all(const char* name, int max_log, uint64_t& s)
+{
+  int failures = 0;
+  for(int lg = 0; lg <= max_log; ++lg)
+    for(unsigned threads : {1u, 3u, 0u})
+      failures += check<T>(name, lg, threads, s);
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  failures += check_all<uint8_t>("uint8_t", 20, s);
+  failures += check_all<uint32_t>("uint32_t", 19, s);
+  failures += check_all<std::complex<double>>("complex<double>", 17, s);
+  failures += check_all<Sample>("Sample", 15, s);
+
+  for(std::size_t i : {std::size_t(0), std::size_t(1), std::size_t(6), std::size_t(0x2C)})
+    if(bit_reverse_index(i, 6) != detail::reversal_of(i, 6) || bit_reverse_index(bit_reverse_index(i, 6), 6) != i)
+      ++failures;
+  if(bit_reverse_index(1, 6) != 32 || bit_reverse_index(6, 6) != 24)
+    ++failures;
+
+  std::cout << "bit_reversal failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_span_test.cpp
+ * purpose: BitSpan fields against a bit at a time reference
+ */
+
+
+#include "bit_span.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+static bool ref_bit(const std::vector<uint8_t>& b, std::size_t i, bool msb)
+{
+  return (b[i / 8] >> (msb ? 7 - i % 8 : i % 8)) & 1;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  std::mt19937_64 rng(3);
+  int failures = 0;
+
+  std::vector<uint8_t> buf(37);
+  for(auto& b : buf)
+    b = static_cast<uint8_t>(rng());
+
+  for(int t = 0; t < 20000; ++t)
+  {
+    const std::size_t off = rng() % 8;
+    BitSpan span(buf.data(), buf.size() * 8 - off, off);
+    const unsigned n = static_cast<unsigned>(rng() % 65);
+    const std::size_t pos = rng() % (span.size() - n + 1);
+    const bool msb = rng() & 1;
+
+    uint64_t want = 0;
+    for(unsigned i = 0; i < n; ++i)
+      if(ref_bit(buf, off + pos + i, msb))
+        want |= msb ? (uint64_t(1) << (n - 1 - i)) : (uint64_t(1) << i);
+    if((msb ? span.getMsb(pos, n) : span.get(pos, n)) != want)
+      ++failures;
+
+    /* write a fresh value and make sure only the field changed */
+    const std::vector<uint8_t> before = buf;
+    const uint64_t v = rng();
+    if(msb)
+      span.setMsb(pos, n, v);
+    else
+      span.set(pos, n, v);
+    const uint64_t vm = n == 64 ? v : (v & ((uint64_t(1) << n) - 1));
+    if((msb ? span.getMsb(pos, n) : span.get(pos, n)) != vm)
+      ++failures;
+    for(std::size_t i = 0; i < buf.size() * 8; ++i)
+      if((i < off + pos || i >= off + pos + n) && ref_bit(buf, i, msb) != ref_bit(before, i, msb))
+      {
+        ++failures;
+        break;
+      }
+  }
+
+  /* search and count against the reference */
+  ConstBitSpan all(buf.data(), buf.size() * 8);
+  std::size_t cnt = 0;
+  for(std::size_t i = 0; i < all.size(); ++i)
+    cnt += all.test(i);
+  if(all.count() != cnt)
+    ++failures;
+  for(std::size_t off = 0; off < 16; ++off)
+    for(std::size_t len : {std::size_t(0), std::size_t(3), std::size_t(8) - off % 8, std::size_t(64), std::size_t(65),
+                           std::size_t(127), all.size() - off})
+    {
+      const ConstBitSpan part = all.subspan(off, len);
+      std::size_t want = 0;
+      for(std::size_t k = 0; k < len; ++k)
+        want += part.test(k);
+      if(part.count() != want)
+        ++failures;
+    }
+  ConstBitSpan sub = all.subspan(13, 200);
+  std::size_t i = sub.findFirst(), expect = 0;
+  for(; i != ConstBitSpan::npos; i = sub.findNext(i + 1), ++expect)
+  {
+    while(expect < sub.size() && !sub.test(expect))
+      ++expect;
+    if(i != expect)
+      ++failures;
+  }
+  if(sub.test(0) == (sub.findFirstZero() == 0))
+    ++failures;
+
+  uint32_t words[2] = {0x80000001u, 0};
+  BitSpan ws(as_bits(words), 2);
+  if(ws.findFirst() != 0 || ws.findNext(1) != 31 || ws.findNext(32) != BitSpan::npos ||
+     ws.field<uint32_t>(0).value() != 0x80000001u || ws.findFirstZero() != 1)
+    ++failures;
+
+  std::cout << "bit_span failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
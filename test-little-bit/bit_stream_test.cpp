@@ -0,0 +1,64 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bit_stream_test.cpp
+ * purpose: BitWriter and BitReader round trips against a bit at a time reference
+ */
+
+
+#include "bit_stream.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int r = 0; r < 200; ++r)
+  {
+    BitWriter w;
+    std::vector<bool> ref;
+    std::vector<std::pair<uint64_t, int>> fields;
+    const int count = static_cast<int>(next(s) % 300);
+    for(int i = 0; i < count; ++i)
+    {
+      const int n = static_cast<int>(next(s) % 65);
+      const uint64_t v = next(s);
+      w.write(v, n);
+      fields.emplace_back(n == 64 ? v : (v & ((uint64_t(1) << n) - 1)), n);
+      for(int b = n - 1; b >= 0; --b)
+        ref.push_back((v >> b) & 1);
+    }
+    failures += w.bits() != ref.size();
+
+    /* the snapshot and the finished stream agree with the reference */
+    const std::vector<uint8_t> snap = w.bytes();
+    const std::vector<uint8_t> out = w.finish();
+    failures += snap != out;
+    failures += out.size() != (ref.size() + 7) / 8;
+    for(std::size_t i = 0; i < ref.size(); ++i)
+      failures += ((out[i / 8] >> (7 - i % 8)) & 1) != ref[i];
+
+    BitReader rd(out);
+    for(const std::pair<uint64_t, int>& f : fields)
+    {
+      if(f.second > 0 && f.second <= 56 && (next(s) & 1))
+        failures += rd.peek(f.second) != f.first;
+      failures += rd.read(f.second) != f.first;
+    }
+    failures += rd.position() != ref.size();
+    failures += rd.overrun();
+    rd.read(static_cast<int>(out.size() * 8 - ref.size()));
+    failures += rd.overrun();
+    failures += rd.read(5) != 0;
+    failures += !rd.overrun();
+  }
+
+  std::cout << "bit_stream failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bits_batch_test.cpp
+ * purpose: BitsBatch methods against Bits lane by lane, every kernel set
+ * against the scalar one
+ */
+
+
+#include "bits_batch.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+
+/* random lanes with the edge values mixed in */
+template <typename T>
+static T lane(uint64_t& s)
+{
+  const uint64_t r = next(s);
+  switch(r % 8)
+  {
+    case 0: return T(0);
+    case 1: return T(~T(0));
+    case 2: return T(T(1) << (r >> 8) % (sizeof(T) * 8));
+    default: return T(r >> 3);
+  }
+}
+
+template <typename T>
+static T bytes_reversed(T x)
+{
+  T r = 0;
+  for(std::size_t i = 0; i < sizeof(T); ++i)
+    r = T((r << 4 << 4) | ((x >> (8 * i)) & 0xFF));
+  return r;
+}
+
+template <typename T, std::size_t N>
+static int check_methods(uint64_t& s)
+{
+  using namespace bittle;
+  int failures = 0;
+  constexpr int w = sizeof(T) * 8;
+
+  T a[N], b[N], shift[N], nonzero[N];
+  for(std::size_t i = 0; i < N; ++i)
+  {
+    a[i] = lane<T>(s);
+    b[i] = lane<T>(s);
+    shift[i] = T(next(s) % (2 * w));
+    nonzero[i] = T(lane<T>(s) | 1);
+  }
+  const T k = lane<T>(s);
+  const int n = int(next(s) % w) + 1;
+
+  const BitsBatch<T, N> x(a), y(b), sh(shift), nz(nonzero);
+
+  /* per lane results, want computed with Bits and plain operators */
+  auto expect = [&](const BitsBatch<T, N>& got, auto want) {
+    for(std::size_t i = 0; i < N; ++i)
+      if(got[i] != T(want(a[i], b[i], shift[i], nonzero[i])))
+      {
+        ++failures;
+        return;
+      }
+  };
+
+  expect(x.ones(), [](T v, T, T, T) { return Bits<T>(v).ones(); });
+  expect(x.zeroes(), [](T v, T, T, T) { return Bits<T>(v).zeroes(); });
+  expect(x.leadingZeroes(), [](T v, T, T, T) { return Bits<T>(v).leadingZeroes(); });
+  expect(x.trailingZeroes(), [](T v, T, T, T) { return Bits<T>(v).trailingZeroes(); });
+  expect(x.hammingDistance(y), [](T v, T u, T, T) { return count_ones<T>(T(v ^ u)); });
+  expect(x.hammingDistance(k), [k](T v, T, T, T) { return count_ones<T>(T(v ^ k)); });
+  expect(x.checkBit(n), [n](T v, T, T, T) { return (v >> (n - 1)) & 1; });
+  expect(x.checkBit(0), [](T, T, T, T) { return 0; });
+  expect(x.checkBit(w + 1), [](T, T, T, T) { return 0; });
+
+  expect(BitsBatch<T, N>(x).reverseBits(), [](T v, T, T, T) { return reverse_bits<T>(v); });
+  expect(BitsBatch<T, N>(x).reverseBytes(), [](T v, T, T, T) { return bytes_reversed<T>(v); });
+  expect(BitsBatch<T, N>(x).switchByteOrder(), [](T v, T, T, T) { return bytes_reversed<T>(v); });
+  expect(BitsBatch<T, N>(x).setBit(n), [n](T v, T, T, T) { return v | (T(1) << (n - 1)); });
+  expect(BitsBatch<T, N>(x).clearBit(n), [n](T v, T, T, T) { return v & ~(T(1) << (n - 1)); });
+  expect(BitsBatch<T, N>(x).toggleBit(n), [n](T v, T, T, T) { return v ^ (T(1) << (n - 1)); });
+  expect(BitsBatch<T, N>(x).flipBit(n), [n](T v, T, T, T) { return v ^ (T(1) << (n - 1)); });
+  expect(BitsBatch<T, N>(x).setBit(0).setBit(w + 1), [](T v, T, T, T) { return v; });
+  expect(BitsBatch<T, N>(x).rotateLeft(n), [n](T v, T, T, T) { return rotl<T>(v, n); });
+  expect(BitsBatch<T, N>(x).rotateRight(n), [n](T v, T, T, T) { return rotr<T>(v, n); });
+  expect(BitsBatch<T, N>(x).rotateLeft(-n), [n](T v, T, T, T) { return rotr<T>(v, n); });
+  expect(BitsBatch<T, N>(x).rotateLeft(sh), [](T v, T, T c, T) { return rotl<T>(v, c); });
+  expect(BitsBatch<T, N>(x).rotateRight(sh), [](T v, T, T c, T) { return rotr<T>(v, c); });
+  expect(BitsBatch<T, N>(x).negate(), [](T v, T, T, T) { return T(0) - v; });
+  expect(BitsBatch<T, N>(x).invert(), [](T v, T, T, T) { return T(~v); });
+  expect(BitsBatch<T, N>(x).clear(), [](T, T, T, T) { return 0; });
+  expect(BitsBatch<T, N>(x).add(k), [k](T v, T, T, T) { return T(v + k); });
+  expect(BitsBatch<T, N>(x).subtract(y), [](T v, T u, T, T) { return T(v - u); });
+  expect(BitsBatch<T, N>(x).multiply(k), [k](T v, T, T, T) { return T(uint64_t(v) * k); });
+  expect(BitsBatch<T, N>(x).divide(nz), [](T v, T, T, T d) { return T(v / d); });
+  expect(BitsBatch<T, N>(x).mod(T(k | 1)), [k](T v, T, T, T) { return T(v % T(k | 1)); });
+
+  expect(x & y, [](T v, T u, T, T) { return v & u; });
+  expect(x | k, [k](T v, T, T, T) { return v | k; });
+  expect(x ^ y, [](T v, T u, T, T) { return v ^ u; });
+  expect(x + y, [](T v, T u, T, T) { return T(v + u); });
+  expect(x - k, [k](T v, T, T, T) { return T(v - k); });
+  expect(x * y, [](T v, T u, T, T) { return T(uint64_t(v) * u); });
+  expect(x % nz, [](T v, T, T, T d) { return T(v % d); });
+  expect(x / T(k | 1), [k](T v, T, T, T) { return T(v / T(k | 1)); });
+  expect(x << sh, [w](T v, T, T c, T) { return c >= w ? T(0) : T(uint64_t(v) << c); });
+  expect(x >> sh, [w](T v, T, T c, T) { return c >= w ? T(0) : T(v >> c); });
+  expect(x << T(n - 1), [n](T v, T, T, T) { return T(uint64_t(v) << (n - 1)); });
+  expect(x >> T(n - 1), [n](T v, T, T, T) { return T(v >> (n - 1)); });
+  expect(x << T(w), [](T, T, T, T) { return 0; });
+  expect(x >> T(w + 3), [](T, T, T, T) { return 0; });
+  expect(~x, [](T v, T, T, T) { return T(~v); });
+  expect(-x, [](T v, T, T, T) { return T(0) - v; });
+
+  /* a batch with itself and with one of its own lanes */
+  {
+    BitsBatch<T, N> z(x);
+    z += z;
+    expect(z, [](T v, T, T, T) { return T(v + v); });
+    z = x;
+    z ^= z[0];
+    const T first = a[0];
+    expect(z, [first](T v, T, T, T) { return T(v ^ first); });
+  }
+
+  BitsBatch<T, N> copy(x);
+  failures += copy != x;
+  copy[N - 1] ^= 1;
+  failures += copy == x;
+  failures += BitsBatch<T, N>(k) != BitsBatch<T, N>().value(k);
+
+  return failures;
+}
+
+/* every kernel set the cpu has against the scalar one, over a length
+ * with a tail */
+
+template <typename T>
+static void fill(std::vector<T>& v, uint64_t& s, bool shifts, bool nonzero)
+{
+  for(T& x : v)
+    x = shifts ? T(next(s) % (2 * sizeof(T) * 8)) : nonzero ? T(lane<T>(s) | 1) : lane<T>(s);
+}
+
+template <typename T, bittle::detail::BatchUnary Op>
+static int check_unary(const std::vector<T>& a)
+{
+  using namespace bittle;
+  using namespace bittle::detail;
+  const std::size_t n = a.size();
+  std::vector<T> want(n), got(n);
+  batch_unary_scalar<T, Op>(a.data(), want.data(), n);
+  int failures = 0;
+#if defined(BITTLE_X86)
+  const CpuFeatures& f = cpu_features();
+  if(f.sse42 && f.ssse3)
+  {
+    batch_unary_sse<T, Op>(a.data(), got.data(), n);
+    failures += got != want;
+  }
+  if(f.avx2)
+  {
+    batch_unary_avx2<T, Op>(a.data(), got.data(), n);
+    failures += got != want;
+  }
+  if(f.avx512f && f.avx512bw)
+  {
+    batch_unary_avx512<T, Op>(a.data(), got.data(), n);
+    failures += got != want;
+  }
+#endif
+  return failures;
+}
+
+template <typename T, bittle::detail::BatchBinary Op, bool Broadcast>
+static int check_binary(uint64_t& s, std::size_t n)
+{
+  using namespace bittle;
+  using namespace bittle::detail;
+  const bool shifts = Op == BatchBinary::shl_op || Op == BatchBinary::shr_op ||
+                      Op == BatchBinary::rotl_op || Op == BatchBinary::rotr_op;
+  const bool nonzero = Op == BatchBinary::div_op || Op == BatchBinary::mod_op;
+  std::vector<T> a(n), b(Broadcast ? 1 : n), want(n), got(n);
+  fill(a, s, false, false);
+  fill(b, s, shifts, nonzero);
+  batch_binary_scalar<T, Op, Broadcast>(a.data(), b.data(), want.data(), n);
+  int failures = 0;
+#if defined(BITTLE_X86)
+  const CpuFeatures& f = cpu_features();
+  if(f.sse42 && f.ssse3)
+  {
+    batch_binary_sse<T, Op, Broadcast>(a.data(), b.data(), got.data(), n);
+    failures += got != want;
+  }
+  if(f.avx2)
+  {
+    batch_binary_avx2<T, Op, Broadcast>(a.data(), b.data(), got.data(), n);
+    failures += got != want;
+  }
+  if(f.avx512f && f.avx512bw)
+  {
+    batch_binary_avx512<T, Op, Broadcast>(a.data(), b.data(), got.data(), n);
+    failures += got != want;
+  }
+#endif
+  return failures;
+}
+
+template <typename T, std::size_t... U, std::size_t... B>
+static int check_kernels(uint64_t& s, std::size_t n, std::index_sequence<U...>, std::index_sequence<B...>)
+{
+  using namespace bittle::detail;
+  std::vector<T> a(n);
+  fill(a, s, false, false);
+  int failures = 0;
+  const int unused[] = {0,
+    (failures += check_unary<T, static_cast<BatchUnary>(U)>(a), 0)...,
+    (failures += check_binary<T, static_cast<BatchBinary>(B), false>(s, n), 0)...,
+    (failures += check_binary<T, static_cast<BatchBinary>(B), true>(s, n), 0)...};
+  (void)unused;
+  return failures;
+}
+
+template <typename T>
+static int check_kernels(uint64_t& s)
+{
+  int failures = 0;
+  for(std::size_t n : {std::size_t(0), std::size_t(1), std::size_t(67), std::size_t(1000)})
+    failures += check_kernels<T>(s, n, std::make_index_sequence<8>(), std::make_index_sequence<13>());
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int round = 0; round < 20; ++round)
+  {
+    failures += check_methods<uint8_t, 64>(s);
+    failures += check_methods<uint8_t, 5>(s);
+    failures += check_methods<uint16_t, 32>(s);
+    failures += check_methods<uint16_t, 45>(s);
+    failures += check_methods<uint32_t, 16>(s);
+    failures += check_methods<uint32_t, 1>(s);
+    failures += check_methods<uint64_t, 8>(s);
+    failures += check_methods<uint64_t, 19>(s);
+  }
+
+  failures += check_kernels<uint8_t>(s);
+  failures += check_kernels<uint16_t>(s);
+  failures += check_kernels<uint32_t>(s);
+  failures += check_kernels<uint64_t>(s);
+
+  /* transform_batches over a length that is not a multiple of N */
+  {
+    std::vector<uint32_t> in(1003), out(1003);
+    for(uint32_t& v : in)
+      v = lane<uint32_t>(s);
+    transform_batches<64>(in.data(), out.data(), in.size(),
+                          [](BitsBatch32<64>& b) { b.reverseBits().add(1); });
+    for(std::size_t i = 0; i < in.size(); ++i)
+      failures += out[i] != uint32_t(reverse_bits<uint32_t>(in[i]) + 1);
+  }
+
+  std::cout << "kernels: " << BitsBatch64<8>::implementation() << std::endl;
+  std::cout << "bits_batch failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
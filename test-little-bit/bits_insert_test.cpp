@@ -0,0 +1,103 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: bits_insert_test.cpp
+ * purpose: variadic insertRight, insertLeft and assign against a per bit
+ * reference, in constant expressions too
+ */
+
+
+#include "bittle.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <iostream>
+
+
+/* the setters are usable as constants */
+static_assert(bittle::Bits64U(0).assign(1, 0, 1, 1).value() == 11, "assign");
+static_assert(bittle::Bits64U(0xFF).assign(true, 0).value() == 2, "assign overwrites");
+static_assert(bittle::Bits8U(0x81).insertRight(1, 1).value() == 0x07, "insertRight");
+static_assert(bittle::Bits8U(0x0F).insertLeft(1, 0, true).value() == 0xAF, "insertLeft");
+static_assert(bittle::Bits16U(0).insertLeft(1).value() == 0x8000, "insertLeft one bit");
+static_assert(bittle::Bits32U(7).insertRight(1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
+                                             1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0).value() == 0xAAAAAAAAu,
+              "insertRight full width");
+
+/* one bit at a time, first argument first */
+template <typename T, typename... Fs>
+static bool check(T start, Fs... bits)
+{
+  using namespace bittle;
+  constexpr int tsize = int(sizeof(T)) * 8;
+  const bool in[] = {(bits != 0)...};
+  const int n = int(sizeof...(Fs));
+
+  uint64_t right = start, left = start, assigned = 0;
+  for(int i = 0; i < n; ++i)
+  {
+    right = (right << 1) | uint64_t(in[i]);
+    const uint64_t bit = uint64_t(1) << (tsize - 1 - i);
+    left = in[i] ? left | bit : left & ~bit;
+    assigned = (assigned << 1) | uint64_t(in[i]);
+  }
+
+  return Bits<T>(start).insertRight(bits...).value() == T(right) &&
+         Bits<T>(start).insertLeft(bits...).value() == T(left) &&
+         Bits<T>(start).assign(bits...).value() == T(assigned);
+}
+
+template <typename T>
+static int check_all(uint64_t& s)
+{
+  int failures = 0;
+  for(int r = 0; r < 200; ++r)
+  {
+    const T v = T(next(s));
+    const uint64_t b = next(s);
+    auto bit = [&](int i) { return int((b >> i) & 1); };
+    failures += !check<T>(v, bit(0));
+    failures += !check<T>(v, bit(0), bit(1), bit(2));
+    failures += !check<T>(v, bit(0) != 0, bit(1), 2u * bit(2), bit(3), bit(4), bit(5), bit(6), bit(7));
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  failures += check_all<uint8_t>(s);
+  failures += check_all<uint16_t>(s);
+  failures += check_all<uint32_t>(s);
+  failures += check_all<uint64_t>(s);
+
+  /* full 64 bit argument lists, insertRight drops the old value */
+  for(int r = 0; r < 100; ++r)
+  {
+    const uint64_t v = next(s), b = next(s);
+    auto bit = [&](int i) { return int((b >> i) & 1); };
+    failures += !check<uint64_t>(v,
+      bit(63), bit(62), bit(61), bit(60), bit(59), bit(58), bit(57), bit(56),
+      bit(55), bit(54), bit(53), bit(52), bit(51), bit(50), bit(49), bit(48),
+      bit(47), bit(46), bit(45), bit(44), bit(43), bit(42), bit(41), bit(40),
+      bit(39), bit(38), bit(37), bit(36), bit(35), bit(34), bit(33), bit(32),
+      bit(31), bit(30), bit(29), bit(28), bit(27), bit(26), bit(25), bit(24),
+      bit(23), bit(22), bit(21), bit(20), bit(19), bit(18), bit(17), bit(16),
+      bit(15), bit(14), bit(13), bit(12), bit(11), bit(10), bit(9), bit(8),
+      bit(7), bit(6), bit(5), bit(4), bit(3), bit(2), bit(1), bit(0));
+    failures += Bits64U(v).assign(
+      bit(63), bit(62), bit(61), bit(60), bit(59), bit(58), bit(57), bit(56),
+      bit(55), bit(54), bit(53), bit(52), bit(51), bit(50), bit(49), bit(48),
+      bit(47), bit(46), bit(45), bit(44), bit(43), bit(42), bit(41), bit(40),
+      bit(39), bit(38), bit(37), bit(36), bit(35), bit(34), bit(33), bit(32),
+      bit(31), bit(30), bit(29), bit(28), bit(27), bit(26), bit(25), bit(24),
+      bit(23), bit(22), bit(21), bit(20), bit(19), bit(18), bit(17), bit(16),
+      bit(15), bit(14), bit(13), bit(12), bit(11), bit(10), bit(9), bit(8),
+      bit(7), bit(6), bit(5), bit(4), bit(3), bit(2), bit(1), bit(0)).value() != b;
+  }
+
+  std::cout << "bits_insert failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -27,6 +27,12 @@ int main(int argc, char** argv)
   std::cout << static_cast<uint64_t>(d) << std::endl;
   std::cout << Bits32(c).value() << std::endl;
 
+  /* Bits is laid out exactly like its integral type */
+  uint64_t raw[3] = {1, 2, 3};
+  Bits64U* view = as_bits(raw);
+  view[1].setBit(3);
+  std::cout << raw[1] << " " << sizeof(Bits8U) << std::endl;
+
 
 
 
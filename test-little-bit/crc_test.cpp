@@ -0,0 +1,70 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: crc_test.cpp
+ * purpose: Crc check values, path agreement and combine
+ */
+
+
+#include "crc.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template <typename C>
+static int check(const char* name, typename C::value_type expect)
+{
+  using namespace bittle;
+  int failures = 0;
+  if(C::compute("123456789", 9) != expect)
+  {
+    std::cout << name << " check value mismatch" << std::endl;
+    ++failures;
+  }
+
+  std::vector<uint8_t> buf(10000);
+  uint32_t s = 12345;
+  for(auto& b : buf)
+    b = static_cast<uint8_t>((s = s * 1103515245 + 12345) >> 16);
+
+  const auto ref = C::compute(buf.data(), buf.size(), CrcPath::bytewise);
+  const CrcPath paths[] = {CrcPath::slice8, CrcPath::slice16, CrcPath::clmul, CrcPath::crc32c, CrcPath::best};
+  for(const CrcPath p : paths)
+    for(std::size_t len : {std::size_t(0), std::size_t(17), std::size_t(64), std::size_t(1000), buf.size()})
+      if(C::compute(buf.data(), len, p) != C::compute(buf.data(), len, CrcPath::bytewise) ||
+         (len == buf.size() && C::compute(buf.data(), len, p) != ref))
+      {
+        std::cout << name << " path " << static_cast<int>(p) << " len " << len << " mismatch" << std::endl;
+        ++failures;
+      }
+
+  const auto a = C::compute(buf.data(), 3333);
+  const auto b = C::compute(buf.data() + 3333, buf.size() - 3333);
+  if(C::combine(a, b, buf.size() - 3333) != ref)
+  {
+    std::cout << name << " combine mismatch" << std::endl;
+    ++failures;
+  }
+
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  failures += check<Crc32>("crc32", 0xCBF43926);
+  failures += check<Crc32C>("crc32c", 0xE3069283);
+  failures += check<Crc32Bzip2>("crc32/bzip2", 0xFC891918);
+  failures += check<Crc16CcittFalse>("crc16/ccitt-false", 0x29B1);
+  failures += check<Crc16Arc>("crc16/arc", 0xBB3D);
+  failures += check<Crc64Xz>("crc64/xz", 0x995DC9BBDF1939FAULL);
+  failures += check<Crc64Ecma>("crc64/ecma", 0x6C40DF5F0B497347ULL);
+  failures += check<Crc<5, 0x05, 0x1F, true, true, 0x1F>>("crc5/usb", 0x19);
+  failures += check<Crc<7, 0x09, 0x00, false, false, 0x00>>("crc7/mmc", 0x75);
+
+  std::cout << "crc failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: dispatch_test.cpp
+ * purpose: every implementation the cpu can run against the scalar one
+ */
+
+
+#include "dispatch.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  /* override parsing */
+  CpuFeatures all;
+  all.popcnt = all.ssse3 = all.sse42 = all.avx2 = all.bmi2 = all.fast_pext = all.avx512f = true;
+  const CpuFeatures off = detail::mask_cpu(all, "-avx512f,-bmi2,-bogus");
+  if(off.avx512f || off.bmi2 || off.fast_pext || !off.avx2 || !off.popcnt)
+    ++failures;
+  if(detail::mask_cpu(all, "scalar").avx2 || !detail::mask_cpu(all, nullptr).avx512f)
+    ++failures;
+
+  /* features built on a masked one go with it */
+  all.sse42 = all.avx512bw = all.avx512vpopcntdq = true;
+  const CpuFeatures no_avx2 = detail::mask_cpu(all, "-avx2");
+  if(no_avx2.avx2 || no_avx2.avx512f || no_avx2.avx512bw || no_avx2.avx512vpopcntdq || !no_avx2.sse42 || !no_avx2.ssse3)
+    ++failures;
+  const CpuFeatures no_ssse3 = detail::mask_cpu(all, "-ssse3");
+  if(no_ssse3.sse42 || no_ssse3.avx2 || no_ssse3.avx512bw || !no_ssse3.popcnt || !no_ssse3.bmi2)
+    ++failures;
+  const CpuFeatures no_f = detail::mask_cpu(all, "-avx512f");
+  if(no_f.avx512bw || no_f.avx512vpopcntdq || !no_f.avx2)
+    ++failures;
+
+  /* only '-feature' tokens, anything else rejects the whole spec */
+  for(const char* bad : {"avx2", "-bmi2,avx2", "-bmi2,,-avx2", "scalar,-bmi2"})
+  {
+    bool valid = true;
+    const CpuFeatures kept = detail::mask_cpu(all, bad, &valid);
+    if(valid || !kept.avx2 || !kept.bmi2 || !kept.avx512f)
+      ++failures;
+  }
+  bool valid = false;
+  detail::mask_cpu(all, "-avx2,-gfni,", &valid);
+  if(!valid)
+    ++failures;
+  detail::mask_cpu(all, std::getenv("BITTLE_CPU"), &valid);
+  if(cpu_override_ok() != valid)
+    ++failures;
+
+  const char* specs[] = {
+    "scalar", "-avx512f,-avx512bw,-avx512vpopcntdq,-avx2,-ssse3", "-avx512f,-avx512bw,-avx512vpopcntdq",
+    "-avx512vpopcntdq", ""};
+
+  const detail::DispatchTable ref = detail::make_table(CpuFeatures());
+  uint64_t s = 88172645463325252ULL;
+  std::vector<uint64_t> a(300), b(300), want(300), got(300);
+
+  for(const char* spec : specs)
+  {
+    const detail::DispatchTable t = detail::make_table(detail::mask_cpu(detected_cpu(), spec));
+    for(int round = 0; round < 50; ++round)
+    {
+      for(std::size_t i = 0; i < a.size(); ++i)
+      {
+        a[i] = next(s);
+        b[i] = next(s);
+      }
+      /* odd lengths and offsets reach every tail */
+      const std::size_t off = next(s) % 5;
+      const std::size_t n = next(s) % (a.size() - off);
+
+      if(t.popcount(a.data() + off, n) != ref.popcount(a.data() + off, n))
+        ++failures;
+
+      const uint64_t m = next(s) & next(s);
+      if(t.pext(a[0], m) != ref.pext(a[0], m) || t.pdep(a[0], m) != ref.pdep(a[0], m) ||
+         ref.pdep(ref.pext(a[0], m), m) != (a[0] & m))
+        ++failures;
+      t.pext_bulk(a.data() + off, m, got.data(), n);
+      ref.pext_bulk(a.data() + off, m, want.data(), n);
+      if(!std::equal(got.begin(), got.begin() + n, want.begin()))
+        ++failures;
+      t.pdep_bulk(a.data() + off, m, got.data(), n);
+      ref.pdep_bulk(a.data() + off, m, want.data(), n);
+      if(!std::equal(got.begin(), got.begin() + n, want.begin()))
+        ++failures;
+
+      for(int size : {2, 4, 8})
+      {
+        const std::size_t count = n * 8 / size;
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(a.data() + off) + 1;
+        t.byteswap(in, reinterpret_cast<uint8_t*>(got.data()), count - (count ? 1 : 0), size);
+        ref.byteswap(in, reinterpret_cast<uint8_t*>(want.data()), count - (count ? 1 : 0), size);
+        if(!std::equal(got.begin(), got.begin() + n, want.begin()))
+          ++failures;
+      }
+
+      for(int op = 0; op < 4; ++op)
+      {
+        t.logic[op](a.data() + off, b.data(), got.data(), n);
+        ref.logic[op](a.data() + off, b.data(), want.data(), n);
+        if(!std::equal(got.begin(), got.begin() + n, want.begin()))
+          ++failures;
+      }
+    }
+    if(failures)
+    {
+      std::cout << "BITTLE_CPU=" << spec << " popcount " << t.names[0] << " pext " << t.names[1] << " byteswap "
+                << t.names[2] << " logic " << t.names[3] << std::endl;
+      break;
+    }
+  }
+
+  /* public entry points */
+  uint16_t h[3] = {0x0102, 0x0304, 0x0506};
+  byteswap_array(h, h, 3);
+  if(h[0] != 0x0201 || h[2] != 0x0605)
+    ++failures;
+  uint64_t x[2] = {~uint64_t(0), 1};
+  if(popcount_words(x, 2) != 65 || pext(0xF0, 0xF0) != 0xF || pdep(0xF, 0xF0) != 0xF0)
+    ++failures;
+  logic_words(LogicOp::andnot_op, x, x + 1, x, 1);
+  if(x[0] != ~uint64_t(1))
+    ++failures;
+
+  for(int k = 0; k < static_cast<int>(Kernel::count); ++k)
+    std::cout << kernel_name(static_cast<Kernel>(k)) << ": " << implementation(static_cast<Kernel>(k)) << std::endl;
+
+  std::cout << "dispatch failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
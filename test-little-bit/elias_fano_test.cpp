@@ -0,0 +1,119 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: elias_fano_test.cpp
+ * purpose: EliasFano access, search, iteration and intersection against the raw values
+ */
+
+
+#include "elias_fano.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/* n sorted values with gaps below 'gap', duplicates included */
+static std::vector<uint64_t> sequence(uint64_t& s, std::size_t n, uint64_t gap, uint64_t start)
+{
+  std::vector<uint64_t> v;
+  uint64_t x = start;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    x += gap ? next(s) % gap : 0;
+    v.push_back(x);
+  }
+  return v;
+}
+
+static int check(uint64_t& s, const std::vector<uint64_t>& v)
+{
+  using namespace bittle;
+  int failures = 0;
+  const EliasFano ef(v);
+  failures += !ef.valid();
+  failures += ef.size() != v.size();
+
+  for(std::size_t i = 0; i < v.size(); ++i)
+    failures += ef.at(i) != v[i];
+
+  std::size_t i = 0;
+  for(uint64_t x : ef)
+    failures += i >= v.size() || x != v[i++];
+  failures += i != v.size();
+
+  std::vector<uint64_t> out(v.size() + 1, 0);
+  failures += ef.decode(out.data()) != v.size();
+  failures += !std::equal(v.begin(), v.end(), out.begin());
+  if(!v.empty())
+  {
+    const std::size_t start = next(s) % v.size();
+    const std::size_t count = next(s) % (v.size() + 5);
+    const std::size_t got = ef.decode(out.data(), start, count);
+    failures += got != std::min(count, v.size() - start);
+    failures += !std::equal(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(got), v.begin() + static_cast<std::ptrdiff_t>(start));
+  }
+
+  /* nextGeq and a cursor skipping forward through the same targets */
+  const uint64_t top = v.empty() ? 100 : v.back() + 10;
+  std::vector<uint64_t> targets;
+  for(int k = 0; k < 300; ++k)
+    targets.push_back(next(s) % (top + 1));
+  if(!v.empty())
+    targets.push_back(v.back());
+  std::sort(targets.begin(), targets.end());
+  EliasFano::Cursor c = ef.cursor();
+  for(uint64_t x : targets)
+  {
+    const std::size_t expect = static_cast<std::size_t>(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+    failures += ef.nextGeq(x) != expect;
+    const bool found = c.skipTo(x);
+    failures += found != (expect < v.size());
+    failures += found && c.index() != expect;
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  failures += check(s, {});
+  failures += check(s, {0});
+  failures += check(s, {~uint64_t(0)});
+  failures += check(s, {5, 5, 5, 5});
+  failures += check(s, {0, 1, 2, ~uint64_t(0) - 1, ~uint64_t(0)});
+  const uint64_t gaps[] = {0, 1, 2, 3, 17, 1000, 1ULL << 20, 1ULL << 40};
+  for(uint64_t gap : gaps)
+  {
+    failures += check(s, sequence(s, 1, gap, 3));
+    failures += check(s, sequence(s, 257, gap, 0));
+    failures += check(s, sequence(s, 5000, gap, next(s) % 1000));
+  }
+  /* dense run then a long jump */
+  std::vector<uint64_t> jump = sequence(s, 3000, 2, 0);
+  const std::vector<uint64_t> tail = sequence(s, 3000, 3, 1ULL << 30);
+  jump.insert(jump.end(), tail.begin(), tail.end());
+  failures += check(s, jump);
+
+  const uint64_t bad[] = {3, 2};
+  failures += EliasFano(bad, 2).valid();
+
+  /* intersections against std::set_intersection */
+  for(int r = 0; r < 30; ++r)
+  {
+    const std::vector<uint64_t> a = sequence(s, 1 + next(s) % 20000, 1 + next(s) % 8, 0);
+    const std::vector<uint64_t> b = sequence(s, 1 + next(s) % 2000, 1 + next(s) % 200, 0);
+    std::vector<uint64_t> expect, got(std::min(a.size(), b.size()));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    const std::size_t k = intersect(EliasFano(a), EliasFano(b), got.data());
+    got.resize(k);
+    failures += got != expect;
+  }
+
+  std::cout << "elias_fano failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: galois_test.cpp
+ * purpose: clmul against a bit loop, field arithmetic against shift and
+ * add, every mulXor path against the scalar one
+ */
+
+
+#include "galois.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+static_assert(bittle::clmul_soft(bittle::Bits<uint64_t>(3), bittle::Bits<uint64_t>(3)).lo == 5, "constexpr clmul");
+static_assert(bittle::detail::clmul_soft(~0ULL, 2).hi == 1, "constexpr clmul high half");
+static_assert(bittle::GF256Aes::mulSlow(0x53, 0xCA) == 0x01, "AES inverse pair");
+static_assert(bittle::GF256::mulSlow(0x80, 2) == 0x1D, "x^8 reduces by 0x11D");
+
+static bittle::Clmul128 clmul_bits(uint64_t a, uint64_t b)
+{
+  bittle::Clmul128 r{0, 0};
+  for(int i = 0; i < 64; ++i)
+    if((b >> i) & 1)
+    {
+      r.lo ^= a << i;
+      r.hi ^= i ? a >> (64 - i) : 0;
+    }
+  return r;
+}
+
+static int check_clmul(uint64_t& s)
+{
+  using namespace bittle;
+  int failures = 0;
+  for(int r = 0; r < 20000; ++r)
+  {
+    const uint64_t a = next(s) >> (r % 64), b = r % 3 ? next(s) : ~0ULL;
+    const Clmul128 want = clmul_bits(a, b);
+    const Clmul128 got = clmul(Bits<uint64_t>(a), Bits<uint64_t>(b));
+    const Clmul128 soft = detail::clmul_soft(a, b);
+    if(got.lo != want.lo || got.hi != want.hi || soft.lo != want.lo || soft.hi != want.hi)
+    {
+      std::cout << "clmul " << a << " " << b << " mismatch" << std::endl;
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+/* mul against mulSlow, every pair for small fields, samples for GF(2^16) */
+template <typename F>
+static int check_field(const char* name, uint64_t& s)
+{
+  using V = typename F::value_type;
+  int failures = 0;
+  const uint32_t size = F::ORDER + 1;
+  const uint64_t pairs = size <= 256 ? uint64_t(size) * size : 200000;
+  for(uint64_t k = 0; k < pairs; ++k)
+  {
+    const V a = size <= 256 ? V(k / size) : V(next(s) % size);
+    const V b = size <= 256 ? V(k % size) : V(next(s) % size);
+    const V p = F::mul(a, b);
+    bool ok = p == F::mulSlow(a, b) && F::add(a, b) == V(a ^ b);
+    if(b)
+      ok = ok && F::mul(F::div(a, b), b) == a && F::mul(b, F::inv(b)) == 1;
+    if(a)
+      ok = ok && F::exp(F::log(a)) == a;
+    if(!ok)
+    {
+      std::cout << name << " " << a << " * " << b << " mismatch" << std::endl;
+      ++failures;
+    }
+  }
+
+  for(int r = 0; r < 2000; ++r)
+  {
+    const V a = V(next(s) % size);
+    const unsigned e = unsigned(next(s) % 40);
+    V want = 1;
+    for(unsigned i = 0; i < e; ++i)
+      want = F::mul(want, a);
+    if(F::pow(a, e) != want || F::pow(a, e + uint64_t(F::ORDER) * 5) != (a ? want : V(0)))
+    {
+      std::cout << name << " pow mismatch" << std::endl;
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+/* every path and tail length against dst[i] ^= mul(c, src[i]) */
+template <typename F>
+static int check_mul_xor(const char* name, uint64_t& s)
+{
+  using namespace bittle;
+  using V = typename F::value_type;
+  int failures = 0;
+  const GfPath paths[] = {GfPath::best, GfPath::scalar, GfPath::ssse3, GfPath::avx2, GfPath::avx512bw, GfPath::gfni};
+  const std::size_t lens[] = {0, 1, 15, 16, 31, 33, 63, 64, 65, 127, 128, 200, 1000, 4099};
+
+  std::vector<V> src(4200), dst(4200), want(4200);
+  for(const GfPath p : paths)
+    for(const std::size_t len : lens)
+      for(const std::size_t off : {std::size_t(0), std::size_t(3)})
+      {
+        const V c = V(next(s) % (F::ORDER + 1));
+        for(std::size_t i = 0; i < src.size(); ++i)
+        {
+          src[i] = V(next(s) % (F::ORDER + 1));
+          dst[i] = want[i] = V(next(s));
+        }
+        for(std::size_t i = 0; i < len; ++i)
+          want[off + i] ^= F::mul(c, src[off + i]);
+
+        F::mulXor(src.data() + off, c, dst.data() + off, len, p);
+        if(dst != want)
+        {
+          std::cout << name << " " << F::implementation(p) << " len " << len << " mismatch" << std::endl;
+          ++failures;
+        }
+      }
+
+  /* in place is dst = (c + 1) * dst */
+  const V c = V(F::ORDER / 3);
+  std::vector<V> buf(src.begin(), src.end());
+  F::mulXor(buf.data(), c, buf.data(), buf.size());
+  for(std::size_t i = 0; i < buf.size(); ++i)
+    if(buf[i] != F::mul(V(c ^ 1), src[i]))
+    {
+      std::cout << name << " in place mismatch" << std::endl;
+      ++failures;
+      break;
+    }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  failures += check_clmul(s);
+  failures += check_field<GF16>("gf16", s);
+  failures += check_field<GF256>("gf256", s);
+  failures += check_field<GF256Aes>("gf256/aes", s);
+  failures += check_field<GaloisField<7, 0x83>>("gf128", s);
+  failures += check_field<GF65536>("gf65536", s);
+  failures += check_mul_xor<GF16>("gf16", s);
+  failures += check_mul_xor<GF256>("gf256", s);
+  failures += check_mul_xor<GF256Aes>("gf256/aes", s);
+  failures += check_mul_xor<GF65536>("gf65536", s);
+
+  std::cout << "galois failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
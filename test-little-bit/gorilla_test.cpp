@@ -0,0 +1,134 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: gorilla_test.cpp
+ * purpose: Gorilla round trips over regular, jittered and hostile series
+ */
+
+
+#include "gorilla.hpp"
+#include "xorshift.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+
+template <typename T>
+static bool same(const T& a, const T& b)
+{
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+static int round_trip(const std::vector<int64_t>& ts, const std::vector<T>& vs)
+{
+  using namespace bittle;
+  int failures = 0;
+  GorillaEncoder<T> enc;
+  for(std::size_t i = 0; i < ts.size(); ++i)
+  {
+    enc.append(ts[i], vs[i]);
+    /* the stream decodes while it is still growing */
+    if(i == ts.size() / 2)
+    {
+      const std::vector<uint8_t> snap = enc.bytes();
+      GorillaDecoder<T> dec(snap, i + 1);
+      int64_t t;
+      T v;
+      for(std::size_t k = 0; k <= i; ++k)
+        failures += !dec.next(t, v) || t != ts[k] || !same(v, vs[k]);
+    }
+  }
+  failures += enc.size() != ts.size();
+
+  const std::vector<uint8_t> stream = enc.finish();
+  GorillaDecoder<T> dec(stream, ts.size());
+  std::vector<int64_t> t(ts.size() + 1);
+  std::vector<T> v(ts.size() + 1);
+  failures += dec.decode(t.data(), v.data(), t.size()) != ts.size();
+  for(std::size_t i = 0; i < ts.size(); ++i)
+    failures += t[i] != ts[i] || !same(v[i], vs[i]);
+  failures += !dec.ok();
+  failures += dec.left() != 0;
+  return failures;
+}
+
+/* random bytes as a float stream, bad value windows must stop the
+ * decoder through ok() rather than shift by a negative amount */
+static int corrupt(uint64_t& s)
+{
+  using namespace bittle;
+  int failures = 0;
+  int rejected = 0;
+  for(int r = 0; r < 200; ++r)
+  {
+    std::vector<uint8_t> junk(4096);
+    for(uint8_t& b : junk)
+      b = static_cast<uint8_t>(next(s));
+    GorillaDecoder<float> dec(junk, 300);
+    std::vector<int64_t> t(300);
+    std::vector<float> v(300);
+    const std::size_t got = dec.decode(t.data(), v.data(), t.size());
+    failures += (got < t.size()) == dec.ok();
+    failures += !dec.ok() && (dec.left() != 0 || dec.decode(t.data(), v.data(), 1) != 0);
+    rejected += !dec.ok();
+  }
+  failures += rejected == 0;
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int shape = 0; shape < 6; ++shape)
+  {
+    std::vector<int64_t> ts;
+    std::vector<double> d;
+    std::vector<float> f;
+    std::vector<int64_t> counter;
+    int64_t t = 1700000000000LL;
+    double x = 20.0;
+    int64_t c = 0;
+    for(int i = 0; i < 5000; ++i)
+    {
+      switch(shape)
+      {
+        case 0: t += 1000; break;                                        /* regular */
+        case 1: t += 1000 + static_cast<int64_t>(next(s) % 21) - 10; break; /* jitter */
+        case 2: t += static_cast<int64_t>(next(s) % 100000); break;      /* bursty */
+        case 3: t = static_cast<int64_t>(next(s)); break;                /* hostile */
+        case 4: t -= 7; break;                                           /* backwards */
+        default: t += (i % 100 == 0) ? 1 << 20 : 60; break;
+      }
+      ts.push_back(t);
+      x += (static_cast<double>(next(s) % 1000) - 500.0) / 1000.0;
+      double v = shape == 3 ? static_cast<double>(next(s)) / 3.0 : std::round(x * 100.0) / 100.0;
+      if(i % 97 == 5) v = std::numeric_limits<double>::quiet_NaN();
+      if(i % 89 == 7) v = -std::numeric_limits<double>::infinity();
+      if(shape == 4) v = 42.0;
+      d.push_back(v);
+      f.push_back(static_cast<float>(v));
+      c += static_cast<int64_t>(next(s) % 5);
+      counter.push_back(shape == 3 ? static_cast<int64_t>(next(s)) : c);
+    }
+    failures += round_trip(ts, d);
+    failures += round_trip(ts, f);
+    failures += round_trip(ts, counter);
+  }
+
+  /* extreme deltas */
+  const std::vector<int64_t> edge = {0, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0, -1, 1};
+  const std::vector<double> ev = {0.0, -0.0, 1e308, 5e-324, 0.0, 0.0};
+  failures += round_trip(edge, ev);
+  failures += round_trip(std::vector<int64_t>{5}, std::vector<double>{1.5});
+  failures += round_trip(std::vector<int64_t>{}, std::vector<double>{});
+  failures += corrupt(s);
+
+  std::cout << "gorilla failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hamming_search_test.cpp
+ * purpose: Hamming scan kernels, top-k and radius search against brute force
+ */
+
+
+#include "hamming_search.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+static bool same(const std::vector<bittle::HammingHit>& a, const bittle::HammingHit* b, std::size_t n)
+{
+  if(a.size() != n)
+    return false;
+  for(std::size_t i = 0; i < n; ++i)
+    if(a[i].index != b[i].index || a[i].distance != b[i].distance)
+      return false;
+  return true;
+}
+
+template <std::size_t WORDS>
+static int check(uint64_t& s, std::size_t n)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  /* codes scattered around a few centres so small distances occur */
+  std::vector<uint64_t> centres(8 * WORDS), codes(n * WORDS), queries(6 * WORDS);
+  for(uint64_t& w : centres)
+    w = next(s);
+  for(std::size_t i = 0; i < n; ++i)
+    for(std::size_t w = 0; w < WORDS; ++w)
+    {
+      const uint64_t noise = next(s) & next(s) & next(s) & (i % 3 ? next(s) : ~uint64_t(0));
+      codes[i * WORDS + w] = centres[(i % 8) * WORDS + w] ^ noise;
+    }
+  for(std::size_t i = 0; i < 6; ++i)
+    for(std::size_t w = 0; w < WORDS; ++w)
+      queries[i * WORDS + w] = centres[i * WORDS + w] ^ (next(s) & next(s) & next(s) & next(s));
+  /* one query equal to a stored code */
+  std::copy(codes.begin() + 5 * WORDS, codes.begin() + 6 * WORDS, queries.begin() + 5 * WORDS);
+
+  HammingIndex<WORDS> index(codes.data(), n);
+  failures += index.size() != n;
+
+  for(std::size_t qi = 0; qi < 6; ++qi)
+  {
+    const uint64_t* q = queries.data() + qi * WORDS;
+    std::vector<HammingHit> all(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      uint32_t d = 0;
+      for(std::size_t w = 0; w < WORDS; ++w)
+        for(int b = 0; b < 64; ++b)
+          d += ((codes[i * WORDS + w] ^ q[w]) >> b) & 1;
+      all[i] = HammingHit{static_cast<uint32_t>(i), d};
+      failures += index.distance(i, q) != d;
+    }
+
+    /* every kernel this cpu runs */
+    std::vector<uint32_t> out(n);
+    std::vector<detail::hamming_scan_fn> kernels = {detail::hamming_scan_scalar<WORDS>};
+#if defined(BITTLE_X86)
+    const CpuFeatures& f = cpu_features();
+    if(f.popcnt)
+      kernels.push_back(detail::hamming_scan_popcnt<WORDS>);
+    if(f.avx2 && f.popcnt && (WORDS <= 2 || WORDS % 4 == 0))
+      kernels.push_back(detail::hamming_scan_avx2<WORDS>);
+    if(f.avx512f && f.avx512vpopcntdq && f.popcnt)
+      kernels.push_back(detail::hamming_scan_avx512<WORDS>);
+#endif
+    for(detail::hamming_scan_fn scan : kernels)
+    {
+      /* odd lengths exercise the tails */
+      for(std::size_t len : {n, n - 1, std::size_t(3)})
+      {
+        std::fill(out.begin(), out.end(), 0xFFFFFFFFu);
+        scan(codes.data(), len, q, out.data());
+        for(std::size_t i = 0; i < len; ++i)
+          failures += out[i] != all[i].distance;
+      }
+    }
+
+    std::stable_sort(all.begin(), all.end(), [](const HammingHit& a, const HammingHit& b) {
+      return a.distance < b.distance;
+    });
+
+    /* top-k on one and several threads */
+    for(std::size_t k : {std::size_t(0), std::size_t(1), std::size_t(10), std::size_t(77), n + 5})
+    {
+      for(unsigned threads : {1u, 3u})
+      {
+        std::vector<HammingHit> hits(k + 1);
+        const std::size_t got = index.search(q, k, hits.data(), threads);
+        failures += got != std::min(k, n);
+        failures += !same(std::vector<HammingHit>(all.begin(), all.begin() + got), hits.data(), got);
+      }
+    }
+
+    /* radius, by scan and by multi-index hashing */
+    HammingMultiIndex<WORDS> mih(index), narrow(index, static_cast<int>(WORDS * 64 / 20));
+    for(uint32_t r : {0u, 1u, 7u, 20u, static_cast<uint32_t>(WORDS * 10)})
+    {
+      std::vector<HammingHit> want;
+      for(const HammingHit& h : all)
+        if(h.distance <= r)
+          want.push_back(h);
+      std::vector<HammingHit> got;
+      index.radius(q, r, got);
+      failures += !same(want, got.data(), got.size());
+      if(r <= WORDS * 10 && mih.substrings() * 3 > static_cast<int>(r))
+      {
+        mih.radius(q, r, got);
+        failures += !same(want, got.data(), got.size());
+      }
+      if(r <= 20)
+      {
+        narrow.radius(q, r, got);
+        failures += !same(want, got.data(), got.size());
+      }
+    }
+  }
+
+  /* batches equal one query at a time */
+  for(unsigned threads : {1u, 4u})
+  {
+    const std::size_t k = 9;
+    std::vector<HammingHit> batch(6 * k), one(k);
+    failures += index.searchBatch(queries.data(), 6, k, batch.data(), threads) != std::min(k, n);
+    for(std::size_t qi = 0; qi < 6; ++qi)
+    {
+      index.search(queries.data() + qi * WORDS, k, one.data());
+      failures += !same(std::vector<HammingHit>(one.begin(), one.end()), batch.data() + qi * k, k);
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  failures += check<1>(s, 5003);
+  failures += check<2>(s, 2100);
+  failures += check<3>(s, 1501);
+  failures += check<4>(s, 1200);
+  failures += check<5>(s, 1029);
+  failures += check<8>(s, 1111);
+
+  /* an empty index */
+  {
+    HammingIndex256 empty;
+    uint64_t q[4] = {1, 2, 3, 4};
+    HammingHit hit;
+    failures += empty.search(q, 5, &hit, 2) != 0;
+    std::vector<HammingHit> got;
+    failures += empty.radius(q, 100, got) != 0;
+    HammingMultiIndex<4> mih(empty);
+    failures += mih.radius(q, 4, got) != 0;
+  }
+
+  /* add keeps codes in order */
+  {
+    HammingIndex64 index;
+    for(uint64_t v : {7ULL, 0ULL, 255ULL, 1ULL})
+      index.add(&v);
+    const uint64_t q = 0;
+    HammingHit hits[4];
+    index.search(&q, 4, hits);
+    failures += hits[0].index != 1 || hits[1].index != 3 || hits[2].index != 0 || hits[3].index != 2;
+    failures += hits[3].distance != 8;
+    index.clear();
+    failures += index.size() != 0;
+  }
+
+  std::cout << "hamming_search failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hash_test.cpp
+ * purpose: rotate edge cases and mixer checks
+ */
+
+
+#include "hash.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/* rotates must handle 0, the full width, negative counts and signed types */
+static_assert(bittle::rotl<uint8_t>(0x81, 1) == 0x03, "rotl 8");
+static_assert(bittle::rotl<uint8_t>(0x81, 8) == 0x81, "rotl full width");
+static_assert(bittle::rotl<uint32_t>(0xDEADBEEF, 0) == 0xDEADBEEF, "rotl zero");
+static_assert(bittle::rotl<int8_t>(int8_t(-128), 1) == 1, "rotl signed");
+static_assert(bittle::rotr<uint64_t>(1, 1) == (uint64_t(1) << 63), "rotr 64");
+static_assert(bittle::rotl<uint16_t>(0x1234, -4) == bittle::rotr<uint16_t>(0x1234, 4), "rotl negative");
+static_assert(bittle::Bits8U(0x81).rotateLeft(1).value() == 0x03, "Bits rotateLeft");
+static_assert(bittle::Bits32(-1).rotateRight(7).value() == -1, "Bits rotateRight");
+
+static_assert(bittle::splitmix64(0) == 0xE220A8397B1DCDAFULL, "splitmix64");
+static_assert(bittle::fmix64(0) == 0, "fmix64");
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  std::vector<uint64_t> keys(1000), out(1000);
+  std::vector<Bits64U> bkeys;
+  for(std::size_t i = 0; i < keys.size(); ++i)
+  {
+    keys[i] = i * 0x9E3779B97F4A7C15ULL;
+    bkeys.push_back(Bits64U(keys[i]));
+  }
+
+  hash_bulk<SplitMix>(keys.data(), out.data(), keys.size());
+  for(std::size_t i = 0; i < keys.size(); ++i)
+    if(out[i] != splitmix64(keys[i]))
+      ++failures;
+
+  hash_bulk<WyMix>(bkeys.data(), out.data(), bkeys.size());
+  for(std::size_t i = 0; i < keys.size(); ++i)
+    if(out[i] != hash_bits<WyMix>(bkeys[i]))
+      ++failures;
+
+  /* every length up to 40 must depend on every byte */
+  uint8_t buf[40] = {};
+  for(std::size_t len = 1; len <= sizeof(buf); ++len)
+    for(std::size_t i = 0; i < len; ++i)
+    {
+      const uint64_t before = hash_bytes(buf, len);
+      buf[i] ^= 1;
+      if(hash_bytes(buf, len) == before)
+        ++failures;
+      buf[i] ^= 1;
+    }
+
+  const uint64_t wide[3] = {1, 2, 3};
+  if(hash_words(wide, 3) == hash_words(wide, 2) || hash_words(wide, 3, 1) == hash_words(wide, 3))
+    ++failures;
+
+  std::cout << "hash failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
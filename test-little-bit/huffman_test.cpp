@@ -0,0 +1,233 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: huffman_test.cpp
+ * purpose: Huffman code lengths, canonical codes and round trips
+ */
+
+
+#include "huffman.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+
+/* cost of an unlimited Huffman code, from a heap */
+static uint64_t optimal_cost(const uint64_t* freq, std::size_t symbols)
+{
+  std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> heap;
+  for(std::size_t s = 0; s < symbols; ++s)
+    if(freq[s])
+      heap.push(freq[s]);
+  if(heap.size() == 1)
+    return heap.top();
+  uint64_t cost = 0;
+  while(heap.size() > 1)
+  {
+    const uint64_t a = heap.top(); heap.pop();
+    const uint64_t b = heap.top(); heap.pop();
+    cost += a + b;
+    heap.push(a + b);
+  }
+  return cost;
+}
+
+static int check_lengths(const uint64_t* freq, std::size_t symbols, int limit, bool exact)
+{
+  int failures = 0;
+  std::vector<uint8_t> len(symbols);
+  failures += !bittle::huffman_lengths(freq, symbols, len.data(), limit);
+  uint64_t kraft = 0, cost = 0;
+  for(std::size_t s = 0; s < symbols; ++s)
+  {
+    failures += (freq[s] == 0) != (len[s] == 0);
+    failures += len[s] > limit;
+    if(len[s])
+      kraft += uint64_t(1) << (15 - len[s]);
+    cost += freq[s] * len[s];
+  }
+  failures += kraft > (uint64_t(1) << 15);
+  if(exact)
+    failures += cost != optimal_cost(freq, symbols);
+  return failures;
+}
+
+template <int ROOT>
+static int round_trip(const std::vector<uint8_t>& data, std::size_t streams, int maxLength)
+{
+  std::vector<uint8_t> packed = bittle::huffman_compress(data, streams, maxLength);
+  std::vector<uint8_t> back;
+  int failures = !bittle::huffman_decompress<ROOT>(packed, back);
+  failures += back != data;
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  /* optimal while the limit does not bind */
+  for(int trial = 0; trial < 200; ++trial)
+  {
+    uint64_t freq[HUFFMAN_SYMBOLS] = {};
+    const std::size_t used = 1 + next(s) % HUFFMAN_SYMBOLS;
+    for(std::size_t k = 0; k < used; ++k)
+      freq[next(s) % HUFFMAN_SYMBOLS] += 1 + next(s) % 1000;
+    failures += check_lengths(freq, HUFFMAN_SYMBOLS, 15, true);
+    failures += check_lengths(freq, HUFFMAN_SYMBOLS, 9, false);
+  }
+
+  /* Fibonacci weights make the deepest possible tree */
+  {
+    uint64_t freq[40];
+    freq[0] = freq[1] = 1;
+    for(int i = 2; i < 40; ++i)
+      freq[i] = freq[i - 1] + freq[i - 2];
+    for(int limit = 6; limit <= 15; ++limit)
+      failures += check_lengths(freq, 40, limit, false);
+    uint8_t len[40];
+    failures += huffman_lengths(freq, 40, len, 5);   /* 40 symbols need 6 bits */
+    failures += huffman_lengths(freq, 40, len, 0);
+  }
+
+  /* canonical codes: prefix free, consecutive within a length */
+  {
+    uint64_t freq[HUFFMAN_SYMBOLS];
+    for(std::size_t k = 0; k < HUFFMAN_SYMBOLS; ++k)
+      freq[k] = 1 + (next(s) % 5000) / (k + 1);
+    const HuffmanCode code = HuffmanCode::fromFrequencies(freq, 12);
+    failures += !code.valid();
+    failures += code.maxLength() > 12;
+    for(std::size_t a = 0; a < HUFFMAN_SYMBOLS; ++a)
+    {
+      for(std::size_t b = 0; b < HUFFMAN_SYMBOLS; ++b)
+      {
+        const int la = code.length(uint8_t(a)), lb = code.length(uint8_t(b));
+        if(a == b || la > lb)
+          continue;
+        failures += (code.code(uint8_t(b)) >> (lb - la)) == code.code(uint8_t(a));
+        if(la == lb && b == a + 1)
+          failures += code.code(uint8_t(b)) != code.code(uint8_t(a)) + 1;
+      }
+    }
+  }
+
+  /* lengths that break Kraft or exceed 15 are refused */
+  {
+    uint8_t len[HUFFMAN_SYMBOLS] = {};
+    len[0] = len[1] = len[2] = 1;
+    failures += HuffmanCode(len).valid();
+    len[1] = len[2] = 0;
+    len[3] = 16;
+    failures += HuffmanCode(len).valid();
+  }
+
+  /* data shapes */
+  std::vector<std::vector<uint8_t>> inputs;
+  {
+    const std::string words[] = {"GET ", "POST ", "/index.html ", "200 ", "404 ", "HTTP/1.1\n", "user=", "ok ", "error "};
+    std::vector<uint8_t> text;
+    while(text.size() < 100000)
+    {
+      const std::string& w = words[next(s) % 9];
+      text.insert(text.end(), w.begin(), w.end());
+      text.push_back(uint8_t('0' + next(s) % 10));
+    }
+    inputs.push_back(text);
+
+    std::vector<uint8_t> noise(65537);
+    for(uint8_t& b : noise)
+      b = uint8_t(next(s));
+    inputs.push_back(noise);
+
+    /* geometric: long codes for the tail */
+    std::vector<uint8_t> skew(50000);
+    for(uint8_t& b : skew)
+    {
+      const uint64_t r = next(s);
+      b = uint8_t(r ? __builtin_ctzll(r) * 7 % 256 : 255);
+    }
+    inputs.push_back(skew);
+
+    inputs.push_back(std::vector<uint8_t>(1000, 'x'));
+    inputs.push_back(std::vector<uint8_t>());
+    inputs.push_back(std::vector<uint8_t>(1, 7));
+    inputs.push_back(std::vector<uint8_t>{1, 2, 3});
+
+    std::vector<uint8_t> all;
+    for(int r = 0; r < 3; ++r)
+      for(int b = 0; b < 256; ++b)
+        all.push_back(uint8_t(b));
+    inputs.push_back(all);
+  }
+
+  for(const std::vector<uint8_t>& data : inputs)
+  {
+    for(std::size_t streams = 1; streams <= HUFFMAN_MAX_STREAMS; ++streams)
+    {
+      failures += round_trip<11>(data, streams, 11);
+      failures += round_trip<8>(data, streams, 15);
+    }
+    for(int maxLength = 8; maxLength <= 15; ++maxLength)
+    {
+      failures += round_trip<11>(data, 4, maxLength);
+      failures += round_trip<12>(data, 3, maxLength);
+    }
+  }
+
+  /* the compressed size matches the code */
+  {
+    const std::vector<uint8_t>& text = inputs[0];
+    const HuffmanCode code = HuffmanCode::fromData(text.data(), text.size());
+    const std::vector<uint8_t> packed = huffman_compress(text, 1);
+    failures += packed.size() != (64 + 8 + 256 * 4 + 64) / 8 + (code.encodedBits(text.data(), text.size()) + 7) / 8;
+    failures += packed.size() > text.size() * 5 / 8;
+  }
+
+  /* one stream straight through BitWriter / BitReader */
+  {
+    const std::vector<uint8_t>& skew = inputs[2];
+    const HuffmanCode code = HuffmanCode::fromData(skew.data(), skew.size(), 15);
+    failures += code.maxLength() <= 11;   /* exercises the second level */
+    BitWriter w;
+    w.write(0x5, 3);
+    code.encode(skew.data(), skew.size(), w);
+    const std::vector<uint8_t> bytes = w.finish();
+    BitReader r(bytes);
+    failures += r.read(3) != 0x5;
+    std::vector<uint8_t> back(skew.size());
+    const HuffmanDecoder<9> dec(code);
+    failures += !dec.decode(r, back.data(), back.size());
+    failures += back != skew;
+    failures += r.position() != 3 + code.encodedBits(skew.data(), skew.size());
+  }
+
+  /* damaged input fails or decodes garbage, but stays in bounds */
+  {
+    const std::vector<uint8_t> packed = huffman_compress(inputs[0], 4);
+    std::vector<uint8_t> back;
+    for(std::size_t cut = 0; cut < packed.size(); cut += 1 + cut / 3)
+      failures += huffman_decompress(packed.data(), cut, back);
+    for(int trial = 0; trial < 200; ++trial)
+    {
+      std::vector<uint8_t> bad = packed;
+      bad[next(s) % bad.size()] ^= uint8_t(1 + next(s) % 255);
+      huffman_decompress(bad, back);
+    }
+
+    /* a lone symbol leaves '1' without a code */
+    const std::vector<uint8_t> one = huffman_compress(inputs[3], 1);
+    std::vector<uint8_t> bad = one;
+    bad.back() |= 0x80;
+    failures += huffman_decompress(bad, back);
+  }
+
+  std::cout << "huffman failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: hyperloglog_test.cpp
+ * purpose: HyperLogLog accuracy, sparse/dense agreement and merging
+ */
+
+
+#include "hyperloglog.hpp"
+#include "xorshift.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+static std::vector<uint8_t> regs(const bittle::HyperLogLog& h)
+{
+  std::vector<uint8_t> r(h.registerCount());
+  h.registers(r.data());
+  return r;
+}
+
+/* reference lane max */
+static uint64_t max_lanes(uint64_t a, uint64_t b)
+{
+  uint64_t r = 0;
+  for(int i = 0; i < 10; ++i)
+    r |= std::max((a >> (6 * i)) & 63, (b >> (6 * i)) & 63) << (6 * i);
+  return r;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  /* SWAR and AVX2 lane max against lane by lane */
+  {
+    std::vector<uint64_t> a(103), b(103), c, d;
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+      a[i] = next(s) & 0x0FFFFFFFFFFFFFFFULL;
+      b[i] = (i % 3 == 0) ? a[i] ^ (uint64_t(1) << (next(s) % 60)) : next(s) & 0x0FFFFFFFFFFFFFFFULL;
+    }
+    c = a;
+    detail::hll_merge_scalar(c.data(), b.data(), c.size());
+    for(std::size_t i = 0; i < a.size(); ++i)
+      failures += c[i] != max_lanes(a[i], b[i]);
+#if defined(BITTLE_X86)
+    if(cpu_features().avx2)
+    {
+      d = a;
+      detail::hll_merge_avx2(d.data(), b.data(), d.size());
+      failures += d != c;
+    }
+#endif
+  }
+
+  /* accuracy from empty to well past the sparse limit */
+  for(int p : {10, 14})
+  {
+    const double err = 1.04 / std::sqrt(double(1 << p));
+    HyperLogLog h(p);
+    failures += h.estimate() != 0.0;
+    uint64_t key = 0;
+    for(uint64_t n : {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL})
+    {
+      for(; key < n; ++key)
+        h.add(Bits<uint64_t>(key));
+      const double e = h.estimate();
+      /* linear counting is all but exact while sparse */
+      const double tol = h.isSparse() ? 0.01 : 4 * err;
+      failures += std::fabs(e - double(n)) > tol * double(n) + 0.5;
+    }
+    failures += h.isSparse();
+  }
+
+  /* duplicates do not count */
+  {
+    HyperLogLog h(12);
+    for(int r = 0; r < 20; ++r)
+      for(uint64_t k = 0; k < 5000; ++k)
+        h.add(Bits<uint64_t>(k));
+    failures += std::fabs(h.estimate() - 5000) > 4 * 1.04 / 64 * 5000;
+  }
+
+  /* sparse and dense agree register for register */
+  for(int p : {4, 9, 14, 18})
+  {
+    for(uint64_t n : {0ULL, 3ULL, 200ULL, 5000ULL, 60000ULL})
+    {
+      HyperLogLog a(p), b(p, false);
+      for(uint64_t k = 0; k < n; ++k)
+      {
+        const uint64_t h = next(s);
+        a.addHash(h);
+        b.addHash(h);
+      }
+      failures += regs(a) != regs(b);
+      failures += b.isSparse();
+      if(a.isSparse())
+        failures += a.sizeInBytes() > b.sizeInBytes() * 2;
+      else
+        failures += std::fabs(a.estimate() - b.estimate()) > 1e-9 * (1 + b.estimate());
+    }
+  }
+
+  /* merging is the sketch of the union, in every form */
+  for(uint64_t na : {50ULL, 40000ULL})
+  {
+    for(uint64_t nb : {70ULL, 30000ULL})
+    {
+      HyperLogLog a(12), b(12), all(12);
+      for(uint64_t k = 0; k < na; ++k)
+      {
+        a.add(Bits<uint64_t>(k));
+        all.add(Bits<uint64_t>(k));
+      }
+      for(uint64_t k = na / 2; k < na / 2 + nb; ++k)
+      {
+        b.add(Bits<uint64_t>(k));
+        all.add(Bits<uint64_t>(k));
+      }
+      HyperLogLog ab = a;
+      failures += !ab.merge(b);
+      failures += regs(ab) != regs(all);
+      HyperLogLog ba = b;
+      failures += !ba.merge(a);
+      failures += regs(ba) != regs(all);
+      if(!all.isSparse())
+        failures += std::fabs(ab.estimate() - all.estimate()) > 1e-9 * all.estimate();
+      failures += !ab.merge(ab) || regs(ab) != regs(all);
+
+      /* adds after a merge keep the estimate that of a sketch built
+       * from scratch */
+      for(uint64_t k = 1000000; k < 1000000 + nb; ++k)
+      {
+        ab.add(Bits<uint64_t>(k));
+        all.add(Bits<uint64_t>(k));
+      }
+      failures += regs(ab) != regs(all);
+      if(!all.isSparse())
+        failures += ab.estimate() != all.estimate();
+    }
+  }
+
+  /* many sketches folded into one */
+  {
+    HyperLogLog total(14, false);
+    std::vector<HyperLogLog> parts(64, HyperLogLog(14, false));
+    for(std::size_t i = 0; i < parts.size(); ++i)
+      for(uint64_t k = 0; k < 2000; ++k)
+        parts[i].add(Bits<uint64_t>(i * 1000 + k));   /* neighbours overlap by half */
+    for(const HyperLogLog& h : parts)
+      failures += !total.merge(h);
+    failures += std::fabs(total.estimate() - 65000) > 4 * 1.04 / 128 * 65000;
+  }
+
+  /* precisions must match; byte keys and bulk adds */
+  {
+    HyperLogLog a(10), b(11);
+    failures += a.merge(b);
+    failures += HyperLogLog(2).precision() != 4 || HyperLogLog(30).precision() != 18;
+
+    HyperLogLog words(14), bulk(14);
+    std::vector<uint64_t> keys(30000);
+    for(uint64_t& k : keys)
+      k = next(s) % 20000;
+    bulk.addBulk(keys.data(), keys.size());
+    for(uint64_t k : keys)
+      words.add(Bits<uint64_t>(k));
+    failures += regs(words) != regs(bulk);
+
+    HyperLogLog str(14);
+    for(int i = 0; i < 50000; ++i)
+    {
+      const std::string k = "user-" + std::to_string(i % 25000);
+      str.add(k.data(), k.size());
+    }
+    failures += std::fabs(str.estimate() - 25000) > 4 * 1.04 / 128 * 25000;
+
+    str.clear();
+    failures += !str.isSparse() || str.estimate() != 0.0;
+    HyperLogLog d(8, false);
+    d.addHash(next(s));
+    d.clear();
+    failures += d.isSparse() || d.estimate() != 0.0;
+  }
+
+  std::cout << "hyperloglog failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: packed_vector_test.cpp
+ * purpose: PackedVector against a plain vector at every width
+ */
+
+
+#include "packed_vector.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+/* every operation mirrored on a std::vector */
+template <int W>
+static int check(int width, uint64_t& s)
+{
+  using namespace bittle;
+  int failures = 0;
+  PackedVector<W> v(0, width);
+  const int w = v.width();
+  const uint64_t mask = w == 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1;
+  failures += v.maxValue() != mask;
+  std::vector<uint64_t> ref;
+
+  for(int i = 0; i < 300; ++i)
+  {
+    const uint64_t x = next(s);
+    v.push_back(x);
+    ref.push_back(x & mask);
+  }
+  for(int i = 0; i < 2000; ++i)
+  {
+    const std::size_t at = next(s) % ref.size();
+    const uint64_t x = next(s);
+    if(i & 1)
+      v.set(at, x);
+    else
+      v[at] = x;
+    ref[at] = x & mask;
+  }
+  failures += v.size() != ref.size();
+  failures += !std::equal(v.begin(), v.end(), ref.begin());
+  for(std::size_t i = 0; i < ref.size(); ++i)
+    failures += v.get(i) != ref[i] || v[i] != ref[i] || v.getAtomic(i) != ref[i];
+
+  /* bulk runs at every starting offset */
+  for(int trial = 0; trial < 40; ++trial)
+  {
+    const std::size_t first = next(s) % ref.size();
+    const std::size_t n = next(s) % (ref.size() - first + 1);
+    std::vector<uint64_t> in(n);
+    for(uint64_t& x : in)
+      x = next(s);
+    v.encode(first, in.begin(), in.end());
+    for(std::size_t k = 0; k < n; ++k)
+      ref[first + k] = in[k] & mask;
+    std::vector<uint64_t> out(n);
+    failures += v.decode(first, n, out.begin()) != out.end();
+    failures += !std::equal(out.begin(), out.end(), ref.begin() + static_cast<std::ptrdiff_t>(first));
+  }
+  failures += !std::equal(v.begin(), v.end(), ref.begin());
+
+  /* shrinking leaves zeros behind for the next growth */
+  v.resize(77);
+  ref.resize(77);
+  v.pop_back();
+  ref.pop_back();
+  v.resize(150);
+  ref.resize(150, 0);
+  v.append(ref.begin() + 10, ref.begin() + 20);
+  ref.insert(ref.end(), ref.begin() + 10, ref.begin() + 20);
+  failures += v.size() != ref.size() || !std::equal(v.begin(), v.end(), ref.begin());
+  failures += v.words()[(v.size() * static_cast<std::size_t>(w) + 63) / 64] != 0;
+
+  v.clear();
+  failures += !v.empty() || v.begin() != v.end();
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int w = 1; w <= 64; ++w)
+    failures += check<DYNAMIC_WIDTH>(w, s);
+  failures += check<1>(0, s) + check<3>(0, s) + check<7>(0, s) + check<8>(0, s) + check<13>(0, s);
+  failures += check<20>(0, s) + check<32>(0, s) + check<33>(0, s) + check<63>(0, s) + check<64>(0, s);
+
+  /* widths outside 1 - 64 are clamped */
+  failures += DynamicPackedVector(4, 0).width() != 1;
+  failures += DynamicPackedVector(4, 99).width() != 64;
+
+  /* fill constructor, memory use */
+  {
+    PackedVector<5> v(1000, 5, 21);
+    failures += std::count(v.begin(), v.end(), 21u) != 1000;
+    failures += v.sizeInBits() != (1000 * 5 + 63) / 64 * 64 + 64;
+    failures += std::accumulate(v.begin(), v.end(), uint64_t(0)) != 21000;
+  }
+
+  /* iterator arithmetic */
+  {
+    PackedVector<11> v;
+    for(uint64_t i = 0; i < 100; ++i)
+      v.push_back(i * 7);
+    auto it = v.begin() + 10;
+    failures += *it != 70 || it[5] != 105 || *(it - 3) != 49;
+    failures += v.end() - v.begin() != 100 || !(it < v.end()) || it >= v.end();
+    failures += *std::lower_bound(v.begin(), v.end(), 350u) != 350;
+  }
+
+  /* threads setting interleaved slots of shared words */
+  {
+    const std::size_t n = 1 << 16;
+    PackedVector<13> v(n);
+    std::vector<std::thread> pool;
+    for(unsigned t = 0; t < 4; ++t)
+      pool.emplace_back([&v, t, n]() {
+        for(int round = 0; round < 3; ++round)
+          for(std::size_t i = t; i < n; i += 4)
+            v.setAtomic(i, (i * 2654435761u + static_cast<std::size_t>(round)) & 0x1FFF);
+      });
+    for(std::thread& th : pool)
+      th.join();
+    for(std::size_t i = 0; i < n; ++i)
+      failures += v.getAtomic(i) != ((i * 2654435761u + 2) & 0x1FFF);
+  }
+
+  std::cout << "packed_vector failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,47 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: parallel_test.cpp
+ * purpose: run_threads runs every part once, thread_count clamps
+ */
+
+
+#include "parallel.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  for(unsigned count : {0u, 1u, 2u, 7u, 64u})
+  {
+    std::vector<std::atomic<int>> runs(count);
+    for(std::atomic<int>& r : runs)
+      r = 0;
+    const std::thread::id caller = std::this_thread::get_id();
+    bool first_on_caller = count == 0;
+    detail::run_threads(count, [&](unsigned t) {
+      ++runs[t];
+      if(t == 0)
+        first_on_caller = std::this_thread::get_id() == caller;
+    });
+    for(std::atomic<int>& r : runs)
+      failures += r != 1;
+    failures += !first_on_caller;
+  }
+
+  failures += detail::thread_count(5, 3) != 3;
+  failures += detail::thread_count(2, 0) != 1;
+  failures += detail::thread_count(0, 1) != 1;
+  failures += detail::thread_count(0, 1000) < 1;
+  failures += detail::thread_count(4, 1000) != 4;
+
+  std::cout << "parallel failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: profile_test.cpp
+ * purpose: counters, thread merge and dumps under BITTLE_PROFILE
+ */
+
+
+#define BITTLE_PROFILE
+#define BITTLE_STANDARD
+
+#include "bit_parse.hpp"
+#include "hash.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/* counting must not break constant evaluation */
+static_assert(bittle::Bits8U(0x81).rotateLeft(1).value() == 0x03, "constexpr under profile");
+static_assert(bittle::Bits64U(0xF0).ones() == 4, "constexpr under profile");
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+
+  profile::reset();
+  profile::set_sample_period(1);
+
+  Bits64U b(0xF0F0);
+  for(int i = 0; i < 100; ++i)
+    b.ones();
+  b.setBit(3).clearBit(3);
+
+  /* other threads count too, including ones that already exited */
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 4; ++t)
+    threads.emplace_back([]() {
+      Bits32U x(7);
+      for(int i = 0; i < 1000; ++i)
+        x.ones();
+    });
+  for(auto& t : threads)
+    t.join();
+
+  std::vector<uint64_t> in(64, 1), out(64);
+  hash_bulk(in.data(), out.data(), in.size());
+  hash_bulk(in.data(), out.data(), in.size());
+
+  profile::Snapshot s = profile::snapshot();
+  if(s.callsTo(profile::Site::ones) != 4100 || s.callsTo(profile::Site::setBit) != 1 ||
+     s.callsTo(profile::Site::clearBit) != 1 || s.callsTo(profile::Site::hash_bulk) != 2)
+  {
+    std::cout << s.text();
+    ++failures;
+  }
+
+  /* kernels sampled every call, plain methods never */
+  if(s.samples[static_cast<int>(profile::Site::hash_bulk)] != 2 || s.samples[static_cast<int>(profile::Site::ones)] != 0)
+    ++failures;
+
+  /* most called first */
+  const std::string text = s.text();
+  if(text.find("Bits::ones") != 0 || text.find("hash_bulk") == std::string::npos || text.find("Bits::toString") != std::string::npos)
+    ++failures;
+
+  const std::string json = s.json();
+  if(json.find("{\"sample_period\":1,\"sites\":[{\"name\":\"Bits::ones\",\"calls\":4100,") != 0 || json.back() != '}')
+    ++failures;
+
+  /* truncated dumps keep snprintf rules */
+  char small[16];
+  if(s.json(small, sizeof(small)) != json.size() || std::string(small) != json.substr(0, 15))
+    ++failures;
+
+  profile::reset();
+  if(profile::snapshot().callsTo(profile::Site::ones) != 0 || !profile::snapshot().text().empty())
+    ++failures;
+
+  std::cout << "profile failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
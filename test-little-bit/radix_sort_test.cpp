@@ -0,0 +1,160 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: radix_sort_test.cpp
+ * purpose: radix sorts against std::stable_sort
+ */
+
+
+#include "radix_sort.hpp"
+#include "xorshift.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/* uniform, a narrow range, one value, or a shared high byte */
+template <typename T>
+static T key(uint64_t& s, int shape)
+{
+  const uint64_t r = next(s);
+  switch(shape)
+  {
+    case 0: return static_cast<T>(r);
+    case 1: return static_cast<T>(r % 100) - static_cast<T>(r % 2 ? 50 : 0);
+    case 2: return static_cast<T>(7);
+    default: return static_cast<T>(r & 0xFFFF);
+  }
+}
+
+template <typename T>
+static T raw(const T& k) { return k; }
+
+template <typename T>
+static T raw(const bittle::Bits<T>& k) { return k.value(); }
+
+template <typename K>
+static int check(uint64_t& s, std::size_t n, int shape, bool parallel)
+{
+  using namespace bittle;
+  using T = decltype(raw(std::declval<K>()));
+  std::vector<K> keys, kscratch;
+  std::vector<uint32_t> values(n), vscratch(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    keys.push_back(K(key<T>(s, shape)));
+    values[i] = static_cast<uint32_t>(i);
+  }
+  kscratch = keys;
+
+  /* reference: stable order of (key, index) */
+  std::vector<std::pair<T, uint32_t>> expect;
+  for(std::size_t i = 0; i < n; ++i)
+    expect.emplace_back(raw(keys[i]), values[i]);
+  std::stable_sort(expect.begin(), expect.end(),
+    [](const std::pair<T, uint32_t>& a, const std::pair<T, uint32_t>& b) { return a.first < b.first; });
+
+  std::vector<K> alone = keys;
+  if(parallel)
+  {
+    radix_sort_parallel(keys.data(), values.data(), n, kscratch.data(), vscratch.data(), 4);
+    radix_sort_parallel(alone.data(), n, kscratch.data(), 3);
+  }
+  else
+  {
+    radix_sort(keys.data(), values.data(), n, kscratch.data(), vscratch.data());
+    radix_sort(alone.data(), n, kscratch.data());
+  }
+
+  int failures = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    failures += raw(keys[i]) != expect[i].first;
+    failures += values[i] != expect[i].second;
+    failures += raw(alone[i]) != expect[i].first;
+  }
+  return failures;
+}
+
+/* payloads wider than the key, N bytes with the original index first */
+template <std::size_t N>
+struct Wide
+{
+  uint32_t index;
+  unsigned char pad[N - sizeof(uint32_t)];
+};
+
+/* the staging buffers follow the payload and stay small */
+static_assert(sizeof(bittle::detail::RadixScatter<uint8_t, Wide<64>>) <= 96 * 1024, "64 byte payload staging");
+static_assert(sizeof(bittle::detail::RadixScatter<uint8_t, Wide<200>>) <= 4 * 1024, "wide payloads scatter directly");
+
+template <typename K, std::size_t N>
+static int check_wide(uint64_t& s, std::size_t n, bool parallel)
+{
+  using namespace bittle;
+  std::vector<K> keys(n), kscratch(n);
+  std::vector<Wide<N>> values(n), vscratch(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    keys[i] = static_cast<K>(next(s));
+    values[i].index = static_cast<uint32_t>(i);
+    values[i].pad[N - sizeof(uint32_t) - 1] = static_cast<unsigned char>(keys[i]);
+  }
+  std::vector<std::pair<K, uint32_t>> expect;
+  for(std::size_t i = 0; i < n; ++i)
+    expect.emplace_back(keys[i], static_cast<uint32_t>(i));
+  std::stable_sort(expect.begin(), expect.end(),
+    [](const std::pair<K, uint32_t>& a, const std::pair<K, uint32_t>& b) { return a.first < b.first; });
+
+  if(parallel)
+    radix_sort_parallel(keys.data(), values.data(), n, kscratch.data(), vscratch.data(), 4);
+  else
+    radix_sort(keys.data(), values.data(), n, kscratch.data(), vscratch.data());
+
+  int failures = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    failures += keys[i] != expect[i].first || values[i].index != expect[i].second;
+    failures += values[i].pad[N - sizeof(uint32_t) - 1] != static_cast<unsigned char>(keys[i]);
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  const std::size_t sizes[] = {0, 1, 2, 31, 33, 1000, 5000};
+  for(std::size_t n : sizes)
+  {
+    for(int shape = 0; shape < 4; ++shape)
+    {
+      failures += check<uint32_t>(s, n, shape, false);
+      failures += check<int64_t>(s, n, shape, false);
+      failures += check<int8_t>(s, n, shape, false);
+      failures += check<uint16_t>(s, n, shape, false);
+      failures += check<Bits<int32_t>>(s, n, shape, false);
+      failures += check<Bits<uint64_t>>(s, n, shape, false);
+    }
+  }
+
+  for(int shape = 0; shape < 4; ++shape)
+  {
+    failures += check<uint64_t>(s, 200000, shape, true);
+    failures += check<int32_t>(s, 150001, shape, true);
+    failures += check<Bits<int64_t>>(s, 100000, shape, true);
+  }
+
+  for(bool parallel : {false, true})
+  {
+    failures += check_wide<uint8_t, 64>(s, 100000, parallel);
+    failures += check_wide<uint8_t, 200>(s, 70000, parallel);
+    failures += check_wide<uint16_t, 24>(s, 90000, parallel);
+  }
+
+  std::cout << "radix_sort failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
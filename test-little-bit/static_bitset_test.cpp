@@ -0,0 +1,130 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: static_bitset_test.cpp
+ * purpose: StaticBitset against std::bitset, plus compile time checks
+ */
+
+
+#include "static_bitset.hpp"
+#include "xorshift.hpp"
+#include <bitset>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/* everything below is evaluated by the compiler */
+constexpr bittle::StaticBitset<200> build()
+{
+  bittle::StaticBitset<200> b{1, 64, 130, 199, 500};
+  b.flipBit(2).clearBit(1);
+  return b;
+}
+
+constexpr std::size_t sum_positions(const bittle::StaticBitset<200>& b)
+{
+  std::size_t total = 0;
+  for(std::size_t i : b.setBits())
+    total += i;
+  return total;
+}
+
+static_assert(build().count() == 4, "constexpr count");
+static_assert(build().findFirst() == 2 && build().findNext(3) == 64 && build().findLast() == 199, "constexpr find");
+static_assert(build().rank(131) == 3 && build().rank(200) == 4, "constexpr rank");
+static_assert(sum_positions(build()) == 2 + 64 + 130 + 199, "constexpr iteration");
+static_assert((~build()).count() == 196 && (~build()).findFirstZero() == 2, "constexpr invert");
+static_assert(bittle::StaticBitset<200>{64}.isSubsetOf(build()) && !build().isSubsetOf(bittle::StaticBitset<200>{64}), "constexpr subset");
+static_assert(bittle::StaticBitset<200>().setAll().all() && (build() << 1).test(3), "constexpr all and shift");
+
+template <std::size_t N>
+static int check(uint64_t& s)
+{
+  using namespace bittle;
+  int failures = 0;
+  StaticBitset<N> a, b;
+  std::bitset<N> ra, rb;
+  const int density = static_cast<int>(next(s) % 4);
+  for(std::size_t i = 0; i < N; ++i)
+  {
+    const bool x = density == 0 ? next(s) % 50 == 0 : (density == 3 ? next(s) % 50 != 0 : next(s) & 1);
+    const bool y = next(s) % 3 == 0;
+    a.setBit(i, x);
+    ra[i] = x;
+    b.setBit(i, y);
+    rb[i] = y;
+  }
+
+  failures += a.count() != ra.count();
+  failures += a.any() != ra.any();
+  failures += a.all() != ra.all();
+  failures += a.isSubsetOf(b) != ((ra & ~rb).none());
+  failures += a.intersects(b) != ((ra & rb).any());
+  failures += (a & b).isSubsetOf(a) ? 0 : 1;
+
+  std::vector<std::size_t> seen, each;
+  for(std::size_t i : a.setBits())
+    seen.push_back(i);
+  a.forEach([&](std::size_t i) { each.push_back(i); });
+  std::vector<std::size_t> expect;
+  for(std::size_t i = 0; i < N; ++i)
+    if(ra[i])
+      expect.push_back(i);
+  failures += seen != expect;
+  failures += each != expect;
+
+  std::size_t last = StaticBitset<N>::npos;
+  for(std::size_t i = 0; i < N; ++i)
+  {
+    if(ra[i])
+      last = i;
+    std::size_t nxt = StaticBitset<N>::npos, nxz = StaticBitset<N>::npos;
+    for(std::size_t j = N; j-- > i; )
+    {
+      if(ra[j]) nxt = j;
+      else nxz = j;
+    }
+    failures += a.findNext(i) != nxt;
+    failures += a.findNextZero(i) != nxz;
+    failures += a.rank(i) != (ra << (N - i)).count();
+    failures += a.test(i) != ra[i];
+  }
+  failures += a.findLast() != last;
+  failures += a.rank(N) != ra.count();
+
+  const std::size_t k = next(s) % (N + 70);
+  const StaticBitset<N> l = a << k, r = a >> k, x = a ^ b, o = a | b, n = ~a;
+  const std::bitset<N> rl = ra << k, rr = ra >> k, rx = ra ^ rb, ro = ra | rb, rn = ~ra;
+  for(std::size_t i = 0; i < N; ++i)
+  {
+    failures += l.test(i) != rl[i];
+    failures += r.test(i) != rr[i];
+    failures += x.test(i) != rx[i];
+    failures += o.test(i) != ro[i];
+    failures += n.test(i) != rn[i];
+  }
+  failures += n.count() != rn.count();
+  failures += (a == a) ? 0 : 1;
+  failures += (a != n) ? 0 : 1;
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+  for(int r = 0; r < 40; ++r)
+  {
+    failures += check<1>(s);
+    failures += check<63>(s);
+    failures += check<64>(s);
+    failures += check<65>(s);
+    failures += check<128>(s);
+    failures += check<200>(s);
+    failures += check<1024>(s);
+  }
+
+  std::cout << "static_bitset failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: swar_test.cpp
+ * purpose: lane operations and scanners against a per lane reference
+ */
+
+
+#include "swar.hpp"
+#include "xorshift.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+/* words with plenty of equal, zero and 0x80 lanes */
+static uint64_t lanes(uint64_t& s)
+{
+  uint64_t x = next(s);
+  const uint64_t y = next(s);
+  const uint64_t pick = next(s);
+  for(int i = 0; i < 8; ++i)
+  {
+    const uint64_t m = uint64_t(0xFF) << (8 * i);
+    switch((pick >> (3 * i)) & 7)
+    {
+      case 0: x &= ~m; break;
+      case 1: x = (x & ~m) | (y & m); break;
+      case 2: x = (x & ~m) | (uint64_t(0x80) << (8 * i)); break;
+      default: break;
+    }
+  }
+  return x;
+}
+
+static uint64_t lane(uint64_t x, int w, int i)
+{
+  return (x >> (w * i)) & ((uint64_t(1) << w) - 1);
+}
+
+template <int W>
+static int check_lanes(uint64_t a, uint64_t b)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t zero = 0, eq = 0, lt = 0, gt = 0, add = 0, sub = 0, mn = 0, mx = 0;
+  for(int i = 0; i < 64 / W; ++i)
+  {
+    const uint64_t top = uint64_t(1) << (W * i + W - 1);
+    const uint64_t x = lane(a, W, i);
+    const uint64_t y = lane(b, W, i);
+    const uint64_t m = (uint64_t(1) << W) - 1;
+    if(x == 0) zero |= top;
+    if(x == y) eq |= top;
+    if(x < y) lt |= top;
+    if(x > y) gt |= top;
+    add |= ((x + y) & m) << (W * i);
+    sub |= ((x - y) & m) << (W * i);
+    mn |= (x < y ? x : y) << (W * i);
+    mx |= (x < y ? y : x) << (W * i);
+  }
+  failures += zero_lanes<W>(a) != zero;
+  failures += equal_lanes<W>(a, b) != eq;
+  failures += less_lanes<W>(a, b) != lt;
+  failures += greater_lanes<W>(a, b) != gt;
+  failures += lane_add<W>(a, b) != add;
+  failures += lane_sub<W>(a, b) != sub;
+  failures += lane_min<W>(a, b) != mn;
+  failures += lane_max<W>(a, b) != mx;
+  return failures;
+}
+
+static std::size_t naive_find(const uint8_t* p, uint8_t c, std::size_t n)
+{
+  for(std::size_t i = 0; i < n; ++i)
+    if(p[i] == c)
+      return i;
+  return n;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace bittle;
+  int failures = 0;
+  uint64_t s = 88172645463325252ULL;
+
+  for(int r = 0; r < 100000; ++r)
+  {
+    const uint64_t a = lanes(s);
+    const uint64_t b = (r & 1) ? lanes(s) : a ^ (next(s) & 0x0101010101010101ULL);
+    failures += check_lanes<8>(a, b);
+    failures += check_lanes<16>(a, b);
+    failures += check_lanes<32>(a, b);
+
+    uint64_t bytes = 0, nibbles = 0, sum = 0;
+    for(int i = 0; i < 8; ++i)
+    {
+      bytes |= uint64_t(__builtin_popcountll(lane(a, 8, i))) << (8 * i);
+      sum += lane(a, 8, i);
+    }
+    for(int i = 0; i < 16; ++i)
+      nibbles |= uint64_t(__builtin_popcountll(lane(a, 4, i))) << (4 * i);
+    failures += byte_popcount(a) != bytes;
+    failures += nibble_popcount(a) != nibbles;
+    failures += sum_bytes(a) != sum;
+
+    const uint8_t c = static_cast<uint8_t>(b);
+    const uint64_t m = byte_equal_mask(a, c);
+    int first = 8, last = -1, count = 0;
+    for(int i = 0; i < 8; ++i)
+    {
+      if(lane(a, 8, i) != c)
+        continue;
+      if(first == 8) first = i;
+      last = i;
+      ++count;
+    }
+    failures += first_lane(m) != first;
+    failures += last_lane(m) != last;
+    failures += lane_count(m) != count;
+    failures += has_zero_byte(a) != (zero_lanes(a) != 0);
+    failures += expand_lanes(m) != ((m >> 7) * 0xFF);
+  }
+
+  /* Bits<uint64_t> forms agree with the word forms */
+  const Bits64U x(0x00FF7F8001020300ULL), y(0x01FE7F7F02010400ULL);
+  failures += zero_lanes(x).value() != zero_lanes(x.value());
+  failures += less_lanes(x, y).value() != less_lanes(x.value(), y.value());
+  failures += lane_add<16>(x, y).value() != lane_add<16>(x.value(), y.value());
+  failures += lane_min(x, y).value() != lane_min(x.value(), y.value());
+  failures += byte_popcount(x).value() != byte_popcount(x.value());
+  failures += first_lane(byte_equal_mask(x, 0x80)) != 4;
+  static_assert(lane_max(0x0102030405060708ULL, 0x0807060504030201ULL) == 0x0807060505060708ULL, "constexpr lane_max");
+
+  /* scanners at every length and alignment */
+  std::vector<uint8_t> buf(600);
+  for(std::size_t n = 0; n < 300; ++n)
+  {
+    for(std::size_t off = 0; off < 8; ++off)
+    {
+      uint8_t* p = buf.data() + off;
+      for(std::size_t i = 0; i < n; ++i)
+        p[i] = static_cast<uint8_t>(1 + next(s) % 40);
+      const uint8_t c = static_cast<uint8_t>(1 + next(s) % 40);
+      std::size_t count = 0;
+      for(std::size_t i = 0; i < n; ++i)
+        count += p[i] == c;
+      failures += find_byte(p, c, n) != naive_find(p, c, n);
+      failures += count_byte(p, c, n) != count;
+
+      p[n] = 0;
+      failures += string_length(reinterpret_cast<const char*>(p)) != std::strlen(reinterpret_cast<const char*>(p));
+    }
+  }
+
+  std::cout << "swar failures: " << failures << std::endl;
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
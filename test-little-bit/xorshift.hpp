@@ -0,0 +1,26 @@
+/*
+ * author: bayleaf
+ * date: 10/18/2026
+ * file: xorshift.hpp
+ * purpose: the xorshift64 generator the tests and benchmarks draw from
+ */
+
+
+#ifndef BITTLE_XORSHIFT_HPP
+#define BITTLE_XORSHIFT_HPP
+
+#include <cstdint>
+
+
+/* name: next
+ * desc: advances the xorshift64 state s, s must not be 0
+ * returns: the new state
+ */
+inline uint64_t next(uint64_t& s)
+{
+  s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+  return s;
+}
+
+
+#endif